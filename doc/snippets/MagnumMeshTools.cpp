@@ -26,19 +26,57 @@
 #include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/BuildMeshlets.h"
 #include "Magnum/MeshTools/CombineIndexedArrays.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/GenerateFlatNormals.h"
+#include "Magnum/MeshTools/GenerateSmoothNormals.h"
+#include "Magnum/MeshTools/GenerateTangents.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/OptimizeVertexCache.h"
+#include "Magnum/MeshTools/OptimizeVertexFetch.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Simplify.h"
 #include "Magnum/MeshTools/Transform.h"
+#include "Magnum/Trade/MeshData3D.h"
 
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
 
 int main() {
 
+{
+/* [buildMeshlets] */
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+Matrix4 projection, cameraTransformation;
+
+MeshTools::MeshletData data = MeshTools::buildMeshlets(indices, positions);
+
+const Frustum frustum = Frustum::fromMatrix(
+    projection*cameraTransformation.invertedRigid());
+const Vector3 cameraPosition = cameraTransformation.translation();
+for(const MeshTools::Meshlet& meshlet: data.meshlets) {
+    /* Outside of the view */
+    if(!Math::Intersection::sphereFrustum(meshlet.center, meshlet.radius, frustum))
+        continue;
+
+    /* All triangles facing away from the camera */
+    if(meshlet.coneAngle != Rad{0.0f} &&
+       Math::Intersection::pointCone(cameraPosition, meshlet.coneOrigin,
+            meshlet.coneNormal, meshlet.coneAngle))
+        continue;
+
+    // draw data.indices[meshlet.indexOffset] to
+    // data.indices[meshlet.indexOffset + meshlet.triangleCount*3]
+}
+/* [buildMeshlets] */
+}
+
 {
 /* [combineIndexedArrays] */
 std::vector<UnsignedInt> vertexIndices;
@@ -55,6 +93,28 @@ std::vector<UnsignedInt> indices = MeshTools::combineIndexedArrays(
 /* [combineIndexedArrays] */
 }
 
+{
+/* [combineIndexArraysInto] */
+/* Position, texture coordinate and normal index of each face corner */
+struct Corner {
+    UnsignedInt position, textureCoordinates, normal;
+};
+Containers::ArrayView<Corner> corners;
+
+Containers::Array<UnsignedInt> indices{Containers::NoInit, corners.size()};
+Containers::Array<UnsignedInt> scratch{Containers::NoInit,
+    MeshTools::combineIndexArraysScratchSize(corners.size())};
+std::size_t vertexCount = MeshTools::combineIndexArraysInto({
+        {&corners[0].position, corners.size(), sizeof(Corner)},
+        {&corners[0].textureCoordinates, corners.size(), sizeof(Corner)},
+        {&corners[0].normal, corners.size(), sizeof(Corner)}
+    }, indices, scratch);
+
+/* The first vertexCount items of corners now describe the unique vertices */
+/* [combineIndexArraysInto] */
+static_cast<void>(vertexCount);
+}
+
 {
 /* [compressIndices] */
 std::vector<UnsignedInt> indices;
@@ -82,6 +142,29 @@ Containers::Array<UnsignedShort> indexData =
 /* [compressIndicesAs] */
 }
 
+{
+/* [compressIndicesInto] */
+/* Indices of one of many meshes sharing a single large vertex buffer */
+Containers::ArrayView<const UnsignedInt> indices;
+
+/* Compress in a preallocated buffer, using the smallest index as a base */
+Containers::Array<char> indexData{indices.size()*sizeof(UnsignedInt)};
+MeshIndexType indexType;
+UnsignedInt indexStart, indexEnd;
+std::tie(indexType, indexStart, indexEnd) =
+    MeshTools::compressIndicesInto(indices, indexData, true);
+
+GL::Buffer indexBuffer;
+indexBuffer.setData(indexData.prefix(indices.size()*meshIndexTypeSize(indexType)),
+    GL::BufferUsage::StaticDraw);
+
+GL::Mesh mesh;
+mesh.setCount(indices.size())
+    .setBaseVertex(indexStart)
+    .setIndexBuffer(indexBuffer, 0, indexType, 0, indexEnd - indexStart);
+/* [compressIndicesInto] */
+}
+
 {
 /* [generateFlatNormals] */
 std::vector<UnsignedInt> vertexIndices;
@@ -100,6 +183,41 @@ std::vector<UnsignedInt> indices = MeshTools::combineIndexedArrays(
 /* [generateFlatNormals-recombine] */
 }
 
+{
+/* [generateFlatNormals-nonindexed] */
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> indexedPositions;
+
+std::vector<Vector3> positions = MeshTools::duplicate(indices, indexedPositions);
+std::vector<Vector3> normals = MeshTools::generateFlatNormals(positions);
+/* [generateFlatNormals-nonindexed] */
+}
+
+{
+/* [generateSmoothNormals] */
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+
+std::vector<Vector3> normals = MeshTools::generateSmoothNormals(indices, positions);
+/* [generateSmoothNormals] */
+}
+
+{
+/* [generateTangents] */
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<Vector3> normals;
+std::vector<Vector2> textureCoordinates;
+
+std::vector<Vector4> tangents = MeshTools::generateTangents(indices, positions,
+    normals, textureCoordinates);
+
+GL::Buffer vertexBuffer;
+vertexBuffer.setData(MeshTools::interleave(positions, normals, tangents,
+    textureCoordinates), GL::BufferUsage::StaticDraw);
+/* [generateTangents] */
+}
+
 {
 struct MyShader {
     typedef GL::Attribute<0, Vector3> Position;
@@ -128,6 +246,67 @@ auto data = MeshTools::interleave(positions, weights, 2, vertexColors, 1);
 /* [interleave2] */
 }
 
+{
+bool halfNormals{};
+/* [interleaveAttributesInto] */
+std::vector<Vector3> positions;
+std::vector<Vector3> normals;
+std::vector<Color4> colors;
+
+/* Normals are either half-floats or floats depending on a runtime option,
+   colors are packed to normalized bytes */
+const MeshTools::AttributeFormat normalFormat = halfNormals ?
+    MeshTools::AttributeFormat::Half : MeshTools::AttributeFormat::Float;
+const std::size_t colorOffset = 12 + 3*MeshTools::attributeFormatSize(normalFormat);
+const std::size_t stride = colorOffset + 4;
+
+Containers::Array<char> data{Containers::NoInit, positions.size()*stride};
+MeshTools::interleaveAttributesInto(data, stride, {
+    {Containers::StridedArrayView<const Vector3>{positions.data(), positions.size(), sizeof(Vector3)},
+        MeshTools::AttributeFormat::Float, 3, 0},
+    {Containers::StridedArrayView<const Vector3>{normals.data(), normals.size(), sizeof(Vector3)},
+        MeshTools::AttributeFormat::Float, 3, 12, normalFormat},
+    {Containers::StridedArrayView<const Color4>{colors.data(), colors.size(), sizeof(Color4)},
+        MeshTools::AttributeFormat::Float, 4, colorOffset,
+        MeshTools::AttributeFormat::UnsignedByteNormalized}
+});
+/* [interleaveAttributesInto] */
+
+/* [deinterleaveAttributesInto] */
+MeshTools::deinterleaveAttributesInto(data, stride, {
+    {Containers::StridedArrayView<Vector3>{normals.data(), normals.size(), sizeof(Vector3)},
+        MeshTools::AttributeFormat::Float, 3, 12, normalFormat}
+});
+/* [deinterleaveAttributesInto] */
+}
+
+{
+/* [optimizeVertexCache] */
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+
+MeshTools::optimizeVertexCache(indices, positions.size());
+MeshTools::optimizeOverdraw(indices, positions);
+/* [optimizeVertexCache] */
+}
+
+{
+/* [optimizeVertexFetch] */
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<Vector3> normals;
+
+MeshTools::optimizeVertexCache(indices, positions.size());
+MeshTools::optimizeVertexFetch(indices, positions, normals);
+
+Containers::Array<char> indexData;
+MeshIndexType indexType;
+UnsignedInt indexStart, indexEnd;
+std::tie(indexData, indexType, indexStart, indexEnd) =
+    MeshTools::compressIndices(indices);
+/* [optimizeVertexFetch] */
+}
+
 {
 /* [removeDuplicates1] */
 std::vector<UnsignedInt> indices;
@@ -152,6 +331,32 @@ std::vector<UnsignedInt> indices = MeshTools::combineIndexedArrays(
 /* [removeDuplicates2] */
 }
 
+{
+/* [removeDuplicatesExact] */
+std::vector<UnsignedInt> indices;
+std::vector<Color4ub> colors;
+
+indices = MeshTools::duplicate(indices, MeshTools::removeDuplicatesExact(colors));
+/* [removeDuplicatesExact] */
+}
+
+{
+/* [generateLods] */
+Trade::MeshData3D mesh{MeshPrimitive::Triangles, {}, {{}}, {}, {}, {}};
+
+/* The first level is the original mesh, the rest are simplified. All levels
+   can be concatenated into a single index buffer, sharing the vertex data. */
+std::vector<std::vector<UnsignedInt>> lods =
+    MeshTools::generateLods(mesh, 4, 0.5f);
+std::vector<UnsignedInt> indices;
+std::vector<std::size_t> lodOffsets;
+for(const std::vector<UnsignedInt>& lod: lods) {
+    lodOffsets.push_back(indices.size());
+    indices.insert(indices.end(), lod.begin(), lod.end());
+}
+/* [generateLods] */
+}
+
 {
 /* [transformVectors] */
 std::vector<Vector3> vectors;
@@ -170,4 +375,22 @@ MeshTools::transformPointsInPlace(transformation, points);
 /* [transformPoints] */
 }
 
+{
+/* [transformPointsInto] */
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+};
+Containers::ArrayView<Vertex> vertices;
+
+/* Transform positions and normals of an interleaved mesh in-place */
+Matrix4 transformation = Matrix4::translation({0.5f, -1.0f, 3.0f})*
+    Matrix4::rotationY(35.0_degf);
+Containers::StridedArrayView<Vector3> positions{&vertices[0].position, vertices.size(), sizeof(Vertex)};
+Containers::StridedArrayView<Vector3> normals{&vertices[0].normal, vertices.size(), sizeof(Vertex)};
+MeshTools::transformPointsInto(transformation, positions, positions);
+MeshTools::transformVectorsInto(transformation, normals, normals);
+/* [transformPointsInto] */
+}
+
 }
@@ -34,6 +34,7 @@
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/FlatHierarchy.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/Scene.h"
 
@@ -349,4 +350,81 @@ camera.draw(drawableTransformations);
 /* [Drawable-draw-order] */
 }
 
+{
+Object3D cameraObject;
+SceneGraph::Camera3D camera{cameraObject};
+SceneGraph::DrawableGroup3D drawableGroup;
+SceneGraph::Drawable3D* drawable{};
+/* [Drawable-culling] */
+// Bounding sphere of the mesh, relative to the object
+drawable->setBoundingSphere({0.0f, 0.5f, 0.0f}, 1.5f);
+
+camera.setCullingEnabled(true);
+camera.draw(drawableGroup);
+Debug{} << camera.visibleCount() << "drawables drawn,"
+        << camera.culledCount() << "culled";
+/* [Drawable-culling] */
+}
+
+{
+Scene3D scene;
+Deg angle = 5.0_degf;
+/* [FlatHierarchy-usage] */
+SceneGraph::FlatHierarchy<SceneGraph::MatrixTransformation3D> hierarchy{scene};
+
+// Animate the local transformations directly ...
+for(Matrix4& transformation: hierarchy.localTransformations())
+    transformation = transformation*Matrix4::rotationY(angle);
+
+// ... or after changing them through the scene objects, fetch them again
+hierarchy.pull();
+
+// Calculate world transformations of all objects in a single pass
+hierarchy.update();
+for(std::size_t i = 0; i != hierarchy.size(); ++i) {
+    Object3D& object = *hierarchy.objects()[i];
+    Debug{} << object.transformation() << hierarchy.worldTransformations()[i];
+}
+/* [FlatHierarchy-usage] */
+}
+
+{
+Scene3D scene;
+bool running = false;
+/* [Object-transformationsInto] */
+std::vector<std::reference_wrapper<Object3D>> objects;
+// fill the object list ...
+
+Object3D::TransformationScratch scratch;
+std::vector<Matrix4> transformations(objects.size());
+while(running) {
+    // Allocates only until the scratch is large enough for the object set
+    scene.transformationsInto(objects,
+        {transformations.data(), transformations.size()}, scratch);
+
+    // use the transformations ...
+}
+/* [Object-transformationsInto] */
+}
+
+{
+Scene3D scene;
+/* [Object-setCleanSubtree] */
+// Clean all dirty objects in the scene using four threads
+scene.setCleanSubtree(4);
+/* [Object-setCleanSubtree] */
+}
+
+{
+Scene3D scene;
+Object3D object{&scene};
+/* [Scene-cleanAll] */
+// Moving an object remembers it in the scene as a root of a dirty subtree
+object.translate(Vector3::yAxis(0.5f));
+
+// Clean only the subtrees that changed since the last call
+scene.cleanAll();
+/* [Scene-cleanAll] */
+}
+
 }
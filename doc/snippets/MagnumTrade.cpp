@@ -24,6 +24,7 @@
 */
 
 #include <unordered_map>
+#include <vector>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Directory.h>
 
@@ -40,12 +41,55 @@
 #include "Magnum/Trade/ObjectData3D.h"
 #include "Magnum/Trade/PhongMaterialData.h"
 #ifdef MAGNUM_TARGET_GL
+#include "Magnum/AbstractAsyncResourceLoader.h"
 #include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
 #endif
 
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
 
+#ifdef MAGNUM_TARGET_GL
+/* [AbstractAsyncResourceLoader-implementation] */
+class TextureLoader: public AbstractAsyncResourceLoader<GL::Texture2D, Trade::ImageData2D> {
+    public:
+        explicit TextureLoader(PluginManager::Manager<Trade::AbstractImporter>& manager, UnsignedInt workerCount): AbstractAsyncResourceLoader{workerCount} {
+            /* Plugin instances are not thread-safe, have one per worker */
+            for(UnsignedInt i = 0; i != std::max(workerCount, 1u); ++i)
+                _importers.push_back(manager.loadAndInstantiate("AnyImageImporter"));
+        }
+
+        /* Stop the workers before the importers get destroyed */
+        ~TextureLoader() { stop(); }
+
+        void addFile(const std::string& filename) {
+            _files.emplace(filename, filename);
+        }
+
+    private:
+        /* Called on a worker thread */
+        Containers::Optional<Trade::ImageData2D> doLoadAsync(ResourceKey key, UnsignedInt worker) override {
+            Trade::AbstractImporter& importer = *_importers[worker];
+            auto found = _files.find(key);
+            if(found == _files.end() || !importer.openFile(found->second))
+                return Containers::NullOpt;
+            return importer.image2D(0);
+        }
+
+        /* Called on the main thread from update() */
+        void doFinish(ResourceKey key, Trade::ImageData2D&& image) override {
+            GL::Texture2D texture;
+            texture.setStorage(1, GL::TextureFormat::RGBA8, image.size())
+                .setSubImage(0, {}, image);
+            set(key, std::move(texture));
+        }
+
+        std::vector<Containers::Pointer<Trade::AbstractImporter>> _importers;
+        std::unordered_map<ResourceKey, std::string> _files;
+};
+/* [AbstractAsyncResourceLoader-implementation] */
+#endif
+
 int main() {
 
 {
@@ -197,6 +241,33 @@ else
     texture.setCompressedSubImage(0, {}, *image);
 /* [ImageData-usage] */
 }
+
+{
+PluginManager::Manager<Trade::AbstractImporter> importerManager;
+bool running = true;
+/* [AbstractAsyncResourceLoader-use] */
+ResourceManager<GL::Texture2D> manager;
+Containers::Pointer<TextureLoader> loader{Containers::InPlaceInit, importerManager, 4};
+loader->addFile("sky.png");
+loader->addFile("ground.png");
+loader->setPriority("ground.png", 10);
+TextureLoader& textureLoader = *loader;
+manager.setLoader<GL::Texture2D>(std::move(loader));
+
+// Queues both textures, ground.png gets loaded first
+Resource<GL::Texture2D> sky = manager.get<GL::Texture2D>("sky.png");
+Resource<GL::Texture2D> ground = manager.get<GL::Texture2D>("ground.png");
+
+while(running) {
+    // Publish at most two newly loaded textures each frame
+    textureLoader.update(2);
+
+    if(ground) {
+        // draw with the texture ...
+    }
+}
+/* [AbstractAsyncResourceLoader-use] */
+}
 #endif
 
 {
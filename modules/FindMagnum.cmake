@@ -84,6 +84,7 @@
 #  OpenGLTester                 - OpenGLTester class
 #  MagnumFont                   - Magnum bitmap font plugin
 #  MagnumFontConverter          - Magnum bitmap font converter plugin
+#  MeshBlobImporter             - Mesh blob importer plugin
 #  ObjImporter                  - OBJ importer plugin
 #  TgaImageConverter            - TGA image converter plugin
 #  TgaImporter                  - TGA importer plugin
@@ -91,6 +92,7 @@
 #  distancefieldconverter       - magnum-distancefieldconverter executable
 #  fontconverter                - magnum-fontconverter executable
 #  imageconverter               - magnum-imageconverter executable
+#  meshconverter                - magnum-meshconverter executable
 #  gl-info                      - magnum-gl-info executable
 #  al-info                      - magnum-al-info executable
 #
@@ -338,10 +340,11 @@ set(_MAGNUM_LIBRARY_COMPONENT_LIST
     OpenGLTester)
 set(_MAGNUM_PLUGIN_COMPONENT_LIST
     AnyAudioImporter AnyImageConverter AnyImageImporter AnySceneImporter
-    MagnumFont MagnumFontConverter ObjImporter TgaImageConverter TgaImporter
-    WavAudioImporter)
+    MagnumFont MagnumFontConverter MeshBlobImporter ObjImporter
+    TgaImageConverter TgaImporter WavAudioImporter)
 set(_MAGNUM_EXECUTABLE_COMPONENT_LIST
-    distancefieldconverter fontconverter imageconverter gl-info al-info)
+    distancefieldconverter fontconverter imageconverter meshconverter gl-info
+    al-info)
 
 # Inter-component dependencies
 set(_MAGNUM_Audio_DEPENDENCIES )
@@ -360,10 +363,9 @@ if(MAGNUM_TARGET_GL)
     set(_MAGNUM_DebugTools_GL_DEPENDENCY_IS_OPTIONAL ON)
 endif()
 
-set(_MAGNUM_MeshTools_DEPENDENCIES )
+set(_MAGNUM_MeshTools_DEPENDENCIES Trade)
 if(MAGNUM_TARGET_GL)
-    # Trade is used only in compile(), which needs GL as well
-    list(APPEND _MAGNUM_MeshTools_DEPENDENCIES Trade GL)
+    list(APPEND _MAGNUM_MeshTools_DEPENDENCIES GL)
 endif()
 
 set(_MAGNUM_OpenGLTester_DEPENDENCIES GL)
@@ -804,6 +806,10 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL MeshTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES CompressIndices.h)
 
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
+
         # OpenGLTester library
         elseif(_component STREQUAL OpenGLTester)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_SUFFIX Magnum/GL)
@@ -812,7 +818,12 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL Primitives)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Cube.h)
 
-        # No special setup for SceneGraph library
+        # SceneGraph library
+        elseif(_component STREQUAL SceneGraph)
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
+
         # No special setup for Shaders library
 
         # Text library
@@ -835,6 +846,12 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
             find_package(Vulkan REQUIRED)
             set_property(TARGET Magnum::${_component} APPEND PROPERTY
                 INTERFACE_LINK_LIBRARIES Vulkan::Vulkan)
+
+        # ObjImporter plugin
+        elseif(_component STREQUAL ObjImporter)
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
         endif()
 
         # No special setup for AnyAudioImporter plugin
@@ -843,7 +860,7 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # No special setup for AnySceneImporter plugin
         # No special setup for MagnumFont plugin
         # No special setup for MagnumFontConverter plugin
-        # No special setup for ObjImporter plugin
+        # No special setup for MeshBlobImporter plugin
         # No special setup for TgaImageConverter plugin
         # No special setup for TgaImporter plugin
         # No special setup for WavAudioImporter plugin
@@ -0,0 +1,452 @@
+#ifndef Magnum_AbstractAsyncResourceLoader_h
+#define Magnum_AbstractAsyncResourceLoader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::AbstractAsyncResourceLoader
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/AbstractResourceLoader.h"
+
+#if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+#include <thread>
+#endif
+
+namespace Magnum {
+
+namespace Implementation {
+
+/* The default doFinish() is provided only if the loaded type is the same as
+   the resource type, otherwise it's pure virtual and a subclass can't be
+   instantiated without implementing it */
+template<class T, class U> class AsyncResourceLoaderFinish: public AbstractResourceLoader<T> {
+    protected:
+        virtual void doFinish(ResourceKey key, U&& data) = 0;
+};
+
+template<class T> class AsyncResourceLoaderFinish<T, T>: public AbstractResourceLoader<T> {
+    protected:
+        virtual void doFinish(ResourceKey key, T&& data) {
+            this->set(key, std::move(data));
+        }
+};
+
+}
+
+/**
+@brief Base for asynchronous resource loaders
+@tparam T   Resource type
+@tparam U   Type produced by the worker threads. Defaults to @p T.
+
+An @ref AbstractResourceLoader that moves the actual loading off the main
+thread. Each request coming from @ref ResourceManager::get() is put into a
+priority queue, picked by one of the worker threads and decoded there by
+calling @ref doLoadAsync(). The results are published back to the
+@ref ResourceManager only at a well-defined synchronization point --- in
+@ref update() --- so the manager itself is never accessed from more than one
+thread.
+
+@section AbstractAsyncResourceLoader-usage Usage and subclassing
+
+Subclassing is done by implementing at least @ref doLoadAsync(), which gets
+called on a worker thread and returns either the decoded data or
+@ref Corrade::Containers::NullOpt "Containers::NullOpt" if the resource
+couldn't be loaded. As the function is called from multiple threads in
+parallel, it should only access state that's either read-only or private to
+given worker --- the @p worker parameter is a stable index in range
+@cpp [0, workerCount()) @ce that can be used for that. That's useful
+especially for @ref Trade::AbstractImporter plugins, which are not
+thread-safe and thus need one instance per worker.
+
+Because graphics resources such as @ref GL::Texture can usually be created only
+on the thread that owns the context, the type produced by the worker can
+differ from the resource type. In that case @ref doFinish() has to be
+implemented as well, which is called from @ref update() on the main thread and is expected to
+convert the decoded data and pass them to the manager using
+@ref AbstractResourceLoader::set() "set()" or
+@ref AbstractResourceLoader::setNotFound() "setNotFound()":
+
+@snippet MagnumTrade.cpp AbstractAsyncResourceLoader-implementation
+
+The main loop then calls @ref update() once per frame to publish everything
+that finished loading since the last call, optionally limiting how many
+resources get published in a single frame to spread the cost of
+@ref doFinish() across frames:
+
+@snippet MagnumTrade.cpp AbstractAsyncResourceLoader-use
+
+@section AbstractAsyncResourceLoader-priorities Priorities and cancellation
+
+Requests with higher priority set via @ref setPriority() are picked by the
+workers first, requests of the same priority are processed in the order they
+were made. A request that's still queued or being loaded can be cancelled
+using @ref cancel(), in which case the resource is marked as
+@ref ResourceState::NotFound and the result, if any, is discarded. To retry,
+call @ref AbstractResourceLoader::load() "load()" on the loader again.
+
+@section AbstractAsyncResourceLoader-destruction Destruction
+
+The worker threads are calling the virtual @ref doLoadAsync() function, which
+means they need to be stopped before the subclass gets destructed --- a
+worker could otherwise be in the middle of a @ref doLoadAsync() call on a
+half-destroyed object or pick up a new request after only the base is left.
+Because of that, @b every subclass has to call @ref stop() in its
+destructor, as shown in the snippet above. Requests that are still queued
+are then dropped and the corresponding resources stay in
+@ref ResourceState::Loading state.
+
+@section AbstractAsyncResourceLoader-threads Threading support
+
+The class uses @ref std::thread, so the application needs to link to the
+system thread library (for example using the `Threads::Threads` CMake
+target). On @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" without pthreads
+support the worker count is always zero. With zero workers all loading is
+done synchronously in @ref update() on the calling thread, which is also
+useful for debugging.
+*/
+template<class T, class U = T> class AbstractAsyncResourceLoader: public
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Implementation::AsyncResourceLoaderFinish<T, U>
+    #else
+    AbstractResourceLoader<T>
+    #endif
+{
+    public:
+        /**
+         * @brief Constructor
+         * @param workerCount   Count of worker threads. If @cpp 0 @ce, the
+         *      resources are loaded synchronously in @ref update().
+         */
+        explicit AbstractAsyncResourceLoader(UnsignedInt workerCount = 1);
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref stop(), but at that point the subclass is already
+         * destroyed and the workers might have called into it. Subclasses
+         * are required to call @ref stop() in their own destructor, see
+         * @ref AbstractAsyncResourceLoader-destruction.
+         */
+        ~AbstractAsyncResourceLoader();
+
+        /**
+         * @brief Count of worker threads
+         *
+         * Returns @cpp 0 @ce after @ref stop() was called.
+         */
+        UnsignedInt workerCount() const { return UnsignedInt(_workers.size()); }
+
+        /**
+         * @brief Count of pending requests
+         *
+         * Requests that are queued, being loaded or loaded but not yet
+         * published by @ref update().
+         */
+        std::size_t pendingCount() const { return _pending.size(); }
+
+        /**
+         * @brief Set resource priority
+         *
+         * Resources with higher priority are loaded first. If the resource is
+         * already queued, it's moved in the queue accordingly, otherwise the
+         * priority is remembered and used once the resource gets requested.
+         * Default priority is @cpp 0 @ce.
+         */
+        AbstractAsyncResourceLoader<T, U>& setPriority(ResourceKey key, Int priority);
+
+        /**
+         * @brief Cancel a request
+         *
+         * If the resource is queued, it's removed from the queue; if it's
+         * being loaded, its result is discarded once finished. The resource
+         * is then marked as @ref ResourceState::NotFound, counting towards
+         * @ref notFoundCount(). Returns @cpp false @ce if the resource is
+         * not pending, @cpp true @ce otherwise.
+         */
+        bool cancel(ResourceKey key);
+
+        /**
+         * @brief Publish loaded resources
+         * @param maxCount  Max count of resources to publish
+         * @return Count of published resources, including the ones that
+         *      were not found
+         *
+         * The synchronization point with the main thread. Passes resources
+         * finished by the workers to the @ref ResourceManager, calling
+         * @ref doFinish() for each of them, in the order they were finished.
+         * Resources over @p maxCount are kept for the next call. With zero
+         * workers, the queued requests are loaded here, in priority order.
+         * Expected to be called on the thread that owns the manager.
+         */
+        std::size_t update(std::size_t maxCount = ~std::size_t{});
+
+        /**
+         * @brief Wait for all pending requests
+         *
+         * Blocks until the workers process all queued requests and then
+         * calls @ref update() to publish them.
+         */
+        void wait();
+
+        /**
+         * @brief Stop the workers
+         *
+         * Drops all requests that are not being loaded yet, waits for the
+         * workers to finish the ones they're currently loading and joins
+         * them. The finished results are discarded. Subsequent requests are
+         * loaded synchronously in @ref update(). Called automatically on
+         * destruction, see @ref AbstractAsyncResourceLoader-destruction for
+         * more information.
+         */
+        void stop();
+
+    protected:
+        /**
+         * @brief Implementation for loading the resource on a worker
+         * @param key       Resource key
+         * @param worker    Worker index in range @cpp [0, workerCount()) @ce,
+         *      or @cpp 0 @ce if the loading is done synchronously
+         *
+         * Called on a worker thread. Return @ref Corrade::Containers::NullOpt "Containers::NullOpt"
+         * if the resource can't be loaded, it's then marked as
+         * @ref ResourceState::NotFound in @ref update().
+         */
+        virtual Containers::Optional<U> doLoadAsync(ResourceKey key, UnsignedInt worker) = 0;
+
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Implementation for publishing the resource
+         *
+         * Called from @ref update() on the main thread for every successfully
+         * loaded resource that wasn't cancelled. If @p U is the same as @p T,
+         * default implementation passes @p data to
+         * @ref AbstractResourceLoader::set() "set()" with
+         * @ref ResourceDataState::Final and @ref ResourcePolicy::Resident,
+         * otherwise the function is pure virtual and has to be implemented.
+         */
+        virtual void doFinish(ResourceKey key, U&& data);
+        #endif
+
+    private:
+        struct Request {
+            ResourceKey key;
+            Int priority;
+            std::size_t id;
+        };
+
+        struct Result {
+            ResourceKey key;
+            std::size_t id;
+            Containers::Optional<U> data;
+        };
+
+        void doLoad(ResourceKey key) override;
+
+        /* Expects _mutex to be locked or no workers running */
+        Request popInternal();
+
+        void work(UnsignedInt worker);
+
+        /* Touched by the workers, guarded by _mutex */
+        std::mutex _mutex;
+        std::condition_variable _queueCondition, _doneCondition;
+        std::vector<Request> _queue;
+        std::vector<Result> _finished;
+        std::size_t _loadingCount{};
+        bool _stopping{};
+
+        /* Accessed only from the main thread */
+        #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+        std::vector<std::thread> _workers;
+        #else
+        std::vector<int> _workers;
+        #endif
+        std::unordered_map<ResourceKey, std::size_t> _pending;
+        std::unordered_map<ResourceKey, Int> _priorities;
+        std::size_t _nextId{};
+};
+
+template<class T, class U> AbstractAsyncResourceLoader<T, U>::AbstractAsyncResourceLoader(const UnsignedInt workerCount) {
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    _workers.reserve(workerCount);
+    for(UnsignedInt i = 0; i != workerCount; ++i)
+        _workers.emplace_back(&AbstractAsyncResourceLoader<T, U>::work, this, i);
+    #else
+    static_cast<void>(workerCount);
+    #endif
+}
+
+template<class T, class U> AbstractAsyncResourceLoader<T, U>::~AbstractAsyncResourceLoader() { stop(); }
+
+template<class T, class U> AbstractAsyncResourceLoader<T, U>& AbstractAsyncResourceLoader<T, U>::setPriority(const ResourceKey key, const Int priority) {
+    _priorities[key] = priority;
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    for(Request& request: _queue) if(request.key == key) {
+        request.priority = priority;
+        break;
+    }
+
+    return *this;
+}
+
+template<class T, class U> bool AbstractAsyncResourceLoader<T, U>::cancel(const ResourceKey key) {
+    if(!_pending.erase(key)) return false;
+
+    /* If it's still queued, remove it. If it's already being loaded or
+       finished, update() discards it because it's not pending anymore. */
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        for(auto it = _queue.begin(); it != _queue.end(); ++it) if(it->key == key) {
+            _queue.erase(it);
+            break;
+        }
+    }
+
+    this->setNotFound(key);
+    return true;
+}
+
+template<class T, class U> void AbstractAsyncResourceLoader<T, U>::doLoad(const ResourceKey key) {
+    const std::size_t id = _nextId++;
+    _pending[key] = id;
+
+    const auto priority = _priorities.find(key);
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _queue.push_back({key, priority == _priorities.end() ? 0 : priority->second, id});
+    }
+    _queueCondition.notify_one();
+}
+
+template<class T, class U> typename AbstractAsyncResourceLoader<T, U>::Request AbstractAsyncResourceLoader<T, U>::popInternal() {
+    /* The highest priority wins, the earliest request if there's more of
+       them. The queue is unordered so reprioritization is trivial. */
+    auto found = _queue.begin();
+    for(auto it = _queue.begin() + 1; it < _queue.end(); ++it)
+        if(it->priority > found->priority || (it->priority == found->priority && it->id < found->id))
+            found = it;
+
+    const Request request = *found;
+    _queue.erase(found);
+    return request;
+}
+
+template<class T, class U> void AbstractAsyncResourceLoader<T, U>::work(const UnsignedInt worker) {
+    std::unique_lock<std::mutex> lock{_mutex};
+    for(;;) {
+        _queueCondition.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+        if(_stopping) return;
+
+        const Request request = popInternal();
+        ++_loadingCount;
+
+        lock.unlock();
+        Containers::Optional<U> data = doLoadAsync(request.key, worker);
+        lock.lock();
+
+        _finished.push_back({request.key, request.id, std::move(data)});
+        --_loadingCount;
+        _doneCondition.notify_all();
+    }
+}
+
+template<class T, class U> std::size_t AbstractAsyncResourceLoader<T, U>::update(const std::size_t maxCount) {
+    /* Without workers, load the queued requests here */
+    if(_workers.empty()) while(_finished.size() < maxCount && !_queue.empty()) {
+        const Request request = popInternal();
+        Containers::Optional<U> data = doLoadAsync(request.key, 0);
+        _finished.push_back({request.key, request.id, std::move(data)});
+    }
+
+    /* Take the finished results so the workers aren't blocked while the
+       resources are being published */
+    std::vector<Result> finished;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        if(_finished.size() <= maxCount) std::swap(finished, _finished);
+        else {
+            finished.reserve(maxCount);
+            std::move(_finished.begin(), _finished.begin() + maxCount, std::back_inserter(finished));
+            _finished.erase(_finished.begin(), _finished.begin() + maxCount);
+        }
+    }
+
+    std::size_t count = 0;
+    for(Result& result: finished) {
+        /* Discard results that were cancelled or requested again since */
+        const auto pending = _pending.find(result.key);
+        if(pending == _pending.end() || pending->second != result.id)
+            continue;
+        _pending.erase(pending);
+
+        if(result.data) this->doFinish(result.key, std::move(*result.data));
+        else this->setNotFound(result.key);
+        ++count;
+    }
+
+    return count;
+}
+
+template<class T, class U> void AbstractAsyncResourceLoader<T, U>::wait() {
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _doneCondition.wait(lock, [this]() {
+            return _workers.empty() || (_queue.empty() && !_loadingCount);
+        });
+    }
+
+    update();
+}
+
+template<class T, class U> void AbstractAsyncResourceLoader<T, U>::stop() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping = true;
+        _queue.clear();
+    }
+    _queueCondition.notify_all();
+
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    for(std::thread& worker: _workers) worker.join();
+    #endif
+    _workers.clear();
+    _finished.clear();
+    _pending.clear();
+    _stopping = false;
+}
+
+}
+
+#endif
@@ -305,6 +305,24 @@ Equivalent to GLSL @glsl ivec4 @ce.
 */
 typedef Math::Vector4<Int> Vector4i;
 
+/** @brief Two-component unsigned short vector */
+typedef Math::Vector2<UnsignedShort> Vector2us;
+
+/** @brief Three-component unsigned short vector */
+typedef Math::Vector3<UnsignedShort> Vector3us;
+
+/** @brief Four-component unsigned short vector */
+typedef Math::Vector4<UnsignedShort> Vector4us;
+
+/** @brief Two-component signed short vector */
+typedef Math::Vector2<Short> Vector2s;
+
+/** @brief Three-component signed short vector */
+typedef Math::Vector3<Short> Vector3s;
+
+/** @brief Four-component signed short vector */
+typedef Math::Vector4<Short> Vector4s;
+
 /** @brief Three-component (RGB) float color */
 typedef Math::Color3<Float> Color3;
 
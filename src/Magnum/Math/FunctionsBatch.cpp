@@ -0,0 +1,303 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FunctionsBatch.h"
+
+#include "Magnum/Math/Implementation/sse2.h"
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+/* The SSE2 variants process the bulk of the range and return how many items
+   were processed, the rest is done by the scalar loops below. The base
+   variants process nothing. The argument order of _mm_min_ps() /
+   _mm_max_ps() is chosen so NaNs behave the same as in the scalar code --
+   a NaN in the accumulator stays there, a NaN in the input is ignored. */
+template<class T> std::size_t minmaxSse2(const T*, std::size_t, T&, T&, bool, bool) { return 0; }
+#ifndef _MAGNUM_USE_SSE2
+std::size_t sumSse2(const Float*, std::size_t, Float&) { return 0; }
+std::size_t kahanSumSse2(const Float*, std::size_t, Float&, Float&) { return 0; }
+#endif
+
+#ifdef _MAGNUM_USE_SSE2
+/* Integer min/max via compare + blend, SSE4.1 has _mm_min_epi32() but SSE2
+   doesn't. Unsigned values are biased to make the signed comparison work. */
+template<class T> struct IntegerSse2;
+template<> struct IntegerSse2<Int> {
+    static __m128i bias(__m128i a) { return a; }
+};
+template<> struct IntegerSse2<UnsignedInt> {
+    static __m128i bias(__m128i a) {
+        return _mm_xor_si128(a, _mm_set1_epi32(Int(0x80000000u)));
+    }
+};
+
+inline __m128i select(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/* Reduces four lanes of a min/max accumulator to a single value in the same
+   way the scalar loop would */
+template<class T> inline void reduce(const T(&min)[4], const T(&max)[4], T& outMin, T& outMax) {
+    outMin = min[0];
+    outMax = max[0];
+    for(std::size_t i = 1; i != 4; ++i) {
+        outMin = Math::min(outMin, min[i]);
+        outMax = Math::max(outMax, max[i]);
+    }
+}
+
+template<> std::size_t minmaxSse2<Float>(const Float* data, const std::size_t size, Float& outMin, Float& outMax, const bool doMin, const bool doMax) {
+    if(size < 8) return 0;
+
+    /* Two accumulators for each to hide the latency */
+    __m128 min0 = _mm_set1_ps(data[0]), min1 = min0;
+    __m128 max0 = min0, max1 = min0;
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        const __m128 a = _mm_loadu_ps(data + i);
+        const __m128 b = _mm_loadu_ps(data + i + 4);
+        if(doMin) {
+            min0 = _mm_min_ps(a, min0);
+            min1 = _mm_min_ps(b, min1);
+        }
+        if(doMax) {
+            max0 = _mm_max_ps(a, max0);
+            max1 = _mm_max_ps(b, max1);
+        }
+    }
+
+    Float min[4], max[4];
+    _mm_storeu_ps(min, _mm_min_ps(min1, min0));
+    _mm_storeu_ps(max, _mm_max_ps(max1, max0));
+    reduce(min, max, outMin, outMax);
+    return i;
+}
+
+template<class T> std::size_t minmaxIntegerSse2(const T* data, const std::size_t size, T& outMin, T& outMax, const bool doMin, const bool doMax) {
+    if(size < 8) return 0;
+
+    __m128i min0 = IntegerSse2<T>::bias(_mm_set1_epi32(Int(data[0]))), min1 = min0;
+    __m128i max0 = min0, max1 = min0;
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        const __m128i a = IntegerSse2<T>::bias(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+        const __m128i b = IntegerSse2<T>::bias(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4)));
+        if(doMin) {
+            min0 = select(_mm_cmplt_epi32(a, min0), a, min0);
+            min1 = select(_mm_cmplt_epi32(b, min1), b, min1);
+        }
+        if(doMax) {
+            max0 = select(_mm_cmpgt_epi32(a, max0), a, max0);
+            max1 = select(_mm_cmpgt_epi32(b, max1), b, max1);
+        }
+    }
+
+    T min[4], max[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(min), IntegerSse2<T>::bias(select(_mm_cmplt_epi32(min1, min0), min1, min0)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(max), IntegerSse2<T>::bias(select(_mm_cmpgt_epi32(max1, max0), max1, max0)));
+    reduce(min, max, outMin, outMax);
+    return i;
+}
+
+template<> std::size_t minmaxSse2<Int>(const Int* data, const std::size_t size, Int& outMin, Int& outMax, const bool doMin, const bool doMax) {
+    return minmaxIntegerSse2(data, size, outMin, outMax, doMin, doMax);
+}
+
+template<> std::size_t minmaxSse2<UnsignedInt>(const UnsignedInt* data, const std::size_t size, UnsignedInt& outMin, UnsignedInt& outMax, const bool doMin, const bool doMax) {
+    return minmaxIntegerSse2(data, size, outMin, outMax, doMin, doMax);
+}
+
+/* Four consecutive Vector3s are three SSE registers with lanes in the order
+   (x, y, z, x), (y, z, x, y) and (z, x, y, z), so the accumulators can stay
+   in this order and be reduced to components only at the end. */
+template<> std::size_t minmaxSse2<Vector3<Float>>(const Vector3<Float>* data, const std::size_t size, Vector3<Float>& outMin, Vector3<Float>& outMax, bool, bool) {
+    if(size < 8) return 0;
+
+    const Float* const floats = data[0].data();
+    const Vector3<Float>& first = data[0];
+    __m128 minA = _mm_setr_ps(first.x(), first.y(), first.z(), first.x());
+    __m128 minB = _mm_setr_ps(first.y(), first.z(), first.x(), first.y());
+    __m128 minC = _mm_setr_ps(first.z(), first.x(), first.y(), first.z());
+    __m128 maxA = minA, maxB = minB, maxC = minC;
+    std::size_t i = 0;
+    for(; i + 4 <= size; i += 4) {
+        const __m128 a = _mm_loadu_ps(floats + i*3);
+        const __m128 b = _mm_loadu_ps(floats + i*3 + 4);
+        const __m128 c = _mm_loadu_ps(floats + i*3 + 8);
+        minA = _mm_min_ps(a, minA);
+        minB = _mm_min_ps(b, minB);
+        minC = _mm_min_ps(c, minC);
+        maxA = _mm_max_ps(a, maxA);
+        maxB = _mm_max_ps(b, maxB);
+        maxC = _mm_max_ps(c, maxC);
+    }
+
+    Float min[12], max[12];
+    _mm_storeu_ps(min + 0, minA);
+    _mm_storeu_ps(min + 4, minB);
+    _mm_storeu_ps(min + 8, minC);
+    _mm_storeu_ps(max + 0, maxA);
+    _mm_storeu_ps(max + 4, maxB);
+    _mm_storeu_ps(max + 8, maxC);
+    outMin = Vector3<Float>::from(min);
+    outMax = Vector3<Float>::from(max);
+    for(std::size_t j = 1; j != 4; ++j) {
+        outMin = Math::min(outMin, Vector3<Float>::from(min + j*3));
+        outMax = Math::max(outMax, Vector3<Float>::from(max + j*3));
+    }
+    return i;
+}
+
+/* Four accumulators to hide the addition latency */
+std::size_t sumSse2(const Float* data, const std::size_t size, Float& out) {
+    if(size < 16) return 0;
+
+    __m128 sum0 = _mm_setzero_ps(), sum1 = sum0, sum2 = sum0, sum3 = sum0;
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16) {
+        sum0 = _mm_add_ps(sum0, _mm_loadu_ps(data + i));
+        sum1 = _mm_add_ps(sum1, _mm_loadu_ps(data + i + 4));
+        sum2 = _mm_add_ps(sum2, _mm_loadu_ps(data + i + 8));
+        sum3 = _mm_add_ps(sum3, _mm_loadu_ps(data + i + 12));
+    }
+
+    Float sum[4];
+    _mm_storeu_ps(sum, _mm_add_ps(_mm_add_ps(sum0, sum1), _mm_add_ps(sum2, sum3)));
+    out = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+    return i;
+}
+
+/* Each lane has its own sum and compensation, the lanes are combined with
+   the scalar algorithm at the end */
+std::size_t kahanSumSse2(const Float* data, const std::size_t size, Float& outSum, Float& outCompensation) {
+    if(size < 8) return 0;
+
+    __m128 sum = _mm_setzero_ps(), c = _mm_setzero_ps();
+    std::size_t i = 0;
+    for(; i + 4 <= size; i += 4) {
+        const __m128 y = _mm_sub_ps(_mm_loadu_ps(data + i), c);
+        const __m128 t = _mm_add_ps(sum, y);
+        c = _mm_sub_ps(_mm_sub_ps(t, sum), y);
+        sum = t;
+    }
+
+    Float lanes[8];
+    _mm_storeu_ps(lanes, sum);
+    _mm_storeu_ps(lanes + 4, _mm_sub_ps(_mm_setzero_ps(), c));
+    outCompensation = 0.0f;
+    outSum = Algorithms::kahanSum(lanes, lanes + 8, 0.0f, &outCompensation);
+    return i;
+}
+#endif
+
+template<class T> inline T minImplementation(Corrade::Containers::ArrayView<const T> range) {
+    if(range.empty()) return {};
+
+    T out(range[0]), unused{};
+    std::size_t i = minmaxSse2(range.data(), range.size(), out, unused, true, false);
+    for(i = i ? i : 1; i != range.size(); ++i)
+        out = Math::min(out, range[i]);
+    return out;
+}
+
+template<class T> inline T maxImplementation(Corrade::Containers::ArrayView<const T> range) {
+    if(range.empty()) return {};
+
+    T out(range[0]), unused{};
+    std::size_t i = minmaxSse2(range.data(), range.size(), unused, out, false, true);
+    for(i = i ? i : 1; i != range.size(); ++i)
+        out = Math::max(out, range[i]);
+    return out;
+}
+
+template<class T> inline std::pair<T, T> minmaxImplementation(Corrade::Containers::ArrayView<const T> range) {
+    if(range.empty()) return {};
+
+    T min{range[0]}, max{range[0]};
+    std::size_t i = minmaxSse2(range.data(), range.size(), min, max, true, true);
+    for(i = i ? i : 1; i != range.size(); ++i)
+        Implementation::minmax(min, max, range[i]);
+    return {min, max};
+}
+
+}
+
+template<> Float min(Corrade::Containers::ArrayView<const Float> range) {
+    return minImplementation(range);
+}
+
+template<> Int min(Corrade::Containers::ArrayView<const Int> range) {
+    return minImplementation(range);
+}
+
+template<> UnsignedInt min(Corrade::Containers::ArrayView<const UnsignedInt> range) {
+    return minImplementation(range);
+}
+
+template<> Float max(Corrade::Containers::ArrayView<const Float> range) {
+    return maxImplementation(range);
+}
+
+template<> Int max(Corrade::Containers::ArrayView<const Int> range) {
+    return maxImplementation(range);
+}
+
+template<> UnsignedInt max(Corrade::Containers::ArrayView<const UnsignedInt> range) {
+    return maxImplementation(range);
+}
+
+template<> std::pair<Float, Float> minmax(Corrade::Containers::ArrayView<const Float> range) {
+    return minmaxImplementation(range);
+}
+
+template<> std::pair<Int, Int> minmax(Corrade::Containers::ArrayView<const Int> range) {
+    return minmaxImplementation(range);
+}
+
+template<> std::pair<UnsignedInt, UnsignedInt> minmax(Corrade::Containers::ArrayView<const UnsignedInt> range) {
+    return minmaxImplementation(range);
+}
+
+template<> std::pair<Vector3<Float>, Vector3<Float>> minmax(Corrade::Containers::ArrayView<const Vector3<Float>> range) {
+    return minmaxImplementation(range);
+}
+
+template<> Float sum(Corrade::Containers::ArrayView<const Float> range) {
+    Float out = 0.0f;
+    std::size_t i = sumSse2(range.data(), range.size(), out);
+    for(; i != range.size(); ++i)
+        out += range[i];
+    return out;
+}
+
+template<> Float kahanSum(Corrade::Containers::ArrayView<const Float> range) {
+    Float sum = 0.0f, compensation = 0.0f;
+    const std::size_t i = kahanSumSse2(range.data(), range.size(), sum, compensation);
+    return Algorithms::kahanSum(range.begin() + i, range.end(), sum, &compensation);
+}
+
+}}
@@ -31,14 +31,22 @@
 
 #include <Corrade/Containers/ArrayView.h>
 
+#include "Magnum/visibility.h"
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Algorithms/KahanSum.h"
 
 namespace Magnum { namespace Math {
 
 /**
 @brief Minimum of a range
 
-If the range is empty, returns default-constructed value.
+If the range is empty, returns default-constructed value. Ranges of
+@ref Magnum::Float "Float", @ref Magnum::Int "Int" and
+@ref Magnum::UnsignedInt "UnsignedInt" are processed with SSE2 on x86.
+<em>NaN</em>s are propagated only if they're the first item of the range, the
+same as with the scalar code.
 @see @ref min(T, T)
 */
 template<class T> inline T min(Corrade::Containers::ArrayView<const T> range) {
@@ -50,6 +58,12 @@ template<class T> inline T min(Corrade::Containers::ArrayView<const T> range) {
     return out;
 }
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<> MAGNUM_EXPORT Float min(Corrade::Containers::ArrayView<const Float> range);
+template<> MAGNUM_EXPORT Int min(Corrade::Containers::ArrayView<const Int> range);
+template<> MAGNUM_EXPORT UnsignedInt min(Corrade::Containers::ArrayView<const UnsignedInt> range);
+#endif
+
 /** @overload */
 template<class T> inline T min(std::initializer_list<T> list) {
     return min(Corrade::Containers::ArrayView<const T>{list.begin(), list.size()});
@@ -63,7 +77,9 @@ template<class T, std::size_t size> inline T min(const T(&array)[size]) {
 /**
 @brief Maximum of a range
 
-If the range is empty, returns default-constructed value.
+If the range is empty, returns default-constructed value. The same types as
+in @ref min(Corrade::Containers::ArrayView<const T>) are processed with SSE2.
+@see @ref max(T, T)
 */
 template<class T> inline T max(Corrade::Containers::ArrayView<const T> range) {
     if(range.empty()) return {};
@@ -74,6 +90,12 @@ template<class T> inline T max(Corrade::Containers::ArrayView<const T> range) {
     return out;
 }
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<> MAGNUM_EXPORT Float max(Corrade::Containers::ArrayView<const Float> range);
+template<> MAGNUM_EXPORT Int max(Corrade::Containers::ArrayView<const Int> range);
+template<> MAGNUM_EXPORT UnsignedInt max(Corrade::Containers::ArrayView<const UnsignedInt> range);
+#endif
+
 /** @overload */
 template<class T> inline T max(std::initializer_list<T> list) {
     return max(Corrade::Containers::ArrayView<const T>{list.begin(), list.size()});
@@ -100,8 +122,11 @@ namespace Implementation {
 /**
 @brief Minimum and maximum of a range
 
-If the range is empty, returns default-constructed values.
-@see @ref Range::Range(const std::pair<VectorType, VectorType>&)
+If the range is empty, returns default-constructed values. The same types as
+in @ref min(Corrade::Containers::ArrayView<const T>) and additionally
+@ref Magnum::Vector3 "Vector3" are processed with SSE2.
+@see @ref Range::Range(const std::pair<VectorType, VectorType>&),
+    @ref bounds()
 */
 template<class T> inline std::pair<T, T> minmax(Corrade::Containers::ArrayView<const T> range) {
     if(range.empty()) return {};
@@ -113,6 +138,13 @@ template<class T> inline std::pair<T, T> minmax(Corrade::Containers::ArrayView<c
     return {min, max};
 }
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<> MAGNUM_EXPORT std::pair<Float, Float> minmax(Corrade::Containers::ArrayView<const Float> range);
+template<> MAGNUM_EXPORT std::pair<Int, Int> minmax(Corrade::Containers::ArrayView<const Int> range);
+template<> MAGNUM_EXPORT std::pair<UnsignedInt, UnsignedInt> minmax(Corrade::Containers::ArrayView<const UnsignedInt> range);
+template<> MAGNUM_EXPORT std::pair<Vector3<Float>, Vector3<Float>> minmax(Corrade::Containers::ArrayView<const Vector3<Float>> range);
+#endif
+
 /** @overload */
 template<class T> inline std::pair<T, T> minmax(std::initializer_list<T> list) {
     return minmax(Corrade::Containers::ArrayView<const T>{list.begin(), list.size()});
@@ -123,6 +155,95 @@ template<class T, std::size_t size> inline std::pair<T, T> minmax(const T(&array
     return minmax(Corrade::Containers::arrayView(array));
 }
 
+/**
+@brief Bounds of a range of two-dimensional points
+
+Equivalent to constructing a @ref Range2D from
+@ref minmax(Corrade::Containers::ArrayView<const T>). If the range is empty,
+returns a zero range.
+*/
+template<class T> inline Range2D<T> bounds(Corrade::Containers::ArrayView<const Vector2<T>> points) {
+    return Range2D<T>{minmax(points)};
+}
+
+/** @overload */
+template<class T, std::size_t size> inline Range2D<T> bounds(const Vector2<T>(&points)[size]) {
+    return bounds(Corrade::Containers::ArrayView<const Vector2<T>>{points});
+}
+
+/**
+@brief Bounds of a range of three-dimensional points
+
+Equivalent to constructing a @ref Range3D from
+@ref minmax(Corrade::Containers::ArrayView<const T>). If the range is empty,
+returns a zero range. Ranges of @ref Magnum::Vector3 "Vector3" are processed
+with SSE2 on x86.
+*/
+template<class T> inline Range3D<T> bounds(Corrade::Containers::ArrayView<const Vector3<T>> points) {
+    return Range3D<T>{minmax(points)};
+}
+
+/** @overload */
+template<class T, std::size_t size> inline Range3D<T> bounds(const Vector3<T>(&points)[size]) {
+    return bounds(Corrade::Containers::ArrayView<const Vector3<T>>{points});
+}
+
+/**
+@brief Sum of a range
+
+If the range is empty, returns zero. Ranges of @ref Magnum::Float "Float" are
+processed with SSE2 on x86, in which case the order of additions is
+different from a sequential loop and the result can differ in the last bits.
+Use @ref kahanSum(Corrade::Containers::ArrayView<const T>) for large ranges
+where precision matters.
+*/
+template<class T> inline T sum(Corrade::Containers::ArrayView<const T> range) {
+    T out(0);
+    for(const T& value: range) out += value;
+    return out;
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<> MAGNUM_EXPORT Float sum(Corrade::Containers::ArrayView<const Float> range);
+#endif
+
+/** @overload */
+template<class T> inline T sum(std::initializer_list<T> list) {
+    return sum(Corrade::Containers::ArrayView<const T>{list.begin(), list.size()});
+}
+
+/** @overload */
+template<class T, std::size_t size> inline T sum(const T(&array)[size]) {
+    return sum(Corrade::Containers::arrayView(array));
+}
+
+/**
+@brief Sum of a range with roundoff error compensation
+
+Equivalent to @ref Algorithms::kahanSum() called on the range. Ranges of
+@ref Magnum::Float "Float" are processed with SSE2 on x86, where each of the
+four lanes keeps its own compensation and the partial sums are then combined
+with @ref Algorithms::kahanSum() again, so the error stays comparable to the
+scalar variant. If the range is empty, returns zero.
+*/
+template<class T> inline T kahanSum(Corrade::Containers::ArrayView<const T> range) {
+    return Algorithms::kahanSum(range.begin(), range.end());
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<> MAGNUM_EXPORT Float kahanSum(Corrade::Containers::ArrayView<const Float> range);
+#endif
+
+/** @overload */
+template<class T> inline T kahanSum(std::initializer_list<T> list) {
+    return kahanSum(Corrade::Containers::ArrayView<const T>{list.begin(), list.size()});
+}
+
+/** @overload */
+template<class T, std::size_t size> inline T kahanSum(const T(&array)[size]) {
+    return kahanSum(Corrade::Containers::arrayView(array));
+}
+
 }}
 
 #endif
@@ -210,7 +210,7 @@ template<class T> bool aabbFrustum(const Vector3<T>& aabbCenter, const Vector3<T
 
 Checks for each plane of the frustum whether the sphere is behind the plane
 (the points distance larger than the sphere's radius) using
-@ref Distance::pointPlaneScaled().
+@ref Distance::pointPlaneScaled(). The planes don't need to be normalized.
 */
 template<class T> bool sphereFrustum(const Vector3<T>& sphereCenter, T sphereRadius, const Frustum<T>& frustum);
 
@@ -462,8 +462,10 @@ template<class T> bool sphereFrustum(const Vector3<T>& sphereCenter, const T sph
 
     for(const Vector4<T>& plane: frustum) {
         /* The sphere is in front of one of the frustum planes (normals point
-           outwards) */
-        if(Distance::pointPlaneScaled<T>(sphereCenter, plane) < -radiusSq)
+           outwards). The planes are not necessarily normalized, so compare
+           the squared distance scaled by squared normal length instead. */
+        const T distance = Distance::pointPlaneScaled<T>(sphereCenter, plane);
+        if(distance < T(0) && distance*distance > radiusSq*plane.xyz().dot())
             return false;
     }
 
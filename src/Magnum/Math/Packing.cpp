@@ -25,6 +25,26 @@
 
 #include "Packing.h"
 
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Implementation/sse2.h"
+
+#ifdef _MAGNUM_USE_SSE2
+/* F16C is used through a function-level target attribute and a runtime check
+   if the compiler supports it, the library itself is not built with -mf16c */
+#if defined(__F16C__) || defined(_MSC_VER) || defined(__clang__) || (defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 409)
+#define _MAGNUM_MATH_USE_F16C
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#elif !defined(__F16C__)
+#include <cpuid.h>
+#endif
+#endif
+#endif
+
 namespace Magnum { namespace Math {
 
 namespace {
@@ -101,4 +121,373 @@ UnsignedShort packHalf(const Float value) {
     return h;
 }
 
+namespace {
+
+/* Batch conversions. The views are processed in blocks, strided blocks are
+   gathered to / scattered from contiguous scratch memory so the kernels
+   can work on contiguous data only. Same as in FunctionsBatch.cpp, the SIMD
+   variants process the bulk of the block and return count of processed
+   items, the rest is done by the scalar loop. */
+constexpr std::size_t BlockSize = 256;
+
+template<class T, class U, class Kernel> void convertBlocks(const Corrade::Containers::StridedArrayView<const T>& src, const Corrade::Containers::StridedArrayView<U>& dst, Kernel kernel) {
+    const bool srcContiguous = std::size_t(src.stride()) == sizeof(T);
+    const bool dstContiguous = std::size_t(dst.stride()) == sizeof(U);
+
+    T srcBlock[BlockSize];
+    U dstBlock[BlockSize];
+    for(std::size_t offset = 0; offset < src.size(); offset += BlockSize) {
+        const std::size_t count = Math::min(BlockSize, src.size() - offset);
+
+        const T* srcData = srcBlock;
+        if(srcContiguous) srcData = &src[offset];
+        else for(std::size_t i = 0; i != count; ++i)
+            srcBlock[i] = src[offset + i];
+
+        U* const dstData = dstContiguous ? &dst[offset] : dstBlock;
+        kernel(srcData, count, dstData);
+
+        if(!dstContiguous) for(std::size_t i = 0; i != count; ++i)
+            dst[offset + i] = dstBlock[i];
+    }
+}
+
+template<class T> std::size_t unpackSse2(const T*, std::size_t, Float*) { return 0; }
+template<class T> std::size_t packSse2(const Float*, std::size_t, T*) { return 0; }
+#ifndef _MAGNUM_USE_SSE2
+std::size_t unpackHalfSse2(const UnsignedShort*, std::size_t, Float*) { return 0; }
+std::size_t packHalfSse2(const Float*, std::size_t, UnsignedShort*) { return 0; }
+#endif
+#ifndef _MAGNUM_MATH_USE_F16C
+bool hasF16c() { return false; }
+std::size_t unpackHalfF16c(const UnsignedShort*, std::size_t, Float*) { return 0; }
+#endif
+
+#ifdef _MAGNUM_USE_SSE2
+/* Division instead of multiplication by the reciprocal, to be bit-exact
+   with unpack() */
+template<class T> inline __m128 unpackSse2Four(const __m128i value) {
+    return _mm_div_ps(_mm_cvtepi32_ps(value), _mm_set1_ps(Float(Implementation::bitMax<T>())));
+}
+
+template<> std::size_t unpackSse2<UnsignedByte>(const UnsignedByte* const data, const std::size_t size, Float* const out) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i lo = _mm_unpacklo_epi8(in, zero);
+        const __m128i hi = _mm_unpackhi_epi8(in, zero);
+        _mm_storeu_ps(out + i, unpackSse2Four<UnsignedByte>(_mm_unpacklo_epi16(lo, zero)));
+        _mm_storeu_ps(out + i + 4, unpackSse2Four<UnsignedByte>(_mm_unpackhi_epi16(lo, zero)));
+        _mm_storeu_ps(out + i + 8, unpackSse2Four<UnsignedByte>(_mm_unpacklo_epi16(hi, zero)));
+        _mm_storeu_ps(out + i + 12, unpackSse2Four<UnsignedByte>(_mm_unpackhi_epi16(hi, zero)));
+    }
+    return i;
+}
+
+/* Signed values are widened by unpacking into the upper bits and shifting
+   back arithmetically. The -1 clamp is the same as in unpack(), -128 and
+   -32768 would otherwise be slightly below -1. */
+template<> std::size_t unpackSse2<Byte>(const Byte* const data, const std::size_t size, Float* const out) {
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i lo = _mm_unpacklo_epi8(in, in);
+        const __m128i hi = _mm_unpackhi_epi8(in, in);
+        _mm_storeu_ps(out + i, _mm_max_ps(unpackSse2Four<Byte>(_mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 24)), minusOne));
+        _mm_storeu_ps(out + i + 4, _mm_max_ps(unpackSse2Four<Byte>(_mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 24)), minusOne));
+        _mm_storeu_ps(out + i + 8, _mm_max_ps(unpackSse2Four<Byte>(_mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 24)), minusOne));
+        _mm_storeu_ps(out + i + 12, _mm_max_ps(unpackSse2Four<Byte>(_mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 24)), minusOne));
+    }
+    return i;
+}
+
+template<> std::size_t unpackSse2<UnsignedShort>(const UnsignedShort* const data, const std::size_t size, Float* const out) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_ps(out + i, unpackSse2Four<UnsignedShort>(_mm_unpacklo_epi16(in, zero)));
+        _mm_storeu_ps(out + i + 4, unpackSse2Four<UnsignedShort>(_mm_unpackhi_epi16(in, zero)));
+    }
+    return i;
+}
+
+template<> std::size_t unpackSse2<Short>(const Short* const data, const std::size_t size, Float* const out) {
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_ps(out + i, _mm_max_ps(unpackSse2Four<Short>(_mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16)), minusOne));
+        _mm_storeu_ps(out + i + 4, _mm_max_ps(unpackSse2Four<Short>(_mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16)), minusOne));
+    }
+    return i;
+}
+
+/* Rounding half away from zero to match Math::round() used by pack(),
+   _mm_cvtps_epi32() would round half to even. The fraction is exact as long
+   as the value is below 2^23, which is the case for all types here. */
+inline __m128i roundSse2(const __m128 value) {
+    const __m128i truncated = _mm_cvttps_epi32(value);
+    const __m128 fraction = _mm_sub_ps(value, _mm_cvtepi32_ps(truncated));
+    const __m128 absFraction = _mm_andnot_ps(_mm_set1_ps(-0.0f), fraction);
+    const __m128i roundAway = _mm_castps_si128(_mm_cmpge_ps(absFraction, _mm_set1_ps(0.5f)));
+    /* -1 for negative values, 1 otherwise */
+    const __m128i sign = _mm_or_si128(_mm_srai_epi32(_mm_castps_si128(value), 31), _mm_set1_epi32(1));
+    return _mm_add_epi32(truncated, _mm_and_si128(roundAway, sign));
+}
+
+/* The input is clamped to the normalized range first, as values too large
+   for a 32-bit integer would be converted to 0x80000000 and the subsequent
+   saturating packs would then give the wrong extreme. _mm_max_ps() returns
+   the second operand if either is NaN, so NaNs end up at the lower bound. */
+template<class T> inline __m128i packSse2Four(const Float* const data) {
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(data), _mm_set1_ps(std::is_signed<T>::value ? -1.0f : 0.0f)), _mm_set1_ps(1.0f));
+    return roundSse2(_mm_mul_ps(clamped, _mm_set1_ps(Float(Implementation::bitMax<T>()))));
+}
+
+template<> std::size_t packSse2<UnsignedByte>(const Float* const data, const std::size_t size, UnsignedByte* const out) {
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16) {
+        const __m128i a = _mm_packs_epi32(packSse2Four<UnsignedByte>(data + i), packSse2Four<UnsignedByte>(data + i + 4));
+        const __m128i b = _mm_packs_epi32(packSse2Four<UnsignedByte>(data + i + 8), packSse2Four<UnsignedByte>(data + i + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(a, b));
+    }
+    return i;
+}
+
+template<> std::size_t packSse2<Byte>(const Float* const data, const std::size_t size, Byte* const out) {
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16) {
+        const __m128i a = _mm_packs_epi32(packSse2Four<Byte>(data + i), packSse2Four<Byte>(data + i + 4));
+        const __m128i b = _mm_packs_epi32(packSse2Four<Byte>(data + i + 8), packSse2Four<Byte>(data + i + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi16(a, b));
+    }
+    return i;
+}
+
+/* There's no unsigned 32-to-16-bit pack in SSE2, so the values are biased to
+   signed range and back */
+template<> std::size_t packSse2<UnsignedShort>(const Float* const data, const std::size_t size, UnsignedShort* const out) {
+    const __m128i bias32 = _mm_set1_epi32(32768);
+    const __m128i bias16 = _mm_set1_epi16(-32768);
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        const __m128i a = _mm_sub_epi32(packSse2Four<UnsignedShort>(data + i), bias32);
+        const __m128i b = _mm_sub_epi32(packSse2Four<UnsignedShort>(data + i + 4), bias32);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(_mm_packs_epi32(a, b), bias16));
+    }
+    return i;
+}
+
+template<> std::size_t packSse2<Short>(const Float* const data, const std::size_t size, Short* const out) {
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(packSse2Four<Short>(data + i), packSse2Four<Short>(data + i + 4)));
+    return i;
+}
+
+inline __m128i selectSse2(const __m128i mask, const __m128i a, const __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/* unpackHalf() on four values, operation by operation */
+inline __m128 unpackHalfSse2Four(const __m128i h) {
+    const __m128i shiftedExp = _mm_set1_epi32(0x7c00 << 13);
+
+    __m128i o = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+    const __m128i exp = _mm_and_si128(o, shiftedExp);
+    o = _mm_add_epi32(o, _mm_set1_epi32((127 - 15) << 23));
+
+    /* Inf/NaN get an extra exponent adjust */
+    const __m128i infNan = _mm_cmpeq_epi32(exp, shiftedExp);
+    o = _mm_add_epi32(o, _mm_and_si128(infNan, _mm_set1_epi32((128 - 16) << 23)));
+
+    /* Zero/denormal get renormalized */
+    const __m128i zeroDenormal = _mm_cmpeq_epi32(exp, _mm_setzero_si128());
+    const __m128i renormalized = _mm_castps_si128(_mm_sub_ps(
+        _mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(1 << 23))),
+        _mm_castsi128_ps(_mm_set1_epi32(113 << 23))));
+    o = selectSse2(zeroDenormal, renormalized, o);
+
+    /* Sign bit */
+    o = _mm_or_si128(o, _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16));
+    return _mm_castsi128_ps(o);
+}
+
+std::size_t unpackHalfSse2(const UnsignedShort* const data, const std::size_t size, Float* const out) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_ps(out + i, unpackHalfSse2Four(_mm_unpacklo_epi16(in, zero)));
+        _mm_storeu_ps(out + i + 4, unpackHalfSse2Four(_mm_unpackhi_epi16(in, zero)));
+    }
+    return i;
+}
+
+/* packHalf() on four values, operation by operation. As noted there, all
+   compares can be signed. The result is sign-extended from 16 bits so the
+   saturating signed pack keeps it intact. */
+inline __m128i packHalfSse2Four(const Float* const data) {
+    const __m128i floatInfinity = _mm_set1_epi32(255 << 23);
+    const __m128i roundMask = _mm_set1_epi32(~0xfff);
+
+    __m128i f = _mm_castps_si128(_mm_loadu_ps(data));
+    const __m128i sign = _mm_and_si128(f, _mm_set1_epi32(0x80000000u));
+    f = _mm_xor_si128(f, sign);
+
+    /* Inf or NaN: NaN->qNaN and Inf->Inf */
+    const __m128i infNan = _mm_cmpgt_epi32(f, _mm_set1_epi32((255 << 23) - 1));
+    const __m128i infNanBits = selectSse2(_mm_cmpgt_epi32(f, floatInfinity), _mm_set1_epi32(0x7e00), _mm_set1_epi32(0x7c00));
+
+    /* (De)normalized number or zero, clamped to infinity if overflowed */
+    __m128i h = _mm_castps_si128(_mm_mul_ps(
+        _mm_castsi128_ps(_mm_and_si128(f, roundMask)),
+        _mm_castsi128_ps(_mm_set1_epi32(15 << 23))));
+    h = _mm_sub_epi32(h, roundMask);
+    const __m128i halfInfinity = _mm_set1_epi32(31 << 23);
+    h = selectSse2(_mm_cmpgt_epi32(h, halfInfinity), halfInfinity, h);
+    h = _mm_srli_epi32(h, 13);
+
+    h = _mm_or_si128(selectSse2(infNan, infNanBits, h), _mm_srli_epi32(sign, 16));
+    return _mm_srai_epi32(_mm_slli_epi32(h, 16), 16);
+}
+
+std::size_t packHalfSse2(const Float* const data, const std::size_t size, UnsignedShort* const out) {
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(packHalfSse2Four(data + i), packHalfSse2Four(data + i + 4)));
+    return i;
+}
+#endif
+
+#ifdef _MAGNUM_MATH_USE_F16C
+#ifdef __F16C__
+bool hasF16c() { return true; }
+#else
+/* F16C is VEX-encoded, so besides the CPUID bit the OS has to support the
+   extended state as well, which is checked via OSXSAVE and XGETBV */
+bool detectF16c() {
+    #if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    const UnsignedInt ecx = info[2];
+    #else
+    unsigned int eax, ebx, ecx, edx;
+    if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+    #endif
+
+    if(!(ecx & (1 << 29)) || !(ecx & (1 << 27))) return false;
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+    const UnsignedInt xcr0 = UnsignedInt(_xgetbv(0));
+    #else
+    UnsignedInt xcr0, xcr0High;
+    __asm__("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+    #endif
+    return (xcr0 & 0x6) == 0x6;
+}
+
+bool hasF16c() {
+    static const bool f16c = detectF16c();
+    return f16c;
+}
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__F16C__)
+__attribute__((__target__("f16c")))
+#endif
+std::size_t unpackHalfF16c(const UnsignedShort* const data, const std::size_t size, Float* const out) {
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_ps(out + i, _mm_cvtph_ps(in));
+        _mm_storeu_ps(out + i + 4, _mm_cvtph_ps(_mm_unpackhi_epi64(in, in)));
+    }
+    return i;
+}
+#endif
+
+template<class T> void unpackIntoImplementation(const Corrade::Containers::StridedArrayView<const T>& src, const Corrade::Containers::StridedArrayView<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): expected" << src.size() << "destination items but got" << dst.size(), );
+
+    convertBlocks(src, dst, [](const T* const data, const std::size_t size, Float* const out) {
+        for(std::size_t i = unpackSse2(data, size, out); i != size; ++i)
+            out[i] = unpack<Float>(data[i]);
+    });
+}
+
+template<class T> void packIntoImplementation(const Corrade::Containers::StridedArrayView<const Float>& src, const Corrade::Containers::StridedArrayView<T>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): expected" << src.size() << "destination items but got" << dst.size(), );
+
+    convertBlocks(src, dst, [](const Float* const data, const std::size_t size, T* const out) {
+        /* pack() is undefined for values outside of the normalized range,
+           so clamp them to saturate the same way as the SIMD variant. The
+           comparison is written so NaNs map to the lower bound, as with
+           _mm_max_ps() there. */
+        const Float lo = std::is_signed<T>::value ? -1.0f : 0.0f;
+        for(std::size_t i = packSse2(data, size, out); i != size; ++i)
+            out[i] = pack<T>(data[i] >= lo ? Math::min(data[i], 1.0f) : lo);
+    });
+}
+
+}
+
+void unpackInto(const Corrade::Containers::StridedArrayView<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView<Float>& dst) {
+    unpackIntoImplementation(src, dst);
+}
+
+void unpackInto(const Corrade::Containers::StridedArrayView<const Byte>& src, const Corrade::Containers::StridedArrayView<Float>& dst) {
+    unpackIntoImplementation(src, dst);
+}
+
+void unpackInto(const Corrade::Containers::StridedArrayView<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView<Float>& dst) {
+    unpackIntoImplementation(src, dst);
+}
+
+void unpackInto(const Corrade::Containers::StridedArrayView<const Short>& src, const Corrade::Containers::StridedArrayView<Float>& dst) {
+    unpackIntoImplementation(src, dst);
+}
+
+void packInto(const Corrade::Containers::StridedArrayView<const Float>& src, const Corrade::Containers::StridedArrayView<UnsignedByte>& dst) {
+    packIntoImplementation(src, dst);
+}
+
+void packInto(const Corrade::Containers::StridedArrayView<const Float>& src, const Corrade::Containers::StridedArrayView<Byte>& dst) {
+    packIntoImplementation(src, dst);
+}
+
+void packInto(const Corrade::Containers::StridedArrayView<const Float>& src, const Corrade::Containers::StridedArrayView<UnsignedShort>& dst) {
+    packIntoImplementation(src, dst);
+}
+
+void packInto(const Corrade::Containers::StridedArrayView<const Float>& src, const Corrade::Containers::StridedArrayView<Short>& dst) {
+    packIntoImplementation(src, dst);
+}
+
+void packHalfInto(const Corrade::Containers::StridedArrayView<const Float>& src, const Corrade::Containers::StridedArrayView<UnsignedShort>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packHalfInto(): expected" << src.size() << "destination items but got" << dst.size(), );
+
+    convertBlocks(src, dst, [](const Float* const data, const std::size_t size, UnsignedShort* const out) {
+        for(std::size_t i = packHalfSse2(data, size, out); i != size; ++i)
+            out[i] = packHalf(data[i]);
+    });
+}
+
+void unpackHalfInto(const Corrade::Containers::StridedArrayView<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackHalfInto(): expected" << src.size() << "destination items but got" << dst.size(), );
+
+    const bool f16c = hasF16c();
+    convertBlocks(src, dst, [f16c](const UnsignedShort* const data, const std::size_t size, Float* const out) {
+        for(std::size_t i = f16c ? unpackHalfF16c(data, size, out) : unpackHalfSse2(data, size, out); i != size; ++i)
+            out[i] = unpackHalf(data[i]);
+    });
+}
+
 }}
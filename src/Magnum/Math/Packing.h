@@ -26,9 +26,11 @@
 */
 
 /** @file
- * @brief Functions @ref Magnum::Math::pack(), @ref Magnum::Math::unpack(), @ref Magnum::Math::packHalf(), @ref Magnum::Math::unpackHalf()
+ * @brief Functions @ref Magnum::Math::pack(), @ref Magnum::Math::unpack(), @ref Magnum::Math::packHalf(), @ref Magnum::Math::unpackHalf(), @ref Magnum::Math::packInto(), @ref Magnum::Math::unpackInto(), @ref Magnum::Math::packHalfInto(), @ref Magnum::Math::unpackHalfInto()
  */
 
+#include <Corrade/Containers/Containers.h>
+
 #include "Magnum/Math/Functions.h"
 
 namespace Magnum { namespace Math {
@@ -209,6 +211,80 @@ template<std::size_t size> Vector<size, Float> unpackHalf(const Vector<size, Uns
     return out;
 }
 
+/**
+@brief Unpack a range of integral values into a floating-point representation
+@param[in] src      Source integral values
+@param[out] dst     Destination floating-point values
+
+Batch variant of @ref unpack() for @ref Magnum::Float "Float" outputs, the
+result is the same as calling it on each item. The @p dst view is expected to
+have the same size as @p src, the views can be strided. On x86 the conversion
+is done with SSE2.
+@see @ref packInto(), @ref unpackHalfInto()
+*/
+MAGNUM_EXPORT void unpackInto(const Corrade::Containers::StridedArrayView<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView<Float>& dst);
+
+/** @overload */
+MAGNUM_EXPORT void unpackInto(const Corrade::Containers::StridedArrayView<const Byte>& src, const Corrade::Containers::StridedArrayView<Float>& dst);
+
+/** @overload */
+MAGNUM_EXPORT void unpackInto(const Corrade::Containers::StridedArrayView<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView<Float>& dst);
+
+/** @overload */
+MAGNUM_EXPORT void unpackInto(const Corrade::Containers::StridedArrayView<const Short>& src, const Corrade::Containers::StridedArrayView<Float>& dst);
+
+/**
+@brief Pack a range of floating-point values into an integer representation
+@param[in] src      Source floating-point values
+@param[out] dst     Destination integral values
+
+Batch variant of @ref pack() for @ref Magnum::Float "Float" inputs, the result
+is the same as calling it on each item. The @p dst view is expected to have
+the same size as @p src, the views can be strided. On x86 the conversion is
+done with SSE2. Values outside of the normalized range are saturated instead
+of being undefined.
+@see @ref unpackInto(), @ref packHalfInto()
+*/
+MAGNUM_EXPORT void packInto(const Corrade::Containers::StridedArrayView<const Float>& src, const Corrade::Containers::StridedArrayView<UnsignedByte>& dst);
+
+/** @overload */
+MAGNUM_EXPORT void packInto(const Corrade::Containers::StridedArrayView<const Float>& src, const Corrade::Containers::StridedArrayView<Byte>& dst);
+
+/** @overload */
+MAGNUM_EXPORT void packInto(const Corrade::Containers::StridedArrayView<const Float>& src, const Corrade::Containers::StridedArrayView<UnsignedShort>& dst);
+
+/** @overload */
+MAGNUM_EXPORT void packInto(const Corrade::Containers::StridedArrayView<const Float>& src, const Corrade::Containers::StridedArrayView<Short>& dst);
+
+/**
+@brief Pack a range of 32-bit float values into 16-bit half-float representation
+@param[in] src      Source float values
+@param[out] dst     Destination half-float values
+
+Batch variant of @ref packHalf(), the result is bit-exact with calling it on
+each item, including its rounding behavior. The @p dst view is expected to
+have the same size as @p src, the views can be strided. On x86 the
+conversion is done with SSE2. The hardware F16C conversion is not used here,
+as it rounds differently from @ref packHalf() and the output would then
+depend on the machine.
+@see @ref unpackHalfInto(), @ref packInto()
+*/
+MAGNUM_EXPORT void packHalfInto(const Corrade::Containers::StridedArrayView<const Float>& src, const Corrade::Containers::StridedArrayView<UnsignedShort>& dst);
+
+/**
+@brief Unpack a range of 16-bit half-float values into 32-bit float representation
+@param[in] src      Source half-float values
+@param[out] dst     Destination float values
+
+Batch variant of @ref unpackHalf(). The @p dst view is expected to have the
+same size as @p src, the views can be strided. On x86 the F16C instruction
+set is used if the CPU supports it, which is detected at runtime, and SSE2
+otherwise. The result is the same as calling @ref unpackHalf() on each item,
+the only exception is that signaling NaNs may be converted to quiet NaNs.
+@see @ref packHalfInto(), @ref unpackInto()
+*/
+MAGNUM_EXPORT void unpackHalfInto(const Corrade::Containers::StridedArrayView<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView<Float>& dst);
+
 }}
 
 #endif
@@ -0,0 +1,197 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/FunctionsBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct FunctionsBatchBenchmark: Corrade::TestSuite::Tester {
+    explicit FunctionsBatchBenchmark();
+
+    void minNaive();
+    void min();
+    void minmaxNaive();
+    void minmax();
+    void minmaxUnsignedIntNaive();
+    void minmaxUnsignedInt();
+    void boundsNaive();
+    void bounds();
+
+    void sumNaive();
+    void sum();
+    void kahanSumNaive();
+    void kahanSum();
+
+    std::vector<Float> _floats;
+    std::vector<UnsignedInt> _unsignedInts;
+    std::vector<Vector3<Float>> _vectors;
+};
+
+enum: std::size_t { Size = 1024*1024 };
+
+FunctionsBatchBenchmark::FunctionsBatchBenchmark() {
+    addBenchmarks({&FunctionsBatchBenchmark::minNaive,
+                   &FunctionsBatchBenchmark::min,
+                   &FunctionsBatchBenchmark::minmaxNaive,
+                   &FunctionsBatchBenchmark::minmax,
+                   &FunctionsBatchBenchmark::minmaxUnsignedIntNaive,
+                   &FunctionsBatchBenchmark::minmaxUnsignedInt,
+                   &FunctionsBatchBenchmark::boundsNaive,
+                   &FunctionsBatchBenchmark::bounds,
+
+                   &FunctionsBatchBenchmark::sumNaive,
+                   &FunctionsBatchBenchmark::sum,
+                   &FunctionsBatchBenchmark::kahanSumNaive,
+                   &FunctionsBatchBenchmark::kahanSum}, 10);
+
+    std::mt19937 g;
+    std::uniform_real_distribution<Float> fd(-100.0f, 100.0f);
+
+    _floats.resize(Size);
+    _unsignedInts.resize(Size);
+    _vectors.resize(Size);
+    for(std::size_t i = 0; i != Size; ++i) {
+        _floats[i] = fd(g);
+        _unsignedInts[i] = g();
+        _vectors[i] = {fd(g), fd(g), fd(g)};
+    }
+}
+
+/* The naive variants are what the generic templates do */
+
+void FunctionsBatchBenchmark::minNaive() {
+    Float out{};
+    CORRADE_BENCHMARK(10) {
+        out = _floats[0];
+        for(Float i: _floats) out = Math::min(out, i);
+    }
+
+    CORRADE_VERIFY(out <= _floats[0]);
+}
+
+void FunctionsBatchBenchmark::min() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out = Math::min(Corrade::Containers::ArrayView<const Float>{_floats.data(), _floats.size()});
+
+    CORRADE_VERIFY(out <= _floats[0]);
+}
+
+void FunctionsBatchBenchmark::minmaxNaive() {
+    std::pair<Float, Float> out;
+    CORRADE_BENCHMARK(10) {
+        out = {_floats[0], _floats[0]};
+        for(Float i: _floats) Implementation::minmax(out.first, out.second, i);
+    }
+
+    CORRADE_VERIFY(out.first <= out.second);
+}
+
+void FunctionsBatchBenchmark::minmax() {
+    std::pair<Float, Float> out;
+    CORRADE_BENCHMARK(10)
+        out = Math::minmax(Corrade::Containers::ArrayView<const Float>{_floats.data(), _floats.size()});
+
+    CORRADE_VERIFY(out.first <= out.second);
+}
+
+void FunctionsBatchBenchmark::minmaxUnsignedIntNaive() {
+    std::pair<UnsignedInt, UnsignedInt> out;
+    CORRADE_BENCHMARK(10) {
+        out = {_unsignedInts[0], _unsignedInts[0]};
+        for(UnsignedInt i: _unsignedInts) Implementation::minmax(out.first, out.second, i);
+    }
+
+    CORRADE_VERIFY(out.first <= out.second);
+}
+
+void FunctionsBatchBenchmark::minmaxUnsignedInt() {
+    std::pair<UnsignedInt, UnsignedInt> out;
+    CORRADE_BENCHMARK(10)
+        out = Math::minmax(Corrade::Containers::ArrayView<const UnsignedInt>{_unsignedInts.data(), _unsignedInts.size()});
+
+    CORRADE_VERIFY(out.first <= out.second);
+}
+
+void FunctionsBatchBenchmark::boundsNaive() {
+    Range3D<Float> out;
+    CORRADE_BENCHMARK(10) {
+        Vector3<Float> min = _vectors[0], max = _vectors[0];
+        for(const Vector3<Float>& i: _vectors) Implementation::minmax(min, max, i);
+        out = {min, max};
+    }
+
+    CORRADE_VERIFY((out.min() <= out.max()).all());
+}
+
+void FunctionsBatchBenchmark::bounds() {
+    Range3D<Float> out;
+    CORRADE_BENCHMARK(10)
+        out = Math::bounds(Corrade::Containers::ArrayView<const Vector3<Float>>{_vectors.data(), _vectors.size()});
+
+    CORRADE_VERIFY((out.min() <= out.max()).all());
+}
+
+void FunctionsBatchBenchmark::sumNaive() {
+    Float out{};
+    CORRADE_BENCHMARK(10) {
+        out = 0.0f;
+        for(Float i: _floats) out += i;
+    }
+
+    CORRADE_VERIFY(out != 0.0f);
+}
+
+void FunctionsBatchBenchmark::sum() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out = Math::sum(Corrade::Containers::ArrayView<const Float>{_floats.data(), _floats.size()});
+
+    CORRADE_VERIFY(out != 0.0f);
+}
+
+void FunctionsBatchBenchmark::kahanSumNaive() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out = Algorithms::kahanSum(_floats.begin(), _floats.end());
+
+    CORRADE_VERIFY(out != 0.0f);
+}
+
+void FunctionsBatchBenchmark::kahanSum() {
+    Float out{};
+    CORRADE_BENCHMARK(10)
+        out = Math::kahanSum(Corrade::Containers::ArrayView<const Float>{_floats.data(), _floats.size()});
+
+    CORRADE_VERIFY(out != 0.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::FunctionsBatchBenchmark)
@@ -23,8 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 
+#include "Magnum/Math/Constants.h"
 #include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/Math/Vector3.h"
 
@@ -36,15 +39,46 @@ struct FunctionsBatchTest: Corrade::TestSuite::Tester {
     void minList();
     void maxList();
     void minmaxList();
+
+    template<class T> void minMaxLarge();
+    void minMaxLargeNaN();
+    void minmaxLargeVector3();
+
+    void boundsList();
+
+    void sumList();
+    void sumLarge();
+    void kahanSumList();
+    void kahanSumLarge();
 };
 
 typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector3<Float> Vector3;
 typedef Math::Vector3<Int> Vector3i;
+typedef Math::Range2D<Float> Range2D;
+typedef Math::Range3D<Float> Range3D;
+
+/* Sizes covering the empty SIMD bulk, the bulk alone and the bulk with all
+   possible remainders */
+constexpr std::size_t LargeSizes[]{1, 7, 8, 9, 10, 11, 15, 16, 17, 31, 32, 33, 1001};
 
 FunctionsBatchTest::FunctionsBatchTest() {
     addTests({&FunctionsBatchTest::minList,
               &FunctionsBatchTest::maxList,
-              &FunctionsBatchTest::minmaxList});
+              &FunctionsBatchTest::minmaxList,
+
+              &FunctionsBatchTest::minMaxLarge<Float>,
+              &FunctionsBatchTest::minMaxLarge<Int>,
+              &FunctionsBatchTest::minMaxLarge<UnsignedInt>,
+              &FunctionsBatchTest::minMaxLargeNaN,
+              &FunctionsBatchTest::minmaxLargeVector3,
+
+              &FunctionsBatchTest::boundsList,
+
+              &FunctionsBatchTest::sumList,
+              &FunctionsBatchTest::sumLarge,
+              &FunctionsBatchTest::kahanSumList,
+              &FunctionsBatchTest::kahanSumLarge});
 }
 
 void FunctionsBatchTest::minList() {
@@ -92,6 +126,137 @@ void FunctionsBatchTest::minmaxList() {
     CORRADE_COMPARE(Math::minmax(array), expected);
 }
 
+template<class T> void FunctionsBatchTest::minMaxLarge() {
+    setTestCaseName(std::string{"minMaxLarge<"} + TypeTraits<T>::name() + ">");
+
+    for(std::size_t size: LargeSizes) {
+        /* Pseudo-random values spanning the whole range of both signed and
+           unsigned types, so the unsigned comparison is tested as well */
+        std::vector<T> data(size);
+        UnsignedInt seed = 0x1234567u;
+        for(T& i: data) {
+            seed = seed*1664525u + 1013904223u;
+            i = T(Int(seed));
+        }
+
+        T min = data[0], max = data[0];
+        for(T i: data) {
+            if(i < min) min = i;
+            if(i > max) max = i;
+        }
+
+        Corrade::Containers::ArrayView<const T> view{data.data(), data.size()};
+        CORRADE_COMPARE(Math::min(view), min);
+        CORRADE_COMPARE(Math::max(view), max);
+        CORRADE_COMPARE(Math::minmax(view), std::make_pair(min, max));
+    }
+}
+
+void FunctionsBatchTest::minMaxLargeNaN() {
+    /* NaNs are ignored unless they're the first item, same as in the scalar
+       code */
+    std::vector<Float> data(33);
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Float(i%13) - 5.0f;
+    data[3] = Constants<Float>::nan();
+    data[20] = Constants<Float>::nan();
+
+    Corrade::Containers::ArrayView<const Float> view{data.data(), data.size()};
+    CORRADE_COMPARE(Math::min(view), -5.0f);
+    CORRADE_COMPARE(Math::max(view), 7.0f);
+    CORRADE_COMPARE(Math::minmax(view), std::make_pair(-5.0f, 7.0f));
+
+    data[0] = Constants<Float>::nan();
+    CORRADE_VERIFY(Math::isNan(Math::min(view)));
+    CORRADE_VERIFY(Math::isNan(Math::max(view)));
+    CORRADE_VERIFY(Math::isNan(Math::minmax(view).first));
+    CORRADE_VERIFY(Math::isNan(Math::minmax(view).second));
+}
+
+void FunctionsBatchTest::minmaxLargeVector3() {
+    for(std::size_t size: LargeSizes) {
+        std::vector<Vector3> data(size);
+        for(std::size_t i = 0; i != size; ++i)
+            data[i] = {Float((i*7)%23), -Float((i*5)%19), Float((i*3)%29)*0.5f};
+
+        Vector3 min = data[0], max = data[0];
+        for(const Vector3& i: data) {
+            min = Math::min(min, i);
+            max = Math::max(max, i);
+        }
+
+        CORRADE_COMPARE(Math::minmax(Corrade::Containers::ArrayView<const Vector3>{data.data(), data.size()}), std::make_pair(min, max));
+    }
+}
+
+void FunctionsBatchTest::boundsList() {
+    const Vector2 points2D[]{{-1.0f, 3.0f}, {2.0f, 1.0f}, {-3.0f, -2.0f}};
+    CORRADE_COMPARE(Math::bounds(points2D), (Range2D{{-3.0f, -2.0f}, {2.0f, 3.0f}}));
+
+    const Vector3 points3D[]{{-1.0f, 3.0f, 0.5f}, {2.0f, 1.0f, -0.5f}, {-3.0f, -2.0f, 4.0f}};
+    CORRADE_COMPARE(Math::bounds(points3D), (Range3D{{-3.0f, -2.0f, -0.5f}, {2.0f, 3.0f, 4.0f}}));
+
+    CORRADE_COMPARE(Math::bounds(Corrade::Containers::ArrayView<const Vector3>{}), Range3D{});
+}
+
+void FunctionsBatchTest::sumList() {
+    CORRADE_COMPARE(Math::sum({5, -2, 9}), 12);
+    CORRADE_COMPARE(Math::sum({Vector3i(5, -3, 2),
+                               Vector3i(-2, 14, 7),
+                               Vector3i(9, -5, 18)}), Vector3i(12, 6, 27));
+
+    CORRADE_COMPARE(Math::sum(std::initializer_list<Float>{}), 0.0f);
+
+    const Float array[]{5.0f, -2.5f, 9.0f};
+    CORRADE_COMPARE(Math::sum(array), 11.5f);
+}
+
+void FunctionsBatchTest::sumLarge() {
+    for(std::size_t size: LargeSizes) {
+        /* Small integers are represented exactly so the order of additions
+           doesn't matter */
+        std::vector<Float> data(size);
+        Float expected = 0.0f;
+        for(std::size_t i = 0; i != size; ++i) {
+            data[i] = Float(Int(i%17) - 8);
+            expected += data[i];
+        }
+
+        CORRADE_COMPARE(Math::sum(Corrade::Containers::ArrayView<const Float>{data.data(), data.size()}), expected);
+    }
+}
+
+void FunctionsBatchTest::kahanSumList() {
+    CORRADE_COMPARE(Math::kahanSum({5.0f, -2.5f, 9.0f}), 11.5f);
+    CORRADE_COMPARE(Math::kahanSum(std::initializer_list<Double>{}), 0.0);
+
+    const Double array[]{5.0, -2.5, 9.0};
+    CORRADE_COMPARE(Math::kahanSum(array), 11.5);
+}
+
+void FunctionsBatchTest::kahanSumLarge() {
+    /* 2^24 followed by a few thousand ones. In a naive float sum each of the
+       ones gets rounded away and the result stays at 16777216, the
+       compensation keeps them. Big enough to go through the SSE2 path, where
+       the big value ends up in one lane only. */
+    std::vector<Float> data(4001, 1.0f);
+    data[0] = 16777216.0f;
+    Corrade::Containers::ArrayView<const Float> view{data.data(), data.size()};
+    CORRADE_COMPARE(Math::kahanSum(view), 16781216.0f);
+
+    /* Too small for the SSE2 path */
+    CORRADE_COMPARE(Math::kahanSum(view.prefix(5)), 16777220.0f);
+
+    /* Values that can't be represented exactly, the result should be as
+       precise as the scalar algorithm */
+    std::vector<Float> fractions(3001);
+    for(std::size_t i = 0; i != fractions.size(); ++i)
+        fractions[i] = 1.0f/Float(i%97 + 3);
+    const Float expected = Algorithms::kahanSum(fractions.begin(), fractions.end());
+    CORRADE_COMPARE_WITH(Math::kahanSum(Corrade::Containers::ArrayView<const Float>{fractions.data(), fractions.size()}), expected,
+        Corrade::TestSuite::Compare::around(expected*TypeTraits<Float>::epsilon()*4.0f));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::FunctionsBatchTest)
@@ -26,6 +26,8 @@
 #include <cstring>
 #include <algorithm>
 #include <sstream>
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #if defined(DOXYGEN_GENERATING_OUTPUT) || defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(CORRADE_TARGET_EMSCRIPTEN)
 #include <Corrade/Utility/Tweakable.h>
@@ -43,13 +45,19 @@ struct HalfTest: Corrade::TestSuite::Tester {
     void unpack();
     void pack();
     void repack();
+    void unpackInto();
+    void packInto();
+    void packUnpackIntoStrided();
+    void packUnpackIntoWrongSize();
 
     void unpack1k();
     void unpack1kNaive();
     void unpack1kTable();
+    void unpack1kInto();
     void pack1k();
     void pack1kNaive();
     void pack1kTable();
+    void pack1kInto();
 
     void constructDefault();
     void constructValue();
@@ -131,13 +139,20 @@ HalfTest::HalfTest() {
 
     addRepeatedTests({&HalfTest::repack}, 65536);
 
+    addTests({&HalfTest::unpackInto,
+              &HalfTest::packInto,
+              &HalfTest::packUnpackIntoStrided,
+              &HalfTest::packUnpackIntoWrongSize});
+
     addBenchmarks({
         &HalfTest::unpack1k,
         &HalfTest::unpack1kNaive,
         &HalfTest::unpack1kTable,
+        &HalfTest::unpack1kInto,
         &HalfTest::pack1k,
         &HalfTest::pack1kNaive,
-        &HalfTest::pack1kTable}, 100);
+        &HalfTest::pack1kTable,
+        &HalfTest::pack1kInto}, 100);
 
     addTests({&HalfTest::constructDefault,
               &HalfTest::constructValue,
@@ -490,6 +505,87 @@ void HalfTest::repack() {
     }
 }
 
+void HalfTest::unpackInto() {
+    /* All possible values, the result should be the same as with the scalar
+       function, except for NaN bit patterns */
+    std::vector<UnsignedShort> in(65536);
+    for(std::size_t i = 0; i != in.size(); ++i)
+        in[i] = UnsignedShort(i);
+
+    std::vector<Float> out(in.size());
+    Math::unpackHalfInto(Corrade::Containers::StridedArrayView<const UnsignedShort>{in.data(), in.size(), sizeof(UnsignedShort)},
+        Corrade::Containers::StridedArrayView<Float>{out.data(), out.size(), sizeof(Float)});
+    for(std::size_t i = 0; i != in.size(); ++i) {
+        const Float expected = Math::unpackHalf(in[i]);
+        if(expected != expected) CORRADE_VERIFY(out[i] != out[i]);
+        else CORRADE_COMPARE(out[i], expected);
+    }
+}
+
+void HalfTest::packInto() {
+    /* All representable values and values around the rounding thresholds
+       between them, plus a sparse sweep through all possible float bit
+       patterns. The result should be bit-exact with the scalar function. */
+    std::vector<Float> in;
+    for(UnsignedInt i = 0; i != 65535; ++i) {
+        const Float value = Math::unpackHalf(i);
+        const Float threshold = (value + Math::unpackHalf(i + 1))*0.5f;
+        for(Float j: {value, threshold,
+                      std::nextafter(threshold, Constants::inf()),
+                      std::nextafter(threshold, -Constants::inf())})
+            in.push_back(j);
+    }
+    for(std::uint_fast64_t i = 0; i < (std::uint_fast64_t(1) << 32); i += 4093) {
+        const UnsignedInt bits = UnsignedInt(i);
+        Float value;
+        std::memcpy(&value, &bits, sizeof(Float));
+        in.push_back(value);
+    }
+
+    std::vector<UnsignedShort> out(in.size());
+    Math::packHalfInto(Corrade::Containers::StridedArrayView<const Float>{in.data(), in.size(), sizeof(Float)},
+        Corrade::Containers::StridedArrayView<UnsignedShort>{out.data(), out.size(), sizeof(UnsignedShort)});
+    for(std::size_t i = 0; i != in.size(); ++i)
+        CORRADE_COMPARE(out[i], Math::packHalf(in[i]));
+}
+
+void HalfTest::packUnpackIntoStrided() {
+    /* Interleaved data with a size that's not a multiple of the block or
+       SIMD width */
+    struct Vertex {
+        Float value;
+        UnsignedShort packed;
+        Float unpacked;
+    };
+    std::vector<Vertex> vertices(1001);
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        vertices[i].value = Float(i)*0.37f - 100.0f;
+
+    Math::packHalfInto(Corrade::Containers::StridedArrayView<const Float>{&vertices[0].value, vertices.size(), sizeof(Vertex)},
+        Corrade::Containers::StridedArrayView<UnsignedShort>{&vertices[0].packed, vertices.size(), sizeof(Vertex)});
+    Math::unpackHalfInto(Corrade::Containers::StridedArrayView<const UnsignedShort>{&vertices[0].packed, vertices.size(), sizeof(Vertex)},
+        Corrade::Containers::StridedArrayView<Float>{&vertices[0].unpacked, vertices.size(), sizeof(Vertex)});
+    for(const Vertex& vertex: vertices) {
+        CORRADE_COMPARE(vertex.packed, Math::packHalf(vertex.value));
+        CORRADE_COMPARE(vertex.unpacked, Math::unpackHalf(vertex.packed));
+    }
+}
+
+void HalfTest::packUnpackIntoWrongSize() {
+    Float floats[3]{};
+    UnsignedShort halves[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Math::packHalfInto(Corrade::Containers::StridedArrayView<const Float>{floats, 3, sizeof(Float)},
+        Corrade::Containers::StridedArrayView<UnsignedShort>{halves, 4, sizeof(UnsignedShort)});
+    Math::unpackHalfInto(Corrade::Containers::StridedArrayView<const UnsignedShort>{halves, 4, sizeof(UnsignedShort)},
+        Corrade::Containers::StridedArrayView<Float>{floats, 3, sizeof(Float)});
+    CORRADE_COMPARE(out.str(),
+        "Math::packHalfInto(): expected 3 destination items but got 4\n"
+        "Math::unpackHalfInto(): expected 4 destination items but got 3\n");
+}
+
 void HalfTest::pack1k() {
     UnsignedInt out = 0;
     CORRADE_BENCHMARK(100)
@@ -520,6 +616,20 @@ void HalfTest::pack1kTable() {
     CORRADE_VERIFY(out);
 }
 
+void HalfTest::pack1kInto() {
+    Float in[1000];
+    for(std::uint_fast16_t i = 0; i != 1000; ++i)
+        in[i] = Float(i)*65;
+
+    UnsignedShort out[1000];
+    CORRADE_BENCHMARK(100)
+        Math::packHalfInto(Corrade::Containers::StridedArrayView<const Float>{in, 1000, sizeof(Float)},
+            Corrade::Containers::StridedArrayView<UnsignedShort>{out, 1000, sizeof(UnsignedShort)});
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out[999]);
+}
+
 void HalfTest::unpack1k() {
     Float out = 0.0f;
     CORRADE_BENCHMARK(100)
@@ -550,6 +660,20 @@ void HalfTest::unpack1kTable() {
     CORRADE_VERIFY(out);
 }
 
+void HalfTest::unpack1kInto() {
+    UnsignedShort in[1000];
+    for(std::uint_fast16_t i = 0; i != 1000; ++i)
+        in[i] = i*65;
+
+    Float out[1000];
+    CORRADE_BENCHMARK(100)
+        Math::unpackHalfInto(Corrade::Containers::StridedArrayView<const UnsignedShort>{in, 1000, sizeof(UnsignedShort)},
+            Corrade::Containers::StridedArrayView<Float>{out, 1000, sizeof(Float)});
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out[999]);
+}
+
 void HalfTest::constructDefault() {
     constexpr Half a;
     CORRADE_COMPARE(Float(a), 0.0f);
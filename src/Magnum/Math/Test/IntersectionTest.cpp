@@ -217,6 +217,22 @@ void IntersectionTest::sphereFrustum() {
     CORRADE_VERIFY(Intersection::sphereFrustum({5.5f, 5.5f, 5.5f}, 1.5f,  frustum));
     /* Sphere outside */
     CORRADE_VERIFY(!Intersection::sphereFrustum({0.0f, 0.0f, 100.0f}, 0.5f, frustum));
+    /* Sphere outside, closer than its squared radius */
+    CORRADE_VERIFY(!Intersection::sphereFrustum({0.0f, 0.0f, -3.0f}, 2.5f, frustum));
+
+    /* Frustum with non-normalized planes, such as one created from a
+       projection matrix */
+    const Frustum scaled{
+        {2.0f, 0.0f, 0.0f, 0.0f},
+        {-2.0f, 0.0f, 0.0f, 20.0f},
+        {0.0f, 0.5f, 0.0f, 0.0f},
+        {0.0f, -0.5f, 0.0f, 5.0f},
+        {0.0f, 0.0f, 3.0f, 0.0f},
+        {0.0f, 0.0f, -3.0f, 30.0f}};
+    CORRADE_VERIFY(Intersection::sphereFrustum({0.0f, 0.0f, -1.0f}, 1.5f, scaled));
+    CORRADE_VERIFY(Intersection::sphereFrustum({5.5f, 5.5f, 5.5f}, 1.5f, scaled));
+    CORRADE_VERIFY(!Intersection::sphereFrustum({0.0f, -3.0f, 0.0f}, 2.5f, scaled));
+    CORRADE_VERIFY(!Intersection::sphereFrustum({13.0f, 0.0f, 0.0f}, 2.5f, scaled));
 }
 
 void IntersectionTest::pointCone() {
@@ -24,8 +24,13 @@
 */
 
 #include <limits>
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
 
+#include "Magnum/Math/Constants.h"
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Math/Vector3.h"
 
@@ -47,6 +52,12 @@ struct PackingTest: Corrade::TestSuite::Tester {
     void pack8bitRoundtrip();
     void pack16bitRoundtrip();
 
+    template<class T> void unpackInto();
+    template<class T> void packInto();
+    template<class T> void packIntoSaturate();
+    template<class T> void packUnpackIntoStrided();
+    void packUnpackIntoWrongSize();
+
     /* Half (un)pack functions are tested and benchmarked in HalfTest.cpp,
        because there's involved comparison and benchmarks to ground truth */
 };
@@ -68,6 +79,24 @@ PackingTest::PackingTest() {
 
     addRepeatedTests({&PackingTest::pack8bitRoundtrip}, 256);
     addRepeatedTests({&PackingTest::pack16bitRoundtrip}, 65536);
+
+    addTests({&PackingTest::unpackInto<UnsignedByte>,
+              &PackingTest::unpackInto<Byte>,
+              &PackingTest::unpackInto<UnsignedShort>,
+              &PackingTest::unpackInto<Short>,
+              &PackingTest::packInto<UnsignedByte>,
+              &PackingTest::packInto<Byte>,
+              &PackingTest::packInto<UnsignedShort>,
+              &PackingTest::packInto<Short>,
+              &PackingTest::packIntoSaturate<UnsignedByte>,
+              &PackingTest::packIntoSaturate<Byte>,
+              &PackingTest::packIntoSaturate<UnsignedShort>,
+              &PackingTest::packIntoSaturate<Short>,
+              &PackingTest::packUnpackIntoStrided<UnsignedByte>,
+              &PackingTest::packUnpackIntoStrided<Byte>,
+              &PackingTest::packUnpackIntoStrided<UnsignedShort>,
+              &PackingTest::packUnpackIntoStrided<Short>,
+              &PackingTest::packUnpackIntoWrongSize});
 }
 
 void PackingTest::bitMax() {
@@ -300,6 +329,109 @@ void PackingTest::pack16bitRoundtrip() {
     CORRADE_COMPARE(Math::pack<UnsignedShort>(Math::unpack<Float, UnsignedShort>(testCaseRepeatId())), testCaseRepeatId());
 }
 
+template<class T> void PackingTest::unpackInto() {
+    setTestCaseName(std::string{"unpackInto<"} + TypeTraits<T>::name() + ">");
+
+    /* All possible values, the result should be the same as with the scalar
+       function */
+    std::vector<T> in(std::size_t(1) << sizeof(T)*8);
+    for(std::size_t i = 0; i != in.size(); ++i)
+        in[i] = T(i);
+
+    std::vector<Float> out(in.size());
+    Math::unpackInto(Corrade::Containers::StridedArrayView<const T>{in.data(), in.size(), sizeof(T)},
+        Corrade::Containers::StridedArrayView<Float>{out.data(), out.size(), sizeof(Float)});
+    for(std::size_t i = 0; i != in.size(); ++i)
+        CORRADE_COMPARE(out[i], Math::unpack<Float>(in[i]));
+}
+
+template<class T> void PackingTest::packInto() {
+    setTestCaseName(std::string{"packInto<"} + TypeTraits<T>::name() + ">");
+
+    /* All values that map to integers exactly and the values around the
+       rounding thresholds between them, the result should be the same as
+       with the scalar function */
+    const Float halfStep = 0.5f/Implementation::bitMax<T>();
+    const Float min = std::is_signed<T>::value ? -1.0f : 0.0f;
+    std::vector<Float> in;
+    for(std::size_t i = 0; i != std::size_t(1) << sizeof(T)*8; ++i) {
+        const Float value = Math::unpack<Float>(T(i));
+        const Float threshold = value + halfStep;
+        for(Float j: {value, value - halfStep, threshold,
+                      std::nextafter(threshold, 2.0f),
+                      std::nextafter(threshold, -2.0f)})
+            in.push_back(Math::clamp(j, min, 1.0f));
+    }
+
+    std::vector<T> out(in.size());
+    Math::packInto(Corrade::Containers::StridedArrayView<const Float>{in.data(), in.size(), sizeof(Float)},
+        Corrade::Containers::StridedArrayView<T>{out.data(), out.size(), sizeof(T)});
+    for(std::size_t i = 0; i != in.size(); ++i)
+        CORRADE_COMPARE(out[i], Math::pack<T>(in[i]));
+}
+
+template<class T> void PackingTest::packIntoSaturate() {
+    setTestCaseName(std::string{"packIntoSaturate<"} + TypeTraits<T>::name() + ">");
+
+    /* Out-of-range values in sizes that aren't a multiple of the SIMD width,
+       so both the SIMD path and the scalar remainder get tested. NaN is
+       expected to end up at the lower bound in both. */
+    const Float values[]{-1.0e20f, -2.0f, -1.5f, Constants<Float>::nan(), -0.5f, 0.25f, 1.5f, 2.0f, 1.0e20f, 0.75f};
+    const Float min = std::is_signed<T>::value ? -1.0f : 0.0f;
+    for(std::size_t size: {1, 7, 9, 17, 35}) {
+        std::vector<Float> in(size);
+        for(std::size_t i = 0; i != size; ++i)
+            in[i] = values[i%Corrade::Containers::arraySize(values)];
+
+        std::vector<T> out(size);
+        Math::packInto(Corrade::Containers::StridedArrayView<const Float>{in.data(), in.size(), sizeof(Float)},
+            Corrade::Containers::StridedArrayView<T>{out.data(), out.size(), sizeof(T)});
+        for(std::size_t i = 0; i != size; ++i) {
+            const Float expected = in[i] != in[i] ? min : Math::clamp(in[i], min, 1.0f);
+            CORRADE_COMPARE(out[i], Math::pack<T>(expected));
+        }
+    }
+}
+
+template<class T> void PackingTest::packUnpackIntoStrided() {
+    setTestCaseName(std::string{"packUnpackIntoStrided<"} + TypeTraits<T>::name() + ">");
+
+    /* Interleaved data with a size that's not a multiple of the block or
+       SIMD width */
+    struct Vertex {
+        Float value;
+        T packed;
+        Float unpacked;
+    };
+    std::vector<Vertex> vertices(1001);
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        vertices[i].value = Float(i%101)/100.0f;
+
+    Math::packInto(Corrade::Containers::StridedArrayView<const Float>{&vertices[0].value, vertices.size(), sizeof(Vertex)},
+        Corrade::Containers::StridedArrayView<T>{&vertices[0].packed, vertices.size(), sizeof(Vertex)});
+    Math::unpackInto(Corrade::Containers::StridedArrayView<const T>{&vertices[0].packed, vertices.size(), sizeof(Vertex)},
+        Corrade::Containers::StridedArrayView<Float>{&vertices[0].unpacked, vertices.size(), sizeof(Vertex)});
+    for(const Vertex& vertex: vertices) {
+        CORRADE_COMPARE(vertex.packed, Math::pack<T>(vertex.value));
+        CORRADE_COMPARE(vertex.unpacked, Math::unpack<Float>(vertex.packed));
+    }
+}
+
+void PackingTest::packUnpackIntoWrongSize() {
+    Float floats[3]{};
+    UnsignedByte packed[4]{};
+
+    std::ostringstream out;
+    Corrade::Utility::Error redirectError{&out};
+    Math::packInto(Corrade::Containers::StridedArrayView<const Float>{floats, 3, sizeof(Float)},
+        Corrade::Containers::StridedArrayView<UnsignedByte>{packed, 4, sizeof(UnsignedByte)});
+    Math::unpackInto(Corrade::Containers::StridedArrayView<const UnsignedByte>{packed, 4, sizeof(UnsignedByte)},
+        Corrade::Containers::StridedArrayView<Float>{floats, 3, sizeof(Float)});
+    CORRADE_COMPARE(out.str(),
+        "Math::packInto(): expected 3 destination items but got 4\n"
+        "Math::unpackInto(): expected 4 destination items but got 3\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::PackingTest)
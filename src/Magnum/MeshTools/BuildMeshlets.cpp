@@ -0,0 +1,297 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BuildMeshlets.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Clamp of the cone half-angle sine, so the tangent used in
+   Math::Intersection::pointCone() stays finite for planar meshlets */
+constexpr Float MaxConeSin = 0.9999f;
+
+constexpr UnsignedInt NoIndex = ~UnsignedInt{};
+
+void calculateBounds(Meshlet& meshlet, const UnsignedInt* const vertices, const UnsignedByte* const indices, const std::vector<Vector3>& positions) {
+    /* Bounding sphere using Ritter's algorithm -- take the most distant
+       point from an arbitrary point, the most distant point from that, and
+       then grow the sphere to include the points outside */
+    const Vector3& first = positions[vertices[0]];
+    Vector3 a = first;
+    Float maxDistance = 0.0f;
+    for(UnsignedInt i = 0; i != meshlet.vertexCount; ++i) {
+        const Float distance = (positions[vertices[i]] - first).dot();
+        if(distance > maxDistance) {
+            maxDistance = distance;
+            a = positions[vertices[i]];
+        }
+    }
+    Vector3 b = a;
+    maxDistance = 0.0f;
+    for(UnsignedInt i = 0; i != meshlet.vertexCount; ++i) {
+        const Float distance = (positions[vertices[i]] - a).dot();
+        if(distance > maxDistance) {
+            maxDistance = distance;
+            b = positions[vertices[i]];
+        }
+    }
+    Vector3 center = (a + b)*0.5f;
+    Float radius = (b - a).length()*0.5f;
+    for(UnsignedInt i = 0; i != meshlet.vertexCount; ++i) {
+        const Vector3& position = positions[vertices[i]];
+        const Float distance = (position - center).length();
+        if(distance > radius) {
+            radius = (radius + distance)*0.5f;
+            center = position + (center - position)*(radius/distance);
+        }
+    }
+
+    /* Pushing the center around may leave the most distant points slightly
+       out due to rounding, make sure they're inside */
+    for(UnsignedInt i = 0; i != meshlet.vertexCount; ++i)
+        radius = Math::max(radius, (positions[vertices[i]] - center).length());
+
+    meshlet.center = center;
+    meshlet.radius = radius;
+
+    /* Cone axis is the average of triangle normals, the spread is given by
+       the normal deviating the most from it */
+    Vector3 axis;
+    for(UnsignedInt i = 0; i != meshlet.triangleCount; ++i) {
+        const Vector3& p0 = positions[vertices[indices[i*3 + 0]]];
+        const Vector3& p1 = positions[vertices[indices[i*3 + 1]]];
+        const Vector3& p2 = positions[vertices[indices[i*3 + 2]]];
+        const Vector3 normal = Math::cross(p1 - p0, p2 - p0);
+        const Float length = normal.length();
+        if(length != 0.0f) axis += normal/length;
+    }
+
+    meshlet.coneOrigin = center;
+    meshlet.coneNormal = {};
+    meshlet.coneAngle = Rad{0.0f};
+
+    const Float axisLength = axis.length();
+    if(axisLength == 0.0f) return;
+    axis /= axisLength;
+
+    Float minDot = 1.0f;
+    for(UnsignedInt i = 0; i != meshlet.triangleCount; ++i) {
+        const Vector3& p0 = positions[vertices[indices[i*3 + 0]]];
+        const Vector3& p1 = positions[vertices[indices[i*3 + 1]]];
+        const Vector3& p2 = positions[vertices[indices[i*3 + 2]]];
+        const Vector3 normal = Math::cross(p1 - p0, p2 - p0);
+        const Float length = normal.length();
+        if(length != 0.0f) minDot = Math::min(minDot, Math::dot(normal/length, axis));
+    }
+
+    /* The normals span a hemisphere, there's no point from which all
+       triangles would be facing away */
+    if(minDot <= 0.0f) return;
+
+    /* Move the cone origin along the axis so it's behind all triangle
+       planes. The triangles are then all facing away from any point that's
+       in the cone with half-angle of 90° minus the max normal deviation.
+       Sine of the normal deviation is cosine of the cone half-angle and
+       vice versa. */
+    Float offset = 0.0f;
+    for(UnsignedInt i = 0; i != meshlet.triangleCount; ++i) {
+        const Vector3& p0 = positions[vertices[indices[i*3 + 0]]];
+        const Vector3& p1 = positions[vertices[indices[i*3 + 1]]];
+        const Vector3& p2 = positions[vertices[indices[i*3 + 2]]];
+        const Vector3 normal = Math::cross(p1 - p0, p2 - p0);
+        const Float length = normal.length();
+        if(length == 0.0f) continue;
+        const Vector3 n = normal/length;
+        offset = Math::max(offset, Math::dot(center - p0, n)/Math::dot(axis, n));
+    }
+
+    meshlet.coneOrigin = center - axis*offset;
+    meshlet.coneNormal = -axis;
+    meshlet.coneAngle = Rad{2.0f*std::asin(Math::min(minDot, MaxConeSin))};
+}
+
+}
+
+MeshletData buildMeshlets(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::buildMeshlets(): index count is not divisible by 3", {});
+    CORRADE_ASSERT(maxVertexCount >= 3 && maxVertexCount <= 256,
+        "MeshTools::buildMeshlets(): expected max vertex count between 3 and 256 but got" << maxVertexCount, {});
+    CORRADE_ASSERT(maxTriangleCount,
+        "MeshTools::buildMeshlets(): expected non-zero max triangle count", {});
+
+    const std::size_t triangleCount = indices.size()/3;
+    const std::size_t vertexCount = positions.size();
+
+    /* Triangles adjacent to each vertex */
+    std::vector<UnsignedInt> adjacencyOffset(vertexCount + 1);
+    for(const UnsignedInt index: indices) {
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::buildMeshlets(): index" << index << "out of range for" << vertexCount << "vertices", {});
+        ++adjacencyOffset[index + 1];
+    }
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        adjacencyOffset[i + 1] += adjacencyOffset[i];
+    std::vector<UnsignedInt> adjacency(indices.size());
+    {
+        std::vector<UnsignedInt> adjacencyFill{adjacencyOffset.begin(), adjacencyOffset.end() - 1};
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            adjacency[adjacencyFill[indices[i]]++] = i/3;
+    }
+
+    MeshletData out;
+    out.meshlets.reserve(triangleCount/maxTriangleCount + 1);
+    out.vertices.reserve(indices.size()/2);
+    out.indices.reserve(indices.size());
+
+    /* Index of each vertex in the current meshlet, count of not yet
+       emitted triangles using each vertex, stamp of the meshlet in which a
+       triangle was last added to the candidate list */
+    std::vector<UnsignedInt> localIndex(vertexCount, NoIndex);
+    std::vector<UnsignedInt> liveTriangleCount(vertexCount);
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        liveTriangleCount[i] = adjacencyOffset[i + 1] - adjacencyOffset[i];
+    std::vector<UnsignedInt> candidateStamp(triangleCount, NoIndex);
+    std::vector<bool> emitted(triangleCount);
+    std::vector<UnsignedInt> candidates;
+
+    Meshlet meshlet{};
+    Vector3 centroidSum;
+    Vector3 centroid;
+    std::size_t seed = 0;
+    auto flush = [&]() {
+        calculateBounds(meshlet, out.vertices.data() + meshlet.vertexOffset, out.indices.data() + meshlet.indexOffset, positions);
+        for(std::size_t i = meshlet.vertexOffset; i != out.vertices.size(); ++i)
+            localIndex[out.vertices[i]] = NoIndex;
+        out.meshlets.push_back(meshlet);
+
+        centroid = centroidSum/Float(meshlet.triangleCount);
+        centroidSum = {};
+        meshlet = Meshlet{};
+        meshlet.vertexOffset = out.vertices.size();
+        meshlet.indexOffset = out.indices.size();
+    };
+
+    for(;;) {
+        /* Pick the candidate that fits into the meshlet and adds the least
+           vertices, then the one with least unused neighbors and then the
+           closest one. Remove the already emitted ones on the way. */
+        UnsignedInt best = NoIndex;
+        UnsignedInt bestNewVertexCount = 4;
+        UnsignedInt bestLiveCount = NoIndex;
+        Float bestDistance = Constants::inf();
+        const Vector3 center = meshlet.triangleCount ?
+            centroidSum/Float(meshlet.triangleCount) : centroid;
+        std::size_t candidateCount = 0;
+        for(const UnsignedInt candidate: candidates) {
+            if(emitted[candidate]) continue;
+            candidates[candidateCount++] = candidate;
+
+            const UnsignedInt a = indices[candidate*3 + 0];
+            const UnsignedInt b = indices[candidate*3 + 1];
+            const UnsignedInt c = indices[candidate*3 + 2];
+            const UnsignedInt newVertexCount =
+                (localIndex[a] == NoIndex) +
+                (localIndex[b] == NoIndex && b != a) +
+                (localIndex[c] == NoIndex && c != a && c != b);
+            if(meshlet.vertexCount + newVertexCount > maxVertexCount ||
+               newVertexCount > bestNewVertexCount) continue;
+
+            const UnsignedInt liveCount = liveTriangleCount[a] + liveTriangleCount[b] + liveTriangleCount[c];
+            if(newVertexCount == bestNewVertexCount && liveCount > bestLiveCount) continue;
+
+            const Float distance = ((positions[a] + positions[b] + positions[c])/3.0f - center).dot();
+            if(newVertexCount < bestNewVertexCount || liveCount < bestLiveCount || distance < bestDistance) {
+                best = candidate;
+                bestNewVertexCount = newVertexCount;
+                bestLiveCount = liveCount;
+                bestDistance = distance;
+            }
+        }
+        candidates.resize(candidateCount);
+
+        /* Nothing fits into a non-empty meshlet anymore, start a new one.
+           The candidates are kept for seeding the next meshlet. */
+        if(best == NoIndex && meshlet.triangleCount) {
+            flush();
+            continue;
+        }
+
+        /* Starting a new meshlet, forget the candidates from the previous
+           one. If there are none, take the next unused triangle in mesh
+           order. If there's no such triangle, we're done. */
+        if(!meshlet.triangleCount) {
+            candidates.clear();
+            if(best == NoIndex) {
+                while(seed != triangleCount && emitted[seed]) ++seed;
+                if(seed == triangleCount) break;
+                best = seed;
+            }
+        }
+
+        /* Add the triangle */
+        emitted[best] = true;
+        for(std::size_t i = 0; i != 3; ++i) {
+            const UnsignedInt vertex = indices[best*3 + i];
+            --liveTriangleCount[vertex];
+            if(localIndex[vertex] == NoIndex) {
+                localIndex[vertex] = meshlet.vertexCount++;
+                out.vertices.push_back(vertex);
+            }
+            out.indices.push_back(localIndex[vertex]);
+            centroidSum += positions[vertex]/3.0f;
+
+            /* Add unused neighbor triangles to candidates */
+            for(std::size_t j = adjacencyOffset[vertex], jMax = adjacencyOffset[vertex + 1]; j != jMax; ++j) {
+                const UnsignedInt neighbor = adjacency[j];
+                if(emitted[neighbor] || candidateStamp[neighbor] == out.meshlets.size()) continue;
+                candidateStamp[neighbor] = out.meshlets.size();
+                candidates.push_back(neighbor);
+            }
+        }
+
+        if(++meshlet.triangleCount == maxTriangleCount) flush();
+    }
+
+    return out;
+}
+
+MeshletData buildMeshlets(const Trade::MeshData3D& mesh, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles && mesh.isIndexed(),
+        "MeshTools::buildMeshlets(): expected an indexed triangle mesh", {});
+
+    return buildMeshlets(mesh.indices(), mesh.positions(0), maxVertexCount, maxTriangleCount);
+}
+
+}}
@@ -0,0 +1,167 @@
+#ifndef Magnum_MeshTools_BuildMeshlets_h
+#define Magnum_MeshTools_BuildMeshlets_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::Meshlet, @ref Magnum::MeshTools::MeshletData, function @ref Magnum::MeshTools::buildMeshlets()
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Meshlet
+
+A spatially coherent cluster of mesh triangles, produced by
+@ref buildMeshlets(). See its documentation for an example usage.
+*/
+struct Meshlet {
+    /** @brief Offset of the first vertex in @ref MeshletData::vertices */
+    UnsignedInt vertexOffset;
+
+    /** @brief Offset of the first index in @ref MeshletData::indices */
+    UnsignedInt indexOffset;
+
+    /** @brief Vertex count */
+    UnsignedInt vertexCount;
+
+    /** @brief Triangle count */
+    UnsignedInt triangleCount;
+
+    /**
+     * @brief Bounding sphere center
+     *
+     * Together with @ref radius usable for frustum culling with
+     * @ref Math::Intersection::sphereFrustum() or for testing against a
+     * cone with @ref Math::Intersection::sphereCone().
+     */
+    Vector3 center;
+
+    /** @brief Bounding sphere radius */
+    Float radius;
+
+    /**
+     * @brief Backface cone origin
+     *
+     * If @ref Math::Intersection::pointCone() for the camera position,
+     * @ref coneOrigin, @ref coneNormal and @ref coneAngle returns
+     * @cpp true @ce, all triangles of the meshlet are facing away from the
+     * camera.
+     */
+    Vector3 coneOrigin;
+
+    /** @brief Backface cone normal */
+    Vector3 coneNormal;
+
+    /**
+     * @brief Backface cone apex angle
+     *
+     * If the triangle normals span a hemisphere or more, the meshlet can't
+     * be backface-culled and the angle is set to zero.
+     */
+    Rad coneAngle;
+};
+
+/**
+@brief Meshlet data
+
+Output of @ref buildMeshlets().
+*/
+struct MeshletData {
+    /** @brief Meshlets */
+    std::vector<Meshlet> meshlets;
+
+    /**
+     * @brief Meshlet vertices
+     *
+     * Indices into the original vertex data. Vertices of a meshlet are
+     * stored consecutively starting at @ref Meshlet::vertexOffset.
+     */
+    std::vector<UnsignedInt> vertices;
+
+    /**
+     * @brief Meshlet indices
+     *
+     * Triangle indices local to each meshlet, i.e. indexing the range of
+     * @ref vertices belonging to given meshlet. Indices of a meshlet are
+     * stored consecutively starting at @ref Meshlet::indexOffset, three for
+     * each triangle.
+     */
+    std::vector<UnsignedByte> indices;
+};
+
+/**
+@brief Split a mesh into meshlets
+@param indices          Index array of a triangle mesh
+@param positions        Vertex positions
+@param maxVertexCount   Max count of vertices in a meshlet
+@param maxTriangleCount Max count of triangles in a meshlet
+@return Meshlets together with their vertex and index arrays
+
+Greedily grows each meshlet from a seed triangle by adding the neighboring
+triangle that introduces the fewest new vertices until the vertex or triangle
+limit is hit. Ties are broken first by preferring triangles with fewer unused
+neighbors, which makes the meshlets follow the border of the already
+processed part and avoids leaving small isolated pockets behind, and then by
+distance to the meshlet center. The next meshlet is seeded from the border of
+the previous one, which keeps the meshlets spatially coherent and the whole
+process linear in triangle count. Triangle winding is preserved.
+
+Each meshlet has a bounding sphere and a backface cone calculated, usable for
+culling on the CPU directly with the @ref Math::Intersection functions:
+
+@snippet MagnumMeshTools.cpp buildMeshlets
+
+Expects that the index count is divisible by 3, @p maxVertexCount is at least
+@cpp 3 @ce and at most @cpp 256 @ce, so the local indices fit into
+@ref Magnum::UnsignedByte "UnsignedByte", and @p maxTriangleCount is not
+zero. The defaults of @cpp 64 @ce vertices and @cpp 126 @ce triangles are a
+good fit for mesh shader hardware.
+*/
+MAGNUM_MESHTOOLS_EXPORT MeshletData buildMeshlets(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 126);
+
+/**
+@brief Split a mesh into meshlets
+@param mesh             Indexed triangle mesh
+@param maxVertexCount   Max count of vertices in a meshlet
+@param maxTriangleCount Max count of triangles in a meshlet
+
+Calls @ref buildMeshlets(const std::vector<UnsignedInt>&, const std::vector<Vector3>&, UnsignedInt, UnsignedInt)
+with the index array and the first position array of @p mesh. Expects that
+the mesh is indexed and has @ref MeshPrimitive::Triangles.
+*/
+MAGNUM_MESHTOOLS_EXPORT MeshletData buildMeshlets(const Trade::MeshData3D& mesh, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 126);
+
+}}
+
+#endif
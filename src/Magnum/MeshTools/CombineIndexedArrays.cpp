@@ -25,39 +25,149 @@
 
 #include "CombineIndexedArrays.h"
 
-#include <cstring>
-#include <unordered_map>
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Assert.h>
-#include <Corrade/Utility/MurmurHash2.h>
 
 #include "Magnum/Magnum.h"
 
 namespace Magnum { namespace MeshTools {
 
+namespace {
+
+/* Mixes the indices one at a time, with a final avalanche so the low bits
+   used for addressing the table depend on all input bits */
+inline UnsignedInt hashIndex(UnsignedInt hash, const UnsignedInt index) {
+    hash = (hash ^ index)*0x9e3779b1u;
+    return hash ^ (hash >> 15);
+}
+
+inline UnsignedInt hashFinalize(UnsignedInt hash) {
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    return hash ^ (hash >> 13);
+}
+
+/* Moves a new unique combination to the front of the arrays. Read-only
+   arrays are never compacted, position of the first occurrence of each
+   combination is recorded instead. */
+inline void compactIndex(const Containers::StridedArrayView<UnsignedInt>& array, const std::size_t unique, const UnsignedInt index) {
+    array[unique] = index;
+}
+
+inline void compactIndex(const Containers::StridedArrayView<const UnsignedInt>&, std::size_t, UnsignedInt) {
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* If Count is non-zero, the combination is loaded into a local array first
+   so the compiler can keep it in registers and unroll the loops, otherwise
+   it's read from the arrays every time. If uniquePositions is non-null, the
+   arrays are left untouched and the position of the first occurrence of
+   each unique combination is written there instead. */
+template<std::size_t Count, class T> std::size_t combineInto(const Containers::ArrayView<const Containers::StridedArrayView<T>> arrays, const Containers::ArrayView<UnsignedInt> combinedIndices, const Containers::ArrayView<UnsignedInt> table, UnsignedInt* const uniquePositions) {
+    constexpr UnsignedInt Empty = ~UnsignedInt{};
+    const std::size_t arrayCount = Count ? Count : arrays.size();
+    const std::size_t tableMask = table.size() - 1;
+    std::fill(table.begin(), table.end(), Empty);
+
+    UnsignedInt combination[Count ? Count : 1];
+    UnsignedInt uniqueCount = 0;
+    for(std::size_t i = 0; i != combinedIndices.size(); ++i) {
+        UnsignedInt hash = 2166136261u;
+        for(std::size_t j = 0; j != arrayCount; ++j) {
+            const UnsignedInt index = arrays[j][i];
+            if(Count) combination[j] = index;
+            hash = hashIndex(hash, index);
+        }
+        hash = hashFinalize(hash);
+
+        for(std::size_t slot = hash & tableMask; ; slot = (slot + 1) & tableMask) {
+            const UnsignedInt unique = table[slot];
+
+            /* New unique combination. The unique count never exceeds the
+               count of processed combinations, so they can be compacted to
+               the front in place. */
+            if(unique == Empty) {
+                if(uniquePositions) uniquePositions[uniqueCount] = i;
+                else if(uniqueCount != i) for(std::size_t j = 0; j != arrayCount; ++j)
+                    compactIndex(arrays[j], uniqueCount, Count ? combination[j] : arrays[j][i]);
+                table[slot] = uniqueCount;
+                combinedIndices[i] = uniqueCount++;
+                break;
+            }
+
+            /* Duplicate of an existing one */
+            const std::size_t position = uniquePositions ? uniquePositions[unique] : unique;
+            std::size_t j = 0;
+            for(; j != arrayCount; ++j)
+                if(arrays[j][position] != (Count ? combination[j] : arrays[j][i])) break;
+            if(j == arrayCount) {
+                combinedIndices[i] = unique;
+                break;
+            }
+        }
+    }
+
+    return uniqueCount;
+}
+
+/* Combines an interleaved array in place, shrinking it to contain just the
+   unique combinations */
+std::vector<UnsignedInt> combineInterleavedInPlace(std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride) {
+    const std::size_t size = interleavedArrays.size()/stride;
+    if(!size) return {};
+
+    std::vector<Containers::StridedArrayView<UnsignedInt>> arrays;
+    arrays.reserve(stride);
+    for(UnsignedInt offset = 0; offset != stride; ++offset)
+        arrays.emplace_back(interleavedArrays.data() + offset, size, stride*sizeof(UnsignedInt));
+
+    std::vector<UnsignedInt> combinedIndices(size);
+    Containers::Array<UnsignedInt> scratch{Containers::NoInit, combineIndexArraysScratchSize(size)};
+    const std::size_t uniqueCount = combineIndexArraysInto({arrays.data(), arrays.size()}, {combinedIndices.data(), combinedIndices.size()}, scratch);
+
+    interleavedArrays.resize(uniqueCount*stride);
+    return combinedIndices;
+}
+
+template<class T> std::size_t combineIntoDispatch(const Containers::ArrayView<const Containers::StridedArrayView<T>> arrays, const Containers::ArrayView<UnsignedInt> combinedIndices, const Containers::ArrayView<UnsignedInt> table, UnsignedInt* const uniquePositions) {
+    switch(arrays.size()) {
+        case 1: return combineInto<1>(arrays, combinedIndices, table, uniquePositions);
+        case 2: return combineInto<2>(arrays, combinedIndices, table, uniquePositions);
+        case 3: return combineInto<3>(arrays, combinedIndices, table, uniquePositions);
+        case 4: return combineInto<4>(arrays, combinedIndices, table, uniquePositions);
+    }
+
+    return combineInto<0>(arrays, combinedIndices, table, uniquePositions);
+}
+
+}
+
 namespace Implementation {
 
-std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> interleaveAndCombineIndexArrays(const std::reference_wrapper<const std::vector<UnsignedInt>>* begin, const std::reference_wrapper<const std::vector<UnsignedInt>>* end) {
-    /* Array stride and size */
-    const UnsignedInt stride = end - begin;
-    const UnsignedInt inputSize = begin->get().size();
+std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineConstIndexArrays(const std::reference_wrapper<const std::vector<UnsignedInt>>* const begin, const std::reference_wrapper<const std::vector<UnsignedInt>>* const end) {
+    const std::size_t size = begin == end ? 0 : begin->get().size();
     #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
     for(auto it = begin; it != end; ++it)
-        CORRADE_ASSERT(it->get().size() == inputSize, "MeshTools::combineIndexArrays(): the arrays don't have the same size", {});
+        CORRADE_ASSERT(it->get().size() == size, "MeshTools::combineIndexArrays(): the arrays don't have the same size", {});
     #endif
+    if(!size) return {};
 
-    /* Interleave the arrays */
-    std::vector<UnsignedInt> interleavedArrays;
-    interleavedArrays.resize(inputSize*stride);
-    for(UnsignedInt offset = 0; offset != stride; ++offset) {
-        const auto& array = (begin+offset)->get();
-        for(UnsignedInt i = 0; i != inputSize; ++i)
-            interleavedArrays[offset + i*stride] = array[i];
-    }
+    /* The index arrays are const, so instead of compacting them in place
+       they're only viewed and positions of the unique combinations are
+       recorded, which are then used to reorder the attribute arrays */
+    std::vector<Containers::StridedArrayView<const UnsignedInt>> arrays;
+    arrays.reserve(end - begin);
+    for(auto it = begin; it != end; ++it)
+        arrays.emplace_back(it->get().data(), size, sizeof(UnsignedInt));
+
+    std::vector<UnsignedInt> combinedIndices(size);
+    std::vector<UnsignedInt> uniquePositions(size);
+    Containers::Array<UnsignedInt> scratch{Containers::NoInit, combineIndexArraysScratchSize(size)};
+    const std::size_t uniqueCount = combineIntoDispatch<const UnsignedInt>({arrays.data(), arrays.size()}, {combinedIndices.data(), combinedIndices.size()}, scratch, uniquePositions.data());
 
-    /* Combine them */
-    std::vector<UnsignedInt> combinedIndices;
-    std::tie(combinedIndices, interleavedArrays) = MeshTools::combineIndexArrays(interleavedArrays, stride);
-    return {combinedIndices, interleavedArrays};
+    uniquePositions.resize(uniqueCount);
+    return {std::move(combinedIndices), std::move(uniquePositions)};
 }
 
 }
@@ -65,58 +175,34 @@ std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> interleaveAndCombi
 namespace {
 
 std::vector<UnsignedInt> combineIndexArrays(const std::reference_wrapper<std::vector<UnsignedInt>>* const begin, const std::reference_wrapper<std::vector<UnsignedInt>>* const end) {
-    /* Interleave and combine the arrays */
-    std::vector<UnsignedInt> combinedIndices;
-    std::vector<UnsignedInt> interleavedCombinedArrays;
-    std::tie(combinedIndices, interleavedCombinedArrays) = Implementation::interleaveAndCombineIndexArrays(
-        /* This will bite me hard once. */
-        reinterpret_cast<const std::reference_wrapper<const std::vector<UnsignedInt>>*>(begin),
-        reinterpret_cast<const std::reference_wrapper<const std::vector<UnsignedInt>>*>(end));
-
-    /* Update the original indices */
-    const UnsignedInt stride = end - begin;
-    const UnsignedInt outputSize = interleavedCombinedArrays.size()/stride;
-    for(UnsignedInt offset = 0; offset != stride; ++offset) {
-        auto& array = (begin+offset)->get();
-        CORRADE_INTERNAL_ASSERT(array.size() >= outputSize);
-        array.resize(outputSize);
-        for(UnsignedInt i = 0; i != outputSize; ++i)
-            array[i] = interleavedCombinedArrays[offset + i*stride];
-    }
-
-    return combinedIndices;
-}
-
-class IndexHash {
-    public:
-        explicit IndexHash(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
-
-        std::size_t operator()(UnsignedInt key) const {
-            return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(indices.data()+key*stride), sizeof(UnsignedInt)*stride).byteArray());
-        }
+    const std::size_t size = begin == end ? 0 : begin->get().size();
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(auto it = begin; it != end; ++it)
+        CORRADE_ASSERT(it->get().size() == size, "MeshTools::combineIndexArrays(): the arrays don't have the same size", {});
+    #endif
+    if(!size) return {};
 
-    private:
-        const std::vector<UnsignedInt>& indices;
-        UnsignedInt stride;
-};
+    /* Combine the arrays directly, without interleaving them first */
+    std::vector<Containers::StridedArrayView<UnsignedInt>> arrays;
+    arrays.reserve(end - begin);
+    for(auto it = begin; it != end; ++it)
+        arrays.emplace_back(it->get().data(), size, sizeof(UnsignedInt));
 
-class IndexEqual {
-    public:
-        explicit IndexEqual(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+    std::vector<UnsignedInt> combinedIndices(size);
+    Containers::Array<UnsignedInt> scratch{Containers::NoInit, combineIndexArraysScratchSize(size)};
+    const std::size_t uniqueCount = combineIndexArraysInto({arrays.data(), arrays.size()}, {combinedIndices.data(), combinedIndices.size()}, scratch);
 
-        bool operator()(UnsignedInt a, UnsignedInt b) const {
-            return std::memcmp(indices.data()+a*stride, indices.data()+b*stride, sizeof(UnsignedInt)*stride) == 0;
-        }
+    /* Cut the original indices to just the unique combinations */
+    for(auto it = begin; it != end; ++it)
+        it->get().resize(uniqueCount);
 
-    private:
-        const std::vector<UnsignedInt>& indices;
-        UnsignedInt stride;
-};
+    return combinedIndices;
+}
 
 }
 
 std::vector<UnsignedInt> combineIndexArrays(const std::vector<std::reference_wrapper<std::vector<UnsignedInt>>>& arrays) {
-    return combineIndexArrays(&arrays[0], &arrays[0] + arrays.size());
+    return combineIndexArrays(arrays.data(), arrays.data() + arrays.size());
 }
 
 std::vector<UnsignedInt> combineIndexArrays(std::initializer_list<std::reference_wrapper<std::vector<UnsignedInt>>> arrays) {
@@ -127,38 +213,30 @@ std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays
     CORRADE_ASSERT(stride != 0, "MeshTools::combineIndexArrays(): stride can't be zero", {});
     CORRADE_ASSERT(interleavedArrays.size() % stride == 0, "MeshTools::combineIndexArrays(): array size is not divisible by stride", {});
 
-    /* Hash map with index combinations, containing just indices into
-       interleavedArrays vector, hashing and comparison is done using IndexHash
-       and IndexEqual functors. Reserving more buckets than necessary (i.e. as
-       if each combination was unique). */
-    std::unordered_map<UnsignedInt, UnsignedInt, IndexHash, IndexEqual> indexCombinations(
-        interleavedArrays.size()/stride,
-        IndexHash(interleavedArrays, stride),
-        IndexEqual(interleavedArrays, stride));
-
-    /* Make the index combinations unique. Original indices into original
-       `interleavedArrays` array were 0, 1, 2, 3, ..., `combinedIndices`
-       contains new ones into new (shorter) `newInterleavedArrays` array. */
-    std::vector<UnsignedInt> combinedIndices;
-    combinedIndices.reserve(interleavedArrays.size()/stride);
-    std::vector<UnsignedInt> newInterleavedArrays;
-    for(std::size_t oldIndex = 0, end = interleavedArrays.size()/stride; oldIndex != end; ++oldIndex) {
-        /* Try to insert new index combination to the map */
-        const auto result = indexCombinations.emplace(oldIndex, indexCombinations.size());
-
-        /* Add the (either new or already existing) index to resulting index array */
-        combinedIndices.push_back(result.first->second);
-
-        /* If this is new combination, copy it to new interleaved arrays */
-        if(result.second) newInterleavedArrays.insert(newInterleavedArrays.end(),
-            interleavedArrays.begin()+oldIndex*stride,
-            interleavedArrays.begin()+(oldIndex+1)*stride);
-    }
+    std::vector<UnsignedInt> newInterleavedArrays{interleavedArrays};
+    std::vector<UnsignedInt> combinedIndices = combineInterleavedInPlace(newInterleavedArrays, stride);
+    return {std::move(combinedIndices), std::move(newInterleavedArrays)};
+}
 
-    CORRADE_INTERNAL_ASSERT(combinedIndices.size() == interleavedArrays.size()/stride &&
-                            newInterleavedArrays.size() <= interleavedArrays.size());
+std::size_t combineIndexArraysScratchSize(const std::size_t indexCount) {
+    std::size_t size = 1;
+    while(size < indexCount + indexCount/2) size <<= 1;
+    return size;
+}
 
-    return {std::move(combinedIndices), std::move(newInterleavedArrays)};
+std::size_t combineIndexArraysInto(const Containers::ArrayView<const Containers::StridedArrayView<UnsignedInt>> arrays, const Containers::ArrayView<UnsignedInt> combinedIndices, const Containers::ArrayView<UnsignedInt> scratch) {
+    CORRADE_ASSERT(!arrays.empty(),
+        "MeshTools::combineIndexArraysInto(): no index arrays given", {});
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(std::size_t i = 0; i != arrays.size(); ++i)
+        CORRADE_ASSERT(arrays[i].size() == combinedIndices.size(),
+            "MeshTools::combineIndexArraysInto(): expected" << combinedIndices.size() << "items in array" << i << "but got" << arrays[i].size(), {});
+    #endif
+    const std::size_t tableSize = combineIndexArraysScratchSize(combinedIndices.size());
+    CORRADE_ASSERT(scratch.size() >= tableSize,
+        "MeshTools::combineIndexArraysInto(): expected at least" << tableSize << "scratch items but got" << scratch.size(), {});
+
+    return combineIntoDispatch<UnsignedInt>(arrays, combinedIndices, scratch.prefix(tableSize), nullptr);
 }
 
 }}
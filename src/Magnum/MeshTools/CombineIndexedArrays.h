@@ -26,15 +26,17 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::combineIndexArrays(), @ref Magnum::MeshTools::combineIndexedArrays()
+ * @brief Function @ref Magnum::MeshTools::combineIndexArrays(), @ref Magnum::MeshTools::combineIndexArraysInto(), @ref Magnum::MeshTools::combineIndexArraysScratchSize(), @ref Magnum::MeshTools::combineIndexedArrays()
  */
 
 #include <functional>
 #include <tuple>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Assert.h>
 
-#include "Magnum/Types.h"
+#include "Magnum/Magnum.h"
 #include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
@@ -77,9 +79,9 @@ which can be then indexed with the combined index array:
 Again, first triangle in the mesh will have positions `a c f` and normals
 `B D E`.
 
-This function calls @ref combineIndexArrays(const std::vector<UnsignedInt>&, UnsignedInt)
-internally. See also @ref combineIndexedArrays() which does the vertex data
-reordering automatically.
+This function calls @ref combineIndexArraysInto() internally. See also
+@ref combineIndexedArrays() which does the vertex data reordering
+automatically.
 */
 MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> combineIndexArrays(const std::vector<std::reference_wrapper<std::vector<UnsignedInt>>>& arrays);
 
@@ -109,16 +111,59 @@ And second pair value is the cleaned up interleaved array:
 */
 MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, UnsignedInt stride);
 
+/**
+@brief Scratch memory size for @ref combineIndexArraysInto()
+@param indexCount   Count of items in each index array
+
+Returns count of @ref Magnum::UnsignedInt "UnsignedInt" items the scratch
+buffer passed to @ref combineIndexArraysInto() needs to have. The size is a
+power of two such that the hash table is at most two thirds full even if all
+index combinations are unique.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t combineIndexArraysScratchSize(std::size_t indexCount);
+
+/**
+@brief Combine index arrays in place
+@param[in,out] arrays       Index arrays to combine. Unique combinations of
+    the original indices are moved to the front of the arrays.
+@param[out] combinedIndices Resulting combined index array
+@param[in] scratch          Scratch memory for the hash table
+@return Count of unique index combinations
+
+Allocation-free variant of @ref combineIndexArrays(const std::vector<std::reference_wrapper<std::vector<UnsignedInt>>>&).
+All @p arrays and @p combinedIndices are expected to have the same size and
+@p scratch is expected to have at least @ref combineIndexArraysScratchSize()
+items. The arrays can be arbitrarily strided, so it's possible to operate
+directly on an interleaved array or on index members of a structure without
+copying them to separate arrays first. After the call, the first *n* items of
+each array, where *n* is the returned value, contain the cleaned up unique
+combinations, while the rest has unspecified contents.
+
+The index combinations are processed in a single pass, looking up each in an
+open-addressing hash table with linear probing. The table stores only the
+unique combination index, which makes it possible to use the cleaned-up front
+of @p arrays for comparison without storing the combinations again.
+Example usage, operating directly on index data produced by a file importer:
+
+@snippet MagnumMeshTools.cpp combineIndexArraysInto
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t combineIndexArraysInto(Containers::ArrayView<const Containers::StridedArrayView<UnsignedInt>> arrays, Containers::ArrayView<UnsignedInt> combinedIndices, Containers::ArrayView<UnsignedInt> scratch);
+
+/** @overload */
+inline std::size_t combineIndexArraysInto(std::initializer_list<Containers::StridedArrayView<UnsignedInt>> arrays, Containers::ArrayView<UnsignedInt> combinedIndices, Containers::ArrayView<UnsignedInt> scratch) {
+    return combineIndexArraysInto({arrays.begin(), arrays.size()}, combinedIndices, scratch);
+}
+
 namespace Implementation {
 
-MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> interleaveAndCombineIndexArrays(const std::reference_wrapper<const std::vector<UnsignedInt>>* begin, const std::reference_wrapper<const std::vector<UnsignedInt>>* end);
+MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineConstIndexArrays(const std::reference_wrapper<const std::vector<UnsignedInt>>* begin, const std::reference_wrapper<const std::vector<UnsignedInt>>* end);
 
-template<class T> void writeCombinedArray(const UnsignedInt stride, const UnsignedInt offset, const std::vector<UnsignedInt>& interleavedCombinedIndexArrays, std::vector<T>& array) {
+template<class T> void writeCombinedArray(const std::vector<UnsignedInt>& uniquePositions, const std::vector<UnsignedInt>& indices, std::vector<T>& array) {
     /* Can't use duplicate() here because we aren't accessing the index data sequentially */
     std::vector<T> output;
-    output.reserve(interleavedCombinedIndexArrays.size()/stride);
-    for(std::size_t i = 0, max = interleavedCombinedIndexArrays.size()/stride; i != max; ++i) {
-        const UnsignedInt index = interleavedCombinedIndexArrays[offset + i*stride];
+    output.reserve(uniquePositions.size());
+    for(const UnsignedInt position: uniquePositions) {
+        const UnsignedInt index = indices[position];
         CORRADE_ASSERT(index < array.size(), "MeshTools::combineIndexedArrays(): index out of range", );
         output.push_back(array[index]);
     }
@@ -127,11 +172,11 @@ template<class T> void writeCombinedArray(const UnsignedInt stride, const Unsign
 }
 
 /* Terminator for recursive calls */
-inline void writeCombinedArrays(UnsignedInt, UnsignedInt, const std::vector<UnsignedInt>&) {}
+inline void writeCombinedArrays(const std::vector<UnsignedInt>&) {}
 
-template<class T, class ...U> inline void writeCombinedArrays(UnsignedInt stride, UnsignedInt offset, const std::vector<UnsignedInt>& interleavedCombinedIndexArrays, std::vector<T>& first, std::vector<U>&... next) {
-    writeCombinedArray(stride, offset, interleavedCombinedIndexArrays, first);
-    writeCombinedArrays(stride, offset + 1, interleavedCombinedIndexArrays, next...);
+template<class T, class ...U> inline void writeCombinedArrays(const std::vector<UnsignedInt>& uniquePositions, const std::pair<const std::vector<UnsignedInt>&, std::vector<T>&>& first, const std::pair<const std::vector<UnsignedInt>&, std::vector<U>&>&... next) {
+    writeCombinedArray(uniquePositions, first.first, first.second);
+    writeCombinedArrays(uniquePositions, next...);
 }
 
 }
@@ -161,14 +206,15 @@ procedure.
    parameter is index array and which is attribute array, mainly when both are
    of the same type. */
 template<class ...T> std::vector<UnsignedInt> combineIndexedArrays(const std::pair<const std::vector<UnsignedInt>&, std::vector<T>&>&... indexedArrays) {
-    /* Interleave and combine index arrays */
+    /* Combine the index arrays, getting position of the first occurrence of
+       each unique combination */
     std::vector<UnsignedInt> combinedIndices;
-    std::vector<UnsignedInt> interleavedCombinedIndexArrays;
-    auto i = {std::ref(indexedArrays.first)...};
-    std::tie(combinedIndices, interleavedCombinedIndexArrays) = Implementation::interleaveAndCombineIndexArrays(i.begin(), i.end());
+    std::vector<UnsignedInt> uniquePositions;
+    auto i = {std::cref(indexedArrays.first)...};
+    std::tie(combinedIndices, uniquePositions) = Implementation::combineConstIndexArrays(i.begin(), i.end());
 
     /* Write combined arrays */
-    Implementation::writeCombinedArrays(sizeof...(T), 0, interleavedCombinedIndexArrays, indexedArrays.second...);
+    Implementation::writeCombinedArrays(uniquePositions, indexedArrays...);
 
     return combinedIndices;
 }
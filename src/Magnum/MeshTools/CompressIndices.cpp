@@ -27,62 +27,275 @@
 
 #include <cstring>
 #include <Corrade/Containers/Array.h>
-#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Utility/Assert.h>
 
-#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Implementation/sse2.h"
 
 namespace Magnum { namespace MeshTools {
 
 namespace {
 
-template<class T> inline Containers::Array<char> compress(const std::vector<UnsignedInt>& indices) {
-    Containers::Array<char> buffer(indices.size()*sizeof(T));
-    for(std::size_t i = 0; i != indices.size(); ++i) {
-        T index = static_cast<T>(indices[i]);
-        std::memcpy(buffer.begin()+i*sizeof(T), &index, sizeof(T));
+/* Range of contiguous indices. The SSE2 variants process the bulk of the
+   data and return count of processed items, the rest is done by the scalar
+   loop. SSE2 has only signed comparisons for 16- and 32-bit integers, so
+   the values are biased to signed range by flipping the highest bit. */
+template<class T> std::size_t minmaxSse2(const T*, std::size_t, T&, T&) { return 0; }
+
+#ifdef _MAGNUM_USE_SSE2
+template<> std::size_t minmaxSse2<UnsignedInt>(const UnsignedInt* const data, const std::size_t size, UnsignedInt& min, UnsignedInt& max) {
+    if(size < 4) return 0;
+
+    const __m128i bias = _mm_set1_epi32(-2147483647 - 1);
+    __m128i vmin = _mm_set1_epi32(2147483647);
+    __m128i vmax = bias;
+    std::size_t i = 0;
+    for(; i + 4 <= size; i += 4) {
+        const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), bias);
+        const __m128i less = _mm_cmplt_epi32(v, vmin);
+        vmin = _mm_or_si128(_mm_and_si128(less, v), _mm_andnot_si128(less, vmin));
+        const __m128i greater = _mm_cmpgt_epi32(v, vmax);
+        vmax = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, vmax));
     }
 
-    return buffer;
+    UnsignedInt mins[4], maxs[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), _mm_xor_si128(vmin, bias));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maxs), _mm_xor_si128(vmax, bias));
+    for(std::size_t j = 0; j != 4; ++j) {
+        min = Math::min(min, mins[j]);
+        max = Math::max(max, maxs[j]);
+    }
+    return i;
+}
+
+template<> std::size_t minmaxSse2<UnsignedShort>(const UnsignedShort* const data, const std::size_t size, UnsignedShort& min, UnsignedShort& max) {
+    if(size < 8) return 0;
+
+    const __m128i bias = _mm_set1_epi16(-32768);
+    __m128i vmin = _mm_set1_epi16(32767);
+    __m128i vmax = bias;
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), bias);
+        vmin = _mm_min_epi16(vmin, v);
+        vmax = _mm_max_epi16(vmax, v);
+    }
+
+    UnsignedShort mins[8], maxs[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), _mm_xor_si128(vmin, bias));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maxs), _mm_xor_si128(vmax, bias));
+    for(std::size_t j = 0; j != 8; ++j) {
+        min = Math::min(min, mins[j]);
+        max = Math::max(max, maxs[j]);
+    }
+    return i;
+}
+
+template<> std::size_t minmaxSse2<UnsignedByte>(const UnsignedByte* const data, const std::size_t size, UnsignedByte& min, UnsignedByte& max) {
+    if(size < 16) return 0;
+
+    __m128i vmin = _mm_set1_epi8(-1);
+    __m128i vmax = _mm_setzero_si128();
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        vmin = _mm_min_epu8(vmin, v);
+        vmax = _mm_max_epu8(vmax, v);
+    }
+
+    UnsignedByte mins[16], maxs[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(mins), vmin);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maxs), vmax);
+    for(std::size_t j = 0; j != 16; ++j) {
+        min = Math::min(min, mins[j]);
+        max = Math::max(max, maxs[j]);
+    }
+    return i;
+}
+#endif
+
+/* Returns {0, 0} for an empty view */
+template<class T> std::pair<T, T> minmax(const Containers::StridedArrayView<const T>& indices) {
+    if(!indices.size()) return {};
+
+    T min = indices[0], max = indices[0];
+    std::size_t i = 0;
+    if(std::size_t(indices.stride()) == sizeof(T))
+        i = minmaxSse2<T>(&indices[0], indices.size(), min, max);
+    for(; i != indices.size(); ++i) {
+        min = Math::min(min, indices[i]);
+        max = Math::max(max, indices[i]);
+    }
+
+    return {min, max};
+}
+
+/* Narrowing of contiguous indices with base vertex subtraction. Same as
+   above, the SSE2 variants return count of processed items. All loads of
+   an iteration are done before the store, which together with the output
+   type being never larger than the input makes it safe to operate
+   in-place. */
+template<class From, class To> std::size_t narrowSse2(const From*, std::size_t, char*, From) { return 0; }
+
+#ifdef _MAGNUM_USE_SSE2
+template<> std::size_t narrowSse2<UnsignedInt, UnsignedInt>(const UnsignedInt* const data, const std::size_t size, char* const out, const UnsignedInt base) {
+    const __m128i vbase = _mm_set1_epi32(Int(base));
+    std::size_t i = 0;
+    for(; i + 4 <= size; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*4), _mm_sub_epi32(v, vbase));
+    }
+    return i;
+}
+
+template<> std::size_t narrowSse2<UnsignedInt, UnsignedShort>(const UnsignedInt* const data, const std::size_t size, char* const out, const UnsignedInt base) {
+    /* There's only a signed saturating pack in SSE2, so shift the range to
+       signed before packing and back after. Adding in unsigned arithmetic
+       as the base can be arbitrarily large. */
+    const __m128i vbase = _mm_set1_epi32(Int(base + 32768u));
+    const __m128i bias = _mm_set1_epi16(-32768);
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        const __m128i a = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), vbase);
+        const __m128i b = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4)), vbase);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*2), _mm_xor_si128(_mm_packs_epi32(a, b), bias));
+    }
+    return i;
+}
+
+template<> std::size_t narrowSse2<UnsignedInt, UnsignedByte>(const UnsignedInt* const data, const std::size_t size, char* const out, const UnsignedInt base) {
+    const __m128i vbase = _mm_set1_epi32(Int(base));
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16) {
+        const __m128i a = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), vbase);
+        const __m128i b = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4)), vbase);
+        const __m128i c = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 8)), vbase);
+        const __m128i d = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12)), vbase);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    }
+    return i;
+}
+
+template<> std::size_t narrowSse2<UnsignedShort, UnsignedShort>(const UnsignedShort* const data, const std::size_t size, char* const out, const UnsignedShort base) {
+    const __m128i vbase = _mm_set1_epi16(Short(base));
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*2), _mm_sub_epi16(v, vbase));
+    }
+    return i;
+}
+
+template<> std::size_t narrowSse2<UnsignedShort, UnsignedByte>(const UnsignedShort* const data, const std::size_t size, char* const out, const UnsignedShort base) {
+    const __m128i vbase = _mm_set1_epi16(Short(base));
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16) {
+        const __m128i a = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), vbase);
+        const __m128i b = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 8)), vbase);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(a, b));
+    }
+    return i;
+}
+
+template<> std::size_t narrowSse2<UnsignedByte, UnsignedByte>(const UnsignedByte* const data, const std::size_t size, char* const out, const UnsignedByte base) {
+    const __m128i vbase = _mm_set1_epi8(Byte(base));
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_sub_epi8(v, vbase));
+    }
+    return i;
+}
+#endif
+
+template<class From, class To> void narrow(const Containers::StridedArrayView<const From>& indices, char* const out, const From base) {
+    std::size_t i = 0;
+    if(indices.size() && std::size_t(indices.stride()) == sizeof(From))
+        i = narrowSse2<From, To>(&indices[0], indices.size(), out, base);
+    for(; i != indices.size(); ++i) {
+        const To index = To(indices[i] - base);
+        std::memcpy(out + i*sizeof(To), &index, sizeof(To));
+    }
+}
+
+template<class T> std::tuple<MeshIndexType, UnsignedInt, UnsignedInt> compressInto(const Containers::StridedArrayView<const T>& indices, const Containers::ArrayView<char> out, const bool subtractBaseVertex) {
+    const std::pair<T, T> minmax = MeshTools::minmax(indices);
+    const T base = subtractBaseVertex ? minmax.first : T(0);
+    const UnsignedInt max = minmax.second - base;
+
+    MeshIndexType type;
+    std::size_t typeSize;
+    if(max <= 0xff) {
+        type = MeshIndexType::UnsignedByte;
+        typeSize = 1;
+    } else if(max <= 0xffff) {
+        type = MeshIndexType::UnsignedShort;
+        typeSize = 2;
+    } else {
+        type = MeshIndexType::UnsignedInt;
+        typeSize = 4;
+    }
+
+    CORRADE_ASSERT(out.size() >= indices.size()*typeSize,
+        "MeshTools::compressIndicesInto(): expected at least" << indices.size()*typeSize << "bytes for the output but got" << out.size(), {});
+
+    if(typeSize == 1)
+        narrow<T, UnsignedByte>(indices, out, base);
+    else if(typeSize == 2)
+        narrow<T, UnsignedShort>(indices, out, base);
+    else
+        narrow<T, UnsignedInt>(indices, out, base);
+
+    return std::make_tuple(type, UnsignedInt(minmax.first), UnsignedInt(minmax.second));
 }
 
 }
 
 std::tuple<Containers::Array<char>, MeshIndexType, UnsignedInt, UnsignedInt> compressIndices(const std::vector<UnsignedInt>& indices) {
-    /** @todo Performance hint when range can be represented by smaller value? */
-    const auto minmax = Math::minmax<UnsignedInt>(indices);
+    const Containers::StridedArrayView<const UnsignedInt> view{indices.data(), indices.size(), sizeof(UnsignedInt)};
+    const std::pair<UnsignedInt, UnsignedInt> minmax = MeshTools::minmax(view);
+
     Containers::Array<char> data;
     MeshIndexType type;
-    switch(Math::log(256, minmax.second)) {
-        case 0:
-            data = compress<UnsignedByte>(indices);
-            type = MeshIndexType::UnsignedByte;
-            break;
-        case 1:
-            data = compress<UnsignedShort>(indices);
-            type = MeshIndexType::UnsignedShort;
-            break;
-        case 2:
-        case 3:
-            data = compress<UnsignedInt>(indices);
-            type = MeshIndexType::UnsignedInt;
-            break;
-
-        default:
-            CORRADE_ASSERT(false, "MeshTools::compressIndices(): no type able to index" << minmax.second << "elements.", {});
+    if(minmax.second <= 0xff) {
+        data = Containers::Array<char>{Containers::NoInit, indices.size()};
+        narrow<UnsignedInt, UnsignedByte>(view, data, 0);
+        type = MeshIndexType::UnsignedByte;
+    } else if(minmax.second <= 0xffff) {
+        data = Containers::Array<char>{Containers::NoInit, indices.size()*2};
+        narrow<UnsignedInt, UnsignedShort>(view, data, 0);
+        type = MeshIndexType::UnsignedShort;
+    } else {
+        data = Containers::Array<char>{Containers::NoInit, indices.size()*4};
+        narrow<UnsignedInt, UnsignedInt>(view, data, 0);
+        type = MeshIndexType::UnsignedInt;
     }
 
     return std::make_tuple(std::move(data), type, minmax.first, minmax.second);
 }
 
+std::tuple<MeshIndexType, UnsignedInt, UnsignedInt> compressIndicesInto(const Containers::StridedArrayView<const UnsignedInt>& indices, const Containers::ArrayView<char> out, const bool subtractBaseVertex) {
+    return compressInto(indices, out, subtractBaseVertex);
+}
+
+std::tuple<MeshIndexType, UnsignedInt, UnsignedInt> compressIndicesInto(const Containers::StridedArrayView<const UnsignedShort>& indices, const Containers::ArrayView<char> out, const bool subtractBaseVertex) {
+    return compressInto(indices, out, subtractBaseVertex);
+}
+
+std::tuple<MeshIndexType, UnsignedInt, UnsignedInt> compressIndicesInto(const Containers::StridedArrayView<const UnsignedByte>& indices, const Containers::ArrayView<char> out, const bool subtractBaseVertex) {
+    return compressInto(indices, out, subtractBaseVertex);
+}
+
 template<class T> Containers::Array<T> compressIndicesAs(const std::vector<UnsignedInt>& indices) {
+    const Containers::StridedArrayView<const UnsignedInt> view{indices.data(), indices.size(), sizeof(UnsignedInt)};
+
     #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
-    const auto max = Math::max<UnsignedInt>(indices);
+    const UnsignedInt max = MeshTools::minmax(view).second;
     CORRADE_ASSERT(Math::log(256, max) < sizeof(T), "MeshTools::compressIndicesAs(): type too small to represent value" << max, {});
     #endif
 
-    Containers::Array<T> buffer(indices.size());
-    for(std::size_t i = 0; i != indices.size(); ++i)
-        buffer[i] = T(indices[i]);
+    Containers::Array<T> buffer{Containers::NoInit, indices.size()};
+    narrow<UnsignedInt, T>(view, reinterpret_cast<char*>(buffer.data()), 0);
 
     return buffer;
 }
@@ -26,11 +26,13 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compressIndices()
+ * @brief Function @ref Magnum::MeshTools::compressIndices(), @ref Magnum::MeshTools::compressIndicesInto(), @ref Magnum::MeshTools::compressIndicesAs()
  */
 
 #include <tuple>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshTools/visibility.h"
@@ -51,11 +53,77 @@ Example usage:
 
 @snippet MagnumMeshTools.cpp compressIndices
 
-@see @ref compressIndicesAs()
+@see @ref compressIndicesAs(),
+    @ref compressIndicesInto(const Containers::StridedArrayView<const UnsignedInt>&, Containers::ArrayView<char>, bool)
 @todo Extract IndexType out of Mesh class
 */
 std::tuple<Containers::Array<char>, MeshIndexType, UnsignedInt, UnsignedInt> MAGNUM_MESHTOOLS_EXPORT compressIndices(const std::vector<UnsignedInt>& indices);
 
+/**
+@brief Compress vertex indices into a caller-provided buffer
+@param[in] indices      Index array
+@param[out] out         Output buffer
+@param[in] subtractBaseVertex Whether to subtract the smallest index from all
+    indices
+@return Index type, smallest and largest index in @p indices
+
+Like @ref compressIndices(const std::vector<UnsignedInt>&), but takes a
+potentially strided view on the indices and writes the result to @p out
+instead of allocating a new array. The output is @p indices size times size
+of the returned type, which is never larger than the input type, so a buffer
+of the same size as @p indices is always enough. If @p indices are
+contiguous, @p out can point to the same memory, in which case the
+compression is done in-place.
+
+If @p subtractBaseVertex is @cpp true @ce, the smallest index is subtracted
+from all indices and the type is chosen based on the index range instead of
+the largest index. The mesh is then expected to be drawn with the smallest
+index as a base vertex, for example using @ref GL::Mesh::setBaseVertex().
+That allows meshes with large vertex buffers but small index ranges to use
+smaller index types:
+
+@snippet MagnumMeshTools.cpp compressIndicesInto
+
+On x86 the range calculation and narrowing is done with SSE2 if
+@p indices are contiguous, strided views are processed with a scalar loop.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<MeshIndexType, UnsignedInt, UnsignedInt> compressIndicesInto(const Containers::StridedArrayView<const UnsignedInt>& indices, Containers::ArrayView<char> out, bool subtractBaseVertex = false);
+
+/**
+ * @overload
+ *
+ * The output is never larger than @ref Magnum::UnsignedShort "UnsignedShort".
+ */
+MAGNUM_MESHTOOLS_EXPORT std::tuple<MeshIndexType, UnsignedInt, UnsignedInt> compressIndicesInto(const Containers::StridedArrayView<const UnsignedShort>& indices, Containers::ArrayView<char> out, bool subtractBaseVertex = false);
+
+/**
+ * @overload
+ *
+ * The output is always @ref Magnum::UnsignedByte "UnsignedByte", so this is
+ * useful mainly for copying data from a strided view or subtracting the base
+ * vertex.
+ */
+MAGNUM_MESHTOOLS_EXPORT std::tuple<MeshIndexType, UnsignedInt, UnsignedInt> compressIndicesInto(const Containers::StridedArrayView<const UnsignedByte>& indices, Containers::ArrayView<char> out, bool subtractBaseVertex = false);
+
+/**
+ * @overload
+ *
+ * Convenience overload for contiguous index arrays.
+ */
+inline std::tuple<MeshIndexType, UnsignedInt, UnsignedInt> compressIndicesInto(Containers::ArrayView<const UnsignedInt> indices, Containers::ArrayView<char> out, bool subtractBaseVertex = false) {
+    return compressIndicesInto(Containers::StridedArrayView<const UnsignedInt>{indices.data(), indices.size(), sizeof(UnsignedInt)}, out, subtractBaseVertex);
+}
+
+/** @overload */
+inline std::tuple<MeshIndexType, UnsignedInt, UnsignedInt> compressIndicesInto(Containers::ArrayView<const UnsignedShort> indices, Containers::ArrayView<char> out, bool subtractBaseVertex = false) {
+    return compressIndicesInto(Containers::StridedArrayView<const UnsignedShort>{indices.data(), indices.size(), sizeof(UnsignedShort)}, out, subtractBaseVertex);
+}
+
+/** @overload */
+inline std::tuple<MeshIndexType, UnsignedInt, UnsignedInt> compressIndicesInto(Containers::ArrayView<const UnsignedByte> indices, Containers::ArrayView<char> out, bool subtractBaseVertex = false) {
+    return compressIndicesInto(Containers::StridedArrayView<const UnsignedByte>{indices.data(), indices.size(), sizeof(UnsignedByte)}, out, subtractBaseVertex);
+}
+
 /**
 @brief Compress vertex indices as given type
 
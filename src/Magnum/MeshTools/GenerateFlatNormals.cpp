@@ -55,4 +55,23 @@ std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateFlatNormals(c
     return std::make_tuple(std::move(normalIndices), std::move(normals));
 }
 
+void generateFlatNormalsInto(const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<Vector3> normals) {
+    CORRADE_ASSERT(positions.size() % 3 == 0,
+        "MeshTools::generateFlatNormalsInto(): position count is not divisible by 3", );
+    CORRADE_ASSERT(normals.size() == positions.size(),
+        "MeshTools::generateFlatNormalsInto(): expected" << positions.size() << "normals but got" << normals.size(), );
+
+    for(std::size_t i = 0; i != positions.size(); i += 3) {
+        const Vector3 normal = Math::cross(positions[i + 2] - positions[i + 1],
+                                           positions[i] - positions[i + 1]).normalized();
+        normals[i] = normals[i + 1] = normals[i + 2] = normal;
+    }
+}
+
+std::vector<Vector3> generateFlatNormals(const Containers::ArrayView<const Vector3> positions) {
+    std::vector<Vector3> normals(positions.size());
+    generateFlatNormalsInto(positions, {normals.data(), normals.size()});
+    return normals;
+}
+
 }}
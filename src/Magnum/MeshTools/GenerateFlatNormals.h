@@ -26,11 +26,12 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::generateFlatNormals()
+ * @brief Function @ref Magnum::MeshTools::generateFlatNormals(), @ref Magnum::MeshTools::generateFlatNormalsInto()
  */
 
 #include <tuple>
 #include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/MeshTools/visibility.h"
@@ -54,11 +55,45 @@ order to have a single index array for both vertices and normals:
 
 @snippet MagnumMeshTools.cpp generateFlatNormals-recombine
 
+If you don't need the normals deduplicated, it's faster to expand the
+positions using @ref duplicate() and then use
+@ref generateFlatNormals(Containers::ArrayView<const Vector3>), which doesn't
+need any deduplication pass and results in a single index array directly.
+
 @attention The function requires the mesh to have triangle faces, thus index
     count must be divisible by 3.
+@see @ref generateSmoothNormals()
 */
 std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> MAGNUM_MESHTOOLS_EXPORT generateFlatNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions);
 
+/**
+@brief Generate flat normals for a non-indexed mesh into an existing array
+@param[in] positions    Triangle vertex positions, three for each face
+@param[out] normals     Where to put the generated normals
+
+All three vertices of each face get the same normal, assuming
+counterclockwise winding. The @p positions are expected to have a size
+divisible by 3 and @p normals are expected to have the same size as
+@p positions. No deduplication is done and nothing is allocated.
+@see @ref generateSmoothNormalsInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void generateFlatNormalsInto(Containers::ArrayView<const Vector3> positions, Containers::ArrayView<Vector3> normals);
+
+/**
+@brief Generate flat normals for a non-indexed mesh
+@param positions    Triangle vertex positions, three for each face
+@return One normal for each item in @p positions
+
+Allocates the output and calls @ref generateFlatNormalsInto(). Unlike
+@ref generateFlatNormals(const std::vector<UnsignedInt>&, const std::vector<Vector3>&)
+this doesn't do any deduplication, the normals correspond to the positions
+1:1. An indexed mesh can be converted to a non-indexed one using
+@ref duplicate():
+
+@snippet MagnumMeshTools.cpp generateFlatNormals-nonindexed
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Vector3> generateFlatNormals(Containers::ArrayView<const Vector3> positions);
+
 }}
 
 #endif
@@ -0,0 +1,96 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateSmoothNormals.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Implementation/parallel.h"
+#include "Magnum/MeshTools/Implementation/vertexCorners.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Below this vertex count it's not worth spawning threads */
+constexpr std::size_t MinVerticesPerThread = 16384;
+
+}
+
+void generateSmoothNormalsInto(const Containers::ArrayView<const UnsignedInt> indices, const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<Vector3> normals, const NormalWeighting weighting, UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::generateSmoothNormalsInto(): index count is not divisible by 3", );
+    CORRADE_ASSERT(normals.size() == positions.size(),
+        "MeshTools::generateSmoothNormalsInto(): expected" << positions.size() << "normals but got" << normals.size(), );
+
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::generateSmoothNormalsInto(): index" << index << "out of bounds for" << positions.size() << "elements", );
+    #endif
+
+    const Implementation::VertexCorners vertexCorners{indices, positions.size()};
+    threadCount = Implementation::effectiveThreadCount(threadCount, positions.size(), MinVerticesPerThread);
+    Implementation::parallelFor(threadCount, positions.size(), [&](const std::size_t begin, const std::size_t end, UnsignedInt) {
+        for(std::size_t i = begin; i != end; ++i) {
+            Vector3 normal;
+            for(std::size_t j = vertexCorners.begin(i); j != vertexCorners.end(i); ++j) {
+                /* Edges going from the vertex to the next and previous vertex
+                   of the face, giving a counterclockwise normal */
+                const UnsignedInt corner = vertexCorners.corners[j];
+                const UnsignedInt face = corner - corner%3;
+                const Vector3 position = positions[indices[corner]];
+                const Vector3 next = positions[indices[face + (corner + 1)%3]] - position;
+                const Vector3 previous = positions[indices[face + (corner + 2)%3]] - position;
+                const Vector3 faceNormal = Math::cross(next, previous);
+
+                /* The cross product length is twice the face area. For angle
+                   weighting the angle is calculated from the cross product
+                   and dot product, which is more robust than acos() for
+                   small angles. */
+                if(weighting == NormalWeighting::Area) {
+                    normal += faceNormal;
+                } else {
+                    const Float length = faceNormal.length();
+                    if(length == 0.0f) continue;
+                    normal += faceNormal*(std::atan2(length, Math::dot(next, previous))/length);
+                }
+            }
+
+            const Float length = normal.length();
+            normals[i] = length == 0.0f ? Vector3{} : normal/length;
+        }
+    });
+}
+
+std::vector<Vector3> generateSmoothNormals(const Containers::ArrayView<const UnsignedInt> indices, const Containers::ArrayView<const Vector3> positions, const NormalWeighting weighting, const UnsignedInt threadCount) {
+    std::vector<Vector3> normals(positions.size());
+    generateSmoothNormalsInto(indices, positions, {normals.data(), normals.size()}, weighting, threadCount);
+    return normals;
+}
+
+}}
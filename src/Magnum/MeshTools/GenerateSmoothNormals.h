@@ -0,0 +1,110 @@
+#ifndef Magnum_MeshTools_GenerateSmoothNormals_h
+#define Magnum_MeshTools_GenerateSmoothNormals_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateSmoothNormals(), @ref Magnum::MeshTools::generateSmoothNormalsInto(), enum @ref Magnum::MeshTools::NormalWeighting
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Face normal weighting
+
+@see @ref generateSmoothNormals()
+*/
+enum class NormalWeighting: UnsignedByte {
+    /**
+     * Each face normal is weighted by the angle the face has at given
+     * vertex. The result doesn't depend on how the surface is triangulated,
+     * so this is the default.
+     */
+    Angle,
+
+    /**
+     * Each face normal is weighted by area of the face. Cheaper to calculate
+     * than @ref NormalWeighting::Angle, but long thin triangles can skew the
+     * result.
+     */
+    Area
+};
+
+/**
+@brief Generate smooth normals into an existing array
+@param[in] indices      Triangle face indices
+@param[in] positions    Vertex positions
+@param[out] normals     Where to put the generated normals
+@param[in] weighting    Face normal weighting
+@param[in] threadCount  Count of threads to use, including the calling one.
+    If @cpp 0 @ce, @ref std::thread::hardware_concurrency() is used.
+
+For each vertex sums normals of all faces that reference it, weighted
+according to @p weighting, and normalizes the result. Assumes counterclockwise
+winding, the same as @ref generateFlatNormals(). Vertices that aren't
+referenced by any face or are referenced only by degenerate faces get a zero
+normal. Vertices on hard edges need to be duplicated beforehand, as each
+vertex gets exactly one normal.
+
+The @p indices are expected to have a size divisible by 3 and all indices
+are expected to be in bounds of @p positions, @p normals are expected to have
+the same size as @p positions.
+
+The face references are first bucketed per vertex, which is the only
+allocation done. The vertices are then processed in parallel, each summing
+its faces in the order they appear in @p indices, so the output is exactly
+the same regardless of @p threadCount. Small meshes are always processed on a
+single thread.
+@see @ref generateFlatNormalsInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void generateSmoothNormalsInto(Containers::ArrayView<const UnsignedInt> indices, Containers::ArrayView<const Vector3> positions, Containers::ArrayView<Vector3> normals, NormalWeighting weighting = NormalWeighting::Angle, UnsignedInt threadCount = 0);
+
+/**
+@brief Generate smooth normals
+@param indices      Triangle face indices
+@param positions    Vertex positions
+@param weighting    Face normal weighting
+@param threadCount  Count of threads to use, including the calling one. If
+    @cpp 0 @ce, @ref std::thread::hardware_concurrency() is used.
+@return One normal for each item in @p positions
+
+Allocates the output and calls @ref generateSmoothNormalsInto(), see its
+documentation for details. Unlike @ref generateFlatNormals(), the resulting
+normals can be indexed using the same index array as the positions. Example
+usage:
+
+@snippet MagnumMeshTools.cpp generateSmoothNormals
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Vector3> generateSmoothNormals(Containers::ArrayView<const UnsignedInt> indices, Containers::ArrayView<const Vector3> positions, NormalWeighting weighting = NormalWeighting::Angle, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
@@ -0,0 +1,138 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateTangents.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshTools/Implementation/parallel.h"
+#include "Magnum/MeshTools/Implementation/vertexCorners.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Below this vertex count it's not worth spawning threads */
+constexpr std::size_t MinVerticesPerThread = 16384;
+
+/* Projects the vector onto a plane given by the normal, normalizing it if
+   non-zero -- same as the reference implementation */
+inline Vector3 projectNormalized(const Vector3& vector, const Vector3& normal) {
+    const Vector3 projected = vector - normal*Math::dot(normal, vector);
+    const Float length = projected.length();
+    return length == 0.0f ? projected : projected/length;
+}
+
+}
+
+void generateTangentsInto(const Containers::ArrayView<const UnsignedInt> indices, const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals, const Containers::ArrayView<const Vector2> textureCoordinates, const Containers::ArrayView<Vector4> tangents, UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::generateTangentsInto(): index count is not divisible by 3", );
+    CORRADE_ASSERT(normals.size() == positions.size(),
+        "MeshTools::generateTangentsInto(): expected" << positions.size() << "normals but got" << normals.size(), );
+    CORRADE_ASSERT(textureCoordinates.size() == positions.size(),
+        "MeshTools::generateTangentsInto(): expected" << positions.size() << "texture coordinates but got" << textureCoordinates.size(), );
+    CORRADE_ASSERT(tangents.size() == positions.size(),
+        "MeshTools::generateTangentsInto(): expected" << positions.size() << "tangents but got" << tangents.size(), );
+
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::generateTangentsInto(): index" << index << "out of bounds for" << positions.size() << "elements", );
+    #endif
+
+    const Implementation::VertexCorners vertexCorners{indices, positions.size()};
+    threadCount = Implementation::effectiveThreadCount(threadCount, positions.size(), MinVerticesPerThread);
+    Implementation::parallelFor(threadCount, positions.size(), [&](const std::size_t begin, const std::size_t end, UnsignedInt) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const Vector3& normal = normals[i];
+            Vector3 tangent;
+            Float handedness = 0.0f;
+            for(std::size_t j = vertexCorners.begin(i); j != vertexCorners.end(i); ++j) {
+                const UnsignedInt corner = vertexCorners.corners[j];
+                const UnsignedInt face = corner - corner%3;
+                const UnsignedInt a = indices[face], b = indices[face + 1], c = indices[face + 2];
+
+                /* Face direction in which the first texture coordinate grows.
+                   The vector is scaled by the signed texture coordinate area,
+                   flip it back if the area is negative. Faces with zero area
+                   don't contribute. */
+                const Vector3 d1 = positions[b] - positions[a];
+                const Vector3 d2 = positions[c] - positions[a];
+                const Vector2 st1 = textureCoordinates[b] - textureCoordinates[a];
+                const Vector2 st2 = textureCoordinates[c] - textureCoordinates[a];
+                const Float area = st1.x()*st2.y() - st1.y()*st2.x();
+                if(area == 0.0f) continue;
+                const Vector3 faceTangent = projectNormalized(area > 0.0f ?
+                    st2.y()*d1 - st1.y()*d2 :
+                    st1.y()*d2 - st2.y()*d1, normal);
+                if(faceTangent.isZero()) continue;
+
+                /* Angle between the edges going to the previous and next
+                   vertex of the face, projected onto the normal plane */
+                const Vector3& position = positions[indices[corner]];
+                const Vector3 previous = projectNormalized(positions[indices[face + (corner + 2)%3]] - position, normal);
+                const Vector3 next = projectNormalized(positions[indices[face + (corner + 1)%3]] - position, normal);
+                const Float angle = std::acos(Math::clamp(Math::dot(previous, next), -1.0f, 1.0f));
+
+                tangent += faceTangent*angle;
+                handedness += area > 0.0f ? angle : -angle;
+            }
+
+            /* If nothing contributed, pick an arbitrary vector perpendicular
+               to the normal */
+            const Float length = tangent.length();
+            if(length == 0.0f) {
+                tangent = projectNormalized(Math::abs(normal.x()) < 0.9f ?
+                    Vector3::xAxis() : Vector3::yAxis(), normal);
+                handedness = 1.0f;
+            } else tangent /= length;
+
+            tangents[i] = {tangent, handedness < 0.0f ? -1.0f : 1.0f};
+        }
+    });
+}
+
+std::vector<Vector4> generateTangents(const Containers::ArrayView<const UnsignedInt> indices, const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals, const Containers::ArrayView<const Vector2> textureCoordinates, const UnsignedInt threadCount) {
+    std::vector<Vector4> tangents(positions.size());
+    generateTangentsInto(indices, positions, normals, textureCoordinates, {tangents.data(), tangents.size()}, threadCount);
+    return tangents;
+}
+
+std::vector<Vector4> generateTangents(const Trade::MeshData3D& mesh, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles && mesh.isIndexed(),
+        "MeshTools::generateTangents(): expected an indexed triangle mesh", {});
+    CORRADE_ASSERT(mesh.hasNormals() && mesh.hasTextureCoords2D(),
+        "MeshTools::generateTangents(): expected a mesh with normals and texture coordinates", {});
+
+    return generateTangents(mesh.indices(), mesh.positions(0), mesh.normals(0), mesh.textureCoords2D(0), threadCount);
+}
+
+}}
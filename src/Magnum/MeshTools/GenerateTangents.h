@@ -0,0 +1,112 @@
+#ifndef Magnum_MeshTools_GenerateTangents_h
+#define Magnum_MeshTools_GenerateTangents_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateTangents(), @ref Magnum::MeshTools::generateTangentsInto()
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Generate tangents into an existing array
+@param[in] indices      Triangle face indices
+@param[in] positions    Vertex positions
+@param[in] normals      Vertex normals
+@param[in] textureCoordinates Vertex texture coordinates
+@param[out] tangents    Where to put the generated tangents
+@param[in] threadCount  Count of threads to use, including the calling one.
+    If @cpp 0 @ce, @ref std::thread::hardware_concurrency() is used.
+
+Calculates a tangent for each vertex following the
+[MikkTSpace](http://www.mikktspace.com/) reference implementation, which is
+the tangent space most tools bake normal maps in. The XYZ components of
+the tangent are normalized and orthogonal to the normal, the W component
+contains the handedness, either @cpp 1.0f @ce or @cpp -1.0f @ce, and the
+bitangent can be calculated as @cpp tangent.w()*Math::cross(normal, tangent.xyz()) @ce.
+
+For each face corner, the direction in which the first texture coordinate
+grows is projected onto the plane given by the vertex normal and weighted
+by the angle the face has at given vertex, the same as with
+@ref NormalWeighting::Angle. Faces with degenerate texture coordinates or
+positions don't contribute. Vertices that have no contributing faces get an
+arbitrary tangent perpendicular to the normal and a positive handedness.
+
+Unlike MikkTSpace, which splits vertices that have faces with different
+handedness or a tangent space discontinuity, the output has exactly one
+tangent for each vertex, so such vertices need to be duplicated beforehand
+in order to get the same result. Otherwise the handedness of the faces with
+the largest angle sum wins.
+
+The @p indices are expected to have a size divisible by 3 and all indices
+are expected to be in bounds. @p normals, @p textureCoordinates and
+@p tangents are expected to have the same size as @p positions. Similarly to
+@ref generateSmoothNormalsInto(), the vertices are processed in parallel,
+each summing its faces in the order they appear in @p indices, so the output
+is the same regardless of @p threadCount.
+*/
+MAGNUM_MESHTOOLS_EXPORT void generateTangentsInto(Containers::ArrayView<const UnsignedInt> indices, Containers::ArrayView<const Vector3> positions, Containers::ArrayView<const Vector3> normals, Containers::ArrayView<const Vector2> textureCoordinates, Containers::ArrayView<Vector4> tangents, UnsignedInt threadCount = 0);
+
+/**
+@brief Generate tangents
+@param indices      Triangle face indices
+@param positions    Vertex positions
+@param normals      Vertex normals
+@param textureCoordinates Vertex texture coordinates
+@param threadCount  Count of threads to use, including the calling one. If
+    @cpp 0 @ce, @ref std::thread::hardware_concurrency() is used.
+@return One tangent for each item in @p positions
+
+Allocates the output and calls @ref generateTangentsInto(), see its
+documentation for details. The result can be directly interleaved with other
+vertex attributes:
+
+@snippet MagnumMeshTools.cpp generateTangents
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Vector4> generateTangents(Containers::ArrayView<const UnsignedInt> indices, Containers::ArrayView<const Vector3> positions, Containers::ArrayView<const Vector3> normals, Containers::ArrayView<const Vector2> textureCoordinates, UnsignedInt threadCount = 0);
+
+/**
+@brief Generate tangents for a mesh
+
+Calls @ref generateTangents(Containers::ArrayView<const UnsignedInt>, Containers::ArrayView<const Vector3>, Containers::ArrayView<const Vector3>, Containers::ArrayView<const Vector2>, UnsignedInt)
+with the index array and the first position, normal and texture coordinate
+array of @p mesh. Expects that the mesh is indexed, has
+@ref MeshPrimitive::Triangles and contains normals and texture coordinates.
+Normals can be generated using @ref generateSmoothNormals() if the mesh
+doesn't have them.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Vector4> generateTangents(const Trade::MeshData3D& mesh, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef Magnum_MeshTools_Implementation_parallel_h
+#define Magnum_MeshTools_Implementation_parallel_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Count of threads to use for processing itemCount items. If requested is
+   zero, std::thread::hardware_concurrency() is used. The result is clamped
+   so each thread gets at least minItemsPerThread items, as for small inputs
+   the cost of spawning threads outweighs any gains. */
+inline UnsignedInt effectiveThreadCount(UnsignedInt requested, const std::size_t itemCount, const std::size_t minItemsPerThread) {
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    if(!requested) requested = std::max(std::thread::hardware_concurrency(), 1u);
+    #else
+    requested = 1;
+    #endif
+    return UnsignedInt(std::max(std::min(std::size_t(requested), itemCount/minItemsPerThread), std::size_t{1}));
+}
+
+/* Splits [0, itemCount) into threadCount contiguous ranges and calls
+   function(begin, end, rangeId) for each. The first range is processed on
+   the calling thread, the function returns after all ranges are done. */
+template<class Function> void parallelFor(const UnsignedInt threadCount, const std::size_t itemCount, Function&& function) {
+    const std::size_t rangeSize = (itemCount + threadCount - 1)/threadCount;
+    auto range = [&](const UnsignedInt id) {
+        const std::size_t begin = std::min(id*rangeSize, itemCount);
+        const std::size_t end = std::min(begin + rangeSize, itemCount);
+        function(begin, end, id);
+    };
+
+    std::vector<std::thread> threads;
+    if(threadCount > 1) threads.reserve(threadCount - 1);
+    for(UnsignedInt i = 1; i < threadCount; ++i)
+        threads.emplace_back(range, i);
+    range(0);
+    for(std::thread& thread: threads) thread.join();
+}
+
+}}}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef Magnum_MeshTools_Implementation_vertexCorners_h
+#define Magnum_MeshTools_Implementation_vertexCorners_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Buckets face corners (i.e., positions in the index array) by the vertex
+   they reference, in the order they appear in the index array. Offsets of
+   the buckets are calculated from vertex use counts, after filling them they
+   point to the end of each bucket, so corners of vertex i are
+   corners[i ? offsets[i - 1] : 0] to corners[offsets[i]]. The indices are
+   expected to be in bounds. Used by algorithms that need to sum per-face
+   contributions for each vertex in a deterministic order independently of
+   how the vertices are split among threads. */
+struct VertexCorners {
+    explicit VertexCorners(const Containers::ArrayView<const UnsignedInt> indices, const std::size_t vertexCount): offsets{Containers::ValueInit, vertexCount + 1}, corners{Containers::NoInit, indices.size()} {
+        for(const UnsignedInt index: indices) ++offsets[index + 1];
+        for(std::size_t i = 0; i != vertexCount; ++i)
+            offsets[i + 1] += offsets[i];
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            corners[offsets[indices[i]]++] = i;
+    }
+
+    std::size_t begin(const std::size_t vertex) const {
+        return vertex ? offsets[vertex - 1] : 0;
+    }
+
+    std::size_t end(const std::size_t vertex) const {
+        return offsets[vertex];
+    }
+
+    Containers::Array<UnsignedInt> offsets;
+    Containers::Array<UnsignedInt> corners;
+};
+
+}}}
+
+#endif
@@ -0,0 +1,326 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Interleave.h"
+
+#include <limits>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+
+namespace Magnum { namespace MeshTools {
+
+UnsignedInt attributeFormatSize(const AttributeFormat format) {
+    switch(format) {
+        case AttributeFormat::UnsignedByte:
+        case AttributeFormat::UnsignedByteNormalized:
+        case AttributeFormat::Byte:
+        case AttributeFormat::ByteNormalized:
+            return 1;
+        case AttributeFormat::Half:
+        case AttributeFormat::UnsignedShort:
+        case AttributeFormat::UnsignedShortNormalized:
+        case AttributeFormat::Short:
+        case AttributeFormat::ShortNormalized:
+            return 2;
+        case AttributeFormat::Float:
+        case AttributeFormat::UnsignedInt:
+        case AttributeFormat::Int:
+            return 4;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+Debug& operator<<(Debug& debug, const AttributeFormat value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case AttributeFormat::value: return debug << "MeshTools::AttributeFormat::" #value;
+        _c(Float)
+        _c(Half)
+        _c(UnsignedByte)
+        _c(UnsignedByteNormalized)
+        _c(Byte)
+        _c(ByteNormalized)
+        _c(UnsignedShort)
+        _c(UnsignedShortNormalized)
+        _c(Short)
+        _c(ShortNormalized)
+        _c(UnsignedInt)
+        _c(Int)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "MeshTools::AttributeFormat(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+#endif
+
+namespace {
+
+/* Vertices are processed in blocks. A block of the interleaved buffer should
+   stay in L1 while all attributes are written to it (or read from it), and
+   the per-attribute scratch below has to fit the largest block. */
+constexpr std::size_t MaxBlockSize = 256;
+constexpr std::size_t BlockBytes = 16384;
+
+/* Strided item copy. Items are at most 16 bytes, so the common sizes get a
+   memcpy() with a compile-time size that compiles down to plain moves. */
+template<std::size_t size> void copyItems(const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, src += srcStride, dst += dstStride)
+        std::memcpy(dst, src, size);
+}
+
+void copyItems(const char* const src, const std::ptrdiff_t srcStride, char* const dst, const std::ptrdiff_t dstStride, const std::size_t size, const std::size_t count) {
+    switch(size) {
+        case 1: return copyItems<1>(src, srcStride, dst, dstStride, count);
+        case 2: return copyItems<2>(src, srcStride, dst, dstStride, count);
+        case 3: return copyItems<3>(src, srcStride, dst, dstStride, count);
+        case 4: return copyItems<4>(src, srcStride, dst, dstStride, count);
+        case 6: return copyItems<6>(src, srcStride, dst, dstStride, count);
+        case 8: return copyItems<8>(src, srcStride, dst, dstStride, count);
+        case 12: return copyItems<12>(src, srcStride, dst, dstStride, count);
+        case 16: return copyItems<16>(src, srcStride, dst, dstStride, count);
+    }
+
+    /* Not reachable with component counts and formats validated by the
+       callers, kept for robustness */
+    const char* s = src;
+    char* d = dst;
+    for(std::size_t i = 0; i != count; ++i, s += srcStride, d += dstStride)
+        std::memcpy(d, s, size);
+}
+
+/* Conversions of contiguous components, the normalized and half-float ones
+   are done by the batch functions in Math */
+template<class T> void packNormalized(const Float* const data, const std::size_t size, char* const out) {
+    Math::packInto(Containers::StridedArrayView<const Float>{data, size, sizeof(Float)}, Containers::StridedArrayView<T>{reinterpret_cast<T*>(out), size, sizeof(T)});
+}
+
+/* Float to integer conversion is undefined for values that don't fit into the
+   type, so they're saturated first. NaNs end up at the lower bound, the same
+   as in Math::packInto(). For 32-bit types the float upper bound is rounded
+   up to a power of two, so everything below it fits. */
+template<class T> void packCast(const Float* const data, const std::size_t size, char* const out) {
+    constexpr Float min = Float(std::numeric_limits<T>::min());
+    constexpr Float max = Float(std::numeric_limits<T>::max());
+    T* const typed = reinterpret_cast<T*>(out);
+    for(std::size_t i = 0; i != size; ++i) {
+        const Float value = data[i];
+        typed[i] = value >= max ? std::numeric_limits<T>::max() :
+            value >= min ? T(value) : std::numeric_limits<T>::min();
+    }
+}
+
+template<class T> void unpackNormalized(const char* const data, const std::size_t size, Float* const out) {
+    Math::unpackInto(Containers::StridedArrayView<const T>{reinterpret_cast<const T*>(data), size, sizeof(T)}, Containers::StridedArrayView<Float>{out, size, sizeof(Float)});
+}
+
+template<class T> void unpackCast(const char* const data, const std::size_t size, Float* const out) {
+    const T* const typed = reinterpret_cast<const T*>(data);
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = Float(typed[i]);
+}
+
+/* Conversion of contiguous components from and to floats */
+void packComponents(const Float* const data, const std::size_t size, const AttributeFormat format, char* const out) {
+    switch(format) {
+        case AttributeFormat::Float:
+            std::memcpy(out, data, size*sizeof(Float));
+            return;
+        case AttributeFormat::Half:
+            Math::packHalfInto(Containers::StridedArrayView<const Float>{data, size, sizeof(Float)}, Containers::StridedArrayView<UnsignedShort>{reinterpret_cast<UnsignedShort*>(out), size, sizeof(UnsignedShort)});
+            return;
+        case AttributeFormat::UnsignedByte:
+            return packCast<UnsignedByte>(data, size, out);
+        case AttributeFormat::UnsignedByteNormalized:
+            return packNormalized<UnsignedByte>(data, size, out);
+        case AttributeFormat::Byte:
+            return packCast<Byte>(data, size, out);
+        case AttributeFormat::ByteNormalized:
+            return packNormalized<Byte>(data, size, out);
+        case AttributeFormat::UnsignedShort:
+            return packCast<UnsignedShort>(data, size, out);
+        case AttributeFormat::UnsignedShortNormalized:
+            return packNormalized<UnsignedShort>(data, size, out);
+        case AttributeFormat::Short:
+            return packCast<Short>(data, size, out);
+        case AttributeFormat::ShortNormalized:
+            return packNormalized<Short>(data, size, out);
+        case AttributeFormat::UnsignedInt:
+            return packCast<UnsignedInt>(data, size, out);
+        case AttributeFormat::Int:
+            return packCast<Int>(data, size, out);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+void unpackComponents(const char* const data, const std::size_t size, const AttributeFormat format, Float* const out) {
+    switch(format) {
+        case AttributeFormat::Float:
+            std::memcpy(out, data, size*sizeof(Float));
+            return;
+        case AttributeFormat::Half:
+            Math::unpackHalfInto(Containers::StridedArrayView<const UnsignedShort>{reinterpret_cast<const UnsignedShort*>(data), size, sizeof(UnsignedShort)}, Containers::StridedArrayView<Float>{out, size, sizeof(Float)});
+            return;
+        case AttributeFormat::UnsignedByte:
+            return unpackCast<UnsignedByte>(data, size, out);
+        case AttributeFormat::UnsignedByteNormalized:
+            return unpackNormalized<UnsignedByte>(data, size, out);
+        case AttributeFormat::Byte:
+            return unpackCast<Byte>(data, size, out);
+        case AttributeFormat::ByteNormalized:
+            return unpackNormalized<Byte>(data, size, out);
+        case AttributeFormat::UnsignedShort:
+            return unpackCast<UnsignedShort>(data, size, out);
+        case AttributeFormat::UnsignedShortNormalized:
+            return unpackNormalized<UnsignedShort>(data, size, out);
+        case AttributeFormat::Short:
+            return unpackCast<Short>(data, size, out);
+        case AttributeFormat::ShortNormalized:
+            return unpackNormalized<Short>(data, size, out);
+        case AttributeFormat::UnsignedInt:
+            return unpackCast<UnsignedInt>(data, size, out);
+        case AttributeFormat::Int:
+            return unpackCast<Int>(data, size, out);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Converts count items of componentCount components, count is at most
+   MaxBlockSize. If the formats differ, the items are gathered into
+   contiguous scratch memory, converted there and scattered back. */
+void convertItems(const char* const src, const std::ptrdiff_t srcStride, const AttributeFormat srcFormat, char* const dst, const std::ptrdiff_t dstStride, const AttributeFormat dstFormat, const UnsignedInt componentCount, const std::size_t count) {
+    const std::size_t srcItemSize = componentCount*attributeFormatSize(srcFormat);
+    if(srcFormat == dstFormat)
+        return copyItems(src, srcStride, dst, dstStride, srcItemSize, count);
+
+    const std::size_t dstItemSize = componentCount*attributeFormatSize(dstFormat);
+    const std::size_t componentTotal = count*componentCount;
+
+    /* Aligned for the float reinterpretation */
+    Float floats[MaxBlockSize*4];
+    Float packed[MaxBlockSize*4];
+    char* const packedData = reinterpret_cast<char*>(packed);
+
+    if(srcFormat == AttributeFormat::Float) {
+        copyItems(src, srcStride, reinterpret_cast<char*>(floats), srcItemSize, srcItemSize, count);
+        packComponents(floats, componentTotal, dstFormat, packedData);
+        copyItems(packedData, dstItemSize, dst, dstStride, dstItemSize, count);
+    } else {
+        copyItems(src, srcStride, packedData, srcItemSize, srcItemSize, count);
+        unpackComponents(packedData, componentTotal, srcFormat, floats);
+        copyItems(reinterpret_cast<const char*>(floats), dstItemSize, dst, dstStride, dstItemSize, count);
+    }
+}
+
+std::size_t blockSize(const std::size_t stride) {
+    return Math::max(std::size_t{1}, Math::min(MaxBlockSize, BlockBytes/Math::max(stride, std::size_t{1})));
+}
+
+}
+
+void interleaveAttributesInto(const Containers::ArrayView<char> buffer, const std::size_t stride, const Containers::ArrayView<const InterleaveAttribute> attributes) {
+    if(attributes.empty()) return;
+
+    const std::size_t vertexCount = attributes[0].data.size();
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(std::size_t i = 0; i != attributes.size(); ++i) {
+        const InterleaveAttribute& attribute = attributes[i];
+        CORRADE_ASSERT(attribute.data.size() == vertexCount,
+            "MeshTools::interleaveAttributesInto(): expected" << vertexCount << "items in attribute" << i << "but got" << attribute.data.size(), );
+        CORRADE_ASSERT(attribute.componentCount >= 1 && attribute.componentCount <= 4,
+            "MeshTools::interleaveAttributesInto(): expected 1 to 4 components in attribute" << i << "but got" << attribute.componentCount, );
+        CORRADE_ASSERT(attribute.format == attribute.interleavedFormat || attribute.format == AttributeFormat::Float || attribute.interleavedFormat == AttributeFormat::Float,
+            "MeshTools::interleaveAttributesInto(): can't convert attribute" << i << "from" << attribute.format << "to" << attribute.interleavedFormat, );
+        CORRADE_ASSERT(attribute.offset + attribute.componentCount*attributeFormatSize(attribute.interleavedFormat) <= stride,
+            "MeshTools::interleaveAttributesInto(): attribute" << i << "of" << attribute.componentCount*attributeFormatSize(attribute.interleavedFormat) << "bytes at offset" << attribute.offset << "doesn't fit into stride" << stride, );
+    }
+    #endif
+    CORRADE_ASSERT(vertexCount*stride <= buffer.size(),
+        "MeshTools::interleaveAttributesInto(): the data buffer is too small, expected" << vertexCount*stride << "but got" << buffer.size(), );
+
+    const std::size_t step = blockSize(stride);
+    for(std::size_t begin = 0; begin < vertexCount; begin += step) {
+        const std::size_t count = Math::min(step, vertexCount - begin);
+        for(const InterleaveAttribute& attribute: attributes)
+            convertItems(&attribute.data[begin], attribute.data.stride(), attribute.format, buffer + begin*stride + attribute.offset, stride, attribute.interleavedFormat, attribute.componentCount, count);
+    }
+}
+
+void interleaveAttributesInto(const Containers::ArrayView<char> buffer, const std::size_t stride, const std::initializer_list<InterleaveAttribute> attributes) {
+    interleaveAttributesInto(buffer, stride, Containers::ArrayView<const InterleaveAttribute>{attributes.begin(), attributes.size()});
+}
+
+Containers::Array<char> interleaveAttributes(const std::size_t stride, const Containers::ArrayView<const InterleaveAttribute> attributes) {
+    if(attributes.empty()) return nullptr;
+
+    Containers::Array<char> data{Containers::ValueInit, attributes[0].data.size()*stride};
+    interleaveAttributesInto(data, stride, attributes);
+    return data;
+}
+
+Containers::Array<char> interleaveAttributes(const std::size_t stride, const std::initializer_list<InterleaveAttribute> attributes) {
+    return interleaveAttributes(stride, Containers::ArrayView<const InterleaveAttribute>{attributes.begin(), attributes.size()});
+}
+
+void deinterleaveAttributesInto(const Containers::ArrayView<const char> buffer, const std::size_t stride, const Containers::ArrayView<const DeinterleaveAttribute> attributes) {
+    if(attributes.empty()) return;
+
+    const std::size_t vertexCount = attributes[0].data.size();
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(std::size_t i = 0; i != attributes.size(); ++i) {
+        const DeinterleaveAttribute& attribute = attributes[i];
+        CORRADE_ASSERT(attribute.data.size() == vertexCount,
+            "MeshTools::deinterleaveAttributesInto(): expected" << vertexCount << "items in attribute" << i << "but got" << attribute.data.size(), );
+        CORRADE_ASSERT(attribute.componentCount >= 1 && attribute.componentCount <= 4,
+            "MeshTools::deinterleaveAttributesInto(): expected 1 to 4 components in attribute" << i << "but got" << attribute.componentCount, );
+        CORRADE_ASSERT(attribute.format == attribute.interleavedFormat || attribute.format == AttributeFormat::Float || attribute.interleavedFormat == AttributeFormat::Float,
+            "MeshTools::deinterleaveAttributesInto(): can't convert attribute" << i << "from" << attribute.interleavedFormat << "to" << attribute.format, );
+        CORRADE_ASSERT(attribute.offset + attribute.componentCount*attributeFormatSize(attribute.interleavedFormat) <= stride,
+            "MeshTools::deinterleaveAttributesInto(): attribute" << i << "of" << attribute.componentCount*attributeFormatSize(attribute.interleavedFormat) << "bytes at offset" << attribute.offset << "doesn't fit into stride" << stride, );
+    }
+    #endif
+    CORRADE_ASSERT(vertexCount*stride <= buffer.size(),
+        "MeshTools::deinterleaveAttributesInto(): the data buffer is too small, expected" << vertexCount*stride << "but got" << buffer.size(), );
+
+    const std::size_t step = blockSize(stride);
+    for(std::size_t begin = 0; begin < vertexCount; begin += step) {
+        const std::size_t count = Math::min(step, vertexCount - begin);
+        for(const DeinterleaveAttribute& attribute: attributes)
+            convertItems(buffer + begin*stride + attribute.offset, stride, attribute.interleavedFormat, &attribute.data[begin], attribute.data.stride(), attribute.format, attribute.componentCount, count);
+    }
+}
+
+void deinterleaveAttributesInto(const Containers::ArrayView<const char> buffer, const std::size_t stride, const std::initializer_list<DeinterleaveAttribute> attributes) {
+    deinterleaveAttributesInto(buffer, stride, Containers::ArrayView<const DeinterleaveAttribute>{attributes.begin(), attributes.size()});
+}
+
+}}
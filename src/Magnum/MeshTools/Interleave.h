@@ -26,14 +26,17 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::interleave(), @ref Magnum::MeshTools::interleaveInto()
+ * @brief Function @ref Magnum::MeshTools::interleave(), @ref Magnum::MeshTools::interleaveInto(), @ref Magnum::MeshTools::interleaveAttributes(), @ref Magnum::MeshTools::interleaveAttributesInto(), @ref Magnum::MeshTools::deinterleaveAttributesInto(), struct @ref Magnum::MeshTools::InterleaveAttribute, @ref Magnum::MeshTools::DeinterleaveAttribute, enum @ref Magnum::MeshTools::AttributeFormat
  */
 
 #include <cstring>
+#include <initializer_list>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -124,7 +127,7 @@ would be 21 bytes, causing possible performance loss.
     for) and function `size()` returning count of elements. In most cases it
     will be @ref std::vector or @ref std::array.
 
-@see @ref interleaveInto()
+@see @ref interleaveInto(), @ref interleaveAttributes()
 */
 template<class T, class ...U> Containers::Array<char> interleave(const T& first, const U&... next)
 {
@@ -154,6 +157,7 @@ parameters.
 @attention Similarly to @ref interleave(), this function expects that all
     arrays have the same size. The passed buffer must also be large enough to
     contain the interleaved data.
+@see @ref interleaveAttributesInto()
 */
 template<class T, class ...U> void interleaveInto(Containers::ArrayView<char> buffer, const T& first, const U&... next) {
     /* Verify expected buffer size */
@@ -167,6 +171,235 @@ template<class T, class ...U> void interleaveInto(Containers::ArrayView<char> bu
     Implementation::writeInterleaved(stride, buffer.begin(), first, next...);
 }
 
+/**
+@brief Vertex attribute component format
+
+Format of a single attribute component, used by @ref interleaveAttributes(),
+@ref interleaveAttributesInto() and @ref deinterleaveAttributesInto() to
+describe vertex layouts that are known only at runtime.
+@see @ref attributeFormatSize()
+*/
+enum class AttributeFormat: UnsignedByte {
+    /** @ref Magnum::Float "Float" */
+    Float,
+
+    /**
+     * Half-float, converted using @ref Math::packHalf() /
+     * @ref Math::unpackHalf()
+     */
+    Half,
+
+    /** @ref Magnum::UnsignedByte "UnsignedByte" */
+    UnsignedByte,
+
+    /**
+     * @ref Magnum::UnsignedByte "UnsignedByte" interpreted as a normalized
+     * value in the @f$ [0, 1] @f$ range, converted using @ref Math::pack() /
+     * @ref Math::unpack()
+     */
+    UnsignedByteNormalized,
+
+    /** @ref Magnum::Byte "Byte" */
+    Byte,
+
+    /**
+     * @ref Magnum::Byte "Byte" interpreted as a normalized value in the
+     * @f$ [-1, 1] @f$ range, converted using @ref Math::pack() /
+     * @ref Math::unpack()
+     */
+    ByteNormalized,
+
+    /** @ref Magnum::UnsignedShort "UnsignedShort" */
+    UnsignedShort,
+
+    /**
+     * @ref Magnum::UnsignedShort "UnsignedShort" interpreted as a normalized
+     * value in the @f$ [0, 1] @f$ range, converted using @ref Math::pack() /
+     * @ref Math::unpack()
+     */
+    UnsignedShortNormalized,
+
+    /** @ref Magnum::Short "Short" */
+    Short,
+
+    /**
+     * @ref Magnum::Short "Short" interpreted as a normalized value in the
+     * @f$ [-1, 1] @f$ range, converted using @ref Math::pack() /
+     * @ref Math::unpack()
+     */
+    ShortNormalized,
+
+    /** @ref Magnum::UnsignedInt "UnsignedInt" */
+    UnsignedInt,
+
+    /** @ref Magnum::Int "Int" */
+    Int
+};
+
+/** @brief Size of given attribute component format */
+MAGNUM_MESHTOOLS_EXPORT UnsignedInt attributeFormatSize(AttributeFormat format);
+
+/** @debugoperatorenum{AttributeFormat} */
+MAGNUM_MESHTOOLS_EXPORT Debug& operator<<(Debug& debug, AttributeFormat value);
+
+/**
+@brief Attribute to interleave
+
+Describes a separate attribute array and where and in which format it should
+end up in the interleaved buffer. See @ref interleaveAttributesInto() for more
+information.
+@see @ref DeinterleaveAttribute
+*/
+struct InterleaveAttribute {
+    /**
+     * @brief Constructor
+     * @param data              Attribute data, one item for each vertex
+     * @param format            Component format of @p data
+     * @param componentCount    Count of components in each item. Expected
+     *      to be in range @f$ [1, 4] @f$.
+     * @param offset            Offset of the attribute in the interleaved
+     *      vertex
+     * @param interleavedFormat Component format in the interleaved buffer
+     *
+     * The @p data view can be of any type, the view is only reinterpreted
+     * and the items are expected to be @p componentCount values of
+     * @p format.
+     */
+    template<class T> /*implicit*/ InterleaveAttribute(const Containers::StridedArrayView<T>& data, AttributeFormat format, UnsignedInt componentCount, std::size_t offset, AttributeFormat interleavedFormat) noexcept: data{reinterpret_cast<const Containers::StridedArrayView<const char>&>(data)}, offset{offset}, componentCount{componentCount}, format{format}, interleavedFormat{interleavedFormat} {}
+
+    /**
+     * @brief Construct with the same format in the interleaved buffer
+     *
+     * Equivalent to calling @ref InterleaveAttribute(const Containers::StridedArrayView<T>&, AttributeFormat, UnsignedInt, std::size_t, AttributeFormat)
+     * with @p format passed also to @p interleavedFormat.
+     */
+    template<class T> /*implicit*/ InterleaveAttribute(const Containers::StridedArrayView<T>& data, AttributeFormat format, UnsignedInt componentCount, std::size_t offset) noexcept: InterleaveAttribute{data, format, componentCount, offset, format} {}
+
+    Containers::StridedArrayView<const char> data;  /**< @brief Attribute data */
+    std::size_t offset;             /**< @brief Offset in the interleaved vertex */
+    UnsignedInt componentCount;     /**< @brief Component count */
+    AttributeFormat format;         /**< @brief Component format of @ref data */
+
+    /** @brief Component format in the interleaved buffer */
+    AttributeFormat interleavedFormat;
+};
+
+/**
+@brief Attribute to deinterleave
+
+Describes where and in which format an attribute is in the interleaved buffer
+and a separate array it should be extracted into. See
+@ref deinterleaveAttributesInto() for more information.
+@see @ref InterleaveAttribute
+*/
+struct DeinterleaveAttribute {
+    /**
+     * @brief Constructor
+     * @param data              Where to put the attribute data, one item
+     *      for each vertex
+     * @param format            Component format of @p data
+     * @param componentCount    Count of components in each item. Expected
+     *      to be in range @f$ [1, 4] @f$.
+     * @param offset            Offset of the attribute in the interleaved
+     *      vertex
+     * @param interleavedFormat Component format in the interleaved buffer
+     *
+     * The @p data view can be of any type, the view is only reinterpreted
+     * and the items are expected to be @p componentCount values of
+     * @p format.
+     */
+    template<class T> /*implicit*/ DeinterleaveAttribute(const Containers::StridedArrayView<T>& data, AttributeFormat format, UnsignedInt componentCount, std::size_t offset, AttributeFormat interleavedFormat) noexcept: data{reinterpret_cast<const Containers::StridedArrayView<char>&>(data)}, offset{offset}, componentCount{componentCount}, format{format}, interleavedFormat{interleavedFormat} {}
+
+    /**
+     * @brief Construct with the same format in the interleaved buffer
+     *
+     * Equivalent to calling @ref DeinterleaveAttribute(const Containers::StridedArrayView<T>&, AttributeFormat, UnsignedInt, std::size_t, AttributeFormat)
+     * with @p format passed also to @p interleavedFormat.
+     */
+    template<class T> /*implicit*/ DeinterleaveAttribute(const Containers::StridedArrayView<T>& data, AttributeFormat format, UnsignedInt componentCount, std::size_t offset) noexcept: DeinterleaveAttribute{data, format, componentCount, offset, format} {}
+
+    Containers::StridedArrayView<char> data;  /**< @brief Attribute data */
+    std::size_t offset;             /**< @brief Offset in the interleaved vertex */
+    UnsignedInt componentCount;     /**< @brief Component count */
+    AttributeFormat format;         /**< @brief Component format of @ref data */
+
+    /** @brief Component format in the interleaved buffer */
+    AttributeFormat interleavedFormat;
+};
+
+/**
+@brief Interleave vertex attributes described at runtime into existing buffer
+@param[out] buffer      Interleaved buffer
+@param[in] stride       Interleaved vertex stride
+@param[in] attributes   Attributes to interleave
+
+Counterpart to @ref interleaveInto() for vertex layouts that are known only at
+runtime. Each attribute is copied from its potentially strided
+@ref InterleaveAttribute::data view to @ref InterleaveAttribute::offset in each
+vertex of @p buffer, converting each component from
+@ref InterleaveAttribute::format to @ref InterleaveAttribute::interleavedFormat
+on the way:
+
+@snippet MagnumMeshTools.cpp interleaveAttributesInto
+
+Supported conversions are between equal formats and between
+@ref AttributeFormat::Float and any other format. Normalized formats are
+converted using @ref Math::pack() / @ref Math::unpack(), half-floats with
+@ref Math::packHalf() / @ref Math::unpackHalf() and the rest with a plain
+cast. Values outside of the range of the destination type are saturated, NaNs
+are converted to the lowest representable value. Bytes not covered by any
+attribute are left untouched.
+
+All attributes are expected to have the same size, fit into @p stride and
+@p buffer is expected to be large enough to contain the interleaved data. The
+vertices are processed in blocks small enough for the destination to stay in
+cache while all attributes are written to it and each block of an attribute is
+converted with a tight loop over contiguous memory. On x86 the conversion to
+normalized integer formats is done with SSE2.
+@see @ref interleaveAttributes(), @ref deinterleaveAttributesInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void interleaveAttributesInto(Containers::ArrayView<char> buffer, std::size_t stride, Containers::ArrayView<const InterleaveAttribute> attributes);
+
+/** @overload */
+MAGNUM_MESHTOOLS_EXPORT void interleaveAttributesInto(Containers::ArrayView<char> buffer, std::size_t stride, std::initializer_list<InterleaveAttribute> attributes);
+
+/**
+@brief Interleave vertex attributes described at runtime
+@param stride       Interleaved vertex stride
+@param attributes   Attributes to interleave
+
+Allocates a zero-initialized buffer of @p stride times attribute size bytes
+and calls @ref interleaveAttributesInto(). If @p attributes is empty, returns
+@cpp nullptr @ce.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> interleaveAttributes(std::size_t stride, Containers::ArrayView<const InterleaveAttribute> attributes);
+
+/** @overload */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> interleaveAttributes(std::size_t stride, std::initializer_list<InterleaveAttribute> attributes);
+
+/**
+@brief Deinterleave vertex attributes described at runtime
+@param[in] buffer       Interleaved buffer
+@param[in] stride       Interleaved vertex stride
+@param[out] attributes  Attributes to deinterleave
+
+Inverse of @ref interleaveAttributesInto(). Each attribute is copied from
+@ref DeinterleaveAttribute::offset in each vertex of @p buffer to its
+potentially strided @ref DeinterleaveAttribute::data view, converting each
+component from @ref DeinterleaveAttribute::interleavedFormat to
+@ref DeinterleaveAttribute::format on the way:
+
+@snippet MagnumMeshTools.cpp deinterleaveAttributesInto
+
+The supported conversions and expectations are the same as in
+@ref interleaveAttributesInto(), the vertex count is taken from size of the
+attribute views.
+*/
+MAGNUM_MESHTOOLS_EXPORT void deinterleaveAttributesInto(Containers::ArrayView<const char> buffer, std::size_t stride, Containers::ArrayView<const DeinterleaveAttribute> attributes);
+
+/** @overload */
+MAGNUM_MESHTOOLS_EXPORT void deinterleaveAttributesInto(Containers::ArrayView<const char> buffer, std::size_t stride, std::initializer_list<DeinterleaveAttribute> attributes);
+
 }}
 
 #endif
@@ -0,0 +1,302 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OptimizeVertexCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Scoring constants from the Forsyth paper */
+constexpr Float CacheDecayPower = 1.5f;
+constexpr Float LastTriangleScore = 0.75f;
+constexpr Float ValenceBoostScale = 2.0f;
+constexpr Float ValenceBoostPower = 0.5f;
+
+inline Float valenceScore(const UnsignedInt liveTriangleCount) {
+    /* Boost vertices with only a few triangles left so they get finished
+       instead of leaving lone triangles behind */
+    return ValenceBoostScale*std::pow(Float(liveTriangleCount), -ValenceBoostPower);
+}
+
+}
+
+VertexCacheOptimizer::VertexCacheOptimizer(const std::size_t cacheSize): _cacheSize{cacheSize} {
+    CORRADE_ASSERT(cacheSize > 3 && cacheSize <= MaxCacheSize,
+        "MeshTools::VertexCacheOptimizer: expected cache size larger than 3 and at most" << std::size_t(MaxCacheSize) << "but got" << cacheSize, );
+
+    /* Vertices of the last triangle get a fixed score so the next triangle
+       doesn't prefer any particular of its edges, the rest decays with
+       position in the cache */
+    for(std::size_t i = 0; i != 3; ++i)
+        _cachePositionScore[i] = LastTriangleScore;
+    for(std::size_t i = 3; i != cacheSize; ++i)
+        _cachePositionScore[i] = std::pow(1.0f - Float(i - 3)/Float(cacheSize - 3), CacheDecayPower);
+}
+
+void VertexCacheOptimizer::operator()(std::vector<UnsignedInt>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::VertexCacheOptimizer: index count is not divisible by 3", );
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* Count of not yet emitted triangles for each vertex */
+    _liveTriangleCount.assign(vertexCount, 0);
+    for(const UnsignedInt index: indices) ++_liveTriangleCount[index];
+
+    /* Neighboring triangles for i-th vertex are in interval
+       neighbors[neighborOffset[i]] ; neighbors[neighborOffset[i+1]]. The
+       offsets are shifted right at first, the filling loop shifts them back
+       left. Emitted triangles are moved to the end of each interval, so the
+       first liveTriangleCount[i] neighbors are always the live ones. */
+    _neighborOffset.resize(vertexCount + 1);
+    _neighborOffset[0] = 0;
+    UnsignedInt sum = 0;
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        _neighborOffset[i + 1] = sum;
+        sum += _liveTriangleCount[i];
+    }
+    _neighbors.resize(indices.size());
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        _neighbors[_neighborOffset[indices[i] + 1]++] = i/3;
+
+    /* Initial scores. No vertex is in cache yet, so they're based only on
+       the triangle count. Emitted triangles have a negative score, the
+       score of live ones is never negative. */
+    _vertexScore.resize(vertexCount);
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        _vertexScore[i] = _liveTriangleCount[i] ? valenceScore(_liveTriangleCount[i]) : 0.0f;
+    _triangleScore.resize(triangleCount);
+    UnsignedInt bestTriangle = 0;
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        _triangleScore[i] = _vertexScore[indices[i*3]] + _vertexScore[indices[i*3 + 1]] + _vertexScore[indices[i*3 + 2]];
+        if(_triangleScore[i] > _triangleScore[bestTriangle])
+            bestTriangle = i;
+    }
+
+    /* Simulated LRU cache. While adding a triangle, it temporarily holds up
+       to three vertices more. */
+    UnsignedInt cache[2][MaxCacheSize + 3];
+    std::size_t cacheFill = 0;
+    UnsignedInt* currentCache = cache[0];
+    UnsignedInt* nextCache = cache[1];
+
+    _output.resize(indices.size());
+    std::size_t nextArbitraryTriangle = 0;
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        /* No live triangle touches the cache, take the first not yet emitted
+           one. The cursor only moves forward, so this is linear in total. */
+        if(bestTriangle == ~UnsignedInt{}) {
+            while(_triangleScore[nextArbitraryTriangle] < 0.0f)
+                ++nextArbitraryTriangle;
+            bestTriangle = nextArbitraryTriangle;
+        }
+
+        /* Emit the triangle, remove it from live neighbors of its vertices
+           and put them to the front of the cache */
+        const UnsignedInt* const triangle = indices.data() + bestTriangle*3;
+        std::size_t nextCacheFill = 0;
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt v = triangle[j];
+            _output[i*3 + j] = v;
+
+            UnsignedInt* const neighbors = _neighbors.data() + _neighborOffset[v];
+            const UnsignedInt last = --_liveTriangleCount[v];
+            for(std::size_t k = 0; k != last; ++k) {
+                if(neighbors[k] != bestTriangle) continue;
+                std::swap(neighbors[k], neighbors[last]);
+                break;
+            }
+
+            /* Degenerate triangles can reference the same vertex twice */
+            if(j == 0 || (v != triangle[0] && (j == 1 || v != triangle[1])))
+                nextCache[nextCacheFill++] = v;
+        }
+        _triangleScore[bestTriangle] = -1.0f;
+
+        /* Add the rest of the cache after the triangle vertices, skipping
+           the ones that were just moved to the front */
+        for(std::size_t j = 0; j != cacheFill; ++j) {
+            const UnsignedInt v = currentCache[j];
+            if(v != triangle[0] && v != triangle[1] && v != triangle[2])
+                nextCache[nextCacheFill++] = v;
+        }
+
+        /* Update score of all vertices that were touched. Those that fell
+           out of the cache are updated too, as their score dropped. */
+        for(std::size_t j = 0; j != nextCacheFill; ++j) {
+            const UnsignedInt v = nextCache[j];
+            const Int position = j < _cacheSize ? Int(j) : -1;
+            _vertexScore[v] = _liveTriangleCount[v] ?
+                (position == -1 ? 0.0f : _cachePositionScore[position]) + valenceScore(_liveTriangleCount[v]) : 0.0f;
+        }
+
+        /* Update score of their live triangles and pick the best one for the
+           next iteration */
+        bestTriangle = ~UnsignedInt{};
+        Float bestScore = -1.0f;
+        for(std::size_t j = 0; j != nextCacheFill; ++j) {
+            const UnsignedInt v = nextCache[j];
+            const UnsignedInt* const neighbors = _neighbors.data() + _neighborOffset[v];
+            for(std::size_t k = 0, kMax = _liveTriangleCount[v]; k != kMax; ++k) {
+                const UnsignedInt t = neighbors[k];
+                const Float score = _vertexScore[indices[t*3]] + _vertexScore[indices[t*3 + 1]] + _vertexScore[indices[t*3 + 2]];
+                _triangleScore[t] = score;
+                if(score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = t;
+                }
+            }
+        }
+
+        cacheFill = std::min(nextCacheFill, _cacheSize);
+        std::swap(currentCache, nextCache);
+    }
+
+    std::copy(_output.begin(), _output.end(), indices.begin());
+}
+
+void VertexCacheOptimizer::optimizeOverdraw(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const Float threshold) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::VertexCacheOptimizer::optimizeOverdraw(): index count is not divisible by 3", );
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* Simulated FIFO cache, the same as in tipsify(). A vertex is in the
+       cache if less than cacheSize misses happened since it got in. */
+    UnsignedInt time = _cacheSize + 1;
+    _timestamp.assign(positions.size(), 0);
+    auto misses = [&](const std::size_t triangle) {
+        UnsignedInt count = 0;
+        for(std::size_t i = 0; i != 3; ++i) {
+            const UnsignedInt v = indices[triangle*3 + i];
+            if(time - _timestamp[v] <= _cacheSize) continue;
+            _timestamp[v] = time++;
+            ++count;
+        }
+        return count;
+    };
+
+    /* Hard boundaries, where all vertices of a triangle missed the cache */
+    _clusterOffset.clear();
+    _clusterOffset.push_back(0);
+    misses(0);
+    for(std::size_t i = 1; i != triangleCount; ++i)
+        if(misses(i) == 3) _clusterOffset.push_back(i);
+    _clusterOffset.push_back(triangleCount);
+
+    /* Soft boundaries inside each cluster. The cluster is simulated again
+       with the cache flushed after each split, which makes the split
+       increase the miss count only as much as the threshold allows. */
+    const std::size_t hardClusterCount = _clusterOffset.size() - 1;
+    for(std::size_t c = 0; c != hardClusterCount; ++c) {
+        const UnsignedInt begin = _clusterOffset[c];
+        const UnsignedInt end = _clusterOffset[c + 1];
+
+        time += _cacheSize + 1;
+        UnsignedInt clusterMisses = 0;
+        for(UnsignedInt i = begin; i != end; ++i)
+            clusterMisses += misses(i);
+        const Float maxRatio = threshold*Float(clusterMisses)/Float(end - begin);
+
+        time += _cacheSize + 1;
+        UnsignedInt splitMisses = 0;
+        UnsignedInt splitBegin = begin;
+        for(UnsignedInt i = begin; i != end - 1; ++i) {
+            splitMisses += misses(i);
+            if(Float(splitMisses) > maxRatio*Float(i + 1 - splitBegin))
+                continue;
+
+            _clusterOffset.push_back(i + 1);
+            splitMisses = 0;
+            splitBegin = i + 1;
+            time += _cacheSize + 1;
+        }
+    }
+    std::sort(_clusterOffset.begin(), _clusterOffset.end());
+    const std::size_t clusterCount = _clusterOffset.size() - 1;
+
+    /* Area-weighted centroid of the whole mesh. Triangle centroids are
+       weighted by the doubled area, which cancels out in the end. */
+    Vector3 meshCentroid;
+    Float meshArea = 0.0f;
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        const Vector3& a = positions[indices[i*3]];
+        const Vector3& b = positions[indices[i*3 + 1]];
+        const Vector3& c = positions[indices[i*3 + 2]];
+        const Float area = Math::cross(c - b, a - b).length();
+        meshCentroid += (a + b + c)*area;
+        meshArea += area;
+    }
+    if(meshArea != 0.0f) meshCentroid /= 3.0f*meshArea;
+
+    /* Sort key of each cluster is how much is its average normal pointing
+       away from the mesh center */
+    _clusterSortKey.resize(clusterCount);
+    for(std::size_t cluster = 0; cluster != clusterCount; ++cluster) {
+        Vector3 centroid, normal;
+        Float area = 0.0f;
+        for(UnsignedInt i = _clusterOffset[cluster]; i != _clusterOffset[cluster + 1]; ++i) {
+            const Vector3& a = positions[indices[i*3]];
+            const Vector3& b = positions[indices[i*3 + 1]];
+            const Vector3& c = positions[indices[i*3 + 2]];
+            const Vector3 triangleNormal = Math::cross(c - b, a - b);
+            const Float triangleArea = triangleNormal.length();
+            centroid += (a + b + c)*triangleArea;
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        const Float normalLength = normal.length();
+        _clusterSortKey[cluster] = area != 0.0f && normalLength != 0.0f ?
+            Math::dot(centroid/(3.0f*area) - meshCentroid, normal/normalLength) : 0.0f;
+    }
+
+    _clusterOrder.resize(clusterCount);
+    for(std::size_t c = 0; c != clusterCount; ++c) _clusterOrder[c] = c;
+    std::stable_sort(_clusterOrder.begin(), _clusterOrder.end(), [&](UnsignedInt a, UnsignedInt b) {
+        return _clusterSortKey[a] > _clusterSortKey[b];
+    });
+
+    /* Emit the clusters in sorted order */
+    _output.resize(indices.size());
+    std::size_t out = 0;
+    for(const UnsignedInt c: _clusterOrder) {
+        const std::size_t begin = _clusterOffset[c]*3;
+        const std::size_t end = _clusterOffset[c + 1]*3;
+        std::copy(indices.begin() + begin, indices.begin() + end, _output.begin() + out);
+        out += end - begin;
+    }
+
+    std::copy(_output.begin(), _output.end(), indices.begin());
+}
+
+}}
@@ -0,0 +1,67 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OptimizeVertexFetch.h"
+
+#include <algorithm>
+
+namespace Magnum { namespace MeshTools {
+
+std::vector<UnsignedInt> optimizeVertexFetchRemap(std::vector<UnsignedInt>& indices, const std::size_t vertexCount, std::size_t& usedVertexCount) {
+    /* New position for each vertex, in order of first use */
+    constexpr UnsignedInt Unused = ~UnsignedInt{};
+    std::vector<UnsignedInt> permutation(vertexCount, Unused);
+    UnsignedInt next = 0;
+    for(UnsignedInt& index: indices) {
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::optimizeVertexFetch(): index" << index << "out of range for" << vertexCount << "vertices", {});
+        UnsignedInt& position = permutation[index];
+        if(position == Unused) position = next++;
+        index = position;
+    }
+
+    /* Move unused vertices after the used ones to make it a permutation */
+    usedVertexCount = next;
+    for(UnsignedInt& position: permutation)
+        if(position == Unused) position = next++;
+
+    return permutation;
+}
+
+std::size_t optimizeVertexFetch(std::vector<UnsignedInt>& indices, const Containers::ArrayView<char> data, const std::size_t stride) {
+    CORRADE_ASSERT(stride && data.size() % stride == 0,
+        "MeshTools::optimizeVertexFetch(): data size" << data.size() << "is not divisible by stride" << stride, {});
+
+    std::size_t usedVertexCount{};
+    const std::vector<UnsignedInt> permutation = optimizeVertexFetchRemap(indices, data.size()/stride, usedVertexCount);
+    std::vector<UnsignedInt> scratch;
+    Implementation::permuteInPlace(permutation, scratch, [&](std::size_t a, std::size_t b) {
+        std::swap_ranges(data.begin() + a*stride, data.begin() + (a + 1)*stride, data.begin() + b*stride);
+    });
+
+    return usedVertexCount;
+}
+
+}}
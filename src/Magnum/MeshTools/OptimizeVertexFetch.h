@@ -0,0 +1,144 @@
+#ifndef Magnum_MeshTools_OptimizeVertexFetch_h
+#define Magnum_MeshTools_OptimizeVertexFetch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeVertexFetch(), @ref Magnum::MeshTools::optimizeVertexFetchRemap()
+ */
+
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Compute vertex renumbering for better fetch locality
+@param[in,out] indices      Index array to operate on
+@param[in] vertexCount      Vertex count
+@param[out] usedVertexCount Count of vertices referenced by the index array
+@return Permutation of vertices, new position for each original vertex
+
+Vertices are numbered in order of their first use in @p indices and the
+index array is updated accordingly. Vertices not referenced by the index
+array are moved to the end, keeping their original order, so the returned
+array is always a permutation of @cpp 0 @ce to @p vertexCount. Expects that
+all indices are in range.
+
+This is the building block of @ref optimizeVertexFetch(), useful when the
+vertex data are in a custom storage.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> optimizeVertexFetchRemap(std::vector<UnsignedInt>& indices, std::size_t vertexCount, std::size_t& usedVertexCount);
+
+namespace Implementation {
+
+/* Moves item i to position permutation[i] using as many calls to
+   swap(a, b) as there are items not already in place. The permutation is
+   copied to a scratch array, which gets destroyed in the process. */
+template<class Swap> void permuteInPlace(const std::vector<UnsignedInt>& permutation, std::vector<UnsignedInt>& scratch, Swap swap) {
+    scratch.assign(permutation.begin(), permutation.end());
+    for(std::size_t i = 0; i != scratch.size(); ++i) {
+        /* Follow the cycle until the item that should be at i lands there */
+        while(scratch[i] != i) {
+            const UnsignedInt j = scratch[i];
+            swap(i, j);
+            std::swap(scratch[i], scratch[j]);
+        }
+    }
+}
+
+constexpr bool attributeSizesMatch(std::size_t) { return true; }
+template<class T, class ...U> bool attributeSizesMatch(std::size_t size, const std::vector<T>& first, const std::vector<U>&... next) {
+    return first.size() == size && attributeSizesMatch(size, next...);
+}
+
+inline void optimizeVertexFetchAttributes(const std::vector<UnsignedInt>&, std::vector<UnsignedInt>&, std::size_t) {}
+
+template<class T, class ...U> void optimizeVertexFetchAttributes(const std::vector<UnsignedInt>& permutation, std::vector<UnsignedInt>& scratch, const std::size_t usedVertexCount, std::vector<T>& first, std::vector<U>&... next) {
+    permuteInPlace(permutation, scratch, [&first](std::size_t a, std::size_t b) {
+        using std::swap;
+        swap(first[a], first[b]);
+    });
+    first.resize(usedVertexCount);
+
+    optimizeVertexFetchAttributes(permutation, scratch, usedVertexCount, next...);
+}
+
+}
+
+/**
+@brief Optimize vertex order for fetch locality
+@param[in,out] indices      Index array to operate on
+@param[in,out] first        First attribute array
+@param[in,out] next         Next attribute arrays
+@return Resulting vertex count
+
+Reorders the vertices in order of their first use in @p indices, so vertex
+data are accessed mostly sequentially when the mesh is drawn or processed on
+the CPU. All attribute arrays are expected to have the same size, they are
+permuted in place and vertices not referenced by @p indices are removed from
+them. The function should be called after the index order is optimized, for
+example with @ref tipsify() or @ref optimizeVertexCache(). It doesn't change
+the triangle order and only decreases the index range, so it works well
+together with @ref compressIndices():
+
+@snippet MagnumMeshTools.cpp optimizeVertexFetch
+
+@see @ref optimizeVertexFetchRemap()
+*/
+template<class T, class ...U> std::size_t optimizeVertexFetch(std::vector<UnsignedInt>& indices, std::vector<T>& first, std::vector<U>&... next) {
+    CORRADE_ASSERT(Implementation::attributeSizesMatch(first.size(), next...),
+        "MeshTools::optimizeVertexFetch(): attribute arrays don't have the same size", {});
+
+    std::size_t usedVertexCount{};
+    const std::vector<UnsignedInt> permutation = optimizeVertexFetchRemap(indices, first.size(), usedVertexCount);
+    std::vector<UnsignedInt> scratch;
+    Implementation::optimizeVertexFetchAttributes(permutation, scratch, usedVertexCount, first, next...);
+    return usedVertexCount;
+}
+
+/**
+@brief Optimize vertex order of an interleaved buffer for fetch locality
+@param[in,out] indices      Index array to operate on
+@param[in,out] data         Interleaved vertex data
+@param[in] stride           Vertex stride
+@return Count of vertices referenced by @p indices
+
+Same as @ref optimizeVertexFetch(std::vector<UnsignedInt>&, std::vector<T>&, std::vector<U>&...),
+but operating on a buffer returned by @ref interleave() or
+@ref interleaveInto(). As the buffer can't be shrunk, vertices not
+referenced by @p indices are moved to the end of the buffer, after the
+returned vertex count. Expects that @p data size is divisible by @p stride.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t optimizeVertexFetch(std::vector<UnsignedInt>& indices, Containers::ArrayView<char> data, std::size_t stride);
+
+}}
+
+#endif
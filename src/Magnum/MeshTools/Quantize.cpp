@@ -0,0 +1,191 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Quantize.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+inline Vector2 signNotZero(const Vector2& value) {
+    return {value.x() >= 0.0f ? 1.0f : -1.0f, value.y() >= 0.0f ? 1.0f : -1.0f};
+}
+
+/* Unit vector to the [-1, 1]^2 square, with the lower hemisphere folded
+   over the diagonals */
+inline Vector2 octahedralProject(const Vector3& vector) {
+    const Float sum = Math::abs(vector).sum();
+    if(sum == 0.0f) return {};
+
+    const Vector2 p = vector.xy()/sum;
+    if(vector.z() >= 0.0f) return p;
+    return (Vector2{1.0f} - Math::abs(Vector2{p.y(), p.x()}))*signNotZero(p);
+}
+
+inline Vector3 octahedralUnproject(const Vector2& p) {
+    Vector3 out{p, 1.0f - Math::abs(p).sum()};
+    if(out.z() < 0.0f)
+        out.xy() = (Vector2{1.0f} - Math::abs(Vector2{p.y(), p.x()}))*signNotZero(p);
+    return out.normalized();
+}
+
+/* Maps values relative to the bounds to [0, 1], zero-sized axes map to 0 */
+template<class T> inline T normalizeToBounds(const T& value, const T& min, const T& inverseSize) {
+    return T{Math::clamp((value - min)*inverseSize, 0.0f, 1.0f)};
+}
+
+template<class T> inline T inverseSize(const T& size) {
+    T out{Math::NoInit};
+    for(std::size_t i = 0; i != T::Size; ++i)
+        out[i] = size[i] == 0.0f ? 0.0f : 1.0f/size[i];
+    return out;
+}
+
+}
+
+void encodeOctahedralInto(const Containers::StridedArrayView<const Vector3>& vectors, const Containers::StridedArrayView<Vector2s>& out) {
+    CORRADE_ASSERT(out.size() == vectors.size(),
+        "MeshTools::encodeOctahedralInto(): expected" << vectors.size() << "output items but got" << out.size(), );
+
+    constexpr Float Max = Math::Implementation::bitMax<Short>();
+    for(std::size_t i = 0; i != vectors.size(); ++i) {
+        const Vector3& vector = vectors[i];
+        const Vector2 scaled = octahedralProject(vector)*Max;
+        const Vector2 floor = Math::floor(scaled);
+
+        /* Pick the neighbor that decodes closest to the original */
+        Vector2s best;
+        Float bestDot = -2.0f;
+        for(UnsignedInt j = 0; j != 4; ++j) {
+            /* Clamping to avoid overflow for values already at the edge */
+            const Vector2s candidate{Math::clamp(Vector2{floor.x() + (j & 1), floor.y() + (j >> 1)}, -Max, Max)};
+            const Float dot = Math::dot(octahedralUnproject(Vector2{candidate}/Max), vector);
+            if(dot > bestDot) {
+                bestDot = dot;
+                best = candidate;
+            }
+        }
+
+        out[i] = best;
+    }
+}
+
+void decodeOctahedralInto(const Containers::StridedArrayView<const Vector2s>& encoded, const Containers::StridedArrayView<Vector3>& out) {
+    CORRADE_ASSERT(out.size() == encoded.size(),
+        "MeshTools::decodeOctahedralInto(): expected" << encoded.size() << "output items but got" << out.size(), );
+
+    for(std::size_t i = 0; i != encoded.size(); ++i)
+        out[i] = octahedralUnproject(Math::unpack<Vector2>(encoded[i]));
+}
+
+QuantizedMeshData3D quantize(const Trade::MeshData3D& mesh) {
+    QuantizedMeshData3D out;
+    out.primitive = mesh.primitive();
+    if(mesh.isIndexed()) out.indices = mesh.indices();
+
+    {
+        const std::vector<Vector3>& positions = mesh.positions(0);
+        out.positionBounds = Math::bounds(Containers::ArrayView<const Vector3>{positions.data(), positions.size()});
+        const Vector3 min = out.positionBounds.min();
+        const Vector3 inverse = inverseSize(out.positionBounds.size());
+        out.positions.reserve(positions.size());
+        for(const Vector3& position: positions)
+            out.positions.push_back(Math::pack<Vector3us>(normalizeToBounds(position, min, inverse)));
+    }
+
+    if(mesh.hasNormals()) {
+        const std::vector<Vector3>& normals = mesh.normals(0);
+        out.normals.resize(normals.size());
+        encodeOctahedralInto(
+            Containers::StridedArrayView<const Vector3>{normals.data(), normals.size(), sizeof(Vector3)},
+            Containers::StridedArrayView<Vector2s>{out.normals.data(), out.normals.size(), sizeof(Vector2s)});
+    }
+
+    if(mesh.hasTextureCoords2D()) {
+        const std::vector<Vector2>& textureCoords = mesh.textureCoords2D(0);
+        out.textureCoordinateBounds = Math::bounds(Containers::ArrayView<const Vector2>{textureCoords.data(), textureCoords.size()});
+        const Vector2 min = out.textureCoordinateBounds.min();
+        const Vector2 inverse = inverseSize(out.textureCoordinateBounds.size());
+        out.textureCoords2D.reserve(textureCoords.size());
+        for(const Vector2& textureCoord: textureCoords)
+            out.textureCoords2D.push_back(Math::pack<Vector2us>(normalizeToBounds(textureCoord, min, inverse)));
+    }
+
+    /* Colors are processed as a flat array of channels, the batch packing
+       saturates out-of-range values */
+    if(mesh.hasColors()) {
+        const std::vector<Color4>& colors = mesh.colors(0);
+        out.colors.resize(colors.size());
+        Math::packInto(
+            Containers::StridedArrayView<const Float>{colors.empty() ? nullptr : colors[0].data(), colors.size()*4, sizeof(Float)},
+            Containers::StridedArrayView<UnsignedByte>{out.colors.empty() ? nullptr : out.colors[0].data(), out.colors.size()*4, sizeof(UnsignedByte)});
+    }
+
+    return out;
+}
+
+Trade::MeshData3D dequantize(const QuantizedMeshData3D& mesh) {
+    const Matrix4 positionDequantization = mesh.positionDequantization();
+    std::vector<Vector3> positions;
+    positions.reserve(mesh.positions.size());
+    for(const Vector3us& position: mesh.positions)
+        positions.push_back(positionDequantization.transformPoint(Math::unpack<Vector3>(position)));
+
+    std::vector<std::vector<Vector3>> normals;
+    if(!mesh.normals.empty()) {
+        normals.emplace_back(mesh.normals.size());
+        decodeOctahedralInto(
+            Containers::StridedArrayView<const Vector2s>{mesh.normals.data(), mesh.normals.size(), sizeof(Vector2s)},
+            Containers::StridedArrayView<Vector3>{normals[0].data(), normals[0].size(), sizeof(Vector3)});
+    }
+
+    std::vector<std::vector<Vector2>> textureCoords2D;
+    if(!mesh.textureCoords2D.empty()) {
+        const Matrix3 textureCoordinateDequantization = mesh.textureCoordinateDequantization();
+        textureCoords2D.emplace_back();
+        textureCoords2D[0].reserve(mesh.textureCoords2D.size());
+        for(const Vector2us& textureCoord: mesh.textureCoords2D)
+            textureCoords2D[0].push_back(textureCoordinateDequantization.transformPoint(Math::unpack<Vector2>(textureCoord)));
+    }
+
+    std::vector<std::vector<Color4>> colors;
+    if(!mesh.colors.empty()) {
+        colors.emplace_back(mesh.colors.size());
+        Math::unpackInto(
+            Containers::StridedArrayView<const UnsignedByte>{mesh.colors[0].data(), mesh.colors.size()*4, sizeof(UnsignedByte)},
+            Containers::StridedArrayView<Float>{colors[0][0].data(), colors[0].size()*4, sizeof(Float)});
+    }
+
+    return Trade::MeshData3D{mesh.primitive, mesh.indices, {std::move(positions)}, std::move(normals), std::move(textureCoords2D), std::move(colors)};
+}
+
+}}
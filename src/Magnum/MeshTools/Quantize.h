@@ -0,0 +1,183 @@
+#ifndef Magnum_MeshTools_Quantize_h
+#define Magnum_MeshTools_Quantize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::QuantizedMeshData3D, function @ref Magnum::MeshTools::quantize(), @ref Magnum::MeshTools::dequantize(), @ref Magnum::MeshTools::encodeOctahedralInto(), @ref Magnum::MeshTools::decodeOctahedralInto()
+ */
+
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Quantized 3D mesh data
+
+Output of @ref quantize(), input of @ref dequantize(). All attributes are
+normalized integers, the ranges are parameters needed to get the original
+values back.
+*/
+struct QuantizedMeshData3D {
+    /** @brief Primitive */
+    MeshPrimitive primitive;
+
+    /** @brief Indices, unchanged from the original mesh */
+    std::vector<UnsignedInt> indices;
+
+    /**
+     * @brief Positions
+     *
+     * Normalized values relative to @ref positionBounds, i.e. the original
+     * position is @cpp positionBounds.min() + Math::unpack<Vector3>(p)*positionBounds.size() @ce.
+     * Bind as a normalized unsigned short attribute and multiply with
+     * @ref positionDequantization() in the shader.
+     */
+    std::vector<Vector3us> positions;
+
+    /** @brief Position bounds */
+    Range3D positionBounds;
+
+    /**
+     * @brief Normals
+     *
+     * Octahedral-encoded normalized values, decode with
+     * @ref decodeOctahedralInto(). Empty if the original mesh has no
+     * normals.
+     */
+    std::vector<Vector2s> normals;
+
+    /**
+     * @brief Texture coordinates
+     *
+     * Normalized values relative to @ref textureCoordinateBounds. Empty if
+     * the original mesh has no texture coordinates.
+     */
+    std::vector<Vector2us> textureCoords2D;
+
+    /** @brief Texture coordinate bounds */
+    Range2D textureCoordinateBounds;
+
+    /**
+     * @brief Colors
+     *
+     * Normalized values, channels outside of the @f$ [0, 1] @f$ range are
+     * saturated. Empty if the original mesh has no colors.
+     */
+    std::vector<Color4ub> colors;
+
+    /**
+     * @brief Position dequantization matrix
+     *
+     * Transforms unpacked @ref positions from the @f$ [0, 1] @f$ range back
+     * to the original range. Can be combined with the transformation
+     * matrix of the mesh so the dequantization comes for free.
+     */
+    Matrix4 positionDequantization() const {
+        return Matrix4::translation(positionBounds.min())*Matrix4::scaling(positionBounds.size());
+    }
+
+    /**
+     * @brief Texture coordinate dequantization matrix
+     *
+     * Transforms unpacked @ref textureCoords2D from the @f$ [0, 1] @f$ range
+     * back to the original range.
+     */
+    Matrix3 textureCoordinateDequantization() const {
+        return Matrix3::translation(textureCoordinateBounds.min())*Matrix3::scaling(textureCoordinateBounds.size());
+    }
+};
+
+/**
+@brief Quantize mesh data
+@param mesh     Mesh to quantize
+@return Quantized mesh data
+
+Converts the first position, normal, texture coordinate and color array of
+@p mesh to packed representations, roughly halving the memory use compared
+to 32-bit floats:
+
+-   positions are stored as 16-bit normalized values relative to the mesh
+    bounds, with an error at most half of
+    @cpp positionBounds.size()/65535.0f @ce in each axis,
+-   normals are octahedral-encoded into two 16-bit normalized values,
+    choosing the nearest of the four neighboring encodings, with an angular
+    error below @cpp 0.01_degf @ce,
+-   texture coordinates are stored as 16-bit normalized values relative to
+    their bounds, with an error at most half of
+    @cpp textureCoordinateBounds.size()/65535.0f @ce in each axis,
+-   colors are stored as 8-bit normalized values, with an error at most
+    @cpp 0.5f/255.0f @ce.
+
+If an axis has zero size, all values along it are quantized to zero and
+restored exactly. Additional attribute arrays are ignored.
+@see @ref dequantize(), @ref Math::packInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT QuantizedMeshData3D quantize(const Trade::MeshData3D& mesh);
+
+/**
+@brief Dequantize mesh data
+
+Inverse of @ref quantize(), useful mainly for verification and for CPU-side
+processing of quantized meshes.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData3D dequantize(const QuantizedMeshData3D& mesh);
+
+/**
+@brief Octahedral-encode unit vectors
+@param[in] vectors  Unit vectors
+@param[out] out     Where to put the encoded vectors
+
+Projects the vectors onto an octahedron and unfolds its lower half, then
+picks the one of four neighboring 16-bit encodings that decodes closest to
+the original vector. Zero vectors are encoded as the positive Z axis. The
+@p out view is expected to have the same size as @p vectors.
+@see @ref decodeOctahedralInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void encodeOctahedralInto(const Containers::StridedArrayView<const Vector3>& vectors, const Containers::StridedArrayView<Vector2s>& out);
+
+/**
+@brief Decode octahedral-encoded unit vectors
+@param[in] encoded  Encoded vectors
+@param[out] out     Where to put the decoded unit vectors
+
+Inverse of @ref encodeOctahedralInto(). The @p out view is expected to have
+the same size as @p encoded.
+*/
+MAGNUM_MESHTOOLS_EXPORT void decodeOctahedralInto(const Containers::StridedArrayView<const Vector2s>& encoded, const Containers::StridedArrayView<Vector3>& out);
+
+}}
+
+#endif
@@ -0,0 +1,107 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RemoveDuplicates.h"
+
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Hashes the bytes four at a time, with a final avalanche so the low bits
+   used for addressing the table depend on all input bits */
+inline UnsignedInt hashBytes(const char* const data, const std::size_t size) {
+    UnsignedInt hash = 2166136261u;
+    std::size_t i = 0;
+    for(; i + 4 <= size; i += 4) {
+        UnsignedInt word;
+        std::memcpy(&word, data + i, 4);
+        hash = (hash ^ word)*0x9e3779b1u;
+        hash ^= hash >> 15;
+    }
+    for(; i != size; ++i)
+        hash = (hash ^ UnsignedByte(data[i]))*16777619u;
+
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+struct Slot {
+    UnsignedInt hash;
+    UnsignedInt index;
+};
+
+}
+
+std::size_t removeDuplicatesExactInPlace(const Containers::StridedArrayView<char>& data, const std::size_t size, const Containers::ArrayView<UnsignedInt> indices) {
+    CORRADE_ASSERT(indices.size() == data.size(),
+        "MeshTools::removeDuplicatesExactInPlace(): expected" << data.size() << "indices but got" << indices.size(), {});
+    CORRADE_ASSERT(data.size() < 2 || std::size_t(data.stride()) >= size,
+        "MeshTools::removeDuplicatesExactInPlace(): stride" << std::size_t(data.stride()) << "is smaller than item size" << size, {});
+
+    /* Power-of-two table with load factor at most 2/3 even if all items are
+       unique. The hash is stored next to the index so colliding items don't
+       need to be compared bytewise. */
+    constexpr UnsignedInt Empty = ~UnsignedInt{};
+    std::size_t tableSize = 1;
+    while(tableSize < data.size() + data.size()/2) tableSize <<= 1;
+    const std::size_t tableMask = tableSize - 1;
+    std::vector<Slot> table(tableSize, Slot{0, Empty});
+
+    /* The unique count never exceeds the count of processed items, so unique
+       items can be compacted to the front in place */
+    UnsignedInt uniqueCount = 0;
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        const char* const item = &data[i];
+        const UnsignedInt hash = hashBytes(item, size);
+
+        for(std::size_t slot = hash & tableMask; ; slot = (slot + 1) & tableMask) {
+            Slot& s = table[slot];
+
+            /* New unique item */
+            if(s.index == Empty) {
+                if(uniqueCount != i) std::memcpy(&data[uniqueCount], item, size);
+                s.hash = hash;
+                s.index = uniqueCount;
+                indices[i] = uniqueCount++;
+                break;
+            }
+
+            /* Duplicate of an existing one */
+            if(s.hash == hash && std::memcmp(&data[s.index], item, size) == 0) {
+                indices[i] = s.index;
+                break;
+            }
+        }
+    }
+
+    return uniqueCount;
+}
+
+}}
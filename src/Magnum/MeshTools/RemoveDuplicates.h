@@ -26,41 +26,57 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::removeDuplicates()
+ * @brief Function @ref Magnum::MeshTools::removeDuplicates(), @ref Magnum::MeshTools::removeDuplicatesExact(), @ref Magnum::MeshTools::removeDuplicatesExactInPlace()
  */
 
-#include <limits>
-#include <numeric>
-#include <unordered_map>
 #include <vector>
-#include <Corrade/Utility/MurmurHash2.h>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
-    template<std::size_t size> class VectorHash {
-        public:
-            std::size_t operator()(const Math::Vector<size, std::size_t>& data) const {
-                return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&data), sizeof(data)).byteArray());
-            }
-    };
+    /* Spatial hash of integer cell coordinates. Multiplying each component by
+       a different large prime and mixing the result so low bits, which are
+       used for addressing the table, depend on all input bits. */
+    template<std::size_t size> inline UnsignedInt hashCell(const Math::Vector<size, Int>& cell) {
+        constexpr UnsignedInt Primes[]{73856093u, 19349663u, 83492791u, 2654435761u};
+        UnsignedInt hash = 0;
+        for(std::size_t i = 0; i != size; ++i)
+            hash ^= UnsignedInt(cell[i])*Primes[i % 4];
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        return hash;
+    }
 }
 
 /**
 @brief Remove duplicate floating-point vector data from given array
 @param[in,out] data Input data array
-@param[in] epsilon  Epsilon value, vertices nearer than this distance will be
-    melt together
+@param[in] epsilon  Epsilon value, vertices nearer than this distance in all
+    coordinates will be melt together
 @return Index array and unique data
 
-Removes duplicate data from the array by collapsing them into buckets of size
-@p epsilon. First vector in given bucket is used, other ones are thrown away,
-no interpolation is done. Note that this function is meant to be used for
-floating-point data (or generally with non-zero @p epsilon), for discrete data
-the usual sorting method is much more efficient.
+Removes duplicate data from the array by merging each vector with the first
+previous unique vector that differs from it by less than @p epsilon in every
+coordinate. The first vector of each such group is kept and moved to the
+front of the array in the order of first occurrence, other ones are thrown
+away, no interpolation is done. Note that this function is meant to be used
+for floating-point data (or generally with non-zero @p epsilon), for discrete
+data use @ref removeDuplicatesExact() instead, which is much more efficient.
+
+The data are processed in a single pass. Coordinates are first quantized into
+a grid of cells with size at least @cpp 2*epsilon @ce, the unique vectors are
+then put into an open-addressing hash table keyed by the cell, so for each
+vector it's enough to look into the cell it lies in and at most one neighbor
+cell in each direction. Apart from the returned index array, the function
+allocates a table of cell coordinates and one integer per vertex plus a hash
+table with about two slots per vertex.
 
 If you want to remove duplicate data from already indexed array, first remove
 duplicates as if the array wasn't indexed at all and then use @ref duplicate()
@@ -76,6 +92,12 @@ data accordingly:
 @snippet MagnumMeshTools.cpp removeDuplicates2
 */
 template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vector>& data, typename Vector::Type epsilon = Math::TypeTraits<typename Vector::Type>::epsilon()) {
+    typedef typename Vector::Type T;
+    typedef Math::Vector<Vector::Size, Int> Cell;
+    constexpr UnsignedInt Empty = ~UnsignedInt{};
+
+    if(data.empty()) return {};
+
     /* Get bounds */
     Vector min = data[0], max = data[0];
     for(const auto& v: data) {
@@ -83,63 +105,145 @@ template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vec
         max = Math::max(v, max);
     }
 
-    /* Make epsilon so large that std::size_t can index all vectors inside the
-       bounds. */
-    epsilon = Math::max(epsilon, typename Vector::Type((max-min).max()/~std::size_t{}));
-
-    /* Resulting index array */
+    /* Make the cells at least twice the epsilon so each vector needs to look
+       at most at one neighbor cell in each direction. Also make them so large
+       that the cell coordinates fit into 31 bits. */
+    T cellSize = Math::max(epsilon*T(2), T((max-min).max()/T(1 << 30)));
+    if(cellSize == T(0)) cellSize = T(1);
+
+    /* Quantize all vectors upfront. This is a tight loop with no
+       dependencies between iterations, so the compiler can vectorize it. */
+    std::vector<Cell> cells(data.size());
+    for(std::size_t i = 0; i != data.size(); ++i)
+        cells[i] = Cell{(data[i] - min)/cellSize};
+
+    /* Open-addressing hash table with linear probing, containing the first
+       unique vector for each occupied cell. Other unique vectors in the same
+       cell are chained through the `next` array. Power-of-two size with load
+       factor at most 2/3 even if all vectors are unique. */
+    std::size_t tableSize = 1;
+    while(tableSize < data.size() + data.size()/2) tableSize <<= 1;
+    const std::size_t tableMask = tableSize - 1;
+    std::vector<UnsignedInt> table(tableSize, Empty);
+    std::vector<UnsignedInt> next(data.size());
+
+    /* Unique vectors and their cells are compacted to the front of the data
+       and cell arrays in place, as the unique count never exceeds the count
+       of processed vectors */
     std::vector<UnsignedInt> resultIndices(data.size());
-    std::iota(resultIndices.begin(), resultIndices.end(), 0);
-
-    /* Table containing original vector index for each discretized vector.
-       Reserving more buckets than necessary (i.e. as if each vector was
-       unique). */
-    std::unordered_map<Math::Vector<Vector::Size, std::size_t>, UnsignedInt, Implementation::VectorHash<Vector::Size>> table(data.size());
-
-    /* Index array for each pass, new data array */
-    std::vector<UnsignedInt> indices;
-    indices.reserve(data.size());
-
-    /* First go with original coordinates, then move them by epsilon/2 in each
-       direction. */
-    Vector moved;
-    for(std::size_t moving = 0; moving <= Vector::Size; ++moving) {
-        /* Go through all vectors */
-        for(std::size_t i = 0; i != data.size(); ++i) {
-            /* Try to insert new vertex to the table */
-            const Math::Vector<Vector::Size, std::size_t> v((data[i] + moved - min)/epsilon);
-            const auto result = table.emplace(v, table.size());
-
-            /* Add the (either new or already existing) index to index array */
-            indices.push_back(result.first->second);
-
-            /* If this is new combination, copy the data to new (earlier)
-               possition in the array */
-            if(result.second && i != table.size()-1) data[table.size()-1] = data[i];
-        }
-
-        /* Shrink the data array */
-        CORRADE_INTERNAL_ASSERT(data.size() >= table.size());
-        data.resize(table.size());
+    UnsignedInt uniqueCount = 0;
+    const Vector epsilonVector{epsilon};
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        const Vector v = data[i];
+        const Cell cell = cells[i];
+
+        /* Find out in which direction the vector is nearer than epsilon to
+           the cell boundary */
+        const Vector offset = v - min - Vector{cell}*cellSize;
+        Cell direction;
+        for(std::size_t j = 0; j != Vector::Size; ++j)
+            direction[j] = offset[j] < epsilon ? -1 : cellSize - offset[j] < epsilon ? 1 : 0;
+
+        /* Go through the cell itself and all relevant neighbor combinations,
+           pick the earliest unique vector that's near enough */
+        UnsignedInt found = Empty;
+        for(UnsignedInt mask = 0; mask != (1u << Vector::Size); ++mask) {
+            Cell neighbor = cell;
+            bool skip = false;
+            for(std::size_t j = 0; j != Vector::Size; ++j) if(mask & (1u << j)) {
+                if(!direction[j]) {
+                    skip = true;
+                    break;
+                }
+                neighbor[j] += direction[j];
+            }
+            if(skip) continue;
 
-        /* Remap the resulting index array */
-        for(auto& i: resultIndices) i = indices[i];
+            std::size_t slot = Implementation::hashCell(neighbor) & tableMask;
+            while(table[slot] != Empty && cells[table[slot]] != neighbor)
+                slot = (slot + 1) & tableMask;
 
-        /* Finished */
-        if(moving == Vector::Size) continue;
+            for(UnsignedInt candidate = table[slot]; candidate != Empty; candidate = next[candidate])
+                if(candidate < found && (Math::abs(data[candidate] - v) < epsilonVector).all())
+                    found = candidate;
+        }
 
-        /* Move vertex coordinates by epsilon/2 in next direction */
-        moved = Vector();
-        moved[moving] = epsilon/2;
+        if(found != Empty) {
+            resultIndices[i] = found;
+            continue;
+        }
 
-        /* Clear the structures for next pass */
-        table.clear();
-        indices.clear();
+        /* New unique vector, insert it into its cell */
+        data[uniqueCount] = v;
+        cells[uniqueCount] = cell;
+        std::size_t slot = Implementation::hashCell(cell) & tableMask;
+        while(table[slot] != Empty && cells[table[slot]] != cell)
+            slot = (slot + 1) & tableMask;
+        next[uniqueCount] = table[slot];
+        table[slot] = uniqueCount;
+        resultIndices[i] = uniqueCount++;
     }
 
+    /* Shrink the data array */
+    data.resize(uniqueCount);
+
     return resultIndices;
 }
 
+/**
+@brief Remove exact duplicates from a strided array in place
+@param[in,out] data     Input data array, each item is @p size bytes
+@param[in] size         Size of a single item in bytes
+@param[out] indices     Where to put the resulting index array. Expected to
+    have the same size as @p data.
+@return Count of unique items
+
+Meant for discrete data such as packed integer or half-float attributes or
+whole vertices of an interleaved buffer, for which @ref removeDuplicates()
+would needlessly go through bucketing of floating-point values. Items are
+compared bytewise, so for example padding bytes have to be initialized and
+floating-point @cpp -0.0f @ce and @cpp 0.0f @ce are treated as different
+values. The first occurence of each item is kept and moved to the front of
+the array in the order of first occurence, @p indices are filled with
+position of the unique item for each original item. Expects that the
+@p data stride is not smaller than @p size.
+
+The data are processed in a single pass, looking up each item in an
+open-addressing hash table with linear probing. The only allocation done is
+the hash table itself, with about two slots per item.
+@see @ref removeDuplicatesExact(std::vector<T>&)
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesExactInPlace(const Containers::StridedArrayView<char>& data, std::size_t size, Containers::ArrayView<UnsignedInt> indices);
+
+/**
+@brief Remove exact duplicates from a typed strided array in place
+
+Equivalent to calling @ref removeDuplicatesExactInPlace(const Containers::StridedArrayView<char>&, std::size_t, Containers::ArrayView<UnsignedInt>)
+with @cpp sizeof(T) @ce as item size. Useful for deduplicating a single
+attribute of an interleaved vertex buffer.
+*/
+template<class T> std::size_t removeDuplicatesExactInPlace(const Containers::StridedArrayView<T>& data, Containers::ArrayView<UnsignedInt> indices) {
+    return removeDuplicatesExactInPlace(reinterpret_cast<const Containers::StridedArrayView<char>&>(data), sizeof(T), indices);
+}
+
+/**
+@brief Remove exact duplicates from given array
+@param[in,out] data Input data array
+@return Index array and unique data
+
+Discrete counterpart to @ref removeDuplicates(), see
+@ref removeDuplicatesExactInPlace(const Containers::StridedArrayView<char>&, std::size_t, Containers::ArrayView<UnsignedInt>)
+for details about the algorithm. The resulting index array can be used the
+same way as with @ref removeDuplicates():
+
+@snippet MagnumMeshTools.cpp removeDuplicatesExact
+*/
+template<class T> std::vector<UnsignedInt> removeDuplicatesExact(std::vector<T>& data) {
+    std::vector<UnsignedInt> indices(data.size());
+    data.resize(removeDuplicatesExactInPlace(Containers::StridedArrayView<char>{reinterpret_cast<char*>(data.data()), data.size(), sizeof(T)}, sizeof(T), {indices.data(), indices.size()}));
+    return indices;
+}
+
 }}
 
 #endif
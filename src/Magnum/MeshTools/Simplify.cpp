@@ -0,0 +1,448 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Simplify.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Weights of attribute differences, added to the squared distance error */
+constexpr Float NormalWeight = 0.01f;
+constexpr Float TextureCoordWeight = 0.01f;
+
+/* Weight of the planes perpendicular to border edges, relative to the
+   squared edge length. Larger values preserve the border shape better. */
+constexpr Float BorderWeight = 10.0f;
+
+struct Collapse {
+    Float cost;
+    UnsignedInt vertex;
+    UnsignedInt target;
+};
+
+/* Symmetric matrix A, vector b and scalar c of the quadric
+   Q(p) = pᵀAp + 2bᵀp + c, together with sum of the plane weights */
+struct Quadric {
+    Float a00, a01, a02, a11, a12, a22;
+    Float b0, b1, b2;
+    Float c;
+    Float w;
+};
+
+void addPlane(Quadric& q, const Vector3& normal, const Float distance, const Float weight) {
+    q.a00 += weight*normal.x()*normal.x();
+    q.a01 += weight*normal.x()*normal.y();
+    q.a02 += weight*normal.x()*normal.z();
+    q.a11 += weight*normal.y()*normal.y();
+    q.a12 += weight*normal.y()*normal.z();
+    q.a22 += weight*normal.z()*normal.z();
+    q.b0 += weight*normal.x()*distance;
+    q.b1 += weight*normal.y()*distance;
+    q.b2 += weight*normal.z()*distance;
+    q.c += weight*distance*distance;
+    q.w += weight;
+}
+
+void addQuadric(Quadric& q, const Quadric& other) {
+    q.a00 += other.a00;
+    q.a01 += other.a01;
+    q.a02 += other.a02;
+    q.a11 += other.a11;
+    q.a12 += other.a12;
+    q.a22 += other.a22;
+    q.b0 += other.b0;
+    q.b1 += other.b1;
+    q.b2 += other.b2;
+    q.c += other.c;
+    q.w += other.w;
+}
+
+/* Weighted average of squared distances to the planes */
+Float evaluate(const Quadric& q, const Vector3& p) {
+    const Float x = p.x(), y = p.y(), z = p.z();
+    const Float result =
+        q.a00*x*x + q.a11*y*y + q.a22*z*z +
+        2.0f*(q.a01*x*y + q.a02*x*z + q.a12*y*z) +
+        2.0f*(q.b0*x + q.b1*y + q.b2*z) + q.c;
+
+    /* Rounding errors can make it slightly negative */
+    return q.w == 0.0f ? 0.0f : Math::abs(result)/q.w;
+}
+
+inline UnsignedInt hashPosition(const UnsignedInt(&words)[3]) {
+    UnsignedInt hash = 2166136261u;
+    for(const UnsignedInt word: words) {
+        hash = (hash ^ word)*0x9e3779b1u;
+        hash ^= hash >> 15;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+/* Maps each vertex to the first vertex with bitwise equal position */
+std::vector<UnsignedInt> canonicalVertices(const std::vector<Vector3>& positions) {
+    constexpr UnsignedInt Empty = ~UnsignedInt{};
+    std::size_t tableSize = 1;
+    while(tableSize < positions.size() + positions.size()/2) tableSize <<= 1;
+    const std::size_t tableMask = tableSize - 1;
+    std::vector<UnsignedInt> table(tableSize, Empty);
+
+    std::vector<UnsignedInt> canonical(positions.size());
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        UnsignedInt words[3];
+        std::memcpy(words, positions[i].data(), sizeof(words));
+
+        std::size_t slot = hashPosition(words) & tableMask;
+        for(;; slot = (slot + 1) & tableMask) {
+            if(table[slot] == Empty) {
+                table[slot] = canonical[i] = i;
+                break;
+            }
+            if(std::memcmp(positions[table[slot]].data(), words, sizeof(words)) == 0) {
+                canonical[i] = table[slot];
+                break;
+            }
+        }
+    }
+
+    return canonical;
+}
+
+}
+
+std::vector<UnsignedInt> simplify(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoords, const std::size_t targetIndexCount, const Float targetError, Float* const resultError) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::simplify(): index count is not divisible by 3", {});
+    CORRADE_ASSERT(normals.empty() || normals.size() == positions.size(),
+        "MeshTools::simplify(): expected" << positions.size() << "normals but got" << normals.size(), {});
+    CORRADE_ASSERT(textureCoords.empty() || textureCoords.size() == positions.size(),
+        "MeshTools::simplify(): expected" << positions.size() << "texture coordinates but got" << textureCoords.size(), {});
+
+    if(resultError) *resultError = 0.0f;
+    std::vector<UnsignedInt> result = indices;
+    if(result.size() <= targetIndexCount) return result;
+
+    const std::size_t vertexCount = positions.size();
+
+    /* Scale the positions to an unit cube so the error is relative to mesh
+       size and the quadrics stay in a sane range */
+    Vector3 min{Constants::inf()}, max{-Constants::inf()};
+    for(const Vector3& position: positions) {
+        min = Math::min(min, position);
+        max = Math::max(max, position);
+    }
+    const Float extent = (max - min).max();
+    const Float scale = extent > 0.0f ? 1.0f/extent : 1.0f;
+    std::vector<Vector3> scaled(vertexCount);
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        scaled[i] = (positions[i] - min)*scale;
+
+    /* Vertices that share a position but differ in other attributes are
+       mapped to a single vertex for topology queries and are locked, as
+       moving just one of them would tear the mesh apart */
+    const std::vector<UnsignedInt> canonical = canonicalVertices(positions);
+    std::vector<UnsignedInt> wedgeCount(vertexCount);
+    for(std::size_t i = 0; i != vertexCount; ++i) ++wedgeCount[canonical[i]];
+
+    /* Quadrics of triangle planes weighted by triangle area */
+    std::vector<Quadric> quadrics(vertexCount);
+    for(std::size_t i = 0; i != result.size(); i += 3) {
+        const Vector3& a = scaled[result[i]];
+        const Vector3& b = scaled[result[i + 1]];
+        const Vector3& c = scaled[result[i + 2]];
+        Vector3 normal = Math::cross(b - a, c - a);
+        const Float length = normal.length();
+        if(length == 0.0f) continue;
+        normal /= length;
+        for(std::size_t j = 0; j != 3; ++j)
+            addPlane(quadrics[result[i + j]], normal, -Math::dot(normal, a), length*0.5f);
+    }
+
+    std::vector<UnsignedInt> triangleOffset(vertexCount + 1);
+    std::vector<UnsignedInt> vertexTriangles;
+    std::vector<UnsignedInt> edgesOut, edgesIn;
+    std::vector<Float> targetCost(vertexCount);
+    std::vector<Collapse> candidates;
+    std::vector<UnsignedInt> remap(vertexCount);
+    std::vector<bool> touched(vertexCount);
+    std::vector<UnsignedInt> stamp(vertexCount);
+    UnsignedInt currentStamp = 0;
+
+    /* Canonical vertices after and before the canonical vertex a in each
+       triangle adjacent to it. An edge a → b has an opposite if b is among
+       the vertices before a. */
+    auto gatherEdges = [&](const UnsignedInt a) {
+        edgesOut.clear();
+        edgesIn.clear();
+        for(UnsignedInt t = triangleOffset[a]; t != triangleOffset[a + 1]; ++t) {
+            const UnsignedInt* const triangle = result.data() + vertexTriangles[t]*3;
+            const std::size_t j = canonical[triangle[0]] == a ? 0 : canonical[triangle[1]] == a ? 1 : 2;
+            edgesOut.push_back(canonical[triangle[(j + 1) % 3]]);
+            edgesIn.push_back(canonical[triangle[(j + 2) % 3]]);
+        }
+    };
+    auto contains = [](const std::vector<UnsignedInt>& edges, const UnsignedInt b) {
+        return std::find(edges.begin(), edges.end(), b) != edges.end();
+    };
+
+    const Float maxCost = targetError*targetError;
+    Float error = 0.0f;
+    for(bool firstPass = true; result.size() > targetIndexCount; firstPass = false) {
+        const std::size_t triangleCount = result.size()/3;
+
+        /* Triangles adjacent to each vertex, with vertices sharing a
+           position treated as one. Offsets are shifted right at first,
+           filling shifts them back left. */
+        std::fill(triangleOffset.begin(), triangleOffset.end(), 0);
+        for(const UnsignedInt index: result) ++triangleOffset[canonical[index] + 1];
+        UnsignedInt sum = 0;
+        for(std::size_t i = 0; i != vertexCount; ++i) {
+            const UnsignedInt count = triangleOffset[i + 1];
+            triangleOffset[i + 1] = sum;
+            sum += count;
+        }
+        vertexTriangles.resize(result.size());
+        for(std::size_t i = 0; i != result.size(); ++i)
+            vertexTriangles[triangleOffset[canonical[result[i]] + 1]++] = i/3;
+
+        /* Planes perpendicular to the original border edges, so the border
+           doesn't shrink */
+        if(firstPass) for(UnsignedInt a = 0; a != vertexCount; ++a) {
+            if(canonical[a] != a) continue;
+
+            gatherEdges(a);
+            for(std::size_t e = 0; e != edgesOut.size(); ++e) {
+                if(contains(edgesIn, edgesOut[e])) continue;
+
+                const UnsignedInt* const triangle = result.data() + vertexTriangles[triangleOffset[a] + e]*3;
+                const std::size_t j = canonical[triangle[0]] == a ? 0 : canonical[triangle[1]] == a ? 1 : 2;
+                const UnsignedInt i0 = triangle[j];
+                const UnsignedInt i1 = triangle[(j + 1) % 3];
+                const Vector3 edge = scaled[i1] - scaled[i0];
+                const Vector3 triangleNormal = Math::cross(edge, scaled[triangle[(j + 2) % 3]] - scaled[i0]);
+                Vector3 normal = Math::cross(edge, triangleNormal);
+                const Float length = normal.length();
+                if(length == 0.0f) continue;
+                normal /= length;
+                const Float distance = -Math::dot(normal, scaled[i0]);
+                const Float weight = edge.dot()*BorderWeight;
+                addPlane(quadrics[i0], normal, distance, weight);
+                addPlane(quadrics[i1], normal, distance, weight);
+            }
+        }
+
+        /* Error accumulated in each vertex so far, which is a part of the
+           cost of collapsing to it. Vertices with other wedges are locked
+           and can't be a collapse target either, as it would be ambiguous
+           which of the wedges to use. */
+        for(std::size_t i = 0; i != vertexCount; ++i)
+            targetCost[i] = wedgeCount[canonical[i]] > 1 ? Constants::inf() : evaluate(quadrics[i], scaled[i]);
+
+        /* Cheapest collapse for each vertex. As vertices with other wedges
+           are excluded, both ends are their own canonical vertices and can
+           be used to query the adjacency directly. */
+        candidates.clear();
+        for(UnsignedInt a = 0; a != vertexCount; ++a) {
+            if(canonical[a] != a || wedgeCount[a] > 1) continue;
+
+            /* Each interior edge has exactly one opposite, edges without one
+               are on a border and edges appearing more than once are
+               non-manifold. Vertices with a non-manifold edge or more than
+               one border passing through them are locked, border vertices
+               can be collapsed only along the border. */
+            gatherEdges(a);
+            bool locked = false;
+            std::size_t borderEdgeCount = 0;
+            for(const UnsignedInt b: edgesOut) {
+                if(std::count(edgesOut.begin(), edgesOut.end(), b) > 1) locked = true;
+                if(!contains(edgesIn, b)) ++borderEdgeCount;
+            }
+            for(const UnsignedInt b: edgesIn) {
+                if(std::count(edgesIn.begin(), edgesIn.end(), b) > 1) locked = true;
+                if(!contains(edgesOut, b)) ++borderEdgeCount;
+            }
+            if(locked || (borderEdgeCount && borderEdgeCount != 2)) continue;
+
+            Collapse best{Constants::inf(), a, a};
+            auto consider = [&](const UnsignedInt b) {
+                if(targetCost[b] == Constants::inf()) return;
+                if(borderEdgeCount && contains(edgesOut, b) == contains(edgesIn, b)) return;
+
+                Float cost = evaluate(quadrics[a], scaled[b]) + targetCost[b];
+                if(!normals.empty())
+                    cost += NormalWeight*(normals[a] - normals[b]).dot();
+                if(!textureCoords.empty())
+                    cost += TextureCoordWeight*(textureCoords[a] - textureCoords[b]).dot();
+
+                if(cost < best.cost) {
+                    best.cost = cost;
+                    best.target = b;
+                }
+            };
+            /* For interior vertices the incoming edges have the same
+               vertices as outgoing */
+            for(const UnsignedInt b: edgesOut) consider(b);
+            if(borderEdgeCount) for(const UnsignedInt b: edgesIn) consider(b);
+
+            if(best.cost <= maxCost) candidates.push_back(best);
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const Collapse& a, const Collapse& b) {
+            return a.cost < b.cost;
+        });
+
+        /* Collapse in order of increasing cost. Vertices around each
+           collapse are not touched again in this pass, so the adjacency and
+           quadrics used for the remaining candidates stay valid. */
+        std::iota(remap.begin(), remap.end(), 0);
+        std::fill(touched.begin(), touched.end(), false);
+        const std::size_t trianglesToRemove = triangleCount - targetIndexCount/3;
+        std::size_t removed = 0;
+        for(const Collapse& collapse: candidates) {
+            if(removed >= trianglesToRemove) break;
+
+            const UnsignedInt a = collapse.vertex;
+            const UnsignedInt b = collapse.target;
+            if(touched[a] || touched[b]) continue;
+
+            /* Reject the collapse if any remaining triangle would flip */
+            bool flips = false;
+            std::size_t collapsed = 0;
+            for(UnsignedInt t = triangleOffset[a]; t != triangleOffset[a + 1]; ++t) {
+                const UnsignedInt* const triangle = result.data() + vertexTriangles[t]*3;
+                if(triangle[0] == b || triangle[1] == b || triangle[2] == b) {
+                    ++collapsed;
+                    continue;
+                }
+
+                const std::size_t j = triangle[0] == a ? 0 : triangle[1] == a ? 1 : 2;
+                const Vector3& p1 = scaled[triangle[(j + 1) % 3]];
+                const Vector3& p2 = scaled[triangle[(j + 2) % 3]];
+                const Vector3 before = Math::cross(p1 - scaled[a], p2 - scaled[a]);
+                const Vector3 after = Math::cross(p1 - scaled[b], p2 - scaled[b]);
+                if(Math::dot(before, after) <= 0.0f) {
+                    flips = true;
+                    break;
+                }
+            }
+            if(flips) continue;
+
+            /* Reject the collapse if a and b have a common neighbor that's
+               not a part of the collapsed triangles, as that would create a
+               non-manifold edge */
+            ++currentStamp;
+            for(UnsignedInt t = triangleOffset[b]; t != triangleOffset[b + 1]; ++t)
+                for(std::size_t j = 0; j != 3; ++j)
+                    stamp[canonical[result[vertexTriangles[t]*3 + j]]] = currentStamp;
+            for(UnsignedInt t = triangleOffset[a]; t != triangleOffset[a + 1]; ++t) {
+                const UnsignedInt* const triangle = result.data() + vertexTriangles[t]*3;
+                if(triangle[0] == b || triangle[1] == b || triangle[2] == b) {
+                    for(std::size_t j = 0; j != 3; ++j)
+                        stamp[canonical[triangle[j]]] = 0;
+                }
+            }
+            bool shared = false;
+            for(UnsignedInt t = triangleOffset[a]; t != triangleOffset[a + 1] && !shared; ++t) {
+                const UnsignedInt* const triangle = result.data() + vertexTriangles[t]*3;
+                for(std::size_t j = 0; j != 3; ++j) {
+                    if(stamp[canonical[triangle[j]]] != currentStamp) continue;
+                    shared = true;
+                    break;
+                }
+            }
+            if(shared) continue;
+
+            remap[a] = b;
+            touched[a] = touched[b] = true;
+            for(UnsignedInt t = triangleOffset[a]; t != triangleOffset[a + 1]; ++t)
+                for(std::size_t j = 0; j != 3; ++j)
+                    touched[result[vertexTriangles[t]*3 + j]] = true;
+
+            addQuadric(quadrics[b], quadrics[a]);
+            error = Math::max(error, collapse.cost);
+            removed += collapsed;
+        }
+
+        if(!removed) break;
+
+        /* Apply the collapses, removing triangles that became degenerate */
+        std::size_t out = 0;
+        for(std::size_t i = 0; i != result.size(); i += 3) {
+            const UnsignedInt a = remap[result[i]];
+            const UnsignedInt b = remap[result[i + 1]];
+            const UnsignedInt c = remap[result[i + 2]];
+            if(a == b || b == c || c == a) continue;
+            result[out++] = a;
+            result[out++] = b;
+            result[out++] = c;
+        }
+        result.resize(out);
+    }
+
+    if(resultError) *resultError = std::sqrt(error);
+    return result;
+}
+
+std::vector<UnsignedInt> simplify(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, Float* const resultError) {
+    return simplify(indices, positions, {}, {}, targetIndexCount, targetError, resultError);
+}
+
+std::vector<std::vector<UnsignedInt>> generateLods(const Trade::MeshData3D& mesh, const std::size_t levelCount, const Float ratio, const Float targetError) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles && mesh.isIndexed(),
+        "MeshTools::generateLods(): expected an indexed triangle mesh", {});
+
+    const std::vector<Vector3> noNormals;
+    const std::vector<Vector2> noTextureCoords;
+    const std::vector<Vector3>& positions = mesh.positions(0);
+    const std::vector<Vector3>& normals = mesh.hasNormals() ? mesh.normals(0) : noNormals;
+    const std::vector<Vector2>& textureCoords = mesh.hasTextureCoords2D() ? mesh.textureCoords2D(0) : noTextureCoords;
+
+    std::vector<std::vector<UnsignedInt>> levels;
+    levels.reserve(levelCount);
+    levels.push_back(mesh.indices());
+    while(levels.size() < levelCount) {
+        const std::size_t targetIndexCount = std::size_t(Float(levels.back().size()/3)*ratio)*3;
+        std::vector<UnsignedInt> level = simplify(levels.back(), positions, normals, textureCoords, targetIndexCount, targetError);
+        if(level.size() == levels.back().size()) break;
+        levels.push_back(std::move(level));
+    }
+
+    return levels;
+}
+
+}}
@@ -0,0 +1,112 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::simplify(), @ref Magnum::MeshTools::generateLods()
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Simplify a mesh
+@param indices          Index array of a triangle mesh
+@param positions        Vertex positions
+@param normals          Vertex normals. Can be empty.
+@param textureCoords    Vertex texture coordinates. Can be empty.
+@param targetIndexCount Desired index count
+@param targetError      Max allowed error, relative to mesh size
+@param[out] resultError If not @cpp nullptr @ce, the error of the resulting
+    mesh relative to mesh size is written here
+@return Index array of the simplified mesh, referencing the original vertices
+
+Repeatedly collapses edges of the mesh until the index count is at most
+@p targetIndexCount or until the next collapse would introduce an error
+larger than @p targetError. The error is a distance from the original
+surface, measured as a fraction of the largest dimension of mesh bounding
+box. Algorithm used: *Michael Garland and Paul S. Heckbert --- Surface
+Simplification Using Quadric Error Metrics, SIGGRAPH 1997,
+https://www.cs.cmu.edu/~./garland/Papers/quadrics.pdf*.
+
+Edges are always collapsed to one of their endpoints, so the result
+references a subset of the original vertices and can share the vertex buffer
+with the original mesh. Differences in normals and texture coordinates
+between the endpoints are added to the collapse cost. Mesh borders are only
+collapsed along the border, vertices where the normals or texture
+coordinates are discontinuous (i.e., multiple vertices with the same
+position) and vertices on non-manifold edges are kept in place, so no cracks
+appear. Collapses that would flip a triangle are rejected.
+
+The collapses are done in passes, each pass collapsing a set of independent
+edges in order of increasing cost, which makes both the time and the memory
+use linear in the mesh size. Apart from the output, the memory used is
+roughly 100 bytes per vertex and 8 bytes per index.
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+@see @ref generateLods(), @ref subdivide()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> simplify(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoords, std::size_t targetIndexCount, Float targetError = 1.0e-2f, Float* resultError = nullptr);
+
+/**
+@brief Simplify a mesh using just its positions
+
+Equivalent to calling @ref simplify(const std::vector<UnsignedInt>&, const std::vector<Vector3>&, const std::vector<Vector3>&, const std::vector<Vector2>&, std::size_t, Float, Float*)
+with empty normal and texture coordinate arrays.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> simplify(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, std::size_t targetIndexCount, Float targetError = 1.0e-2f, Float* resultError = nullptr);
+
+/**
+@brief Generate a chain of mesh LODs
+@param mesh         Indexed triangle mesh
+@param levelCount   Max count of levels, including the original
+@param ratio        Triangle count ratio between consecutive levels
+@param targetError  Max allowed error of each level compared to the
+    previous one, relative to mesh size
+@return Index arrays of the levels, the first being the original index
+    array
+
+Each level is created by calling @ref simplify() on the previous level with
+target triangle count being @p ratio times the previous count, using the
+first position, normal and texture coordinate array of @p mesh. All levels
+reference the original vertex data of @p mesh. If a level can't be
+simplified further without exceeding @p targetError, the chain ends early.
+Example usage:
+
+@snippet MagnumMeshTools.cpp generateLods
+
+Expects that the mesh is indexed and has @ref MeshPrimitive::Triangles.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<std::vector<UnsignedInt>> generateLods(const Trade::MeshData3D& mesh, std::size_t levelCount, Float ratio = 0.5f, Float targetError = 1.0e-2f);
+
+}}
+
+#endif
@@ -0,0 +1,169 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Subdivide.h"
+
+#include <atomic>
+#include <memory>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/MeshTools/Implementation/parallel.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+namespace {
+
+/* Below this count of faces per thread it's not worth spawning threads */
+constexpr std::size_t MinFacesPerThread = 16384;
+
+constexpr UnsignedLong EmptyKey = ~UnsignedLong{};
+constexpr UnsignedInt NoOwner = ~UnsignedInt{};
+
+inline UnsignedLong edgeKey(const UnsignedInt a, const UnsignedInt b) {
+    return a < b ? (UnsignedLong(a) << 32)|b : (UnsignedLong(b) << 32)|a;
+}
+
+}
+
+std::vector<UnsignedInt> subdivideSharedIndices(std::vector<UnsignedInt>& indices, const std::size_t vertexCount, UnsignedInt threadCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivideShared(): index count is not divisible by 3", {});
+
+    const std::size_t faceCount = indices.size()/3;
+    const std::size_t edgeSlotCount = indices.size();
+    threadCount = effectiveThreadCount(threadCount, faceCount, MinFacesPerThread);
+
+    /* The table has at least twice as many cells as there are edge slots,
+       so the load factor is at most 0.5 even if no edges are shared */
+    std::size_t capacity = 1;
+    UnsignedInt capacityBits = 0;
+    while(capacity < edgeSlotCount*2) {
+        capacity <<= 1;
+        ++capacityBits;
+    }
+    const std::size_t mask = capacity - 1;
+
+    /* Edge keys, slot of the first face edge referencing given edge and ID of
+       the new vertex for each cell, table cell for each face edge */
+    std::unique_ptr<std::atomic<UnsignedLong>[]> keys{new std::atomic<UnsignedLong>[capacity]};
+    std::unique_ptr<std::atomic<UnsignedInt>[]> owners{new std::atomic<UnsignedInt>[capacity]};
+    std::unique_ptr<UnsignedInt[]> vertexIds{new UnsignedInt[capacity]};
+    std::unique_ptr<UnsignedInt[]> edgeCells{new UnsignedInt[edgeSlotCount]};
+    std::vector<std::size_t> newVertexCount(threadCount);
+
+    parallelFor(threadCount, capacity, [&](const std::size_t begin, const std::size_t end, UnsignedInt) {
+        for(std::size_t i = begin; i != end; ++i) {
+            keys[i].store(EmptyKey, std::memory_order_relaxed);
+            owners[i].store(NoOwner, std::memory_order_relaxed);
+        }
+    });
+
+    /* Insert all edges, for each remembering the first face edge that
+       references it. Threads only synchronize on the table cells, the
+       ordering is given by the slot index and not by which thread came
+       first. */
+    parallelFor(threadCount, faceCount, [&](const std::size_t begin, const std::size_t end, UnsignedInt) {
+        for(std::size_t slot = begin*3; slot != end*3; ++slot) {
+            const UnsignedInt a = indices[slot];
+            const UnsignedInt b = indices[slot - slot%3 + (slot + 1)%3];
+            const UnsignedLong key = edgeKey(a, b);
+
+            /* Fibonacci hashing, linear probing */
+            std::size_t cell = std::size_t((key*11400714819323198485ull) >> (64 - capacityBits)) & mask;
+            for(;;) {
+                UnsignedLong existing = keys[cell].load(std::memory_order_relaxed);
+                if(existing == EmptyKey && keys[cell].compare_exchange_strong(existing, key, std::memory_order_relaxed))
+                    break;
+                if(existing == key) break;
+                cell = (cell + 1) & mask;
+            }
+            edgeCells[slot] = UnsignedInt(cell);
+
+            UnsignedInt owner = owners[cell].load(std::memory_order_relaxed);
+            while(slot < owner && !owners[cell].compare_exchange_weak(owner, UnsignedInt(slot), std::memory_order_relaxed));
+        }
+    });
+
+    /* Count the edges owned by each range, then assign the new vertex IDs
+       in order of the owning slots */
+    parallelFor(threadCount, faceCount, [&](const std::size_t begin, const std::size_t end, const UnsignedInt rangeId) {
+        std::size_t count = 0;
+        for(std::size_t slot = begin*3; slot != end*3; ++slot)
+            if(owners[edgeCells[slot]].load(std::memory_order_relaxed) == slot) ++count;
+        newVertexCount[rangeId] = count;
+    });
+
+    std::size_t totalNewVertexCount = 0;
+    for(std::size_t& count: newVertexCount) {
+        const std::size_t offset = totalNewVertexCount;
+        totalNewVertexCount += count;
+        count = offset;
+    }
+
+    std::vector<UnsignedInt> edges(totalNewVertexCount*2);
+    parallelFor(threadCount, faceCount, [&](const std::size_t begin, const std::size_t end, const UnsignedInt rangeId) {
+        std::size_t id = newVertexCount[rangeId];
+        for(std::size_t slot = begin*3; slot != end*3; ++slot) {
+            const UnsignedInt cell = edgeCells[slot];
+            if(owners[cell].load(std::memory_order_relaxed) != slot) continue;
+            vertexIds[cell] = UnsignedInt(vertexCount + id);
+            edges[id*2] = indices[slot];
+            edges[id*2 + 1] = indices[slot - slot%3 + (slot + 1)%3];
+            ++id;
+        }
+    });
+
+    /* Subdivide each face to four new, in the same layout as subdivide().
+       The original face is replaced with the middle one, the three others
+       are appended. */
+    indices.resize(indices.size()*4);
+    parallelFor(threadCount, faceCount, [&](const std::size_t begin, const std::size_t end, UnsignedInt) {
+        for(std::size_t i = begin; i != end; ++i) {
+            UnsignedInt* const face = indices.data() + i*3;
+            UnsignedInt* const newFaces = indices.data() + faceCount*3 + i*9;
+            const UnsignedInt newVertices[]{
+                vertexIds[edgeCells[i*3 + 0]],
+                vertexIds[edgeCells[i*3 + 1]],
+                vertexIds[edgeCells[i*3 + 2]]
+            };
+
+            newFaces[0] = face[0];
+            newFaces[1] = newVertices[0];
+            newFaces[2] = newVertices[2];
+            newFaces[3] = newVertices[0];
+            newFaces[4] = face[1];
+            newFaces[5] = newVertices[1];
+            newFaces[6] = newVertices[2];
+            newFaces[7] = newVertices[1];
+            newFaces[8] = face[2];
+            face[0] = newVertices[0];
+            face[1] = newVertices[1];
+            face[2] = newVertices[2];
+        }
+    });
+
+    return edges;
+}
+
+}}}
@@ -26,12 +26,15 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::subdivide()
+ * @brief Function @ref Magnum::MeshTools::subdivide(), @ref Magnum::MeshTools::subdivideShared()
  */
 
 #include <vector>
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
@@ -58,6 +61,11 @@ template<class Vertex, class Interpolator> class Subdivide {
         }
 };
 
+/* Subdivides the index array in place, assigning a single new vertex to each
+   unique edge. Returns pairs of original vertex indices to interpolate for
+   each new vertex, the new vertices are numbered from vertexCount. */
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> subdivideSharedIndices(std::vector<UnsignedInt>& indices, std::size_t vertexCount, UnsignedInt threadCount);
+
 }
 
 /**
@@ -71,11 +79,45 @@ template<class Vertex, class Interpolator> class Subdivide {
 
 Goes through all triangle faces and subdivides them into four new. Removing
 duplicate vertices in the mesh is up to user.
+@see @ref subdivideShared()
 */
 template<class Vertex, class Interpolator> inline void subdivide(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator) {
     Implementation::Subdivide<Vertex, Interpolator>(indices, vertices)(interpolator);
 }
 
+/**
+@brief Subdivide the mesh, sharing vertices of common edges
+@tparam Vertex          Vertex data type
+@tparam Interpolator    See `interpolator` function parameter
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param interpolator     Functor or function pointer which interpolates
+    two adjacent vertices: `Vertex interpolator(Vertex a, Vertex b)`
+@param threadCount      Count of threads to use, including the calling one.
+    If @cpp 0 @ce, @ref std::thread::hardware_concurrency() is used.
+
+Produces the same triangles as @ref subdivide(), but edges shared by more
+faces get only a single new vertex. Unlike with @ref subdivide(), there's no
+need to call @ref removeDuplicates() afterwards, as long as the original mesh
+didn't contain any duplicates. Edges are identified by their vertex indices
+in an open-addressing hash map, so vertices that have the same data but
+different indices are not considered shared.
+
+The faces are split into contiguous ranges processed in parallel. New
+vertices are numbered in order of first occurrence of their edge in
+@p indices, so the output is the same regardless of @p threadCount. Small
+meshes are always processed on a single thread. The @p interpolator is
+called on the calling thread only.
+*/
+template<class Vertex, class Interpolator> void subdivideShared(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator, UnsignedInt threadCount = 0) {
+    const std::vector<UnsignedInt> edges = Implementation::subdivideSharedIndices(indices, vertices.size(), threadCount);
+
+    /* Reserve first so the references to existing items stay valid */
+    vertices.reserve(vertices.size() + edges.size()/2);
+    for(std::size_t i = 0; i != edges.size(); i += 2)
+        vertices.push_back(interpolator(vertices[edges[i]], vertices[edges[i + 1]]));
+}
+
 namespace Implementation {
 
 template<class Vertex, class Interpolator> void Subdivide<Vertex, Interpolator>::operator()(Interpolator interpolator) {
@@ -0,0 +1,113 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/BuildMeshlets.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct BuildMeshletsBenchmark: TestSuite::Tester {
+    explicit BuildMeshletsBenchmark();
+
+    void build();
+    void cull();
+};
+
+constexpr UnsignedInt Subdivisions[]{5, 6, 7, 8};
+
+enum: std::size_t { CullSubdivisions = 8 };
+
+constexpr struct {
+    const char* name;
+    bool frustum, backface;
+} CullData[] {
+    {"frustum", true, false},
+    {"backface", false, true},
+    {"frustum + backface", true, true}
+};
+
+BuildMeshletsBenchmark::BuildMeshletsBenchmark() {
+    addInstancedBenchmarks({&BuildMeshletsBenchmark::build}, 1,
+        Containers::arraySize(Subdivisions));
+
+    addInstancedBenchmarks({&BuildMeshletsBenchmark::cull}, 10,
+        Containers::arraySize(CullData));
+}
+
+void BuildMeshletsBenchmark::build() {
+    const UnsignedInt subdivisions = Subdivisions[testCaseInstanceId()];
+    Trade::MeshData3D icosphere = Primitives::icosphereSolid(subdivisions);
+    setTestCaseDescription(std::to_string(icosphere.indices().size()/3) + " triangles");
+
+    MeshletData meshlets;
+    CORRADE_BENCHMARK(1) {
+        meshlets = MeshTools::buildMeshlets(icosphere);
+    }
+
+    CORRADE_COMPARE_AS(meshlets.meshlets.size(), icosphere.indices().size()/3/126, TestSuite::Compare::Greater);
+}
+
+void BuildMeshletsBenchmark::cull() {
+    auto&& data = CullData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const MeshletData meshlets = MeshTools::buildMeshlets(Primitives::icosphereSolid(CullSubdivisions));
+
+    /* Camera close to the sphere surface, seeing a part of it */
+    const Vector3 cameraPosition{0.0f, 0.0f, 1.5f};
+    const Frustum frustum = Frustum::fromMatrix(
+        Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.01f, 100.0f)*
+        Matrix4::translation(-cameraPosition));
+
+    std::size_t visible = 0;
+    CORRADE_BENCHMARK(1) {
+        visible = 0;
+        for(const Meshlet& meshlet: meshlets.meshlets) {
+            if(data.frustum && !Math::Intersection::sphereFrustum(meshlet.center, meshlet.radius, frustum))
+                continue;
+            if(data.backface && Math::Intersection::pointCone(cameraPosition, meshlet.coneOrigin, meshlet.coneNormal, meshlet.coneAngle))
+                continue;
+            ++visible;
+        }
+    }
+
+    CORRADE_COMPARE_AS(visible, std::size_t(0), TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(visible, meshlets.meshlets.size(), TestSuite::Compare::Less);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BuildMeshletsBenchmark)
@@ -0,0 +1,285 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshTools/BuildMeshlets.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct BuildMeshletsTest: TestSuite::Tester {
+    explicit BuildMeshletsTest();
+
+    void grid();
+    void limits();
+    void closed();
+    void frustum();
+    void meshData();
+
+    void wrongIndexCount();
+    void wrongLimits();
+    void meshDataNotIndexed();
+
+    void verify(const MeshletData& data, const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, UnsignedInt maxVertexCount, UnsignedInt maxTriangleCount);
+};
+
+BuildMeshletsTest::BuildMeshletsTest() {
+    addTests({&BuildMeshletsTest::grid,
+              &BuildMeshletsTest::limits,
+              &BuildMeshletsTest::closed,
+              &BuildMeshletsTest::frustum,
+              &BuildMeshletsTest::meshData,
+
+              &BuildMeshletsTest::wrongIndexCount,
+              &BuildMeshletsTest::wrongLimits,
+              &BuildMeshletsTest::meshDataNotIndexed});
+}
+
+/* 16x16 grid in the XY plane, facing +Z */
+void grid(std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions) {
+    for(Int y = 0; y <= 16; ++y)
+        for(Int x = 0; x <= 16; ++x)
+            positions.emplace_back(x, y, 0);
+
+    for(UnsignedInt y = 0; y != 16; ++y) {
+        for(UnsignedInt x = 0; x != 16; ++x) {
+            const UnsignedInt a = y*17 + x;
+            const UnsignedInt b = a + 1;
+            const UnsignedInt c = a + 17;
+            const UnsignedInt d = c + 1;
+            indices.insert(indices.end(), {a, b, d, a, d, c});
+        }
+    }
+}
+
+/* Checks that the meshlets reference exactly the original triangles with the
+   same winding, are in limits and have bounding spheres containing all
+   vertices */
+void BuildMeshletsTest::verify(const MeshletData& data, const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, UnsignedInt maxVertexCount, UnsignedInt maxTriangleCount) {
+    std::vector<std::array<UnsignedInt, 3>> expected, actual;
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        expected.push_back({{indices[i], indices[i + 1], indices[i + 2]}});
+
+    std::size_t vertexOffset = 0, indexOffset = 0;
+    for(const Meshlet& meshlet: data.meshlets) {
+        CORRADE_COMPARE(meshlet.vertexOffset, vertexOffset);
+        CORRADE_COMPARE(meshlet.indexOffset, indexOffset);
+        CORRADE_COMPARE_AS(meshlet.vertexCount, maxVertexCount, TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(meshlet.triangleCount, maxTriangleCount, TestSuite::Compare::LessOrEqual);
+        CORRADE_VERIFY(meshlet.triangleCount);
+        vertexOffset += meshlet.vertexCount;
+        indexOffset += meshlet.triangleCount*3;
+
+        for(std::size_t i = 0; i != meshlet.vertexCount; ++i)
+            CORRADE_COMPARE_AS((positions[data.vertices[meshlet.vertexOffset + i]] - meshlet.center).length(), meshlet.radius*1.0001f, TestSuite::Compare::LessOrEqual);
+
+        for(std::size_t i = 0; i != meshlet.triangleCount*3; i += 3) {
+            const UnsignedByte* triangle = data.indices.data() + meshlet.indexOffset + i;
+            CORRADE_COMPARE_AS(UnsignedInt(triangle[0]), meshlet.vertexCount, TestSuite::Compare::Less);
+            CORRADE_COMPARE_AS(UnsignedInt(triangle[1]), meshlet.vertexCount, TestSuite::Compare::Less);
+            CORRADE_COMPARE_AS(UnsignedInt(triangle[2]), meshlet.vertexCount, TestSuite::Compare::Less);
+            actual.push_back({{data.vertices[meshlet.vertexOffset + triangle[0]],
+                               data.vertices[meshlet.vertexOffset + triangle[1]],
+                               data.vertices[meshlet.vertexOffset + triangle[2]]}});
+        }
+    }
+    CORRADE_COMPARE(vertexOffset, data.vertices.size());
+    CORRADE_COMPARE(indexOffset, data.indices.size());
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    CORRADE_VERIFY(actual == expected);
+}
+
+void BuildMeshletsTest::grid() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    Test::grid(indices, positions);
+
+    MeshletData data = MeshTools::buildMeshlets(indices, positions);
+    verify(data, indices, positions, 64, 126);
+
+    /* 512 triangles, which is at least five meshlets. The meshlets should be
+       reasonably full. */
+    CORRADE_COMPARE_AS(data.meshlets.size(), std::size_t(5), TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(data.meshlets.size(), std::size_t(8), TestSuite::Compare::LessOrEqual);
+
+    /* All meshlets are facing +Z, so they're all culled from below and none
+       from above */
+    for(const Meshlet& meshlet: data.meshlets) {
+        CORRADE_COMPARE(meshlet.coneNormal, -Vector3::zAxis());
+        CORRADE_VERIFY(Math::Intersection::pointCone({8.0f, 8.0f, -10.0f}, meshlet.coneOrigin, meshlet.coneNormal, meshlet.coneAngle));
+        CORRADE_VERIFY(Math::Intersection::pointCone({20.0f, -4.0f, -1.0f}, meshlet.coneOrigin, meshlet.coneNormal, meshlet.coneAngle));
+        CORRADE_VERIFY(!Math::Intersection::pointCone({8.0f, 8.0f, 10.0f}, meshlet.coneOrigin, meshlet.coneNormal, meshlet.coneAngle));
+        CORRADE_VERIFY(!Math::Intersection::pointCone({20.0f, -4.0f, 1.0f}, meshlet.coneOrigin, meshlet.coneNormal, meshlet.coneAngle));
+    }
+}
+
+void BuildMeshletsTest::limits() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    Test::grid(indices, positions);
+
+    /* Each triangle separately */
+    MeshletData single = MeshTools::buildMeshlets(indices, positions, 3, 1);
+    verify(single, indices, positions, 3, 1);
+    CORRADE_COMPARE(single.meshlets.size(), 512);
+    CORRADE_COMPARE(single.vertices.size(), 512*3);
+
+    /* Limited by vertex count */
+    MeshletData vertexLimited = MeshTools::buildMeshlets(indices, positions, 9, 1000);
+    verify(vertexLimited, indices, positions, 9, 1000);
+
+    /* Everything in a single meshlet */
+    MeshletData whole = MeshTools::buildMeshlets(indices, positions, 256, 512);
+    verify(whole, indices, positions, 256, 512);
+    CORRADE_COMPARE(whole.meshlets.size(), 2);
+}
+
+void BuildMeshletsTest::closed() {
+    /* Octahedron, normals pointing outside */
+    const std::vector<Vector3> positions{
+        {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}, {0.0f, -1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}};
+    const std::vector<UnsignedInt> indices{
+        0, 2, 4, 2, 1, 4, 1, 3, 4, 3, 0, 4,
+        2, 0, 5, 1, 2, 5, 3, 1, 5, 0, 3, 5};
+
+    /* The whole mesh can't be backface-culled */
+    MeshletData whole = MeshTools::buildMeshlets(indices, positions);
+    verify(whole, indices, positions, 64, 126);
+    CORRADE_COMPARE(whole.meshlets.size(), 1);
+    CORRADE_COMPARE(whole.meshlets[0].coneAngle, Rad{0.0f});
+    CORRADE_COMPARE(whole.meshlets[0].center, Vector3{});
+    CORRADE_COMPARE(whole.meshlets[0].radius, 1.0f);
+
+    /* Single triangles are culled from the inside and from the back, but not
+       from the front */
+    MeshletData single = MeshTools::buildMeshlets(indices, positions, 3, 1);
+    verify(single, indices, positions, 3, 1);
+    CORRADE_COMPARE(single.meshlets.size(), 8);
+    for(const Meshlet& meshlet: single.meshlets) {
+        CORRADE_COMPARE_AS(meshlet.coneAngle, Rad{0.0f}, TestSuite::Compare::Greater);
+        CORRADE_VERIFY(Math::Intersection::pointCone(Vector3{}, meshlet.coneOrigin, meshlet.coneNormal, meshlet.coneAngle));
+        CORRADE_VERIFY(Math::Intersection::pointCone(-meshlet.center*10.0f, meshlet.coneOrigin, meshlet.coneNormal, meshlet.coneAngle));
+        CORRADE_VERIFY(!Math::Intersection::pointCone(meshlet.center*10.0f, meshlet.coneOrigin, meshlet.coneNormal, meshlet.coneAngle));
+    }
+}
+
+void BuildMeshletsTest::frustum() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    Test::grid(indices, positions);
+
+    MeshletData data = MeshTools::buildMeshlets(indices, positions, 16, 16);
+
+    /* Everything is inside a frustum covering the whole grid, nothing is
+       inside a frustum next to it, and only some meshlets are inside a
+       frustum covering a quarter of it */
+    const Frustum all = Frustum::fromMatrix(Matrix4::orthographicProjection({16.0f, 16.0f}, -1.0f, 1.0f)*Matrix4::translation({-8.0f, -8.0f, 0.0f}));
+    const Frustum none = Frustum::fromMatrix(Matrix4::orthographicProjection({16.0f, 16.0f}, -1.0f, 1.0f)*Matrix4::translation({-32.0f, -8.0f, 0.0f}));
+    const Frustum quarter = Frustum::fromMatrix(Matrix4::orthographicProjection({4.0f, 4.0f}, -1.0f, 1.0f)*Matrix4::translation({-2.0f, -2.0f, 0.0f}));
+    std::size_t inAll = 0, inNone = 0, inQuarter = 0;
+    for(const Meshlet& meshlet: data.meshlets) {
+        inAll += Math::Intersection::sphereFrustum(meshlet.center, meshlet.radius, all);
+        inNone += Math::Intersection::sphereFrustum(meshlet.center, meshlet.radius, none);
+        inQuarter += Math::Intersection::sphereFrustum(meshlet.center, meshlet.radius, quarter);
+    }
+    CORRADE_COMPARE(inAll, data.meshlets.size());
+    CORRADE_COMPARE(inNone, 0);
+    CORRADE_COMPARE_AS(inQuarter, std::size_t(0), TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(inQuarter, data.meshlets.size(), TestSuite::Compare::Less);
+
+    /* A cone looking at the grid from above sees all meshlets, a cone
+       looking away doesn't see any */
+    std::size_t inCone = 0, inConeAway = 0;
+    for(const Meshlet& meshlet: data.meshlets) {
+        inCone += Math::Intersection::sphereCone(meshlet.center, meshlet.radius, {8.0f, 8.0f, 10.0f}, -Vector3::zAxis(), Rad{Constants::pi()*2.0f/3.0f});
+        inConeAway += Math::Intersection::sphereCone(meshlet.center, meshlet.radius, {8.0f, 8.0f, 10.0f}, Vector3::zAxis(), Rad{Constants::pi()*2.0f/3.0f});
+    }
+    CORRADE_COMPARE(inCone, data.meshlets.size());
+    CORRADE_COMPARE(inConeAway, 0);
+}
+
+void BuildMeshletsTest::meshData() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    Test::grid(indices, positions);
+
+    Trade::MeshData3D mesh{MeshPrimitive::Triangles, indices, {positions}, {}, {}, {}};
+    MeshletData data = MeshTools::buildMeshlets(mesh, 32, 32);
+    MeshletData expected = MeshTools::buildMeshlets(indices, positions, 32, 32);
+    CORRADE_COMPARE(data.meshlets.size(), expected.meshlets.size());
+    CORRADE_VERIFY(data.vertices == expected.vertices);
+    CORRADE_VERIFY(data.indices == expected.indices);
+}
+
+void BuildMeshletsTest::wrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MeshTools::buildMeshlets({0, 1}, {{}, {}});
+    CORRADE_COMPARE(out.str(), "MeshTools::buildMeshlets(): index count is not divisible by 3\n");
+}
+
+void BuildMeshletsTest::wrongLimits() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MeshTools::buildMeshlets({0, 1, 2}, {{}, {}, {}}, 2, 1);
+    MeshTools::buildMeshlets({0, 1, 2}, {{}, {}, {}}, 257, 1);
+    MeshTools::buildMeshlets({0, 1, 2}, {{}, {}, {}}, 3, 0);
+    MeshTools::buildMeshlets({0, 1, 3}, {{}, {}, {}}, 3, 1);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::buildMeshlets(): expected max vertex count between 3 and 256 but got 2\n"
+        "MeshTools::buildMeshlets(): expected max vertex count between 3 and 256 but got 257\n"
+        "MeshTools::buildMeshlets(): expected non-zero max triangle count\n"
+        "MeshTools::buildMeshlets(): index 3 out of range for 3 vertices\n");
+}
+
+void BuildMeshletsTest::meshDataNotIndexed() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Trade::MeshData3D mesh{MeshPrimitive::Triangles, {}, {{{}, {}, {}}}, {}, {}, {}};
+    MeshTools::buildMeshlets(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::buildMeshlets(): expected an indexed triangle mesh\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BuildMeshletsTest)
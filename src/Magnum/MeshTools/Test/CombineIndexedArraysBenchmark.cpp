@@ -0,0 +1,202 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/MurmurHash2.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/CombineIndexedArrays.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct CombineIndexedArraysBenchmark: TestSuite::Tester {
+    explicit CombineIndexedArraysBenchmark();
+
+    void naive();
+    void combineIndexArrays();
+    void combineIndexArraysInto();
+};
+
+/* Quad grids of given size, resulting in 6*(size - 1)^2 corners */
+const struct {
+    const char* name;
+    UnsignedInt size;
+} Data[]{
+    {"60k corners", 101},
+    {"1.5M corners", 501},
+    {"6M corners", 1001}
+};
+
+/* Index data as produced by an OBJ importer -- positions and texture
+   coordinates shared among neighboring quads, normals shared only inside a
+   quad, resulting in four unique combinations for every six corners */
+struct Corner {
+    UnsignedInt position;
+    UnsignedInt textureCoordinates;
+    UnsignedInt normal;
+};
+
+Containers::Array<Corner> generateGrid(const UnsignedInt size) {
+    Containers::Array<Corner> corners{Containers::NoInit, 6*std::size_t(size - 1)*(size - 1)};
+    std::size_t i = 0;
+    for(UnsignedInt y = 0; y + 1 < size; ++y) for(UnsignedInt x = 0; x + 1 < size; ++x) {
+        const UnsignedInt a = y*size + x, b = a + 1, c = a + size, d = c + 1;
+        const UnsignedInt normal = y*(size - 1) + x;
+        for(const UnsignedInt index: {a, b, d, a, d, c})
+            corners[i++] = {index, index, normal};
+    }
+
+    return corners;
+}
+
+/* Equivalent to the original implementation, for comparison -- interleaving
+   the arrays and deduplicating with a hash map using MurmurHash */
+std::size_t combineNaive(std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride) {
+    struct Hash {
+        std::size_t operator()(UnsignedInt key) const {
+            return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(indices.data() + key*stride), sizeof(UnsignedInt)*stride).byteArray());
+        }
+
+        const std::vector<UnsignedInt>& indices;
+        UnsignedInt stride;
+    };
+    struct Equal {
+        bool operator()(UnsignedInt a, UnsignedInt b) const {
+            return std::memcmp(indices.data() + a*stride, indices.data() + b*stride, sizeof(UnsignedInt)*stride) == 0;
+        }
+
+        const std::vector<UnsignedInt>& indices;
+        UnsignedInt stride;
+    };
+
+    const std::size_t size = interleavedArrays.size()/stride;
+    std::unordered_map<UnsignedInt, UnsignedInt, Hash, Equal> combinations{size,
+        Hash{interleavedArrays, stride}, Equal{interleavedArrays, stride}};
+    std::vector<UnsignedInt> combinedIndices;
+    combinedIndices.reserve(size);
+    std::vector<UnsignedInt> newInterleavedArrays;
+    for(std::size_t i = 0; i != size; ++i) {
+        const auto result = combinations.emplace(i, combinations.size());
+        combinedIndices.push_back(result.first->second);
+        if(result.second) newInterleavedArrays.insert(newInterleavedArrays.end(),
+            interleavedArrays.begin() + i*stride,
+            interleavedArrays.begin() + (i + 1)*stride);
+    }
+
+    return combinations.size();
+}
+
+CombineIndexedArraysBenchmark::CombineIndexedArraysBenchmark() {
+    addInstancedBenchmarks({&CombineIndexedArraysBenchmark::naive,
+                            &CombineIndexedArraysBenchmark::combineIndexArrays,
+                            &CombineIndexedArraysBenchmark::combineIndexArraysInto}, 1,
+        Containers::arraySize(Data));
+}
+
+void CombineIndexedArraysBenchmark::naive() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<Corner> corners = generateGrid(data.size);
+
+    /* The original implementation interleaved the separate arrays first, so
+       include that in the measurement as well */
+    std::vector<UnsignedInt> positions, textureCoordinates, normals;
+    positions.reserve(corners.size());
+    textureCoordinates.reserve(corners.size());
+    normals.reserve(corners.size());
+    for(const Corner& corner: corners) {
+        positions.push_back(corner.position);
+        textureCoordinates.push_back(corner.textureCoordinates);
+        normals.push_back(corner.normal);
+    }
+
+    std::size_t uniqueCount = 0;
+    CORRADE_BENCHMARK(1) {
+        std::vector<UnsignedInt> interleaved(corners.size()*3);
+        for(std::size_t i = 0; i != corners.size(); ++i) {
+            interleaved[i*3 + 0] = positions[i];
+            interleaved[i*3 + 1] = textureCoordinates[i];
+            interleaved[i*3 + 2] = normals[i];
+        }
+        uniqueCount = combineNaive(interleaved, 3);
+    }
+
+    CORRADE_COMPARE(uniqueCount, corners.size()/6*4);
+}
+
+void CombineIndexedArraysBenchmark::combineIndexArrays() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::vector<UnsignedInt> positions, textureCoordinates, normals;
+    {
+        const Containers::Array<Corner> corners = generateGrid(data.size);
+        positions.reserve(corners.size());
+        textureCoordinates.reserve(corners.size());
+        normals.reserve(corners.size());
+        for(const Corner& corner: corners) {
+            positions.push_back(corner.position);
+            textureCoordinates.push_back(corner.textureCoordinates);
+            normals.push_back(corner.normal);
+        }
+    }
+
+    const std::size_t cornerCount = positions.size();
+    CORRADE_BENCHMARK(1) {
+        MeshTools::combineIndexArrays({positions, textureCoordinates, normals});
+    }
+
+    CORRADE_COMPARE(positions.size(), cornerCount/6*4);
+}
+
+void CombineIndexedArraysBenchmark::combineIndexArraysInto() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Operating directly on the interleaved structure, with all memory
+       allocated upfront */
+    Containers::Array<Corner> corners = generateGrid(data.size);
+    Containers::Array<UnsignedInt> combinedIndices{Containers::NoInit, corners.size()};
+    Containers::Array<UnsignedInt> scratch{Containers::NoInit, MeshTools::combineIndexArraysScratchSize(corners.size())};
+
+    std::size_t uniqueCount = 0;
+    CORRADE_BENCHMARK(1) {
+        uniqueCount = MeshTools::combineIndexArraysInto({
+            {&corners[0].position, corners.size(), sizeof(Corner)},
+            {&corners[0].textureCoordinates, corners.size(), sizeof(Corner)},
+            {&corners[0].normal, corners.size(), sizeof(Corner)}
+        }, combinedIndices, scratch);
+    }
+
+    CORRADE_COMPARE(uniqueCount, corners.size()/6*4);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CombineIndexedArraysBenchmark)
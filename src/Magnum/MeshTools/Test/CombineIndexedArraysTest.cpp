@@ -25,7 +25,9 @@
 
 #include <functional>
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/MeshTools/CombineIndexedArrays.h"
@@ -37,13 +39,35 @@ struct CombineIndexedArraysTest: TestSuite::Tester {
 
     void wrongIndexCount();
     void indexArrays();
+    void interleavedIndexArrays();
     void indexedArrays();
+    void indexedArraysConstIndices();
+
+    void scratchSize();
+    void into();
+    void intoStrided();
+    void intoManyArrays();
+    void intoEmpty();
+    void intoNoArrays();
+    void intoWrongSize();
+    void intoScratchTooSmall();
 };
 
 CombineIndexedArraysTest::CombineIndexedArraysTest() {
     addTests({&CombineIndexedArraysTest::wrongIndexCount,
               &CombineIndexedArraysTest::indexArrays,
-              &CombineIndexedArraysTest::indexedArrays});
+              &CombineIndexedArraysTest::interleavedIndexArrays,
+              &CombineIndexedArraysTest::indexedArrays,
+              &CombineIndexedArraysTest::indexedArraysConstIndices,
+
+              &CombineIndexedArraysTest::scratchSize,
+              &CombineIndexedArraysTest::into,
+              &CombineIndexedArraysTest::intoStrided,
+              &CombineIndexedArraysTest::intoManyArrays,
+              &CombineIndexedArraysTest::intoEmpty,
+              &CombineIndexedArraysTest::intoNoArrays,
+              &CombineIndexedArraysTest::intoWrongSize,
+              &CombineIndexedArraysTest::intoScratchTooSmall});
 }
 
 void CombineIndexedArraysTest::wrongIndexCount() {
@@ -68,6 +92,16 @@ void CombineIndexedArraysTest::indexArrays() {
     CORRADE_COMPARE(c, (std::vector<UnsignedInt>{6, 7}));
 }
 
+void CombineIndexedArraysTest::interleavedIndexArrays() {
+    /* Same as in the documentation */
+    std::vector<UnsignedInt> result;
+    std::vector<UnsignedInt> interleaved;
+    std::tie(result, interleaved) = MeshTools::combineIndexArrays(
+        std::vector<UnsignedInt>{0, 1, 2, 3, 5, 4, 0, 1, 0, 4, 1, 6, 3, 1, 2, 3, 2, 1}, 2);
+    CORRADE_COMPARE(result, (std::vector<UnsignedInt>{0, 1, 2, 0, 3, 4, 5, 1, 6}));
+    CORRADE_COMPARE(interleaved, (std::vector<UnsignedInt>{0, 1, 2, 3, 5, 4, 0, 4, 1, 6, 3, 1, 2, 1}));
+}
+
 void CombineIndexedArraysTest::indexedArrays() {
     std::vector<UnsignedInt> a{0, 1, 0};
     std::vector<UnsignedInt> b{3, 4, 3};
@@ -87,6 +121,170 @@ void CombineIndexedArraysTest::indexedArrays() {
     CORRADE_COMPARE(array3, (std::vector<UnsignedInt>{6, 7}));
 }
 
+void CombineIndexedArraysTest::indexedArraysConstIndices() {
+    /* Same as in the combineIndexArrays() documentation, the index arrays
+       are expected to stay untouched */
+    const std::vector<UnsignedInt> positionIndices{0, 2, 5, 0, 0, 1, 3, 2, 2};
+    const std::vector<UnsignedInt> normalIndices{1, 3, 4, 1, 4, 6, 1, 3, 1};
+    std::vector<Int> positions{10, 11, 12, 13, 14, 15};
+    std::vector<Int> normals{20, 21, 22, 23, 24, 25, 26};
+
+    std::vector<UnsignedInt> result = MeshTools::combineIndexedArrays(
+        std::make_pair(std::cref(positionIndices), std::ref(positions)),
+        std::make_pair(std::cref(normalIndices), std::ref(normals)));
+
+    CORRADE_COMPARE(result, (std::vector<UnsignedInt>{0, 1, 2, 0, 3, 4, 5, 1, 6}));
+    CORRADE_COMPARE(positions, (std::vector<Int>{10, 12, 15, 10, 11, 13, 12}));
+    CORRADE_COMPARE(normals, (std::vector<Int>{21, 23, 24, 24, 26, 21, 21}));
+    CORRADE_COMPARE(positionIndices, (std::vector<UnsignedInt>{0, 2, 5, 0, 0, 1, 3, 2, 2}));
+    CORRADE_COMPARE(normalIndices, (std::vector<UnsignedInt>{1, 3, 4, 1, 4, 6, 1, 3, 1}));
+}
+
+void CombineIndexedArraysTest::scratchSize() {
+    CORRADE_COMPARE(MeshTools::combineIndexArraysScratchSize(0), 1);
+    CORRADE_COMPARE(MeshTools::combineIndexArraysScratchSize(1), 1);
+    CORRADE_COMPARE(MeshTools::combineIndexArraysScratchSize(2), 4);
+    CORRADE_COMPARE(MeshTools::combineIndexArraysScratchSize(11), 16);
+    CORRADE_COMPARE(MeshTools::combineIndexArraysScratchSize(12), 32);
+}
+
+void CombineIndexedArraysTest::into() {
+    /* Same as in the combineIndexArrays() documentation */
+    UnsignedInt a[]{0, 2, 5, 0, 0, 1, 3, 2, 2};
+    UnsignedInt b[]{1, 3, 4, 1, 4, 6, 1, 3, 1};
+    UnsignedInt combined[9];
+    UnsignedInt scratch[16];
+
+    CORRADE_COMPARE(MeshTools::combineIndexArraysInto({
+        {a, 9, sizeof(UnsignedInt)},
+        {b, 9, sizeof(UnsignedInt)}
+    }, combined, scratch), 7);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const UnsignedInt>{combined},
+        (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {0, 1, 2, 0, 3, 4, 5, 1, 6}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedInt>>);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const UnsignedInt>{a}.prefix(7),
+        (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {0, 2, 5, 0, 1, 3, 2}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedInt>>);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const UnsignedInt>{b}.prefix(7),
+        (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {1, 3, 4, 4, 6, 1, 1}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedInt>>);
+}
+
+void CombineIndexedArraysTest::intoStrided() {
+    /* Index members of a structure, with some unrelated data in between */
+    struct Corner {
+        UnsignedInt position;
+        Float unrelated;
+        UnsignedInt normal;
+    } corners[]{
+        {0, 1.0f, 1},
+        {2, 2.0f, 3},
+        {5, 3.0f, 4},
+        {0, 4.0f, 1},
+        {0, 5.0f, 4},
+        {1, 6.0f, 6},
+        {3, 7.0f, 1},
+        {2, 8.0f, 3},
+        {2, 9.0f, 1}
+    };
+    UnsignedInt combined[9];
+    UnsignedInt scratch[16];
+
+    CORRADE_COMPARE(MeshTools::combineIndexArraysInto({
+        {&corners[0].position, 9, sizeof(Corner)},
+        {&corners[0].normal, 9, sizeof(Corner)}
+    }, combined, scratch), 7);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const UnsignedInt>{combined},
+        (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {0, 1, 2, 0, 3, 4, 5, 1, 6}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedInt>>);
+
+    constexpr UnsignedInt expectedPositions[]{0, 2, 5, 0, 1, 3, 2};
+    constexpr UnsignedInt expectedNormals[]{1, 3, 4, 4, 6, 1, 1};
+    for(std::size_t i = 0; i != 7; ++i) {
+        CORRADE_COMPARE(corners[i].position, expectedPositions[i]);
+        CORRADE_COMPARE(corners[i].normal, expectedNormals[i]);
+    }
+
+    /* The unrelated data stay untouched */
+    CORRADE_COMPARE(corners[8].unrelated, 9.0f);
+}
+
+void CombineIndexedArraysTest::intoManyArrays() {
+    /* More arrays than there are specialized code paths for */
+    UnsignedInt a[]{0, 1, 0, 0};
+    UnsignedInt b[]{2, 3, 2, 2};
+    UnsignedInt c[]{4, 5, 4, 4};
+    UnsignedInt d[]{6, 7, 6, 6};
+    UnsignedInt e[]{8, 9, 8, 7};
+    UnsignedInt combined[4];
+    UnsignedInt scratch[8];
+
+    CORRADE_COMPARE(MeshTools::combineIndexArraysInto({
+        {a, 4, sizeof(UnsignedInt)},
+        {b, 4, sizeof(UnsignedInt)},
+        {c, 4, sizeof(UnsignedInt)},
+        {d, 4, sizeof(UnsignedInt)},
+        {e, 4, sizeof(UnsignedInt)}
+    }, combined, scratch), 3);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const UnsignedInt>{combined},
+        (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {0, 1, 0, 2}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedInt>>);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const UnsignedInt>{e}.prefix(3),
+        (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {8, 9, 7}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedInt>>);
+}
+
+void CombineIndexedArraysTest::intoEmpty() {
+    UnsignedInt scratch[1];
+    CORRADE_COMPARE(MeshTools::combineIndexArraysInto({
+        {nullptr, 0, sizeof(UnsignedInt)},
+        {nullptr, 0, sizeof(UnsignedInt)}
+    }, nullptr, scratch), 0);
+}
+
+void CombineIndexedArraysTest::intoNoArrays() {
+    UnsignedInt scratch[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::combineIndexArraysInto(nullptr, nullptr, scratch);
+    CORRADE_COMPARE(out.str(), "MeshTools::combineIndexArraysInto(): no index arrays given\n");
+}
+
+void CombineIndexedArraysTest::intoWrongSize() {
+    UnsignedInt a[3]{};
+    UnsignedInt b[2]{};
+    UnsignedInt combined[3];
+    UnsignedInt scratch[8];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::combineIndexArraysInto({
+        {a, 3, sizeof(UnsignedInt)},
+        {b, 2, sizeof(UnsignedInt)}
+    }, combined, scratch);
+    MeshTools::combineIndexArraysInto({
+        {a, 3, sizeof(UnsignedInt)},
+        {a, 3, sizeof(UnsignedInt)}
+    }, {combined, 2}, scratch);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::combineIndexArraysInto(): expected 3 items in array 1 but got 2\n"
+        "MeshTools::combineIndexArraysInto(): expected 2 items in array 0 but got 3\n");
+}
+
+void CombineIndexedArraysTest::intoScratchTooSmall() {
+    UnsignedInt a[5]{};
+    UnsignedInt combined[5];
+    UnsignedInt scratch[7];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::combineIndexArraysInto({
+        {a, 5, sizeof(UnsignedInt)}
+    }, combined, scratch);
+    CORRADE_COMPARE(out.str(), "MeshTools::combineIndexArraysInto(): expected at least 8 scratch items but got 7\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CombineIndexedArraysTest)
@@ -25,6 +25,7 @@
 
 #include <sstream>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/Endianness.h>
@@ -41,6 +42,17 @@ struct CompressIndicesTest: TestSuite::Tester {
     void compressInt();
 
     void compressAsShort();
+
+    void compressIntoUnsignedInt();
+    void compressIntoUnsignedShort();
+    void compressIntoUnsignedByte();
+    void compressIntoStrided();
+    void compressIntoInPlace();
+    void compressIntoBaseVertex();
+    void compressIntoBaseVertexLarge();
+    void compressIntoLarge();
+    void compressIntoEmpty();
+    void compressIntoOutputTooSmall();
 };
 
 CompressIndicesTest::CompressIndicesTest() {
@@ -48,7 +60,18 @@ CompressIndicesTest::CompressIndicesTest() {
               &CompressIndicesTest::compressShort,
               &CompressIndicesTest::compressInt,
 
-              &CompressIndicesTest::compressAsShort});
+              &CompressIndicesTest::compressAsShort,
+
+              &CompressIndicesTest::compressIntoUnsignedInt,
+              &CompressIndicesTest::compressIntoUnsignedShort,
+              &CompressIndicesTest::compressIntoUnsignedByte,
+              &CompressIndicesTest::compressIntoStrided,
+              &CompressIndicesTest::compressIntoInPlace,
+              &CompressIndicesTest::compressIntoBaseVertex,
+              &CompressIndicesTest::compressIntoBaseVertexLarge,
+              &CompressIndicesTest::compressIntoLarge,
+              &CompressIndicesTest::compressIntoEmpty,
+              &CompressIndicesTest::compressIntoOutputTooSmall});
 }
 
 void CompressIndicesTest::compressChar() {
@@ -125,6 +148,195 @@ void CompressIndicesTest::compressAsShort() {
     CORRADE_COMPARE(out.str(), "MeshTools::compressIndicesAs(): type too small to represent value 65536\n");
 }
 
+void CompressIndicesTest::compressIntoUnsignedInt() {
+    const UnsignedInt indices[]{1, 256, 0, 5};
+    UnsignedShort out[4];
+
+    MeshIndexType type;
+    UnsignedInt start, end;
+    std::tie(type, start, end) = MeshTools::compressIndicesInto(
+        {indices, 4, sizeof(UnsignedInt)},
+        {reinterpret_cast<char*>(out), sizeof(out)});
+
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 256);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const UnsignedShort>{out},
+        (Containers::Array<UnsignedShort>{Containers::InPlaceInit, {1, 256, 0, 5}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedShort>>);
+}
+
+void CompressIndicesTest::compressIntoUnsignedShort() {
+    const UnsignedShort indices[]{1, 255, 0, 5, 17};
+    UnsignedByte out[5];
+
+    MeshIndexType type;
+    UnsignedInt start, end;
+    std::tie(type, start, end) = MeshTools::compressIndicesInto(
+        {indices, 5, sizeof(UnsignedShort)},
+        {reinterpret_cast<char*>(out), sizeof(out)});
+
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 255);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const UnsignedByte>{out},
+        (Containers::Array<UnsignedByte>{Containers::InPlaceInit, {1, 255, 0, 5, 17}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedByte>>);
+}
+
+void CompressIndicesTest::compressIntoUnsignedByte() {
+    const UnsignedByte indices[]{12, 13, 11, 14};
+    UnsignedByte out[4];
+
+    MeshIndexType type;
+    UnsignedInt start, end;
+    std::tie(type, start, end) = MeshTools::compressIndicesInto(
+        {indices, 4, sizeof(UnsignedByte)},
+        {reinterpret_cast<char*>(out), sizeof(out)}, true);
+
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(start, 11);
+    CORRADE_COMPARE(end, 14);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const UnsignedByte>{out},
+        (Containers::Array<UnsignedByte>{Containers::InPlaceInit, {1, 2, 0, 3}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedByte>>);
+}
+
+void CompressIndicesTest::compressIntoStrided() {
+    /* Every second item is an index, the rest is garbage that should not
+       affect the range */
+    const UnsignedInt indices[]{
+        3, 0xffffffff,
+        70000, 0xffffffff,
+        2, 0,
+        5, 0xffffffff
+    };
+    UnsignedInt out[4];
+
+    MeshIndexType type;
+    UnsignedInt start, end;
+    std::tie(type, start, end) = MeshTools::compressIndicesInto(
+        {indices, 4, 2*sizeof(UnsignedInt)},
+        {reinterpret_cast<char*>(out), sizeof(out)});
+
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE(start, 2);
+    CORRADE_COMPARE(end, 70000);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const UnsignedInt>{out},
+        (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {3, 70000, 2, 5}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedInt>>);
+}
+
+void CompressIndicesTest::compressIntoInPlace() {
+    /* Enough items to go through the SIMD path as well */
+    UnsignedInt indices[37];
+    for(std::size_t i = 0; i != Containers::arraySize(indices); ++i)
+        indices[i] = (i*7) % 37;
+
+    MeshIndexType type;
+    UnsignedInt start, end;
+    std::tie(type, start, end) = MeshTools::compressIndicesInto(
+        {indices, 37, sizeof(UnsignedInt)},
+        {reinterpret_cast<char*>(indices), sizeof(indices)});
+
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 36);
+    const UnsignedByte* out = reinterpret_cast<const UnsignedByte*>(indices);
+    for(std::size_t i = 0; i != 37; ++i) {
+        CORRADE_COMPARE(out[i], UnsignedByte((i*7) % 37));
+    }
+}
+
+void CompressIndicesTest::compressIntoBaseVertex() {
+    /* The range fits into 16 bits, the values don't */
+    const UnsignedInt indices[]{100002, 165000, 100000, 100001};
+    UnsignedShort out[4];
+
+    MeshIndexType type;
+    UnsignedInt start, end;
+    std::tie(type, start, end) = MeshTools::compressIndicesInto(
+        Containers::arrayView(indices),
+        {reinterpret_cast<char*>(out), sizeof(out)}, true);
+
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(start, 100000);
+    CORRADE_COMPARE(end, 165000);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const UnsignedShort>{out},
+        (Containers::Array<UnsignedShort>{Containers::InPlaceInit, {2, 65000, 0, 1}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const UnsignedShort>>);
+}
+
+void CompressIndicesTest::compressIntoBaseVertexLarge() {
+    /* Base near the top of the 32-bit range, size not divisible by the SIMD
+       width to test the remainder handling as well */
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, 21};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = 0xfffffff0u - UnsignedInt((i*4099) % 60000);
+    indices[20] = 0xfffffff0u - 65000;
+
+    Containers::Array<char> out{Containers::NoInit, indices.size()*sizeof(UnsignedShort)};
+
+    MeshIndexType type;
+    UnsignedInt start, end;
+    std::tie(type, start, end) = MeshTools::compressIndicesInto(
+        {indices.data(), indices.size(), sizeof(UnsignedInt)}, out, true);
+
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(start, 0xfffffff0u - 65000);
+    CORRADE_COMPARE(end, 0xfffffff0u);
+    const UnsignedShort* data = reinterpret_cast<const UnsignedShort*>(out.data());
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        CORRADE_COMPARE(data[i], UnsignedShort(indices[i] - start));
+    }
+}
+
+void CompressIndicesTest::compressIntoLarge() {
+    /* Sizes not divisible by the SIMD width to test the remainder handling
+       as well, the smallest and largest value placed at the very end */
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, 1001};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = 70000 + (i*31) % 900;
+    indices[999] = 69999;
+    indices[1000] = 135534;
+
+    Containers::Array<char> out{Containers::NoInit, indices.size()*sizeof(UnsignedShort)};
+
+    MeshIndexType type;
+    UnsignedInt start, end;
+    std::tie(type, start, end) = MeshTools::compressIndicesInto(
+        {indices.data(), indices.size(), sizeof(UnsignedInt)}, out, true);
+
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(start, 69999);
+    CORRADE_COMPARE(end, 135534);
+    const UnsignedShort* data = reinterpret_cast<const UnsignedShort*>(out.data());
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        CORRADE_COMPARE(data[i], UnsignedShort(indices[i] - 69999));
+    }
+}
+
+void CompressIndicesTest::compressIntoEmpty() {
+    MeshIndexType type;
+    UnsignedInt start, end;
+    std::tie(type, start, end) = MeshTools::compressIndicesInto(
+        Containers::StridedArrayView<const UnsignedInt>{nullptr, 0, sizeof(UnsignedInt)}, nullptr);
+
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(start, 0);
+    CORRADE_COMPARE(end, 0);
+}
+
+void CompressIndicesTest::compressIntoOutputTooSmall() {
+    const UnsignedInt indices[]{1, 256, 0, 5};
+    char buffer[7];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::compressIndicesInto({indices, 4, sizeof(UnsignedInt)}, buffer);
+    CORRADE_COMPARE(out.str(), "MeshTools::compressIndicesInto(): expected at least 8 bytes for the output but got 7\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompressIndicesTest)
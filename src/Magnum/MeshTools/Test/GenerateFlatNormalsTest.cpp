@@ -36,11 +36,17 @@ struct GenerateFlatNormalsTest: TestSuite::Tester {
 
     void wrongIndexCount();
     void generate();
+
+    void nonIndexed();
+    void nonIndexedWrongCount();
 };
 
 GenerateFlatNormalsTest::GenerateFlatNormalsTest() {
     addTests({&GenerateFlatNormalsTest::wrongIndexCount,
-              &GenerateFlatNormalsTest::generate});
+              &GenerateFlatNormalsTest::generate,
+
+              &GenerateFlatNormalsTest::nonIndexed,
+              &GenerateFlatNormalsTest::nonIndexedWrongCount});
 }
 
 void GenerateFlatNormalsTest::wrongIndexCount() {
@@ -81,6 +87,41 @@ void GenerateFlatNormalsTest::generate() {
     }));
 }
 
+void GenerateFlatNormalsTest::nonIndexed() {
+    /* Same as above, but with the positions duplicated */
+    const Vector3 positions[]{
+        {-1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f}
+    };
+
+    CORRADE_COMPARE(MeshTools::generateFlatNormals(positions), (std::vector<Vector3>{
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        -Vector3::zAxis(),
+        -Vector3::zAxis(),
+        -Vector3::zAxis()
+    }));
+}
+
+void GenerateFlatNormalsTest::nonIndexedWrongCount() {
+    const Vector3 positions[4];
+    Vector3 normals[3];
+
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::generateFlatNormalsInto(positions, normals);
+    MeshTools::generateFlatNormalsInto({positions, 3}, {normals, 2});
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::generateFlatNormalsInto(): position count is not divisible by 3\n"
+        "MeshTools::generateFlatNormalsInto(): expected 3 normals but got 2\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateFlatNormalsTest)
@@ -0,0 +1,198 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/GenerateSmoothNormals.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct GenerateSmoothNormalsTest: TestSuite::Tester {
+    explicit GenerateSmoothNormalsTest();
+
+    void wrongIndexCount();
+    void wrongOutputSize();
+    void indexOutOfBounds();
+
+    void plane();
+    void weighting();
+    void empty();
+    void multipleThreads();
+};
+
+const struct {
+    const char* name;
+    NormalWeighting weighting;
+} PlaneData[]{
+    {"angle weighting", NormalWeighting::Angle},
+    {"area weighting", NormalWeighting::Area}
+};
+
+GenerateSmoothNormalsTest::GenerateSmoothNormalsTest() {
+    addTests({&GenerateSmoothNormalsTest::wrongIndexCount,
+              &GenerateSmoothNormalsTest::wrongOutputSize,
+              &GenerateSmoothNormalsTest::indexOutOfBounds});
+
+    addInstancedTests({&GenerateSmoothNormalsTest::plane},
+        Containers::arraySize(PlaneData));
+
+    addTests({&GenerateSmoothNormalsTest::weighting,
+              &GenerateSmoothNormalsTest::empty,
+              &GenerateSmoothNormalsTest::multipleThreads});
+}
+
+void GenerateSmoothNormalsTest::wrongIndexCount() {
+    const UnsignedInt indices[]{0, 1};
+    const Vector3 positions[2];
+    Vector3 normals[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateSmoothNormalsInto(indices, positions, normals);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateSmoothNormalsInto(): index count is not divisible by 3\n");
+}
+
+void GenerateSmoothNormalsTest::wrongOutputSize() {
+    const UnsignedInt indices[]{0, 1, 2};
+    const Vector3 positions[3];
+    Vector3 normals[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateSmoothNormalsInto(indices, positions, normals);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateSmoothNormalsInto(): expected 3 normals but got 4\n");
+}
+
+void GenerateSmoothNormalsTest::indexOutOfBounds() {
+    const UnsignedInt indices[]{0, 3, 2};
+    const Vector3 positions[3];
+    Vector3 normals[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateSmoothNormalsInto(indices, positions, normals);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateSmoothNormalsInto(): index 3 out of bounds for 3 elements\n");
+}
+
+void GenerateSmoothNormalsTest::plane() {
+    auto&& data = PlaneData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Two faces of a different size and shape in a single plane, all
+       normals should be the same regardless of the weighting */
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        0, 2, 3
+    };
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {-5.0f, 3.0f, 0.0f}
+    };
+
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(indices, positions, data.weighting), (std::vector<Vector3>{
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis()
+    }));
+}
+
+void GenerateSmoothNormalsTest::weighting() {
+    /* Two perpendicular faces sharing the first vertex, both with a right
+       angle in it but the second one having twice the area. The last face
+       is degenerate and shouldn't affect the result, the last vertex is not
+       referenced at all. */
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        0, 3, 4,
+        0, 1, 1
+    };
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 2.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {7.0f, 7.0f, 7.0f}
+    };
+
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(indices, positions, NormalWeighting::Angle), (std::vector<Vector3>{
+        Vector3{1.0f, 0.0f, 1.0f}.normalized(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::xAxis(),
+        Vector3::xAxis(),
+        Vector3{}
+    }));
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(indices, positions, NormalWeighting::Area), (std::vector<Vector3>{
+        Vector3{2.0f, 0.0f, 1.0f}.normalized(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::xAxis(),
+        Vector3::xAxis(),
+        Vector3{}
+    }));
+}
+
+void GenerateSmoothNormalsTest::empty() {
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(nullptr, nullptr), std::vector<Vector3>{});
+}
+
+void GenerateSmoothNormalsTest::multipleThreads() {
+    /* A bumpy grid large enough to be split among more threads */
+    constexpr UnsignedInt Size = 320;
+    std::vector<Vector3> positions;
+    positions.reserve(Size*Size);
+    for(UnsignedInt y = 0; y != Size; ++y) for(UnsignedInt x = 0; x != Size; ++x)
+        positions.emplace_back(Float(x), Float(y), Float((x*7 + y*13) % 5)*0.1f);
+    std::vector<UnsignedInt> indices;
+    indices.reserve((Size - 1)*(Size - 1)*6);
+    for(UnsignedInt y = 0; y + 1 != Size; ++y) for(UnsignedInt x = 0; x + 1 != Size; ++x) {
+        const UnsignedInt a = y*Size + x, b = a + 1, c = a + Size, d = c + 1;
+        indices.insert(indices.end(), {a, b, d, a, d, c});
+    }
+
+    const std::vector<Vector3> single = MeshTools::generateSmoothNormals(indices, positions, NormalWeighting::Angle, 1);
+    const std::vector<Vector3> multiple = MeshTools::generateSmoothNormals(indices, positions, NormalWeighting::Angle, 4);
+
+    /* The sums are done in the same order in both cases, so the results
+       should be bit-exact */
+    CORRADE_COMPARE(multiple.size(), single.size());
+    CORRADE_VERIFY(std::memcmp(multiple.data(), single.data(), single.size()*sizeof(Vector3)) == 0);
+
+    /* Inner vertices point up, roughly */
+    CORRADE_COMPARE_AS(single[Size*Size/2 + Size/2].z(), 0.5f,
+        TestSuite::Compare::Greater);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateSmoothNormalsTest)
@@ -0,0 +1,318 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshTools/GenerateTangents.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct GenerateTangentsTest: TestSuite::Tester {
+    explicit GenerateTangentsTest();
+
+    void wrongIndexCount();
+    void wrongSize();
+    void indexOutOfBounds();
+
+    void generate();
+    void orthogonalize();
+    void degenerate();
+    void multipleThreads();
+    void interleaved();
+
+    void meshData();
+    void meshDataNotIndexed();
+    void meshDataNoNormals();
+};
+
+/* A quad in the XY plane */
+constexpr UnsignedInt QuadIndices[]{
+    0, 1, 2,
+    0, 2, 3
+};
+const Vector3 QuadPositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f}
+};
+const Vector3 QuadNormals[]{
+    Vector3::zAxis(),
+    Vector3::zAxis(),
+    Vector3::zAxis(),
+    Vector3::zAxis()
+};
+
+const struct {
+    const char* name;
+    Vector2 textureCoordinates[4];
+    Vector4 expected;
+} GenerateData[]{
+    {"texture coordinates same as positions",
+        {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}},
+        {1.0f, 0.0f, 0.0f, 1.0f}},
+    /* U goes in the opposite direction, bitangent stays the same */
+    {"mirrored texture coordinates",
+        {{0.0f, 0.0f}, {-1.0f, 0.0f}, {-1.0f, 1.0f}, {0.0f, 1.0f}},
+        {-1.0f, 0.0f, 0.0f, -1.0f}},
+    /* U goes along Y, V along -X */
+    {"rotated texture coordinates",
+        {{0.0f, 0.0f}, {0.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 0.0f}},
+        {0.0f, 1.0f, 0.0f, 1.0f}},
+    /* Non-uniform scale of the texture doesn't change the direction */
+    {"scaled texture coordinates",
+        {{0.0f, 0.0f}, {3.0f, 0.0f}, {3.0f, 0.5f}, {0.0f, 0.5f}},
+        {1.0f, 0.0f, 0.0f, 1.0f}}
+};
+
+GenerateTangentsTest::GenerateTangentsTest() {
+    addTests({&GenerateTangentsTest::wrongIndexCount,
+              &GenerateTangentsTest::wrongSize,
+              &GenerateTangentsTest::indexOutOfBounds});
+
+    addInstancedTests({&GenerateTangentsTest::generate},
+        Containers::arraySize(GenerateData));
+
+    addTests({&GenerateTangentsTest::orthogonalize,
+              &GenerateTangentsTest::degenerate,
+              &GenerateTangentsTest::multipleThreads,
+              &GenerateTangentsTest::interleaved,
+
+              &GenerateTangentsTest::meshData,
+              &GenerateTangentsTest::meshDataNotIndexed,
+              &GenerateTangentsTest::meshDataNoNormals});
+}
+
+void GenerateTangentsTest::wrongIndexCount() {
+    const UnsignedInt indices[]{0, 1};
+    const Vector3 positions[2];
+    const Vector3 normals[2];
+    const Vector2 textureCoordinates[2];
+    Vector4 tangents[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateTangentsInto(indices, positions, normals, textureCoordinates, tangents);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateTangentsInto(): index count is not divisible by 3\n");
+}
+
+void GenerateTangentsTest::wrongSize() {
+    const UnsignedInt indices[]{0, 1, 2};
+    const Vector3 positions[3];
+    const Vector3 normals[3];
+    const Vector2 textureCoordinates[3];
+    Vector4 tangents[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateTangentsInto(indices, positions, {normals, 2}, textureCoordinates, tangents);
+    MeshTools::generateTangentsInto(indices, positions, normals, {textureCoordinates, 2}, tangents);
+    MeshTools::generateTangentsInto(indices, positions, normals, textureCoordinates, {tangents, 2});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): expected 3 normals but got 2\n"
+        "MeshTools::generateTangentsInto(): expected 3 texture coordinates but got 2\n"
+        "MeshTools::generateTangentsInto(): expected 3 tangents but got 2\n");
+}
+
+void GenerateTangentsTest::indexOutOfBounds() {
+    const UnsignedInt indices[]{0, 3, 2};
+    const Vector3 positions[3];
+    const Vector3 normals[3];
+    const Vector2 textureCoordinates[3];
+    Vector4 tangents[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateTangentsInto(indices, positions, normals, textureCoordinates, tangents);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateTangentsInto(): index 3 out of bounds for 3 elements\n");
+}
+
+void GenerateTangentsTest::generate() {
+    auto&& data = GenerateData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    CORRADE_COMPARE(MeshTools::generateTangents(QuadIndices, QuadPositions, QuadNormals, data.textureCoordinates), (std::vector<Vector4>{
+        data.expected,
+        data.expected,
+        data.expected,
+        data.expected
+    }));
+}
+
+void GenerateTangentsTest::orthogonalize() {
+    /* The normals are tilted, the tangents should be perpendicular to them
+       while still pointing roughly in the direction of U */
+    const Vector3 normals[]{
+        Vector3{1.0f, 0.0f, 1.0f}.normalized(),
+        Vector3{1.0f, 0.0f, 1.0f}.normalized(),
+        Vector3{1.0f, 0.0f, 1.0f}.normalized(),
+        Vector3{1.0f, 0.0f, 1.0f}.normalized()
+    };
+    const Vector2 textureCoordinates[]{
+        {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}
+    };
+
+    const Vector4 expected{Vector3{1.0f, 0.0f, -1.0f}.normalized(), 1.0f};
+    CORRADE_COMPARE(MeshTools::generateTangents(QuadIndices, QuadPositions, normals, textureCoordinates), (std::vector<Vector4>{
+        expected,
+        expected,
+        expected,
+        expected
+    }));
+}
+
+void GenerateTangentsTest::degenerate() {
+    /* Texture coordinates of the first face are collinear, so only the
+       second face contributes and the second vertex is not in it. The last
+       vertex is not referenced at all. */
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        0, 2, 3
+    };
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {5.0f, 5.0f, 5.0f}
+    };
+    const Vector3 normals[]{
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::xAxis()
+    };
+    const Vector2 textureCoordinates[]{
+        {0.0f, 0.0f}, {1.0f, 0.0f}, {2.0f, 0.0f}, {0.0f, 1.0f}, {}
+    };
+
+    /* In the second face U grows only from the first to the third vertex,
+       so the tangent points along +X+Y. The vertices with no contributing
+       faces get an arbitrary perpendicular tangent. */
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(indices, positions, normals, textureCoordinates);
+    CORRADE_COMPARE(tangents, (std::vector<Vector4>{
+        {Vector3{1.0f, 1.0f, 0.0f}.normalized(), 1.0f},
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {Vector3{1.0f, 1.0f, 0.0f}.normalized(), 1.0f},
+        {Vector3{1.0f, 1.0f, 0.0f}.normalized(), 1.0f},
+        {0.0f, 1.0f, 0.0f, 1.0f}
+    }));
+}
+
+void GenerateTangentsTest::multipleThreads() {
+    /* A bumpy grid large enough to be split among more threads */
+    constexpr UnsignedInt Size = 320;
+    std::vector<Vector3> positions;
+    std::vector<Vector3> normals;
+    std::vector<Vector2> textureCoordinates;
+    positions.reserve(Size*Size);
+    normals.reserve(Size*Size);
+    textureCoordinates.reserve(Size*Size);
+    for(UnsignedInt y = 0; y != Size; ++y) for(UnsignedInt x = 0; x != Size; ++x) {
+        const Float z = Float((x*7 + y*13) % 5)*0.1f;
+        positions.emplace_back(Float(x), Float(y), z);
+        normals.push_back(Vector3{z - 0.2f, 0.2f - z, 1.0f}.normalized());
+        textureCoordinates.emplace_back(Float(x)/Size, Float(y)/Size);
+    }
+    std::vector<UnsignedInt> indices;
+    indices.reserve((Size - 1)*(Size - 1)*6);
+    for(UnsignedInt y = 0; y + 1 != Size; ++y) for(UnsignedInt x = 0; x + 1 != Size; ++x) {
+        const UnsignedInt a = y*Size + x, b = a + 1, c = a + Size, d = c + 1;
+        indices.insert(indices.end(), {a, b, d, a, d, c});
+    }
+
+    const std::vector<Vector4> single = MeshTools::generateTangents(indices, positions, normals, textureCoordinates, 1);
+    const std::vector<Vector4> multiple = MeshTools::generateTangents(indices, positions, normals, textureCoordinates, 4);
+
+    /* The sums are done in the same order in both cases, so the results
+       should be bit-exact */
+    CORRADE_COMPARE(multiple.size(), single.size());
+    CORRADE_VERIFY(std::memcmp(multiple.data(), single.data(), single.size()*sizeof(Vector4)) == 0);
+
+    /* All tangents are perpendicular to the normals and with positive
+       handedness */
+    for(std::size_t i = 0; i != single.size(); ++i) {
+        CORRADE_COMPARE(Math::dot(single[i].xyz(), normals[i]), 0.0f);
+        CORRADE_COMPARE(single[i].w(), 1.0f);
+    }
+}
+
+void GenerateTangentsTest::interleaved() {
+    const Vector2 textureCoordinates[]{
+        {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}
+    };
+    const std::vector<Vector3> positions{std::begin(QuadPositions), std::end(QuadPositions)};
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(QuadIndices, QuadPositions, QuadNormals, textureCoordinates);
+
+    const Containers::Array<char> data = MeshTools::interleave(positions, tangents);
+    CORRADE_COMPARE(data.size(), 4*(sizeof(Vector3) + sizeof(Vector4)));
+    CORRADE_COMPARE(*reinterpret_cast<const Vector3*>(data.data() + 2*28), (Vector3{1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(*reinterpret_cast<const Vector4*>(data.data() + 2*28 + 12), (Vector4{1.0f, 0.0f, 0.0f, 1.0f}));
+}
+
+void GenerateTangentsTest::meshData() {
+    Trade::MeshData3D mesh{MeshPrimitive::Triangles,
+        {std::begin(QuadIndices), std::end(QuadIndices)},
+        {{std::begin(QuadPositions), std::end(QuadPositions)}},
+        {{std::begin(QuadNormals), std::end(QuadNormals)}},
+        {{{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}}}, {}};
+
+    CORRADE_COMPARE(MeshTools::generateTangents(mesh), (std::vector<Vector4>{
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 0.0f, 1.0f}
+    }));
+}
+
+void GenerateTangentsTest::meshDataNotIndexed() {
+    Trade::MeshData3D mesh{MeshPrimitive::Triangles, {}, {{{}, {}, {}}}, {{{}, {}, {}}}, {{{}, {}, {}}}, {}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateTangents(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateTangents(): expected an indexed triangle mesh\n");
+}
+
+void GenerateTangentsTest::meshDataNoNormals() {
+    Trade::MeshData3D mesh{MeshPrimitive::Triangles, {0, 1, 2}, {{{}, {}, {}}}, {}, {{{}, {}, {}}}, {}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateTangents(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateTangents(): expected a mesh with normals and texture coordinates\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateTangentsTest)
@@ -25,9 +25,12 @@
 
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/Endianness.h>
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Packing.h"
 #include "Magnum/MeshTools/Interleave.h"
 
 namespace Magnum { namespace MeshTools { namespace Test { namespace {
@@ -43,6 +46,24 @@ struct InterleaveTest: Corrade::TestSuite::Tester {
     void writeGaps();
 
     void interleaveInto();
+
+    void attributeFormatSize();
+    void debugAttributeFormat();
+
+    void interleaveAttributes();
+    void interleaveAttributesEmpty();
+    void interleaveAttributesInto();
+    void interleaveAttributesIntoBlocks();
+    void interleaveAttributesIntoSaturate();
+    void interleaveAttributesIntoWrongSize();
+    void interleaveAttributesIntoInvalidComponentCount();
+    void interleaveAttributesIntoUnsupportedConversion();
+    void interleaveAttributesIntoStrideTooSmall();
+    void interleaveAttributesIntoBufferTooSmall();
+
+    void deinterleaveAttributesInto();
+    void deinterleaveAttributesIntoWrongSize();
+    void deinterleaveAttributesIntoUnsupportedConversion();
 };
 
 InterleaveTest::InterleaveTest() {
@@ -53,7 +74,25 @@ InterleaveTest::InterleaveTest() {
               &InterleaveTest::write,
               &InterleaveTest::writeGaps,
 
-              &InterleaveTest::interleaveInto});
+              &InterleaveTest::interleaveInto,
+
+              &InterleaveTest::attributeFormatSize,
+              &InterleaveTest::debugAttributeFormat,
+
+              &InterleaveTest::interleaveAttributes,
+              &InterleaveTest::interleaveAttributesEmpty,
+              &InterleaveTest::interleaveAttributesInto,
+              &InterleaveTest::interleaveAttributesIntoBlocks,
+              &InterleaveTest::interleaveAttributesIntoSaturate,
+              &InterleaveTest::interleaveAttributesIntoWrongSize,
+              &InterleaveTest::interleaveAttributesIntoInvalidComponentCount,
+              &InterleaveTest::interleaveAttributesIntoUnsupportedConversion,
+              &InterleaveTest::interleaveAttributesIntoStrideTooSmall,
+              &InterleaveTest::interleaveAttributesIntoBufferTooSmall,
+
+              &InterleaveTest::deinterleaveAttributesInto,
+              &InterleaveTest::deinterleaveAttributesIntoWrongSize,
+              &InterleaveTest::deinterleaveAttributesIntoUnsupportedConversion});
 }
 
 void InterleaveTest::attributeCount() {
@@ -157,6 +196,328 @@ void InterleaveTest::interleaveInto() {
     }
 }
 
+void InterleaveTest::attributeFormatSize() {
+    CORRADE_COMPARE(MeshTools::attributeFormatSize(AttributeFormat::Float), 4);
+    CORRADE_COMPARE(MeshTools::attributeFormatSize(AttributeFormat::Half), 2);
+    CORRADE_COMPARE(MeshTools::attributeFormatSize(AttributeFormat::ByteNormalized), 1);
+    CORRADE_COMPARE(MeshTools::attributeFormatSize(AttributeFormat::UnsignedShortNormalized), 2);
+    CORRADE_COMPARE(MeshTools::attributeFormatSize(AttributeFormat::Int), 4);
+}
+
+void InterleaveTest::debugAttributeFormat() {
+    std::ostringstream out;
+    Debug{&out} << AttributeFormat::ShortNormalized << AttributeFormat(0xfe);
+    CORRADE_COMPARE(out.str(), "MeshTools::AttributeFormat::ShortNormalized MeshTools::AttributeFormat(0xfe)\n");
+}
+
+namespace {
+
+struct Vertex {
+    Vector3 position;
+    Color4ub color;
+    Math::Vector2<UnsignedShort> textureCoordinates;
+    Math::Vector3<Short> normal;
+    UnsignedShort padding;
+};
+
+/* Separate float arrays the way they'd come from an importer, colors are
+   four floats inside a larger structure to test strided input */
+const Vector3 Positions[]{
+    {1.0f, 2.0f, 3.0f},
+    {4.0f, 5.0f, 6.0f},
+    {7.0f, 8.0f, 9.0f}
+};
+
+const struct ColorData {
+    Int id;
+    Color4 color;
+} Colors[]{
+    {0, {1.0f, 0.0f, 0.5f, 1.0f}},
+    {1, {0.2f, 0.4f, 0.6f, 0.8f}},
+    {2, {0.0f, 1.0f, 0.0f, 0.0f}}
+};
+
+const Vector2 TextureCoordinates[]{
+    {0.0f, 0.5f},
+    {0.25f, 1.0f},
+    {0.75f, 0.125f}
+};
+
+const Vector3 Normals[]{
+    {0.0f, 1.0f, 0.0f},
+    {-1.0f, 0.0f, 0.0f},
+    {0.6f, 0.0f, -0.8f}
+};
+
+template<class T> Containers::StridedArrayView<const T> view(const T* data, std::size_t size) {
+    return {data, size, sizeof(T)};
+}
+
+}
+
+void InterleaveTest::interleaveAttributes() {
+    Containers::Array<char> data = MeshTools::interleaveAttributes(sizeof(Vertex), {
+        InterleaveAttribute{view(Positions, 3), AttributeFormat::Float, 3, offsetof(Vertex, position)},
+        InterleaveAttribute{Containers::StridedArrayView<const Color4>{&Colors[0].color, 3, sizeof(ColorData)}, AttributeFormat::Float, 4, offsetof(Vertex, color), AttributeFormat::UnsignedByteNormalized},
+        InterleaveAttribute{view(TextureCoordinates, 3), AttributeFormat::Float, 2, offsetof(Vertex, textureCoordinates), AttributeFormat::Half},
+        InterleaveAttribute{view(Normals, 3), AttributeFormat::Float, 3, offsetof(Vertex, normal), AttributeFormat::ShortNormalized}
+    });
+    CORRADE_COMPARE(data.size(), 3*sizeof(Vertex));
+
+    auto vertices = Containers::arrayCast<const Vertex>(data);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_COMPARE(vertices[i].position, Positions[i]);
+        CORRADE_COMPARE(vertices[i].color, Math::pack<Color4ub>(Colors[i].color));
+        CORRADE_COMPARE(vertices[i].textureCoordinates, Math::packHalf(TextureCoordinates[i]));
+        CORRADE_COMPARE(vertices[i].normal, Math::pack<Math::Vector3<Short>>(Normals[i]));
+        /* Gaps are zero-initialized */
+        CORRADE_COMPARE(vertices[i].padding, 0);
+    }
+
+    CORRADE_COMPARE(vertices[1].color, (Color4ub{51, 102, 153, 204}));
+    CORRADE_COMPARE(vertices[2].normal, (Math::Vector3<Short>{19660, 0, -26214}));
+}
+
+void InterleaveTest::interleaveAttributesEmpty() {
+    CORRADE_VERIFY(!MeshTools::interleaveAttributes(16, Containers::ArrayView<const InterleaveAttribute>{}));
+}
+
+void InterleaveTest::interleaveAttributesInto() {
+    Containers::Array<char> data{Containers::InPlaceInit, {
+        0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77,
+        0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77,
+        0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77}};
+
+    const Float ids[]{4.0f, 5.0f, -6.0f};
+    const Float weights[]{0.0f, 1.0f, 0.5f};
+    MeshTools::interleaveAttributesInto(data, 8, {
+        InterleaveAttribute{view(ids, 3), AttributeFormat::Float, 1, 0, AttributeFormat::Short},
+        InterleaveAttribute{view(ids, 3), AttributeFormat::Float, 1, 3, AttributeFormat::Byte},
+        InterleaveAttribute{view(weights, 3), AttributeFormat::Float, 1, 5, AttributeFormat::UnsignedByteNormalized}
+    });
+
+    if(!Utility::Endianness::isBigEndian()) {
+        /*  short_____, _gap, byte, _gap, ubyte, __________gap */
+        CORRADE_COMPARE_AS(Containers::ArrayView<const char>{data}, (Containers::Array<char>{Containers::InPlaceInit, {
+            0x04, 0x00, 0x55, 0x04, 0x11, '\x00', 0x55, 0x77,
+            0x05, 0x00, 0x55, 0x05, 0x11, '\xff', 0x55, 0x77,
+            '\xfa', '\xff', 0x55, '\xfa', 0x11, '\x80', 0x55, 0x77}}),
+            TestSuite::Compare::Container<Containers::ArrayView<const char>>);
+    } else {
+        /*  _____short, _gap, byte, _gap, ubyte, __________gap */
+        CORRADE_COMPARE_AS(Containers::ArrayView<const char>{data}, (Containers::Array<char>{Containers::InPlaceInit, {
+            0x00, 0x04, 0x55, 0x04, 0x11, '\x00', 0x55, 0x77,
+            0x00, 0x05, 0x55, 0x05, 0x11, '\xff', 0x55, 0x77,
+            '\xff', '\xfa', 0x55, '\xfa', 0x11, '\x80', 0x55, 0x77}}),
+            TestSuite::Compare::Container<Containers::ArrayView<const char>>);
+    }
+}
+
+void InterleaveTest::interleaveAttributesIntoBlocks() {
+    /* Enough vertices to span several blocks and a non-trivial remainder,
+       with values including exact halves to verify the vectorized rounding
+       matches Math::pack() */
+    constexpr std::size_t Count = 1001;
+    Containers::Array<Vector4> values{Containers::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i) values[i] = {
+        (i % 256 + 0.5f)/256.0f,
+        ((i*7) % 255 + 0.5f)/255.0f,
+        ((i*13) % 65535)/65535.0f,
+        (Int(i % 255) - 127)/127.0f};
+
+    struct Packed {
+        Math::Vector2<UnsignedByte> ub;
+        Math::Vector2<Byte> b;
+        Math::Vector2<UnsignedShort> us;
+        Math::Vector2<Short> s;
+    };
+
+    Containers::Array<char> data = MeshTools::interleaveAttributes(sizeof(Packed), {
+        InterleaveAttribute{view(values.data(), Count), AttributeFormat::Float, 2, offsetof(Packed, ub), AttributeFormat::UnsignedByteNormalized},
+        InterleaveAttribute{view(values.data(), Count), AttributeFormat::Float, 2, offsetof(Packed, us), AttributeFormat::UnsignedShortNormalized},
+        InterleaveAttribute{Containers::StridedArrayView<const Float>{&values[0].z(), Count, sizeof(Vector4)}, AttributeFormat::Float, 2, offsetof(Packed, b), AttributeFormat::ByteNormalized},
+        InterleaveAttribute{Containers::StridedArrayView<const Float>{&values[0].z(), Count, sizeof(Vector4)}, AttributeFormat::Float, 2, offsetof(Packed, s), AttributeFormat::ShortNormalized}
+    });
+
+    auto packed = Containers::arrayCast<const Packed>(data);
+    CORRADE_COMPARE(packed.size(), Count);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_COMPARE(packed[i].ub, Math::pack<Math::Vector2<UnsignedByte>>(values[i].xy()));
+        CORRADE_COMPARE(packed[i].us, Math::pack<Math::Vector2<UnsignedShort>>(values[i].xy()));
+        CORRADE_COMPARE(packed[i].b, Math::pack<Math::Vector2<Byte>>(Vector2{values[i].z(), values[i].w()}));
+        CORRADE_COMPARE(packed[i].s, Math::pack<Math::Vector2<Short>>(Vector2{values[i].z(), values[i].w()}));
+    }
+}
+
+void InterleaveTest::interleaveAttributesIntoSaturate() {
+    /* Values out of range of the destination type are saturated, NaNs go to
+       the lower bound */
+    const Float values[]{1.0e10f, -1.0e10f, Constants::nan(), 300.0f, -300.5f, 100.75f};
+
+    struct Saturated {
+        Int i;
+        UnsignedInt ui;
+        UnsignedByte ub;
+        Byte b;
+    };
+
+    Containers::Array<char> data = MeshTools::interleaveAttributes(sizeof(Saturated), {
+        InterleaveAttribute{view(values, 6), AttributeFormat::Float, 1, offsetof(Saturated, i), AttributeFormat::Int},
+        InterleaveAttribute{view(values, 6), AttributeFormat::Float, 1, offsetof(Saturated, ui), AttributeFormat::UnsignedInt},
+        InterleaveAttribute{view(values, 6), AttributeFormat::Float, 1, offsetof(Saturated, ub), AttributeFormat::UnsignedByte},
+        InterleaveAttribute{view(values, 6), AttributeFormat::Float, 1, offsetof(Saturated, b), AttributeFormat::Byte}
+    });
+
+    auto saturated = Containers::arrayCast<const Saturated>(data);
+    CORRADE_COMPARE(saturated.size(), 6);
+
+    const Int expectedI[]{2147483647, -2147483647 - 1, -2147483647 - 1, 300, -300, 100};
+    const UnsignedInt expectedUi[]{4294967295u, 0, 0, 300, 0, 100};
+    const UnsignedByte expectedUb[]{255, 0, 0, 255, 0, 100};
+    const Byte expectedB[]{127, -128, -128, 127, -128, 100};
+    for(std::size_t i = 0; i != 6; ++i) {
+        CORRADE_COMPARE(saturated[i].i, expectedI[i]);
+        CORRADE_COMPARE(saturated[i].ui, expectedUi[i]);
+        CORRADE_COMPARE(saturated[i].ub, expectedUb[i]);
+        CORRADE_COMPARE(saturated[i].b, expectedB[i]);
+    }
+}
+
+void InterleaveTest::interleaveAttributesIntoWrongSize() {
+    Containers::Array<char> data{32};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::interleaveAttributesInto(data, 16, {
+        InterleaveAttribute{view(Positions, 3), AttributeFormat::Float, 3, 0},
+        InterleaveAttribute{view(TextureCoordinates, 2), AttributeFormat::Float, 2, 12, AttributeFormat::Half}
+    });
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveAttributesInto(): expected 3 items in attribute 1 but got 2\n");
+}
+
+void InterleaveTest::interleaveAttributesIntoInvalidComponentCount() {
+    Containers::Array<char> data{48};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::interleaveAttributesInto(data, 16, {
+        InterleaveAttribute{view(Positions, 3), AttributeFormat::Float, 0, 0}
+    });
+    MeshTools::interleaveAttributesInto(data, 16, {
+        InterleaveAttribute{view(Positions, 3), AttributeFormat::Float, 5, 0, AttributeFormat::UnsignedByte}
+    });
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::interleaveAttributesInto(): expected 1 to 4 components in attribute 0 but got 0\n"
+        "MeshTools::interleaveAttributesInto(): expected 1 to 4 components in attribute 0 but got 5\n");
+}
+
+void InterleaveTest::interleaveAttributesIntoUnsupportedConversion() {
+    const UnsignedShort halves[3]{};
+    Containers::Array<char> data{48};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::interleaveAttributesInto(data, 16, {
+        InterleaveAttribute{view(Positions, 3), AttributeFormat::Float, 3, 0},
+        InterleaveAttribute{view(halves, 3), AttributeFormat::Half, 1, 12, AttributeFormat::ShortNormalized}
+    });
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveAttributesInto(): can't convert attribute 1 from MeshTools::AttributeFormat::Half to MeshTools::AttributeFormat::ShortNormalized\n");
+}
+
+void InterleaveTest::interleaveAttributesIntoStrideTooSmall() {
+    Containers::Array<char> data{48};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::interleaveAttributesInto(data, 16, {
+        InterleaveAttribute{view(Positions, 3), AttributeFormat::Float, 3, 0},
+        InterleaveAttribute{view(TextureCoordinates, 3), AttributeFormat::Float, 2, 12}
+    });
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveAttributesInto(): attribute 1 of 8 bytes at offset 12 doesn't fit into stride 16\n");
+
+    out.str({});
+    MeshTools::interleaveAttributesInto(data, 16, {
+        InterleaveAttribute{view(Positions, 3), AttributeFormat::Float, 3, 0},
+        InterleaveAttribute{view(TextureCoordinates, 3), AttributeFormat::Float, 2, 13, AttributeFormat::Half}
+    });
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveAttributesInto(): attribute 1 of 4 bytes at offset 13 doesn't fit into stride 16\n");
+}
+
+void InterleaveTest::interleaveAttributesIntoBufferTooSmall() {
+    Containers::Array<char> data{47};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::interleaveAttributesInto(data, 16, {
+        InterleaveAttribute{view(Positions, 3), AttributeFormat::Float, 3, 0}
+    });
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveAttributesInto(): the data buffer is too small, expected 48 but got 47\n");
+}
+
+void InterleaveTest::deinterleaveAttributesInto() {
+    Containers::Array<char> data = MeshTools::interleaveAttributes(sizeof(Vertex), {
+        InterleaveAttribute{view(Positions, 3), AttributeFormat::Float, 3, offsetof(Vertex, position)},
+        InterleaveAttribute{Containers::StridedArrayView<const Color4>{&Colors[0].color, 3, sizeof(ColorData)}, AttributeFormat::Float, 4, offsetof(Vertex, color), AttributeFormat::UnsignedByteNormalized},
+        InterleaveAttribute{view(TextureCoordinates, 3), AttributeFormat::Float, 2, offsetof(Vertex, textureCoordinates), AttributeFormat::Half},
+        InterleaveAttribute{view(Normals, 3), AttributeFormat::Float, 3, offsetof(Vertex, normal), AttributeFormat::ShortNormalized}
+    });
+
+    Vector3 positions[3];
+    ColorData colors[3]{};
+    Vector2 textureCoordinates[3];
+    Math::Vector2<UnsignedShort> textureCoordinatesHalf[3];
+    Vector3 normals[3];
+    MeshTools::deinterleaveAttributesInto(data, sizeof(Vertex), {
+        DeinterleaveAttribute{Containers::StridedArrayView<Vector3>{positions, 3, sizeof(Vector3)}, AttributeFormat::Float, 3, offsetof(Vertex, position)},
+        DeinterleaveAttribute{Containers::StridedArrayView<Color4>{&colors[0].color, 3, sizeof(ColorData)}, AttributeFormat::Float, 4, offsetof(Vertex, color), AttributeFormat::UnsignedByteNormalized},
+        DeinterleaveAttribute{Containers::StridedArrayView<Vector2>{textureCoordinates, 3, sizeof(Vector2)}, AttributeFormat::Float, 2, offsetof(Vertex, textureCoordinates), AttributeFormat::Half},
+        DeinterleaveAttribute{Containers::StridedArrayView<Math::Vector2<UnsignedShort>>{textureCoordinatesHalf, 3, sizeof(Math::Vector2<UnsignedShort>)}, AttributeFormat::Half, 2, offsetof(Vertex, textureCoordinates)},
+        DeinterleaveAttribute{Containers::StridedArrayView<Vector3>{normals, 3, sizeof(Vector3)}, AttributeFormat::Float, 3, offsetof(Vertex, normal), AttributeFormat::ShortNormalized}
+    });
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_COMPARE(positions[i], Positions[i]);
+        CORRADE_COMPARE(colors[i].color, Math::unpack<Color4>(Math::pack<Color4ub>(Colors[i].color)));
+        /* The struct padding is not touched */
+        CORRADE_COMPARE(colors[i].id, 0);
+        /* All texture coordinates are representable as halves exactly */
+        CORRADE_COMPARE(textureCoordinates[i], TextureCoordinates[i]);
+        CORRADE_COMPARE(textureCoordinatesHalf[i], Math::packHalf(TextureCoordinates[i]));
+        CORRADE_COMPARE(normals[i], Math::unpack<Vector3>(Math::pack<Math::Vector3<Short>>(Normals[i])));
+    }
+}
+
+void InterleaveTest::deinterleaveAttributesIntoWrongSize() {
+    Containers::Array<char> data{48};
+    Vector3 positions[3];
+    Vector2 textureCoordinates[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::deinterleaveAttributesInto(data, 16, {
+        DeinterleaveAttribute{Containers::StridedArrayView<Vector3>{positions, 3, sizeof(Vector3)}, AttributeFormat::Float, 3, 0},
+        DeinterleaveAttribute{Containers::StridedArrayView<Vector2>{textureCoordinates, 2, sizeof(Vector2)}, AttributeFormat::Float, 2, 12, AttributeFormat::Half}
+    });
+    MeshTools::deinterleaveAttributesInto(Containers::ArrayView<const char>{data}.prefix(47), 16, {
+        DeinterleaveAttribute{Containers::StridedArrayView<Vector3>{positions, 3, sizeof(Vector3)}, AttributeFormat::Float, 3, 0}
+    });
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::deinterleaveAttributesInto(): expected 3 items in attribute 1 but got 2\n"
+        "MeshTools::deinterleaveAttributesInto(): the data buffer is too small, expected 48 but got 47\n");
+}
+
+void InterleaveTest::deinterleaveAttributesIntoUnsupportedConversion() {
+    Containers::Array<char> data{48};
+    Int ids[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::deinterleaveAttributesInto(data, 16, {
+        DeinterleaveAttribute{Containers::StridedArrayView<Int>{ids, 3, sizeof(Int)}, AttributeFormat::Int, 1, 0, AttributeFormat::UnsignedShort}
+    });
+    CORRADE_COMPARE(out.str(), "MeshTools::deinterleaveAttributesInto(): can't convert attribute 0 from MeshTools::AttributeFormat::UnsignedShort to MeshTools::AttributeFormat::Int\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::InterleaveTest)
@@ -0,0 +1,207 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <random>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/OptimizeVertexCache.h"
+#include "Magnum/MeshTools/Tipsify.h"
+#include "Magnum/Primitives/Capsule.h"
+#include "Magnum/Primitives/Cylinder.h"
+#include "Magnum/Primitives/Grid.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Primitives/UVSphere.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeVertexCacheBenchmark: TestSuite::Tester {
+    explicit OptimizeVertexCacheBenchmark();
+
+    void efficiency();
+
+    void tipsify();
+    void optimizeVertexCache();
+    void optimizeVertexCacheReused();
+    void optimizeOverdraw();
+
+    struct Mesh {
+        std::vector<UnsignedInt> indices;
+        std::vector<Vector3> positions;
+    };
+    std::vector<Mesh> _meshes;
+    VertexCacheOptimizer _optimizer;
+};
+
+constexpr std::size_t CacheSize = 32;
+
+const struct {
+    const char* name;
+    Trade::MeshData3D(*generate)();
+} MeshData[]{
+    {"icosphere", []() { return Primitives::icosphereSolid(5); }},
+    {"UV sphere", []() { return Primitives::uvSphereSolid(128, 256); }},
+    {"grid", []() { return Primitives::grid3DSolid({255, 255}); }},
+    {"cylinder", []() { return Primitives::cylinderSolid(64, 128, 1.0f, Primitives::CylinderFlag::CapEnds); }},
+    {"capsule", []() { return Primitives::capsule3DSolid(32, 32, 128, 0.5f); }}
+};
+
+/* Cache miss count in a simulated FIFO cache, the same as used by tipsify() */
+std::size_t cacheMisses(const std::vector<UnsignedInt>& indices, std::size_t vertexCount) {
+    std::vector<UnsignedInt> timestamp(vertexCount);
+    UnsignedInt time = CacheSize + 1;
+    std::size_t misses = 0;
+    for(const UnsignedInt index: indices) {
+        if(time - timestamp[index] <= CacheSize) continue;
+        timestamp[index] = time++;
+        ++misses;
+    }
+    return misses;
+}
+
+OptimizeVertexCacheBenchmark::OptimizeVertexCacheBenchmark(): _optimizer{CacheSize} {
+    addInstancedTests({&OptimizeVertexCacheBenchmark::efficiency},
+        Containers::arraySize(MeshData));
+
+    addInstancedBenchmarks({&OptimizeVertexCacheBenchmark::tipsify,
+                            &OptimizeVertexCacheBenchmark::optimizeVertexCache,
+                            &OptimizeVertexCacheBenchmark::optimizeVertexCacheReused,
+                            &OptimizeVertexCacheBenchmark::optimizeOverdraw}, 5,
+        Containers::arraySize(MeshData));
+
+    /* The primitives are generated in a fairly cache-friendly order already,
+       so shuffle the triangles to resemble an unoptimized mesh */
+    std::minstd_rand random{17};
+    for(const auto& data: MeshData) {
+        Trade::MeshData3D mesh = data.generate();
+
+        std::vector<UnsignedInt> triangles(mesh.indices().size()/3);
+        for(std::size_t i = 0; i != triangles.size(); ++i) triangles[i] = i;
+        std::shuffle(triangles.begin(), triangles.end(), random);
+
+        Mesh shuffled;
+        shuffled.indices.reserve(mesh.indices().size());
+        for(const UnsignedInt t: triangles)
+            for(std::size_t i = 0; i != 3; ++i)
+                shuffled.indices.push_back(mesh.indices()[t*3 + i]);
+        shuffled.positions = mesh.positions(0);
+        _meshes.push_back(std::move(shuffled));
+    }
+}
+
+void OptimizeVertexCacheBenchmark::efficiency() {
+    setTestCaseDescription(MeshData[testCaseInstanceId()].name);
+
+    const Mesh& mesh = _meshes[testCaseInstanceId()];
+    const std::size_t triangleCount = mesh.indices.size()/3;
+    const std::size_t vertexCount = mesh.positions.size();
+
+    std::vector<UnsignedInt> tipsified = mesh.indices;
+    MeshTools::tipsify(tipsified, vertexCount, CacheSize);
+
+    std::vector<UnsignedInt> optimized = mesh.indices;
+    MeshTools::optimizeVertexCache(optimized, vertexCount, CacheSize);
+
+    std::vector<UnsignedInt> overdrawOptimized = optimized;
+    MeshTools::optimizeOverdraw(overdrawOptimized, mesh.positions, CacheSize);
+
+    /* ACMR is average count of cache misses per triangle (ideal is 0.5),
+       ATVR average count of transforms per vertex (ideal is 1.0). All
+       optimized variants should be better than the shuffled original. */
+    const std::size_t originalMisses = cacheMisses(mesh.indices, vertexCount);
+    for(const std::vector<UnsignedInt>* indices: {&tipsified, &optimized, &overdrawOptimized}) {
+        const std::size_t misses = cacheMisses(*indices, vertexCount);
+        CORRADE_COMPARE_AS(Float(misses)/triangleCount,
+            Float(originalMisses)/triangleCount,
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(Float(misses)/vertexCount,
+            Float(originalMisses)/vertexCount,
+            TestSuite::Compare::Less);
+    }
+}
+
+void OptimizeVertexCacheBenchmark::tipsify() {
+    setTestCaseDescription(MeshData[testCaseInstanceId()].name);
+
+    const Mesh& mesh = _meshes[testCaseInstanceId()];
+    std::vector<UnsignedInt> indices;
+    CORRADE_BENCHMARK(1) {
+        indices = mesh.indices;
+        MeshTools::tipsify(indices, mesh.positions.size(), CacheSize);
+    }
+
+    CORRADE_COMPARE(indices.size(), mesh.indices.size());
+}
+
+void OptimizeVertexCacheBenchmark::optimizeVertexCache() {
+    setTestCaseDescription(MeshData[testCaseInstanceId()].name);
+
+    const Mesh& mesh = _meshes[testCaseInstanceId()];
+    std::vector<UnsignedInt> indices;
+    CORRADE_BENCHMARK(1) {
+        indices = mesh.indices;
+        MeshTools::optimizeVertexCache(indices, mesh.positions.size(), CacheSize);
+    }
+
+    CORRADE_COMPARE(indices.size(), mesh.indices.size());
+}
+
+void OptimizeVertexCacheBenchmark::optimizeVertexCacheReused() {
+    setTestCaseDescription(MeshData[testCaseInstanceId()].name);
+
+    /* The scratch storage is allocated only in the first iteration */
+    const Mesh& mesh = _meshes[testCaseInstanceId()];
+    std::vector<UnsignedInt> indices;
+    CORRADE_BENCHMARK(1) {
+        indices = mesh.indices;
+        _optimizer(indices, mesh.positions.size());
+    }
+
+    CORRADE_COMPARE(indices.size(), mesh.indices.size());
+}
+
+void OptimizeVertexCacheBenchmark::optimizeOverdraw() {
+    setTestCaseDescription(MeshData[testCaseInstanceId()].name);
+
+    const Mesh& mesh = _meshes[testCaseInstanceId()];
+    std::vector<UnsignedInt> optimized = mesh.indices;
+    _optimizer(optimized, mesh.positions.size());
+
+    std::vector<UnsignedInt> indices;
+    CORRADE_BENCHMARK(1) {
+        indices = optimized;
+        _optimizer.optimizeOverdraw(indices, mesh.positions);
+    }
+
+    CORRADE_COMPARE(indices.size(), mesh.indices.size());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeVertexCacheBenchmark)
@@ -0,0 +1,216 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/OptimizeVertexCache.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeVertexCacheTest: TestSuite::Tester {
+    explicit OptimizeVertexCacheTest();
+
+    void optimizeVertexCache();
+    void optimizeVertexCacheDegenerate();
+    void optimizeVertexCacheEmpty();
+    void optimizeVertexCacheReuse();
+    void optimizeVertexCacheWrongIndexCount();
+    void invalidCacheSize();
+
+    void optimizeOverdraw();
+};
+
+/* The same mesh as in TipsifyTest
+
+ 0 ----- 1 ----- 2 ----- 3
+  \ 0  /  \ 7  /  \ 2  /  \
+   \  / 11 \  / 13 \  / 12 \
+    4 ----- 5 ----- 6 ----- 7
+   /  \ 3  /  \ 8  /  \ 5  /
+  / 14 \  / 9  \  / 15 \  /
+ 8 ----- 9 ---- 10 ---- 11          18 ---- 17
+  \ 4  /  \ 1  /  \ 17 /  \           \ 18  /
+   \  / 16 \  / 10 \  / 6  \           \  /
+    12 ---- 13 ---- 14 ---- 15          16
+
+*/
+
+const std::vector<UnsignedInt> Indices{
+    4, 1, 0,
+    10, 9, 13,
+    6, 3, 2,
+    9, 5, 4,
+    12, 9, 8,
+    11, 7, 6,
+
+    14, 15, 11,
+    2, 1, 5,
+    10, 6, 5,
+    10, 5, 9,
+    13, 14, 10,
+    1, 4, 5,
+
+    7, 3, 6,
+    6, 2, 5,
+    9, 4, 8,
+    6, 10, 11,
+    13, 9, 12,
+    14, 11, 10,
+
+    16, 17, 18
+};
+
+constexpr std::size_t VertexCount = 19;
+
+OptimizeVertexCacheTest::OptimizeVertexCacheTest() {
+    addTests({&OptimizeVertexCacheTest::optimizeVertexCache,
+              &OptimizeVertexCacheTest::optimizeVertexCacheDegenerate,
+              &OptimizeVertexCacheTest::optimizeVertexCacheEmpty,
+              &OptimizeVertexCacheTest::optimizeVertexCacheReuse,
+              &OptimizeVertexCacheTest::optimizeVertexCacheWrongIndexCount,
+              &OptimizeVertexCacheTest::invalidCacheSize,
+
+              &OptimizeVertexCacheTest::optimizeOverdraw});
+}
+
+void OptimizeVertexCacheTest::optimizeVertexCache() {
+    std::vector<UnsignedInt> indices = Indices;
+    MeshTools::optimizeVertexCache(indices, VertexCount, 4);
+
+    /* The lone triangle has the highest valence score, so it goes first */
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        16, 17, 18,
+        4, 1, 0,
+        1, 4, 5,
+        2, 1, 5,
+        9, 5, 4,
+        9, 4, 8,
+        12, 9, 8,
+        13, 9, 12,
+        10, 9, 13,
+        10, 5, 9,
+        13, 14, 10,
+        14, 15, 11,
+        14, 11, 10,
+        6, 10, 11,
+        11, 7, 6,
+        10, 6, 5,
+        6, 2, 5,
+        6, 3, 2,
+        7, 3, 6
+    }));
+}
+
+void OptimizeVertexCacheTest::optimizeVertexCacheDegenerate() {
+    /* Vertices referenced twice in one triangle shouldn't occupy two cache
+       slots or break the adjacency */
+    std::vector<UnsignedInt> indices{
+        0, 0, 1,
+        1, 2, 3,
+        3, 3, 3
+    };
+    MeshTools::optimizeVertexCache(indices, 4, 4);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        1, 2, 3,
+        3, 3, 3,
+        0, 0, 1
+    }));
+}
+
+void OptimizeVertexCacheTest::optimizeVertexCacheEmpty() {
+    std::vector<UnsignedInt> indices;
+    MeshTools::optimizeVertexCache(indices, 0);
+    CORRADE_VERIFY(indices.empty());
+}
+
+void OptimizeVertexCacheTest::optimizeVertexCacheReuse() {
+    std::vector<UnsignedInt> expected = Indices;
+    MeshTools::optimizeVertexCache(expected, VertexCount, 4);
+
+    /* Processing a larger and a smaller mesh with the same instance should
+       give the same result as with a fresh one */
+    VertexCacheOptimizer optimizer{4};
+    CORRADE_COMPARE(optimizer.cacheSize(), 4);
+
+    std::vector<UnsignedInt> large;
+    for(UnsignedInt i = 0; i != 10; ++i)
+        for(UnsignedInt index: Indices) large.push_back(index + i*VertexCount);
+    optimizer(large, 10*VertexCount);
+
+    std::vector<UnsignedInt> indices = Indices;
+    optimizer(indices, VertexCount);
+    CORRADE_COMPARE(indices, expected);
+}
+
+void OptimizeVertexCacheTest::optimizeVertexCacheWrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<UnsignedInt> indices{0, 1};
+    MeshTools::optimizeVertexCache(indices, 2);
+    CORRADE_COMPARE(out.str(), "MeshTools::VertexCacheOptimizer: index count is not divisible by 3\n");
+}
+
+void OptimizeVertexCacheTest::invalidCacheSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    VertexCacheOptimizer{3};
+    VertexCacheOptimizer{65};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::VertexCacheOptimizer: expected cache size larger than 3 and at most 64 but got 3\n"
+        "MeshTools::VertexCacheOptimizer: expected cache size larger than 3 and at most 64 but got 65\n");
+}
+
+void OptimizeVertexCacheTest::optimizeOverdraw() {
+    /* Two disconnected triangles, both facing +X. The one on the positive
+       side faces away from the center, so it should be drawn first. */
+    const std::vector<Vector3> positions{
+        {-1.0f, 0.0f, 0.0f},
+        {-1.0f, 1.0f, 0.0f},
+        {-1.0f, 0.0f, 1.0f},
+        { 1.0f, 0.0f, 0.0f},
+        { 1.0f, 1.0f, 0.0f},
+        { 1.0f, 0.0f, 1.0f}
+    };
+    std::vector<UnsignedInt> indices{
+        0, 1, 2,
+        3, 4, 5
+    };
+    MeshTools::optimizeOverdraw(indices, positions, 4);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        3, 4, 5,
+        0, 1, 2
+    }));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeVertexCacheTest)
@@ -0,0 +1,160 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/OptimizeVertexFetch.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeVertexFetchTest: TestSuite::Tester {
+    explicit OptimizeVertexFetchTest();
+
+    void remap();
+    void remapOutOfRange();
+
+    void attributes();
+    void attributesSizeMismatch();
+
+    void interleaved();
+    void interleavedWrongStride();
+};
+
+OptimizeVertexFetchTest::OptimizeVertexFetchTest() {
+    addTests({&OptimizeVertexFetchTest::remap,
+              &OptimizeVertexFetchTest::remapOutOfRange,
+
+              &OptimizeVertexFetchTest::attributes,
+              &OptimizeVertexFetchTest::attributesSizeMismatch,
+
+              &OptimizeVertexFetchTest::interleaved,
+              &OptimizeVertexFetchTest::interleavedWrongStride});
+}
+
+void OptimizeVertexFetchTest::remap() {
+    std::vector<UnsignedInt> indices{3, 1, 5, 5, 1, 0};
+    std::size_t usedVertexCount;
+    const std::vector<UnsignedInt> permutation = MeshTools::optimizeVertexFetchRemap(indices, 6, usedVertexCount);
+
+    /* Vertices 2 and 4 are not used, so they go last */
+    CORRADE_COMPARE(usedVertexCount, 4);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2, 2, 1, 3}));
+    CORRADE_COMPARE(permutation, (std::vector<UnsignedInt>{3, 1, 4, 0, 5, 2}));
+}
+
+void OptimizeVertexFetchTest::remapOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<UnsignedInt> indices{0, 1, 3};
+    std::size_t usedVertexCount;
+    MeshTools::optimizeVertexFetchRemap(indices, 3, usedVertexCount);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexFetch(): index 3 out of range for 3 vertices\n");
+}
+
+void OptimizeVertexFetchTest::attributes() {
+    std::vector<UnsignedInt> indices{3, 1, 4, 4, 1, 0};
+    std::vector<Vector3> positions{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f},
+        {3.0f, 0.0f, 0.0f},
+        {4.0f, 0.0f, 0.0f}
+    };
+    std::vector<Vector2> textureCoordinates{
+        {0.0f, 0.5f},
+        {1.0f, 0.5f},
+        {2.0f, 0.5f},
+        {3.0f, 0.5f},
+        {4.0f, 0.5f}
+    };
+
+    CORRADE_COMPARE(MeshTools::optimizeVertexFetch(indices, positions, textureCoordinates), 4);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2, 2, 1, 3}));
+    CORRADE_COMPARE(positions, (std::vector<Vector3>{
+        {3.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {4.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(textureCoordinates, (std::vector<Vector2>{
+        {3.0f, 0.5f},
+        {1.0f, 0.5f},
+        {4.0f, 0.5f},
+        {0.0f, 0.5f}
+    }));
+}
+
+void OptimizeVertexFetchTest::attributesSizeMismatch() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    std::vector<Vector3> positions(3);
+    std::vector<Vector2> textureCoordinates(2);
+    MeshTools::optimizeVertexFetch(indices, positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexFetch(): attribute arrays don't have the same size\n");
+}
+
+void OptimizeVertexFetchTest::interleaved() {
+    std::vector<UnsignedInt> indices{3, 1, 4, 4, 1, 0};
+    Containers::Array<char> data = MeshTools::interleave(
+        std::vector<UnsignedShort>{0, 1, 2, 3, 4},
+        std::vector<UnsignedByte>{10, 11, 12, 13, 14});
+    CORRADE_COMPARE(data.size(), 15);
+
+    CORRADE_COMPARE(MeshTools::optimizeVertexFetch(indices, data, 3), 4);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2, 2, 1, 3}));
+
+    /* The unused vertex is moved to the end */
+    UnsignedShort expectedShorts[]{3, 1, 4, 0, 2};
+    UnsignedByte expectedBytes[]{13, 11, 14, 10, 12};
+    for(std::size_t i = 0; i != 5; ++i) {
+        UnsignedShort value;
+        std::memcpy(&value, data + i*3, 2);
+        CORRADE_COMPARE(value, expectedShorts[i]);
+        CORRADE_COMPARE(UnsignedByte(data[i*3 + 2]), expectedBytes[i]);
+    }
+}
+
+void OptimizeVertexFetchTest::interleavedWrongStride() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    char data[10];
+    MeshTools::optimizeVertexFetch(indices, data, 4);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexFetch(): data size 10 is not divisible by stride 4\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeVertexFetchTest)
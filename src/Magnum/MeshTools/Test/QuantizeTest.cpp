@@ -0,0 +1,277 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshTools/Quantize.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct QuantizeTest: TestSuite::Tester {
+    explicit QuantizeTest();
+
+    void octahedralAxes();
+    void octahedralErrorBound();
+    void octahedralZero();
+    void octahedralWrongSize();
+
+    void positions();
+    void positionsZeroSizeAxis();
+    void textureCoordinates();
+    void colors();
+    void noAttributes();
+    void dequantizationMatrices();
+};
+
+QuantizeTest::QuantizeTest() {
+    addTests({&QuantizeTest::octahedralAxes,
+              &QuantizeTest::octahedralErrorBound,
+              &QuantizeTest::octahedralZero,
+              &QuantizeTest::octahedralWrongSize,
+
+              &QuantizeTest::positions,
+              &QuantizeTest::positionsZeroSizeAxis,
+              &QuantizeTest::textureCoordinates,
+              &QuantizeTest::colors,
+              &QuantizeTest::noAttributes,
+              &QuantizeTest::dequantizationMatrices});
+}
+
+void QuantizeTest::octahedralAxes() {
+    const Vector3 vectors[]{
+        Vector3::xAxis(), -Vector3::xAxis(),
+        Vector3::yAxis(), -Vector3::yAxis(),
+        Vector3::zAxis(), -Vector3::zAxis()
+    };
+    Vector2s encoded[6];
+    Vector3 decoded[6];
+    encodeOctahedralInto({vectors, 6, sizeof(Vector3)}, {encoded, 6, sizeof(Vector2s)});
+    decodeOctahedralInto({encoded, 6, sizeof(Vector2s)}, {decoded, 6, sizeof(Vector3)});
+
+    CORRADE_COMPARE(encoded[0], (Vector2s{32767, 0}));
+    CORRADE_COMPARE(encoded[2], (Vector2s{0, 32767}));
+    CORRADE_COMPARE(encoded[4], (Vector2s{0, 0}));
+    for(std::size_t i = 0; i != 6; ++i)
+        CORRADE_COMPARE(decoded[i], vectors[i]);
+}
+
+void QuantizeTest::octahedralErrorBound() {
+    std::mt19937 rng;
+    std::normal_distribution<Float> distribution;
+
+    std::vector<Vector3> vectors(100000);
+    for(Vector3& vector: vectors)
+        vector = Vector3{distribution(rng), distribution(rng), distribution(rng)}.normalized();
+
+    std::vector<Vector2s> encoded(vectors.size());
+    std::vector<Vector3> decoded(vectors.size());
+    encodeOctahedralInto({vectors.data(), vectors.size(), sizeof(Vector3)},
+        {encoded.data(), encoded.size(), sizeof(Vector2s)});
+    decodeOctahedralInto({encoded.data(), encoded.size(), sizeof(Vector2s)},
+        {decoded.data(), decoded.size(), sizeof(Vector3)});
+
+    /* Using the cross product length instead of acos(dot), which is too
+       imprecise for angles this small */
+    Float maxError{};
+    for(std::size_t i = 0; i != vectors.size(); ++i) {
+        CORRADE_VERIFY(decoded[i].isNormalized());
+        maxError = Math::max(maxError, Math::cross(vectors[i], decoded[i]).length());
+    }
+    CORRADE_COMPARE_AS(Float(Deg(Rad(Math::asin(maxError)))), 0.01f,
+        TestSuite::Compare::Less);
+}
+
+void QuantizeTest::octahedralZero() {
+    const Vector3 vector;
+    Vector2s encoded;
+    Vector3 decoded;
+    encodeOctahedralInto({&vector, 1, sizeof(Vector3)}, {&encoded, 1, sizeof(Vector2s)});
+    decodeOctahedralInto({&encoded, 1, sizeof(Vector2s)}, {&decoded, 1, sizeof(Vector3)});
+    CORRADE_COMPARE(encoded, Vector2s{});
+    CORRADE_COMPARE(decoded, Vector3::zAxis());
+}
+
+void QuantizeTest::octahedralWrongSize() {
+    const Vector3 vectors[3];
+    Vector2s encoded[3];
+    Vector3 decoded[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    encodeOctahedralInto({vectors, 3, sizeof(Vector3)}, {encoded, 2, sizeof(Vector2s)});
+    decodeOctahedralInto({encoded, 3, sizeof(Vector2s)}, {decoded, 2, sizeof(Vector3)});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeOctahedralInto(): expected 3 output items but got 2\n"
+        "MeshTools::decodeOctahedralInto(): expected 3 output items but got 2\n");
+}
+
+void QuantizeTest::positions() {
+    std::mt19937 rng;
+    std::uniform_real_distribution<Float> distribution{-100.0f, 250.0f};
+
+    std::vector<Vector3> positions(10000);
+    for(Vector3& position: positions)
+        position = {distribution(rng), distribution(rng)*0.01f, distribution(rng)*10.0f};
+
+    const Trade::MeshData3D mesh{MeshPrimitive::Triangles, {0, 1, 2}, {positions}, {}, {}, {}};
+    const QuantizedMeshData3D quantized = quantize(mesh);
+    CORRADE_COMPARE(quantized.primitive, MeshPrimitive::Triangles);
+    CORRADE_COMPARE(quantized.indices, (std::vector<UnsignedInt>{0, 1, 2}));
+    CORRADE_COMPARE(quantized.positions.size(), positions.size());
+
+    /* The extremes map exactly to the ends of the range */
+    Vector3us min{65535}, max{0};
+    for(const Vector3us& position: quantized.positions) {
+        min = Math::min(min, position);
+        max = Math::max(max, position);
+    }
+    CORRADE_COMPARE(min, Vector3us{0});
+    CORRADE_COMPARE(max, Vector3us{65535});
+
+    const Trade::MeshData3D dequantized = dequantize(quantized);
+    CORRADE_COMPARE(dequantized.positionArrayCount(), 1);
+    CORRADE_VERIFY(!dequantized.hasNormals());
+
+    /* Error is at most half of the quantization step, with a bit of slack
+       for float imprecision */
+    const Vector3 maxError = quantized.positionBounds.size()/65535.0f*0.5f*1.01f;
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        const Vector3 error = Math::abs(dequantized.positions(0)[i] - positions[i]);
+        CORRADE_VERIFY((error <= maxError).all());
+    }
+}
+
+void QuantizeTest::positionsZeroSizeAxis() {
+    /* All points in a Y=3.5 plane */
+    const std::vector<Vector3> positions{
+        {-1.0f, 3.5f, 2.0f},
+        { 1.0f, 3.5f, 0.0f},
+        { 0.5f, 3.5f, 1.0f}
+    };
+
+    const QuantizedMeshData3D quantized = quantize(Trade::MeshData3D{MeshPrimitive::Triangles, {}, {positions}, {}, {}, {}});
+    CORRADE_COMPARE(quantized.positionBounds, (Range3D{{-1.0f, 3.5f, 0.0f}, {1.0f, 3.5f, 2.0f}}));
+    CORRADE_COMPARE(quantized.positions, (std::vector<Vector3us>{
+        {0, 0, 65535},
+        {65535, 0, 0},
+        {49151, 0, 32768}
+    }));
+
+    const Trade::MeshData3D dequantized = dequantize(quantized);
+    CORRADE_VERIFY(!dequantized.isIndexed());
+    CORRADE_COMPARE(dequantized.positions(0)[0], positions[0]);
+    CORRADE_COMPARE(dequantized.positions(0)[1], positions[1]);
+    CORRADE_COMPARE(dequantized.positions(0)[2].y(), 3.5f);
+}
+
+void QuantizeTest::textureCoordinates() {
+    std::mt19937 rng;
+    std::uniform_real_distribution<Float> distribution{-0.5f, 4.0f};
+
+    std::vector<Vector2> textureCoordinates(10000);
+    for(Vector2& textureCoordinate: textureCoordinates)
+        textureCoordinate = {distribution(rng), distribution(rng)};
+
+    const QuantizedMeshData3D quantized = quantize(Trade::MeshData3D{MeshPrimitive::Points, {}, {std::vector<Vector3>(textureCoordinates.size())}, {}, {textureCoordinates}, {}});
+    CORRADE_COMPARE(quantized.textureCoords2D.size(), textureCoordinates.size());
+
+    const Trade::MeshData3D dequantized = dequantize(quantized);
+    CORRADE_COMPARE(dequantized.textureCoords2DArrayCount(), 1);
+
+    const Vector2 maxError = quantized.textureCoordinateBounds.size()/65535.0f*0.5f*1.01f;
+    for(std::size_t i = 0; i != textureCoordinates.size(); ++i) {
+        const Vector2 error = Math::abs(dequantized.textureCoords2D(0)[i] - textureCoordinates[i]);
+        CORRADE_VERIFY((error <= maxError).all());
+    }
+}
+
+void QuantizeTest::colors() {
+    /* Twenty channels, so the first sixteen go through the SIMD path and the
+       last color through the scalar remainder. Out-of-range values get
+       saturated in both. */
+    const std::vector<Color4> colors{
+        {-0.5f, 1.5f, 0.1f, 2.0f},
+        {0.0f, 0.5f, 1.0f, 1.0f},
+        {0.2f, 0.75f, 0.3333f, 0.0f},
+        {1.0e10f, -3.0f, 0.5f, 0.0f},
+        {-1.0e10f, 3.0f, 0.2f, 1.0e10f}
+    };
+
+    const QuantizedMeshData3D quantized = quantize(Trade::MeshData3D{MeshPrimitive::Points, {}, {std::vector<Vector3>(5)}, {}, {}, {colors}});
+    CORRADE_COMPARE(quantized.colors, (std::vector<Color4ub>{
+        {0, 255, 26, 255},
+        {0, 128, 255, 255},
+        {51, 191, 85, 0},
+        {255, 0, 128, 0},
+        {0, 255, 51, 255}
+    }));
+
+    const Trade::MeshData3D dequantized = dequantize(quantized);
+    CORRADE_COMPARE(dequantized.colorArrayCount(), 1);
+    /* Only the in-range colors survive the roundtrip, with at most half a
+       step of error plus float rounding */
+    for(std::size_t i = 1; i != 3; ++i) {
+        const Vector4 error = Math::abs(dequantized.colors(0)[i] - colors[i]);
+        CORRADE_VERIFY((error <= Vector4{0.5f/255.0f + Math::TypeTraits<Float>::epsilon()}).all());
+    }
+}
+
+void QuantizeTest::noAttributes() {
+    const QuantizedMeshData3D quantized = quantize(Trade::MeshData3D{MeshPrimitive::Lines, {}, {{}}, {}, {}, {}});
+    CORRADE_VERIFY(quantized.positions.empty());
+    CORRADE_VERIFY(quantized.normals.empty());
+    CORRADE_VERIFY(quantized.textureCoords2D.empty());
+    CORRADE_VERIFY(quantized.colors.empty());
+
+    const Trade::MeshData3D dequantized = dequantize(quantized);
+    CORRADE_COMPARE(dequantized.primitive(), MeshPrimitive::Lines);
+    CORRADE_VERIFY(dequantized.positions(0).empty());
+    CORRADE_VERIFY(!dequantized.hasNormals());
+    CORRADE_VERIFY(!dequantized.hasTextureCoords2D());
+    CORRADE_VERIFY(!dequantized.hasColors());
+}
+
+void QuantizeTest::dequantizationMatrices() {
+    QuantizedMeshData3D mesh;
+    mesh.positionBounds = {{-1.0f, 2.0f, 0.5f}, {3.0f, 2.5f, 1.0f}};
+    mesh.textureCoordinateBounds = {{0.25f, -1.0f}, {0.75f, 1.0f}};
+
+    /* The matrices map the unit cube to the bounds, usable directly as a
+       part of the model transformation */
+    CORRADE_COMPARE(mesh.positionDequantization().transformPoint({}), (Vector3{-1.0f, 2.0f, 0.5f}));
+    CORRADE_COMPARE(mesh.positionDequantization().transformPoint(Vector3{1.0f}), (Vector3{3.0f, 2.5f, 1.0f}));
+    CORRADE_COMPARE(mesh.textureCoordinateDequantization().transformPoint({}), (Vector2{0.25f, -1.0f}));
+    CORRADE_COMPARE(mesh.textureCoordinateDequantization().transformPoint(Vector2{1.0f}), (Vector2{0.75f, 1.0f}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::QuantizeTest)
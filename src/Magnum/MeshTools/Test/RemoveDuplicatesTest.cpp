@@ -23,9 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
-#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 
 namespace Magnum { namespace MeshTools { namespace Test { namespace {
@@ -34,10 +35,28 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     explicit RemoveDuplicatesTest();
 
     void removeDuplicates();
+    void removeDuplicatesEmpty();
+    void removeDuplicatesCellBoundary();
+    void removeDuplicatesLarge();
+
+    void removeDuplicatesExact();
+    void removeDuplicatesExactStrided();
+    void removeDuplicatesExactInterleaved();
+    void removeDuplicatesExactWrongIndexCount();
+    void removeDuplicatesExactWrongStride();
 };
 
 RemoveDuplicatesTest::RemoveDuplicatesTest() {
-    addTests({&RemoveDuplicatesTest::removeDuplicates});
+    addTests({&RemoveDuplicatesTest::removeDuplicates,
+              &RemoveDuplicatesTest::removeDuplicatesEmpty,
+              &RemoveDuplicatesTest::removeDuplicatesCellBoundary,
+              &RemoveDuplicatesTest::removeDuplicatesLarge,
+
+              &RemoveDuplicatesTest::removeDuplicatesExact,
+              &RemoveDuplicatesTest::removeDuplicatesExactStrided,
+              &RemoveDuplicatesTest::removeDuplicatesExactInterleaved,
+              &RemoveDuplicatesTest::removeDuplicatesExactWrongIndexCount,
+              &RemoveDuplicatesTest::removeDuplicatesExactWrongStride});
 }
 
 void RemoveDuplicatesTest::removeDuplicates() {
@@ -59,6 +78,151 @@ void RemoveDuplicatesTest::removeDuplicates() {
     }));
 }
 
+void RemoveDuplicatesTest::removeDuplicatesEmpty() {
+    std::vector<Vector3> data;
+    CORRADE_COMPARE(MeshTools::removeDuplicates(data), std::vector<UnsignedInt>{});
+    CORRADE_VERIFY(data.empty());
+}
+
+void RemoveDuplicatesTest::removeDuplicatesCellBoundary() {
+    /* Pairs of vectors nearer than epsilon, but lying on different sides of
+       a cell boundary (cells are 1.0 wide, starting at 0.0) in one or more
+       coordinates */
+    std::vector<Vector2> data{
+        {0.0f, 0.0f},
+        {1.9f, 0.5f},
+        {2.3f, 0.5f},   /* near 1 in X */
+        {1.9f, 1.9f},
+        {2.1f, 2.1f},   /* near 3 diagonally */
+        {5.0f, 5.0f},
+        {5.0f, 4.5f},   /* not near anything, 0.5 isn't less than epsilon */
+        {0.1f, 0.1f}    /* near 0 */
+    };
+
+    const std::vector<UnsignedInt> indices = MeshTools::removeDuplicates(data, 0.5f);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 1, 2, 2, 3, 4, 0}));
+    CORRADE_COMPARE(data, (std::vector<Vector2>{
+        {0.0f, 0.0f},
+        {1.9f, 0.5f},
+        {1.9f, 1.9f},
+        {5.0f, 5.0f},
+        {5.0f, 4.5f}
+    }));
+}
+
+void RemoveDuplicatesTest::removeDuplicatesLarge() {
+    /* A grid where each vertex is repeated four times with small
+       perturbations, enough to exercise collisions in the hash table */
+    std::vector<Vector3> data;
+    for(Int z = 0; z != 20; ++z) for(Int y = 0; y != 20; ++y) for(Int x = 0; x != 20; ++x)
+        for(Int i = 0; i != 4; ++i)
+            data.emplace_back(x + i*0.01f, y - i*0.01f, z*0.5f);
+
+    const std::vector<UnsignedInt> indices = MeshTools::removeDuplicates(data, 0.1f);
+    CORRADE_COMPARE(data.size(), 20*20*20);
+    CORRADE_COMPARE(indices.size(), 20*20*20*4);
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        CORRADE_COMPARE(indices[i], i/4);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesExact() {
+    /* Unlike with removeDuplicates(), neighboring values are kept */
+    std::vector<Color4ub> data{
+        {0x33, 0x66, 0x99, 0xff},
+        {0x33, 0x66, 0x99, 0xfe},
+        {0x33, 0x66, 0x99, 0xff},
+        {0x00, 0x00, 0x00, 0x00},
+        {0x33, 0x66, 0x99, 0xfe},
+        {0x00, 0x00, 0x00, 0x00}
+    };
+
+    const std::vector<UnsignedInt> indices = MeshTools::removeDuplicatesExact(data);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 0, 2, 1, 2}));
+    CORRADE_COMPARE(data, (std::vector<Color4ub>{
+        {0x33, 0x66, 0x99, 0xff},
+        {0x33, 0x66, 0x99, 0xfe},
+        {0x00, 0x00, 0x00, 0x00}
+    }));
+}
+
+struct Vertex {
+    Vector3i position;
+    Color3ub color;
+    UnsignedByte padding;
+};
+
+void RemoveDuplicatesTest::removeDuplicatesExactStrided() {
+    /* Deduplicating just the colors of an interleaved array, positions should
+       stay untouched */
+    Vertex data[]{
+        {{1, 2, 3}, {0x11, 0x22, 0x33}, 0},
+        {{4, 5, 6}, {0x44, 0x55, 0x66}, 0},
+        {{7, 8, 9}, {0x11, 0x22, 0x33}, 0},
+        {{1, 2, 3}, {0x44, 0x55, 0x66}, 0},
+        {{4, 5, 6}, {0x77, 0x88, 0x99}, 0}
+    };
+
+    UnsignedInt indices[5];
+    CORRADE_COMPARE(MeshTools::removeDuplicatesExactInPlace(Containers::StridedArrayView<Color3ub>{&data[0].color, 5, sizeof(Vertex)}, indices), 3);
+    CORRADE_COMPARE(indices[0], 0);
+    CORRADE_COMPARE(indices[1], 1);
+    CORRADE_COMPARE(indices[2], 0);
+    CORRADE_COMPARE(indices[3], 1);
+    CORRADE_COMPARE(indices[4], 2);
+
+    CORRADE_COMPARE(data[0].color, (Color3ub{0x11, 0x22, 0x33}));
+    CORRADE_COMPARE(data[1].color, (Color3ub{0x44, 0x55, 0x66}));
+    CORRADE_COMPARE(data[2].color, (Color3ub{0x77, 0x88, 0x99}));
+    CORRADE_COMPARE(data[2].position, (Vector3i{7, 8, 9}));
+    CORRADE_COMPARE(data[4].position, (Vector3i{4, 5, 6}));
+}
+
+void RemoveDuplicatesTest::removeDuplicatesExactInterleaved() {
+    /* Whole vertices */
+    Vertex data[]{
+        {{1, 2, 3}, {0x11, 0x22, 0x33}, 0},
+        {{1, 2, 3}, {0x44, 0x55, 0x66}, 0},
+        {{1, 2, 3}, {0x11, 0x22, 0x33}, 0},
+        {{4, 5, 6}, {0x11, 0x22, 0x33}, 0},
+        {{1, 2, 3}, {0x44, 0x55, 0x66}, 0}
+    };
+
+    UnsignedInt indices[5];
+    CORRADE_COMPARE(MeshTools::removeDuplicatesExactInPlace(Containers::StridedArrayView<char>{reinterpret_cast<char*>(data), 5, sizeof(Vertex)}, sizeof(Vertex), indices), 3);
+    CORRADE_COMPARE(indices[0], 0);
+    CORRADE_COMPARE(indices[1], 1);
+    CORRADE_COMPARE(indices[2], 0);
+    CORRADE_COMPARE(indices[3], 2);
+    CORRADE_COMPARE(indices[4], 1);
+
+    CORRADE_COMPARE(data[0].position, (Vector3i{1, 2, 3}));
+    CORRADE_COMPARE(data[0].color, (Color3ub{0x11, 0x22, 0x33}));
+    CORRADE_COMPARE(data[1].position, (Vector3i{1, 2, 3}));
+    CORRADE_COMPARE(data[1].color, (Color3ub{0x44, 0x55, 0x66}));
+    CORRADE_COMPARE(data[2].position, (Vector3i{4, 5, 6}));
+    CORRADE_COMPARE(data[2].color, (Color3ub{0x11, 0x22, 0x33}));
+}
+
+void RemoveDuplicatesTest::removeDuplicatesExactWrongIndexCount() {
+    Color4ub data[3]{};
+    UnsignedInt indices[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::removeDuplicatesExactInPlace(Containers::StridedArrayView<Color4ub>{data, 3, sizeof(Color4ub)}, indices);
+    CORRADE_COMPARE(out.str(), "MeshTools::removeDuplicatesExactInPlace(): expected 3 indices but got 2\n");
+}
+
+void RemoveDuplicatesTest::removeDuplicatesExactWrongStride() {
+    char data[8]{};
+    UnsignedInt indices[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::removeDuplicatesExactInPlace(Containers::StridedArrayView<char>{data, 4, 2}, 3, indices);
+    CORRADE_COMPARE(out.str(), "MeshTools::removeDuplicatesExactInPlace(): stride 2 is smaller than item size 3\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesTest)
@@ -0,0 +1,84 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Simplify.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SimplifyBenchmark: TestSuite::Tester {
+    explicit SimplifyBenchmark();
+
+    void simplify();
+    void generateLods();
+};
+
+constexpr UnsignedInt Subdivisions[]{5, 6, 7, 8};
+
+SimplifyBenchmark::SimplifyBenchmark() {
+    addInstancedBenchmarks({&SimplifyBenchmark::simplify,
+                            &SimplifyBenchmark::generateLods}, 1,
+        Containers::arraySize(Subdivisions));
+}
+
+void SimplifyBenchmark::simplify() {
+    const UnsignedInt subdivisions = Subdivisions[testCaseInstanceId()];
+    Trade::MeshData3D icosphere = Primitives::icosphereSolid(subdivisions);
+    setTestCaseDescription(std::to_string(icosphere.indices().size()/3) + " triangles");
+
+    /* Reduce to a tenth, the error bound is not limiting here */
+    std::vector<UnsignedInt> result;
+    Float error;
+    CORRADE_BENCHMARK(1) {
+        result = MeshTools::simplify(icosphere.indices(), icosphere.positions(0), icosphere.indices().size()/10, 1.0f, &error);
+    }
+
+    CORRADE_COMPARE_AS(result.size(), icosphere.indices().size()/10, TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(error, 1.0e-2f, TestSuite::Compare::Less);
+}
+
+void SimplifyBenchmark::generateLods() {
+    const UnsignedInt subdivisions = Subdivisions[testCaseInstanceId()];
+    Trade::MeshData3D icosphere = Primitives::icosphereSolid(subdivisions);
+    setTestCaseDescription(std::to_string(icosphere.indices().size()/3) + " triangles");
+
+    std::vector<std::vector<UnsignedInt>> lods;
+    CORRADE_BENCHMARK(1) {
+        lods = MeshTools::generateLods(icosphere, 5);
+    }
+
+    CORRADE_COMPARE(lods.size(), 5);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyBenchmark)
@@ -0,0 +1,200 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshTools/Simplify.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SimplifyTest: TestSuite::Tester {
+    explicit SimplifyTest();
+
+    void plane();
+    void crease();
+    void targetIndexCount();
+    void seam();
+    void wrongIndexCount();
+    void wrongAttributeCount();
+
+    void generateLods();
+    void generateLodsNotIndexed();
+};
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::plane,
+              &SimplifyTest::crease,
+              &SimplifyTest::targetIndexCount,
+              &SimplifyTest::seam,
+              &SimplifyTest::wrongIndexCount,
+              &SimplifyTest::wrongAttributeCount,
+
+              &SimplifyTest::generateLods,
+              &SimplifyTest::generateLodsNotIndexed});
+}
+
+/* 16x16 grid in the XY plane, optionally folded along X = 8 */
+void grid(std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions, bool folded) {
+    for(Int y = 0; y <= 16; ++y)
+        for(Int x = 0; x <= 16; ++x)
+            positions.emplace_back(x, y, folded ? 8 - Math::abs(x - 8) : 0);
+
+    for(UnsignedInt y = 0; y != 16; ++y) {
+        for(UnsignedInt x = 0; x != 16; ++x) {
+            const UnsignedInt a = y*17 + x;
+            const UnsignedInt b = a + 1;
+            const UnsignedInt c = a + 17;
+            const UnsignedInt d = c + 1;
+            indices.insert(indices.end(), {a, b, d, a, d, c});
+        }
+    }
+}
+
+void SimplifyTest::plane() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(indices, positions, false);
+
+    /* Everything should collapse into two triangles spanning the corners */
+    Float error;
+    std::vector<UnsignedInt> result = MeshTools::simplify(indices, positions, 0, 1.0e-2f, &error);
+    CORRADE_COMPARE(result.size(), 6);
+    CORRADE_COMPARE_AS(error, 1.0e-2f, TestSuite::Compare::Less);
+    for(const UnsignedInt index: result) {
+        CORRADE_VERIFY(positions[index].x() == 0.0f || positions[index].x() == 16.0f);
+        CORRADE_VERIFY(positions[index].y() == 0.0f || positions[index].y() == 16.0f);
+    }
+}
+
+void SimplifyTest::crease() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(indices, positions, true);
+
+    /* The crease can't be removed without a large error, so it should end
+       up as two quads */
+    std::vector<UnsignedInt> result = MeshTools::simplify(indices, positions, 0, 1.0e-2f);
+    CORRADE_COMPARE(result.size(), 12);
+    for(const UnsignedInt index: result) {
+        CORRADE_VERIFY(positions[index].x() == 0.0f || positions[index].x() == 8.0f || positions[index].x() == 16.0f);
+    }
+}
+
+void SimplifyTest::targetIndexCount() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(indices, positions, false);
+
+    std::vector<UnsignedInt> result = MeshTools::simplify(indices, positions, indices.size()/2);
+    CORRADE_COMPARE_AS(result.size(), indices.size()/2, TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(result.size(), indices.size()/3, TestSuite::Compare::Greater);
+}
+
+void SimplifyTest::seam() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(indices, positions, false);
+
+    /* Split the center vertex into two with different texture coordinates,
+       the right half of the triangles uses the other one */
+    constexpr UnsignedInt center = 8*17 + 8;
+    const UnsignedInt wedge = positions.size();
+    positions.push_back(positions[center]);
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        if(positions[indices[i]].x() <= 8.0f && positions[indices[i + 1]].x() <= 8.0f && positions[indices[i + 2]].x() <= 8.0f)
+            continue;
+        for(std::size_t j = 0; j != 3; ++j)
+            if(indices[i + j] == center) indices[i + j] = wedge;
+    }
+
+    std::vector<Vector2> textureCoords;
+    for(const Vector3& position: positions)
+        textureCoords.push_back(position.xy()/16.0f);
+    textureCoords[wedge] = {1.0f, 1.0f};
+
+    /* Both wedges should stay in place */
+    std::vector<UnsignedInt> result = MeshTools::simplify(indices, positions, {}, textureCoords, 0);
+    CORRADE_COMPARE_AS(result.size(), 6, TestSuite::Compare::Greater);
+    CORRADE_VERIFY(std::find(result.begin(), result.end(), center) != result.end());
+    CORRADE_VERIFY(std::find(result.begin(), result.end(), wedge) != result.end());
+}
+
+void SimplifyTest::wrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MeshTools::simplify({0, 1}, {{}, {}}, 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::simplify(): index count is not divisible by 3\n");
+}
+
+void SimplifyTest::wrongAttributeCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MeshTools::simplify({0, 1, 2}, {{}, {}, {}}, {{}, {}}, {}, 0);
+    MeshTools::simplify({0, 1, 2}, {{}, {}, {}}, {}, {{}, {}, {}, {}}, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): expected 3 normals but got 2\n"
+        "MeshTools::simplify(): expected 3 texture coordinates but got 4\n");
+}
+
+void SimplifyTest::generateLods() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(indices, positions, false);
+
+    Trade::MeshData3D mesh{MeshPrimitive::Triangles, indices, {positions}, {}, {}, {}};
+    std::vector<std::vector<UnsignedInt>> lods = MeshTools::generateLods(mesh, 4);
+    CORRADE_COMPARE(lods.size(), 4);
+    CORRADE_COMPARE(lods[0], indices);
+    CORRADE_COMPARE(lods[1].size(), 256*3);
+    CORRADE_COMPARE(lods[2].size(), 128*3);
+    CORRADE_COMPARE(lods[3].size(), 64*3);
+
+    /* The chain ends when nothing more can be simplified */
+    lods = MeshTools::generateLods(mesh, 100);
+    CORRADE_COMPARE_AS(lods.size(), 100, TestSuite::Compare::Less);
+    CORRADE_COMPARE(lods.back().size(), 6);
+}
+
+void SimplifyTest::generateLodsNotIndexed() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Trade::MeshData3D mesh{MeshPrimitive::Triangles, {}, {{{}, {}, {}}}, {}, {}, {}};
+    MeshTools::generateLods(mesh, 2);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateLods(): expected an indexed triangle mesh\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
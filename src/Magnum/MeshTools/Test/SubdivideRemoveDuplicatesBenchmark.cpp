@@ -23,7 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <numeric>
+#include <unordered_map>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/MurmurHash2.h>
 
 #include "Magnum/Math/Vector4.h"
 #include "Magnum/MeshTools/Duplicate.h"
@@ -34,19 +37,71 @@
 
 namespace Magnum { namespace MeshTools { namespace Test { namespace {
 
+/* Original multi-pass implementation of removeDuplicates(), for comparison.
+   Each pass rebuilds a std::unordered_map of bucket coordinates, with the
+   buckets moved by epsilon/2 in a different direction each time. */
+template<std::size_t size> struct VectorHash {
+    std::size_t operator()(const Math::Vector<size, std::size_t>& data) const {
+        return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&data), sizeof(data)).byteArray());
+    }
+};
+
+template<class Vector> std::vector<UnsignedInt> removeDuplicatesNaive(std::vector<Vector>& data, typename Vector::Type epsilon = Math::TypeTraits<typename Vector::Type>::epsilon()) {
+    Vector min = data[0], max = data[0];
+    for(const auto& v: data) {
+        min = Math::min(v, min);
+        max = Math::max(v, max);
+    }
+
+    epsilon = Math::max(epsilon, typename Vector::Type((max-min).max()/~std::size_t{}));
+
+    std::vector<UnsignedInt> resultIndices(data.size());
+    std::iota(resultIndices.begin(), resultIndices.end(), 0);
+
+    std::unordered_map<Math::Vector<Vector::Size, std::size_t>, UnsignedInt, VectorHash<Vector::Size>> table(data.size());
+
+    std::vector<UnsignedInt> indices;
+    indices.reserve(data.size());
+
+    Vector moved;
+    for(std::size_t moving = 0; moving <= Vector::Size; ++moving) {
+        for(std::size_t i = 0; i != data.size(); ++i) {
+            const Math::Vector<Vector::Size, std::size_t> v((data[i] + moved - min)/epsilon);
+            const auto result = table.emplace(v, table.size());
+            indices.push_back(result.first->second);
+            if(result.second && i != table.size()-1) data[table.size()-1] = data[i];
+        }
+
+        data.resize(table.size());
+        for(auto& i: resultIndices) i = indices[i];
+
+        if(moving == Vector::Size) continue;
+
+        moved = Vector();
+        moved[moving] = epsilon/2;
+        table.clear();
+        indices.clear();
+    }
+
+    return resultIndices;
+}
+
 struct SubdivideRemoveDuplicatesBenchmark: TestSuite::Tester {
     explicit SubdivideRemoveDuplicatesBenchmark();
 
     void subdivide();
     void subdivideAndRemoveDuplicatesAfter();
     void subdivideAndRemoveDuplicatesInBetween();
-};
+    void subdivideShared();
+    void subdivideSharedMultipleThreads();
 
-SubdivideRemoveDuplicatesBenchmark::SubdivideRemoveDuplicatesBenchmark() {
-    addBenchmarks({&SubdivideRemoveDuplicatesBenchmark::subdivide,
-                   &SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesAfter,
-                   &SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesInBetween}, 4);
-}
+    void removeDuplicatesNaiveLarge();
+    void removeDuplicatesLarge();
+    void removeDuplicatesNaiveLargePerturbed();
+    void removeDuplicatesLargePerturbed();
+
+    std::vector<Vector3> _large, _largePerturbed;
+};
 
 namespace {
     static Vector3 interpolator(const Vector3& a, const Vector3& b) {
@@ -54,6 +109,32 @@ namespace {
     }
 }
 
+SubdivideRemoveDuplicatesBenchmark::SubdivideRemoveDuplicatesBenchmark() {
+    addBenchmarks({&SubdivideRemoveDuplicatesBenchmark::subdivide,
+                   &SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesAfter,
+                   &SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesInBetween,
+                   &SubdivideRemoveDuplicatesBenchmark::subdivideShared,
+                   &SubdivideRemoveDuplicatesBenchmark::subdivideSharedMultipleThreads}, 4);
+
+    addBenchmarks({&SubdivideRemoveDuplicatesBenchmark::removeDuplicatesNaiveLarge,
+                   &SubdivideRemoveDuplicatesBenchmark::removeDuplicatesLarge,
+                   &SubdivideRemoveDuplicatesBenchmark::removeDuplicatesNaiveLargePerturbed,
+                   &SubdivideRemoveDuplicatesBenchmark::removeDuplicatesLargePerturbed}, 2);
+
+    /* Icosphere subdivided 7 times without removing duplicates, giving about
+       a million vertices with each unique one repeated ~6 times */
+    Trade::MeshData3D icosphere = Primitives::icosphereSolid(0);
+    for(std::size_t i = 0; i != 7; ++i)
+        MeshTools::subdivide(icosphere.indices(), icosphere.positions(0), interpolator);
+    _large = MeshTools::duplicate(icosphere.indices(), icosphere.positions(0));
+
+    /* The same, but with the duplicates slightly apart, as is common for
+       scanned data */
+    _largePerturbed = _large;
+    for(std::size_t i = 0; i != _largePerturbed.size(); ++i)
+        _largePerturbed[i] += Vector3{Float(i % 7)*1.0e-7f};
+}
+
 void SubdivideRemoveDuplicatesBenchmark::subdivide() {
     CORRADE_BENCHMARK(3) {
         Trade::MeshData3D icosphere = Primitives::icosphereSolid(0);
@@ -89,6 +170,74 @@ void SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesInBetween()
     }
 }
 
+void SubdivideRemoveDuplicatesBenchmark::subdivideShared() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(3) {
+        Trade::MeshData3D icosphere = Primitives::icosphereSolid(0);
+
+        /* Subdivide 5 times, no need to remove duplicates */
+        for(std::size_t i = 0; i != 5; ++i)
+            MeshTools::subdivideShared(icosphere.indices(), icosphere.positions(0), interpolator, 1);
+        count = icosphere.positions(0).size();
+    }
+
+    CORRADE_COMPARE(count, 10242);
+}
+
+void SubdivideRemoveDuplicatesBenchmark::subdivideSharedMultipleThreads() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(3) {
+        Trade::MeshData3D icosphere = Primitives::icosphereSolid(0);
+
+        /* Subdivide 5 times, no need to remove duplicates */
+        for(std::size_t i = 0; i != 5; ++i)
+            MeshTools::subdivideShared(icosphere.indices(), icosphere.positions(0), interpolator);
+        count = icosphere.positions(0).size();
+    }
+
+    CORRADE_COMPARE(count, 10242);
+}
+
+void SubdivideRemoveDuplicatesBenchmark::removeDuplicatesNaiveLarge() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        std::vector<Vector3> data = _large;
+        removeDuplicatesNaive(data);
+        count = data.size();
+    }
+
+    CORRADE_COMPARE(count, 163842);
+}
+
+void SubdivideRemoveDuplicatesBenchmark::removeDuplicatesLarge() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        std::vector<Vector3> data = _large;
+        MeshTools::removeDuplicates(data);
+        count = data.size();
+    }
+
+    CORRADE_COMPARE(count, 163842);
+}
+
+void SubdivideRemoveDuplicatesBenchmark::removeDuplicatesNaiveLargePerturbed() {
+    CORRADE_BENCHMARK(1) {
+        std::vector<Vector3> data = _largePerturbed;
+        removeDuplicatesNaive(data);
+    }
+}
+
+void SubdivideRemoveDuplicatesBenchmark::removeDuplicatesLargePerturbed() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        std::vector<Vector3> data = _largePerturbed;
+        MeshTools::removeDuplicates(data);
+        count = data.size();
+    }
+
+    CORRADE_COMPARE(count, 163842);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideRemoveDuplicatesBenchmark)
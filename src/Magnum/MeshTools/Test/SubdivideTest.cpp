@@ -36,6 +36,10 @@ struct SubdivideTest: TestSuite::Tester {
 
     void wrongIndexCount();
     void subdivide();
+
+    void sharedWrongIndexCount();
+    void shared();
+    void sharedMultipleThreads();
 };
 
 typedef Math::Vector<1, Int> Vector1;
@@ -44,7 +48,11 @@ inline Vector1 interpolator(Vector1 a, Vector1 b) { return (a[0]+b[0])/2; }
 
 SubdivideTest::SubdivideTest() {
     addTests({&SubdivideTest::wrongIndexCount,
-              &SubdivideTest::subdivide});
+              &SubdivideTest::subdivide,
+
+              &SubdivideTest::sharedWrongIndexCount,
+              &SubdivideTest::shared,
+              &SubdivideTest::sharedMultipleThreads});
 }
 
 void SubdivideTest::wrongIndexCount() {
@@ -68,6 +76,52 @@ void SubdivideTest::subdivide() {
     CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 7, 8, 9, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 7, 9, 7, 2, 8, 9, 8, 3}));
 }
 
+void SubdivideTest::sharedWrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<Vector1> positions;
+    std::vector<UnsignedInt> indices{0, 1};
+    MeshTools::subdivideShared(indices, positions, interpolator);
+    CORRADE_COMPARE(ss.str(), "MeshTools::subdivideShared(): index count is not divisible by 3\n");
+}
+
+void SubdivideTest::shared() {
+    std::vector<Vector1> positions{0, 2, 6, 8};
+    std::vector<UnsignedInt> indices{0, 1, 2, 1, 2, 3};
+    MeshTools::subdivideShared(indices, positions, interpolator);
+
+    /* Same as above, except that the 1-2 edge has just one vertex */
+    CORRADE_COMPARE(indices.size(), 24);
+    CORRADE_VERIFY(positions == (std::vector<Vector1>{0, 2, 6, 8, 1, 4, 3, 7, 5}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3}));
+}
+
+void SubdivideTest::sharedMultipleThreads() {
+    /* Subdivide a tetrahedron enough times to have work for more threads */
+    std::vector<Vector1> positions{0, 1000, 2000, 3000};
+    std::vector<UnsignedInt> indices{0, 1, 2, 0, 3, 1, 1, 3, 2, 2, 3, 0};
+    for(std::size_t i = 0; i != 7; ++i)
+        MeshTools::subdivideShared(indices, positions, interpolator, 1);
+
+    std::vector<Vector1> positionsSingle = positions;
+    std::vector<UnsignedInt> indicesSingle = indices;
+    MeshTools::subdivideShared(indicesSingle, positionsSingle, interpolator, 1);
+
+    std::vector<Vector1> positionsMultiple = positions;
+    std::vector<UnsignedInt> indicesMultiple = indices;
+    MeshTools::subdivideShared(indicesMultiple, positionsMultiple, interpolator, 4);
+
+    /* Closed surface, so V - E + F = 2 and each edge is shared by two
+       faces */
+    CORRADE_COMPARE(indicesSingle.size(), 4*4*4*4*4*4*4*4*4*3);
+    CORRADE_COMPARE(positionsSingle.size(), indicesSingle.size()/6 + 2);
+
+    /* The output doesn't depend on thread count */
+    CORRADE_VERIFY(positionsMultiple == positionsSingle);
+    CORRADE_VERIFY(indicesMultiple == indicesSingle);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideTest)
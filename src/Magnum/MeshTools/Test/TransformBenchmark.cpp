@@ -0,0 +1,176 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/Transform.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct TransformBenchmark: TestSuite::Tester {
+    explicit TransformBenchmark();
+
+    void inPlace();
+    void into();
+    void intoStrided();
+    void intoMultipleThreads();
+};
+
+enum class Transformation {
+    Matrix4Points,
+    Matrix4Vectors,
+    DualQuaternionPoints,
+    QuaternionVectors
+};
+
+const struct {
+    const char* name;
+    Transformation transformation;
+} Data[]{
+    {"Matrix4 points", Transformation::Matrix4Points},
+    {"Matrix4 vectors", Transformation::Matrix4Vectors},
+    {"DualQuaternion points", Transformation::DualQuaternionPoints},
+    {"Quaternion vectors", Transformation::QuaternionVectors}
+};
+
+enum: std::size_t { PointCount = 1000000 };
+
+const Matrix4 TransformationMatrix = Matrix4::translation({0.5f, -1.0f, 3.0f})*Matrix4::rotationY(Deg(35.0f));
+const DualQuaternion TransformationDualQuaternion = DualQuaternion::translation({0.5f, -1.0f, 3.0f})*DualQuaternion::rotation(Deg(35.0f), Vector3::yAxis());
+
+/* Same positions as separate and as an interleaved position + normal
+   array */
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+};
+
+std::vector<Vector3> generatePoints() {
+    std::vector<Vector3> out;
+    out.reserve(PointCount);
+    for(std::size_t i = 0; i != PointCount; ++i)
+        out.emplace_back(Float(i % 100), Float(i/100 % 100), Float(i/10000));
+    return out;
+}
+
+void transformInto(const Transformation transformation, const Containers::StridedArrayView<Vector3>& points, const UnsignedInt threadCount) {
+    const Containers::StridedArrayView<const Vector3> in = points;
+    switch(transformation) {
+        case Transformation::Matrix4Points:
+            return MeshTools::transformPointsInto(TransformationMatrix, in, points, threadCount);
+        case Transformation::Matrix4Vectors:
+            return MeshTools::transformVectorsInto(TransformationMatrix, in, points, threadCount);
+        case Transformation::DualQuaternionPoints:
+            return MeshTools::transformPointsInto(TransformationDualQuaternion, in, points, threadCount);
+        case Transformation::QuaternionVectors:
+            return MeshTools::transformVectorsInto(TransformationDualQuaternion.rotation(), in, points, threadCount);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+TransformBenchmark::TransformBenchmark() {
+    addInstancedBenchmarks({&TransformBenchmark::inPlace,
+                            &TransformBenchmark::into,
+                            &TransformBenchmark::intoStrided,
+                            &TransformBenchmark::intoMultipleThreads}, 5,
+        Containers::arraySize(Data));
+}
+
+void TransformBenchmark::inPlace() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::vector<Vector3> points = generatePoints();
+
+    /* The per-item loops the batch variants are compared to */
+    CORRADE_BENCHMARK(1) {
+        switch(data.transformation) {
+            case Transformation::Matrix4Points:
+                MeshTools::transformPointsInPlace(TransformationMatrix, points);
+                break;
+            case Transformation::Matrix4Vectors:
+                MeshTools::transformVectorsInPlace(TransformationMatrix, points);
+                break;
+            case Transformation::DualQuaternionPoints:
+                MeshTools::transformPointsInPlace(TransformationDualQuaternion, points);
+                break;
+            case Transformation::QuaternionVectors:
+                MeshTools::transformVectorsInPlace(TransformationDualQuaternion.rotation(), points);
+                break;
+        }
+    }
+
+    CORRADE_COMPARE(points.size(), std::size_t(PointCount));
+}
+
+void TransformBenchmark::into() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::vector<Vector3> points = generatePoints();
+
+    CORRADE_BENCHMARK(1) {
+        transformInto(data.transformation, {points.data(), points.size(), sizeof(Vector3)}, 1);
+    }
+
+    CORRADE_COMPARE(points.size(), std::size_t(PointCount));
+}
+
+void TransformBenchmark::intoStrided() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::vector<Vector3> points = generatePoints();
+    Containers::Array<Vertex> vertices{Containers::ValueInit, points.size()};
+    for(std::size_t i = 0; i != points.size(); ++i)
+        vertices[i].position = points[i];
+
+    CORRADE_BENCHMARK(1) {
+        transformInto(data.transformation, {&vertices[0].position, vertices.size(), sizeof(Vertex)}, 1);
+    }
+
+    CORRADE_COMPARE(vertices.size(), std::size_t(PointCount));
+}
+
+void TransformBenchmark::intoMultipleThreads() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::vector<Vector3> points = generatePoints();
+
+    CORRADE_BENCHMARK(1) {
+        transformInto(data.transformation, {points.data(), points.size(), sizeof(Vector3)}, 0);
+    }
+
+    CORRADE_COMPARE(points.size(), std::size_t(PointCount));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TransformBenchmark)
@@ -24,6 +24,9 @@
 */
 
 #include <array>
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Matrix3.h"
@@ -40,6 +43,23 @@ struct TransformTest: TestSuite::Tester {
 
     void transformPoints2D();
     void transformPoints3D();
+
+    void transformVectorsInto();
+    void transformPointsInto();
+    void transformIntoInPlace();
+    void transformIntoMultipleThreads();
+    void transformIntoWrongSize();
+    void transformIntoNotNormalized();
+};
+
+constexpr struct {
+    const char* name;
+    std::size_t count;
+    bool strided;
+} IntoData[]{
+    {"single item", 1, false},
+    {"contiguous", 11, false},
+    {"strided", 11, true}
 };
 
 TransformTest::TransformTest() {
@@ -48,6 +68,15 @@ TransformTest::TransformTest() {
 
               &TransformTest::transformPoints2D,
               &TransformTest::transformPoints3D});
+
+    addInstancedTests({&TransformTest::transformVectorsInto,
+                       &TransformTest::transformPointsInto},
+        Containers::arraySize(IntoData));
+
+    addTests({&TransformTest::transformIntoInPlace,
+              &TransformTest::transformIntoMultipleThreads,
+              &TransformTest::transformIntoWrongSize,
+              &TransformTest::transformIntoNotNormalized});
 }
 
 constexpr static std::array<Vector2, 2> points2D{{
@@ -116,6 +145,132 @@ void TransformTest::transformPoints3D() {
     CORRADE_COMPARE(quaternion, points3DRotatedTranslated);
 }
 
+
+/* Every other item of the input is used in the strided case */
+Containers::Array<Vector3> intoInput(std::size_t count) {
+    Containers::Array<Vector3> out{Containers::NoInit, count*2};
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = points3D[i % 2]*Float(i + 1);
+    return out;
+}
+
+template<class T> Containers::StridedArrayView<T> intoView(Containers::Array<Vector3>& data, std::size_t count, bool strided) {
+    return {data.data(), count, std::ptrdiff_t(strided ? 2*sizeof(Vector3) : sizeof(Vector3))};
+}
+
+void TransformTest::transformVectorsInto() {
+    auto&& data = IntoData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Vector3> input = intoInput(data.count);
+    Containers::Array<Vector3> matrix{Containers::ValueInit, data.count*2};
+    Containers::Array<Vector3> quaternion{Containers::ValueInit, data.count*2};
+
+    const Matrix4 transformationMatrix = Matrix4::rotationZ(Deg(90.0f))*Matrix4::scaling({2.0f, 0.5f, 1.0f});
+    const Quaternion transformationQuaternion = Quaternion::rotation(Deg(35.0f), Vector3{1.0f, 2.0f, 3.0f}.normalized());
+    const Containers::StridedArrayView<const Vector3> in = intoView<const Vector3>(input, data.count, data.strided);
+    MeshTools::transformVectorsInto(transformationMatrix, in,
+        intoView<Vector3>(matrix, data.count, data.strided), 1);
+    MeshTools::transformVectorsInto(transformationQuaternion, in,
+        intoView<Vector3>(quaternion, data.count, data.strided), 1);
+
+    for(std::size_t i = 0; i != data.count; ++i) {
+        const std::size_t o = data.strided ? 2*i : i;
+        CORRADE_COMPARE(matrix[o], transformationMatrix.transformVector(in[i]));
+        CORRADE_COMPARE(quaternion[o], transformationQuaternion.transformVectorNormalized(in[i]));
+        /* The gaps are untouched */
+        if(data.strided) {
+            CORRADE_COMPARE(matrix[o + 1], Vector3{});
+            CORRADE_COMPARE(quaternion[o + 1], Vector3{});
+        }
+    }
+
+    /* Verify the actual transformation as well */
+    CORRADE_COMPARE(matrix[0], (Vector3{-2.0f, -6.0f, 34.0f}));
+}
+
+void TransformTest::transformPointsInto() {
+    auto&& data = IntoData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Vector3> input = intoInput(data.count);
+    Containers::Array<Vector3> matrix{Containers::ValueInit, data.count*2};
+    Containers::Array<Vector3> dualQuaternion{Containers::ValueInit, data.count*2};
+
+    const Matrix4 transformationMatrix = Matrix4::translation(Vector3::yAxis(-1.0f))*Matrix4::rotationZ(Deg(90.0f));
+    const DualQuaternion transformationDualQuaternion = DualQuaternion::translation({0.5f, -1.0f, 3.0f})*DualQuaternion::rotation(Deg(35.0f), Vector3{1.0f, 2.0f, 3.0f}.normalized());
+    const Containers::StridedArrayView<const Vector3> in = intoView<const Vector3>(input, data.count, data.strided);
+    MeshTools::transformPointsInto(transformationMatrix, in,
+        intoView<Vector3>(matrix, data.count, data.strided), 1);
+    MeshTools::transformPointsInto(transformationDualQuaternion, in,
+        intoView<Vector3>(dualQuaternion, data.count, data.strided), 1);
+
+    for(std::size_t i = 0; i != data.count; ++i) {
+        const std::size_t o = data.strided ? 2*i : i;
+        CORRADE_COMPARE(matrix[o], transformationMatrix.transformPoint(in[i]));
+        CORRADE_COMPARE(dualQuaternion[o], transformationDualQuaternion.transformPointNormalized(in[i]));
+        if(data.strided) {
+            CORRADE_COMPARE(matrix[o + 1], Vector3{});
+            CORRADE_COMPARE(dualQuaternion[o + 1], Vector3{});
+        }
+    }
+
+    CORRADE_COMPARE(matrix[0], points3DRotatedTranslated[0]);
+}
+
+void TransformTest::transformIntoInPlace() {
+    Containers::Array<Vector3> points = intoInput(5);
+    Containers::Array<Vector3> expected = intoInput(5);
+
+    const Matrix4 transformation = Matrix4::translation(Vector3::yAxis(-1.0f))*Matrix4::rotationZ(Deg(90.0f));
+    MeshTools::transformPointsInto(transformation, Containers::StridedArrayView<const Vector3>{points.data(), points.size(), sizeof(Vector3)}, Containers::StridedArrayView<Vector3>{points.data(), points.size(), sizeof(Vector3)});
+
+    for(std::size_t i = 0; i != points.size(); ++i)
+        CORRADE_COMPARE(points[i], transformation.transformPoint(expected[i]));
+}
+
+void TransformTest::transformIntoMultipleThreads() {
+    /* Enough points for the work to be split */
+    Containers::Array<Vector3> input{Containers::NoInit, 200001};
+    for(std::size_t i = 0; i != input.size(); ++i)
+        input[i] = points3D[i % 2]*Float(i % 1000);
+    const Containers::StridedArrayView<const Vector3> in{input.data(), input.size(), sizeof(Vector3)};
+
+    Containers::Array<Vector3> single{Containers::NoInit, input.size()};
+    Containers::Array<Vector3> multiple{Containers::NoInit, input.size()};
+    const DualQuaternion transformation = DualQuaternion::translation({0.5f, -1.0f, 3.0f})*DualQuaternion::rotation(Deg(35.0f), Vector3::yAxis());
+    MeshTools::transformPointsInto(transformation, in, Containers::StridedArrayView<Vector3>{single.data(), single.size(), sizeof(Vector3)}, 1);
+    MeshTools::transformPointsInto(transformation, in, Containers::StridedArrayView<Vector3>{multiple.data(), multiple.size(), sizeof(Vector3)}, 4);
+
+    CORRADE_VERIFY(std::memcmp(single.data(), multiple.data(), single.size()*sizeof(Vector3)) == 0);
+    CORRADE_COMPARE(multiple[200000], transformation.transformPointNormalized(input[200000]));
+}
+
+void TransformTest::transformIntoWrongSize() {
+    Vector3 in[3];
+    Vector3 out[2];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    MeshTools::transformVectorsInto(Matrix4{}, Containers::StridedArrayView<const Vector3>{in, 3, sizeof(Vector3)}, Containers::StridedArrayView<Vector3>{out, 2, sizeof(Vector3)});
+    MeshTools::transformPointsInto(DualQuaternion{}, Containers::StridedArrayView<const Vector3>{in, 3, sizeof(Vector3)}, Containers::StridedArrayView<Vector3>{out, 2, sizeof(Vector3)});
+    CORRADE_COMPARE(o.str(),
+        "MeshTools::transformVectorsInto(): expected 3 output items but got 2\n"
+        "MeshTools::transformPointsInto(): expected 3 output items but got 2\n");
+}
+
+void TransformTest::transformIntoNotNormalized() {
+    Vector3 data[3];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    MeshTools::transformVectorsInto(Quaternion{{}, 2.0f}, Containers::StridedArrayView<const Vector3>{data, 3, sizeof(Vector3)}, Containers::StridedArrayView<Vector3>{data, 3, sizeof(Vector3)});
+    MeshTools::transformPointsInto(DualQuaternion{{{}, 2.0f}, {}}, Containers::StridedArrayView<const Vector3>{data, 3, sizeof(Vector3)}, Containers::StridedArrayView<Vector3>{data, 3, sizeof(Vector3)});
+    CORRADE_COMPARE(o.str(),
+        "MeshTools::transformVectorsInto(): Quaternion({0, 0, 0}, 2) is not normalized\n"
+        "MeshTools::transformPointsInto(): DualQuaternion({{0, 0, 0}, 2}, {{0, 0, 0}, 0}) is not normalized\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TransformTest)
@@ -46,13 +46,15 @@ void Tipsify::operator()(std::size_t cacheSize) {
     std::vector<UnsignedInt> outputIndices;
     outputIndices.reserve(indices.size());
 
+    /* Array with candidates for next fanning vertex (in 1-ring around
+       fanning vertex), reused across iterations */
+    std::vector<UnsignedInt> candidates;
+
     /* Starting vertex for fanning, cursor */
     UnsignedInt fanningVertex = 0;
     UnsignedInt i = 0;
     while(fanningVertex != 0xFFFFFFFFu) {
-        /* Array with candidates for next fanning vertex (in 1-ring around
-           fanning vertex) */
-        std::vector<UnsignedInt> candidates;
+        candidates.clear();
 
         /* For all neighbors of fanning vertex */
         for(UnsignedInt ti = neighborPosition[fanningVertex], t = neighbors[ti]; ti != neighborPosition[fanningVertex+1]; t = neighbors[++ti]) {
@@ -0,0 +1,232 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Transform.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Implementation/sse2.h"
+#include "Magnum/MeshTools/Implementation/parallel.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Below this count of items per thread the cost of spawning threads
+   outweighs any gains, as each item is just a few multiply-adds */
+constexpr std::size_t MinItemsPerThread = 65536;
+
+#ifdef _MAGNUM_USE_SSE2
+/* Three registers with X, Y and Z components of four consecutive items */
+struct Vector3x4 {
+    __m128 x, y, z;
+};
+
+/* Contiguous Vector3s are loaded as three registers and transposed with five
+   shuffles,
+
+    a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+
+   strided ones are gathered component by component */
+inline Vector3x4 load(const Vector3* const data, const std::ptrdiff_t stride) {
+    if(stride == sizeof(Vector3)) {
+        const Float* const f = data->data();
+        const __m128 a = _mm_loadu_ps(f);
+        const __m128 b = _mm_loadu_ps(f + 4);
+        const __m128 c = _mm_loadu_ps(f + 8);
+        const __m128 x2y2x3y3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+        const __m128 y0z0y1z1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+        return {
+            _mm_shuffle_ps(a, x2y2x3y3, _MM_SHUFFLE(2, 0, 3, 0)),
+            _mm_shuffle_ps(y0z0y1z1, x2y2x3y3, _MM_SHUFFLE(3, 1, 2, 0)),
+            _mm_shuffle_ps(y0z0y1z1, c, _MM_SHUFFLE(3, 0, 3, 1))};
+    }
+
+    const char* const bytes = reinterpret_cast<const char*>(data);
+    const Vector3& v0 = *reinterpret_cast<const Vector3*>(bytes);
+    const Vector3& v1 = *reinterpret_cast<const Vector3*>(bytes + stride);
+    const Vector3& v2 = *reinterpret_cast<const Vector3*>(bytes + 2*stride);
+    const Vector3& v3 = *reinterpret_cast<const Vector3*>(bytes + 3*stride);
+    return {
+        _mm_setr_ps(v0.x(), v1.x(), v2.x(), v3.x()),
+        _mm_setr_ps(v0.y(), v1.y(), v2.y(), v3.y()),
+        _mm_setr_ps(v0.z(), v1.z(), v2.z(), v3.z())};
+}
+
+/* Inverse of the above, the contiguous variant needs six shuffles */
+inline void store(const Vector3x4& v, Vector3* const data, const std::ptrdiff_t stride) {
+    if(stride == sizeof(Vector3)) {
+        Float* const f = data->data();
+        const __m128 x0x2y0y2 = _mm_shuffle_ps(v.x, v.y, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 z0z2x1x3 = _mm_shuffle_ps(v.z, v.x, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128 y1y3z1z3 = _mm_shuffle_ps(v.y, v.z, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(f, _mm_shuffle_ps(x0x2y0y2, z0z2x1x3, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(f + 4, _mm_shuffle_ps(y1y3z1z3, x0x2y0y2, _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm_storeu_ps(f + 8, _mm_shuffle_ps(z0z2x1x3, y1y3z1z3, _MM_SHUFFLE(3, 1, 3, 1)));
+        return;
+    }
+
+    alignas(16) Float x[4], y[4], z[4];
+    _mm_store_ps(x, v.x);
+    _mm_store_ps(y, v.y);
+    _mm_store_ps(z, v.z);
+    char* const bytes = reinterpret_cast<char*>(data);
+    for(std::size_t i = 0; i != 4; ++i)
+        *reinterpret_cast<Vector3*>(bytes + i*stride) = {x[i], y[i], z[i]};
+}
+
+/* a*b + c, kept as a separate multiply and add to give the same results as
+   the scalar code */
+inline __m128 madd(const __m128 a, const __m128 b, const __m128 c) {
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+#endif
+
+/* Each kernel has a scalar operator() taking one item and, if SSE2 is
+   available, an operator() transforming four items at once. The members
+   are the transformation broadcast to all four lanes. */
+struct MatrixKernel {
+    explicit MatrixKernel(const Matrix4& matrix, const bool points): matrix{matrix}, points{points} {
+        #ifdef _MAGNUM_USE_SSE2
+        for(std::size_t col = 0; col != 4; ++col)
+            for(std::size_t row = 0; row != 3; ++row)
+                m[col][row] = _mm_set1_ps(points || col != 3 ? matrix[col][row] : 0.0f);
+        #endif
+    }
+
+    Vector3 operator()(const Vector3& v) const {
+        return points ? matrix.transformPoint(v) : matrix.transformVector(v);
+    }
+
+    #ifdef _MAGNUM_USE_SSE2
+    /* Same order of operations as in Matrix4::operator*(), with the
+       translation column zeroed for vectors */
+    Vector3x4 operator()(const Vector3x4& v) const {
+        Vector3x4 out;
+        __m128* const o[]{&out.x, &out.y, &out.z};
+        for(std::size_t row = 0; row != 3; ++row)
+            *o[row] = _mm_add_ps(madd(m[2][row], v.z, madd(m[1][row], v.y, _mm_mul_ps(m[0][row], v.x))), m[3][row]);
+        return out;
+    }
+
+    __m128 m[4][3];
+    #endif
+
+    Matrix4 matrix;
+    bool points;
+};
+
+/* Same as Quaternion::transformVectorNormalized(), without the assertion
+   and with an optional translation added */
+struct QuaternionKernel {
+    explicit QuaternionKernel(const Quaternion& quaternion, const Vector3& translation): q{quaternion.vector()}, w{quaternion.scalar()}, translation{translation} {
+        #ifdef _MAGNUM_USE_SSE2
+        qx = _mm_set1_ps(q.x());
+        qy = _mm_set1_ps(q.y());
+        qz = _mm_set1_ps(q.z());
+        qw = _mm_set1_ps(w);
+        tx = _mm_set1_ps(translation.x());
+        ty = _mm_set1_ps(translation.y());
+        tz = _mm_set1_ps(translation.z());
+        #endif
+    }
+
+    Vector3 operator()(const Vector3& v) const {
+        const Vector3 t = 2.0f*Math::cross(q, v);
+        return v + w*t + Math::cross(q, t) + translation;
+    }
+
+    #ifdef _MAGNUM_USE_SSE2
+    Vector3x4 operator()(const Vector3x4& v) const {
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 cx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qy, v.z), _mm_mul_ps(qz, v.y)));
+        const __m128 cy = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qz, v.x), _mm_mul_ps(qx, v.z)));
+        const __m128 cz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, v.y), _mm_mul_ps(qy, v.x)));
+        return {
+            _mm_add_ps(_mm_add_ps(madd(qw, cx, v.x), _mm_sub_ps(_mm_mul_ps(qy, cz), _mm_mul_ps(qz, cy))), tx),
+            _mm_add_ps(_mm_add_ps(madd(qw, cy, v.y), _mm_sub_ps(_mm_mul_ps(qz, cx), _mm_mul_ps(qx, cz))), ty),
+            _mm_add_ps(_mm_add_ps(madd(qw, cz, v.z), _mm_sub_ps(_mm_mul_ps(qx, cy), _mm_mul_ps(qy, cx))), tz)};
+    }
+
+    __m128 qx, qy, qz, qw, tx, ty, tz;
+    #endif
+
+    Vector3 q;
+    Float w;
+    Vector3 translation;
+};
+
+template<class Kernel> void transformRange(const Kernel& kernel, const Containers::StridedArrayView<const Vector3>& in, const Containers::StridedArrayView<Vector3>& out, const std::size_t begin, const std::size_t end) {
+    std::size_t i = begin;
+    #ifdef _MAGNUM_USE_SSE2
+    const std::ptrdiff_t inStride = in.stride();
+    const std::ptrdiff_t outStride = out.stride();
+    for(; i + 4 <= end; i += 4)
+        store(kernel(load(&in[i], inStride)), &out[i], outStride);
+    #endif
+    for(; i != end; ++i) out[i] = kernel(in[i]);
+}
+
+template<class Kernel> void transformInto(const Kernel& kernel, const Containers::StridedArrayView<const Vector3>& in, const Containers::StridedArrayView<Vector3>& out, const UnsignedInt threadCount) {
+    Implementation::parallelFor(Implementation::effectiveThreadCount(threadCount, in.size(), MinItemsPerThread), in.size(), [&](const std::size_t begin, const std::size_t end, UnsignedInt) {
+        transformRange(kernel, in, out, begin, end);
+    });
+}
+
+}
+
+void transformVectorsInto(const Matrix4& matrix, const Containers::StridedArrayView<const Vector3>& vectors, const Containers::StridedArrayView<Vector3>& out, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(out.size() == vectors.size(),
+        "MeshTools::transformVectorsInto(): expected" << vectors.size() << "output items but got" << out.size(), );
+
+    transformInto(MatrixKernel{matrix, false}, vectors, out, threadCount);
+}
+
+void transformVectorsInto(const Quaternion& normalizedQuaternion, const Containers::StridedArrayView<const Vector3>& vectors, const Containers::StridedArrayView<Vector3>& out, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(normalizedQuaternion.isNormalized(),
+        "MeshTools::transformVectorsInto():" << normalizedQuaternion << "is not normalized", );
+    CORRADE_ASSERT(out.size() == vectors.size(),
+        "MeshTools::transformVectorsInto(): expected" << vectors.size() << "output items but got" << out.size(), );
+
+    transformInto(QuaternionKernel{normalizedQuaternion, {}}, vectors, out, threadCount);
+}
+
+void transformPointsInto(const Matrix4& matrix, const Containers::StridedArrayView<const Vector3>& points, const Containers::StridedArrayView<Vector3>& out, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(out.size() == points.size(),
+        "MeshTools::transformPointsInto(): expected" << points.size() << "output items but got" << out.size(), );
+
+    transformInto(MatrixKernel{matrix, true}, points, out, threadCount);
+}
+
+void transformPointsInto(const DualQuaternion& normalizedDualQuaternion, const Containers::StridedArrayView<const Vector3>& points, const Containers::StridedArrayView<Vector3>& out, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(normalizedDualQuaternion.isNormalized(),
+        "MeshTools::transformPointsInto():" << normalizedDualQuaternion << "is not normalized", );
+    CORRADE_ASSERT(out.size() == points.size(),
+        "MeshTools::transformPointsInto(): expected" << points.size() << "output items but got" << out.size(), );
+
+    transformInto(QuaternionKernel{normalizedDualQuaternion.real(), normalizedDualQuaternion.translation()}, points, out, threadCount);
+}
+
+}}
@@ -26,11 +26,15 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::transformVectorsInPlace(), @ref Magnum::MeshTools::transformVectors(), @ref Magnum::MeshTools::transformPointsInPlace(), @ref Magnum::MeshTools::transformPoints()
+ * @brief Function @ref Magnum::MeshTools::transformVectorsInPlace(), @ref Magnum::MeshTools::transformVectors(), @ref Magnum::MeshTools::transformVectorsInto(), @ref Magnum::MeshTools::transformPointsInPlace(), @ref Magnum::MeshTools::transformPoints(), @ref Magnum::MeshTools::transformPointsInto()
  */
 
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
 #include "Magnum/Math/DualQuaternion.h"
 #include "Magnum/Math/DualComplex.h"
+#include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -50,6 +54,10 @@ Example usage:
 
 @snippet MagnumMeshTools.cpp transformVectors
 
+For large arrays of three-component vectors prefer
+@ref transformVectorsInto(), which processes multiple vectors at once using
+SIMD instructions and can split the work across multiple threads.
+
 @see @ref transformVectors(), @ref Matrix3::transformVector(),
     @ref Matrix4::transformVector(), @ref Complex::transformVector(),
     @ref Quaternion::transformVectorNormalized()
@@ -86,6 +94,46 @@ template<class T, class U> U transformVectors(const T& transformation, U vectors
     return result;
 }
 
+/**
+@brief Transform vectors into an existing array
+@param[in] matrix       Transformation matrix
+@param[in] vectors      Vectors to transform
+@param[out] out         Where to put the transformed vectors
+@param[in] threadCount  Count of threads to use, including the calling one. If
+    @cpp 0 @ce, @ref std::thread::hardware_concurrency() is used.
+
+Batch variant of @ref transformVectorsInPlace(const Math::Matrix4<T>&, U&)
+operating on potentially strided views. The @p out view is expected to have
+the same size as @p vectors, it can point to the same memory as @p vectors
+(or overlap it exactly), in which case the transformation is done in-place.
+The result is the same as calling @ref Matrix4::transformVector() on each
+item:
+
+@snippet MagnumMeshTools.cpp transformPointsInto
+
+On x86 the vectors are processed four at a time with SSE2, contiguous views
+are loaded and stored without any per-item overhead. Multiple threads are
+used only for large inputs.
+@see @ref transformPointsInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformVectorsInto(const Matrix4& matrix, const Containers::StridedArrayView<const Vector3>& vectors, const Containers::StridedArrayView<Vector3>& out, UnsignedInt threadCount = 0);
+
+/**
+@brief Transform vectors into an existing array using a quaternion
+@param[in] normalizedQuaternion Normalized rotation quaternion
+@param[in] vectors      Vectors to transform
+@param[out] out         Where to put the transformed vectors
+@param[in] threadCount  Count of threads to use, including the calling one. If
+    @cpp 0 @ce, @ref std::thread::hardware_concurrency() is used.
+
+Batch variant of @ref transformVectorsInPlace(const Math::Quaternion<T>&, U&).
+Expects that @p normalizedQuaternion is normalized, the result is the same
+as calling @ref Quaternion::transformVectorNormalized() on each item. See
+@ref transformVectorsInto(const Matrix4&, const Containers::StridedArrayView<const Vector3>&, const Containers::StridedArrayView<Vector3>&, UnsignedInt)
+for more information.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformVectorsInto(const Quaternion& normalizedQuaternion, const Containers::StridedArrayView<const Vector3>& vectors, const Containers::StridedArrayView<Vector3>& out, UnsignedInt threadCount = 0);
+
 /**
 @brief Transform points in-place using given transformation
 
@@ -102,6 +150,10 @@ Example usage:
 
 @snippet MagnumMeshTools.cpp transformPoints
 
+For large arrays of three-component points prefer @ref transformPointsInto(),
+which processes multiple points at once using SIMD instructions and can split
+the work across multiple threads.
+
 @see @ref transformPoints(), @ref Matrix3::transformPoint(),
     @ref Matrix4::transformPoint(),
     @ref DualQuaternion::transformPointNormalized()
@@ -125,6 +177,40 @@ template<class T, class U> void transformPointsInPlace(const Math::DualQuaternio
     for(auto& point: points) point = normalizedDualQuaternion.transformPointNormalized(point);
 }
 
+/**
+@brief Transform points into an existing array
+@param[in] matrix       Transformation matrix
+@param[in] points       Points to transform
+@param[out] out         Where to put the transformed points
+@param[in] threadCount  Count of threads to use, including the calling one. If
+    @cpp 0 @ce, @ref std::thread::hardware_concurrency() is used.
+
+Batch variant of @ref transformPointsInPlace(const Math::Matrix4<T>&, U&)
+operating on potentially strided views. The result is the same as calling
+@ref Matrix4::transformPoint() on each item, see
+@ref transformVectorsInto(const Matrix4&, const Containers::StridedArrayView<const Vector3>&, const Containers::StridedArrayView<Vector3>&, UnsignedInt)
+for more information.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformPointsInto(const Matrix4& matrix, const Containers::StridedArrayView<const Vector3>& points, const Containers::StridedArrayView<Vector3>& out, UnsignedInt threadCount = 0);
+
+/**
+@brief Transform points into an existing array using a dual quaternion
+@param[in] normalizedDualQuaternion Normalized dual quaternion
+@param[in] points       Points to transform
+@param[out] out         Where to put the transformed points
+@param[in] threadCount  Count of threads to use, including the calling one. If
+    @cpp 0 @ce, @ref std::thread::hardware_concurrency() is used.
+
+Batch variant of @ref transformPointsInPlace(const Math::DualQuaternion<T>&, U&).
+Expects that @p normalizedDualQuaternion is normalized. Each point is rotated
+with the real part and translated by @ref DualQuaternion::translation(), which
+gives the same result as @ref DualQuaternion::transformPointNormalized() up to
+floating-point precision. See
+@ref transformVectorsInto(const Matrix4&, const Containers::StridedArrayView<const Vector3>&, const Containers::StridedArrayView<Vector3>&, UnsignedInt)
+for more information.
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformPointsInto(const DualQuaternion& normalizedDualQuaternion, const Containers::StridedArrayView<const Vector3>& points, const Containers::StridedArrayView<Vector3>& out, UnsignedInt threadCount = 0);
+
 /**
 @brief Transform points using given transformation
 
@@ -31,6 +31,7 @@
 
 #include <functional>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/LinkedList.h>
 
 #include "Magnum/DimensionTraits.h"
@@ -165,6 +166,22 @@ template<UnsignedInt dimensions, class T> class AbstractObject
             return doTransformationMatrices(objects, initialTransformationMatrix);
         }
 
+        /**
+         * @brief Calculate transformation matrices of given set of objects into a pre-allocated view
+         *
+         * Like @ref transformationMatrices(), but the result is written into
+         * @p out, which is expected to have the same size as @p objects. The
+         * temporary storage is owned by the scene and reused across calls, so
+         * once it's large enough for given object set, the calculation
+         * doesn't allocate. Expects that this object is a scene.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Object::transformationMatricesInto()
+         *      when possible.
+         */
+        void transformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix = MatrixType()) const {
+            doTransformationMatricesInto(objects, out, initialTransformationMatrix);
+        }
+
         /*@}*/
 
         /**
@@ -242,6 +259,7 @@ template<UnsignedInt dimensions, class T> class AbstractObject
         virtual MatrixType doTransformationMatrix() const = 0;
         virtual MatrixType doAbsoluteTransformationMatrix() const = 0;
         virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& initialTransformationMatrix) const = 0;
+        virtual void doTransformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix) const = 0;
 
         virtual bool doIsDirty() const = 0;
         virtual void doSetDirty() = 0;
@@ -71,6 +71,19 @@ Common setup example for 3D scenes:
 
 @snippet MagnumSceneGraph.cpp Camera-3D
 
+@section SceneGraph-Camera-culling Frustum culling
+
+If enabled using @ref setCullingEnabled(), the camera tests bounding volumes of
+all drawables against the view before drawing them. In 3D the bounding spheres
+and boxes are tested against a @ref Math::Frustum extracted from
+@ref projectionMatrix() using @ref Math::Intersection::sphereFrustum() and
+@ref Math::Intersection::aabbFrustum(), in 2D they are transformed to clip
+space and tested against the @f$ [-1; 1] @f$ range. The test is conservative,
+drawables that are only partially visible are always drawn. Counts of culled
+and visible drawables from the last draw are available through
+@ref culledCount() and @ref visibleCount(). See
+@ref SceneGraph-Drawable-culling for more information.
+
 @section SceneGraph-Camera-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -174,6 +187,49 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
             return {T(2.0)/_projectionMatrix[0].x(), T(2.0)/_projectionMatrix[1].y()};
         }
 
+        /**
+         * @brief Whether frustum culling is enabled
+         *
+         * @see @ref setCullingEnabled()
+         */
+        bool isCullingEnabled() const { return _cullingEnabled; }
+
+        /**
+         * @brief Enable or disable frustum culling
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, @ref draw(DrawableGroup<dimensions, T>&) and
+         * @ref drawableTransformations() skip drawables whose bounding volume
+         * is completely outside of the view. Disabled by default. See
+         * @ref SceneGraph-Camera-culling for more information.
+         */
+        Camera<dimensions, T>& setCullingEnabled(bool enabled) {
+            _cullingEnabled = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Count of drawables culled in the last draw
+         *
+         * Count of drawables skipped in the last call to
+         * @ref draw(DrawableGroup<dimensions, T>&) or
+         * @ref drawableTransformations(). Always @cpp 0 @ce if culling is
+         * disabled.
+         * @see @ref visibleCount(), @ref setCullingEnabled()
+         */
+        std::size_t culledCount() const { return _culledCount; }
+
+        /**
+         * @brief Count of drawables visible in the last draw
+         *
+         * Count of drawables passed on in the last call to
+         * @ref draw(DrawableGroup<dimensions, T>&) or
+         * @ref drawableTransformations(), including drawables without a
+         * bounding volume.
+         * @see @ref culledCount(), @ref setCullingEnabled()
+         */
+        std::size_t visibleCount() const { return _visibleCount; }
+
         /** @brief Viewport size */
         Vector2i viewport() const { return _viewport; }
 
@@ -190,7 +246,8 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
          * @brief Drawable transformations
          *
          * Returns calculated transformations for given group of drawables.
-         * Useful in combination with @ref draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>&)
+         * If culling is enabled, drawables outside of the view are not
+         * included. Useful in combination with @ref draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>&)
          * to provide custom draw order. See @ref SceneGraph-Drawable-draw-order
          * for more information.
          */
@@ -199,7 +256,8 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         /**
          * @brief Draw
          *
-         * Draws given group of drawables.
+         * Draws given group of drawables. If culling is enabled, drawables
+         * outside of the view are skipped.
          * @see @ref draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>&)
          */
         void draw(DrawableGroup<dimensions, T>& group);
@@ -208,7 +266,8 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
          * @brief Draw given drawables with transformations
          *
          * Useful in combination with @ref drawableTransformations() for
-         * drawing in a custom order. See @ref SceneGraph-Drawable-draw-order
+         * drawing in a custom order. No culling is done and the culling
+         * counters are not updated. See @ref SceneGraph-Drawable-draw-order
          * for more information.
          */
         void draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>& drawableTransformations);
@@ -220,6 +279,8 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         }
 
         void fixAspectRatio();
+        void calculateTransformations(const AbstractObject<dimensions, T>& scene, DrawableGroup<dimensions, T>& group);
+        void cull(DrawableGroup<dimensions, T>& group);
 
         MatrixTypeFor<dimensions, T> _rawProjectionMatrix;
         AspectRatioPolicy _aspectRatioPolicy;
@@ -228,6 +289,14 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         MatrixTypeFor<dimensions, T> _cameraMatrix;
 
         Vector2i _viewport;
+
+        bool _cullingEnabled;
+        std::size_t _culledCount, _visibleCount;
+
+        /* Reused by draw() to avoid per-frame allocations */
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> _objects;
+        std::vector<MatrixTypeFor<dimensions, T>> _transformations;
+        std::vector<UnsignedInt> _visible;
 };
 
 /**
@@ -30,6 +30,7 @@
  */
 
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Intersection.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
 
@@ -53,9 +54,87 @@ template<UnsignedInt dimensions, class T> MatrixTypeFor<dimensions, T> aspectRat
         Math::Vector2<T>(T(1), relativeAspectRatio.x()/relativeAspectRatio.y()), T(1)));
 }
 
+/* Half-extents of the smallest axis-aligned box containing a box with given
+   half-extents transformed by given rotation and scaling */
+template<std::size_t size, class T> Math::Vector<size, T> transformedExtents(const Math::Matrix<size, T>& rotationScaling, const Math::Vector<size, T>& extents) {
+    Math::Vector<size, T> out;
+    for(std::size_t i = 0; i != size; ++i)
+        out += Math::abs(rotationScaling[i])*extents[i];
+    return out;
 }
 
-template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved) {
+/* Extents of a sphere transformed with given matrix. The sphere becomes an
+   ellipse, its half-size along each axis is the length of the corresponding
+   matrix row. */
+template<std::size_t size, class T> Math::Vector<size, T> transformedSphereExtents(const Math::Matrix<size, T>& rotationScaling, const T radius) {
+    Math::Vector<size, T> out;
+    for(std::size_t i = 0; i != size; ++i)
+        out += rotationScaling[i]*rotationScaling[i];
+    return Math::sqrt(out)*radius;
+}
+
+/* Upper bound of the scaling factor along any axis, used for scaling sphere
+   radius. That's the largest singular value, i.e. square root of the largest
+   eigenvalue of M^T M. Its Gershgorin bound is the largest column length if
+   the columns are orthogonal, which is the case for matrices made of
+   translation, rotation and scaling applied in this order. Non-uniform
+   scaling applied after rotation makes the columns non-orthogonal, for
+   those ||M||_2^2 <= ||M||_1*||M||_inf is usually tighter. Unlike just
+   taking the largest column length neither ever underestimates. */
+template<std::size_t size, class T> T maxScaling(const Math::Matrix<size, T>& rotationScaling) {
+    T gershgorin{}, norm1{}, normInf{};
+    for(std::size_t i = 0; i != size; ++i) {
+        T sum = rotationScaling[i].dot();
+        for(std::size_t j = 0; j != size; ++j)
+            if(j != i) sum += Math::abs(Math::dot(rotationScaling[i], rotationScaling[j]));
+        gershgorin = Math::max(gershgorin, sum);
+        norm1 = Math::max(norm1, Math::abs(rotationScaling[i]).sum());
+        normInf = Math::max(normInf, Math::abs(rotationScaling.row(i)).sum());
+    }
+    return Math::sqrt(Math::min(gershgorin, norm1*normInf));
+}
+
+template<UnsignedInt dimensions, class T> struct CameraCulling;
+
+/* The 2D projection is affine, so the bounding volumes are transformed
+   directly to clip space and tested against the [-1, 1] square. Spheres are
+   tested as bounding rectangles of the ellipses they become in clip
+   space. */
+template<class T> struct CameraCulling<2, T> {
+    explicit CameraCulling(const Math::Matrix3<T>& projectionMatrix): projectionMatrix{projectionMatrix} {}
+
+    bool sphere(const Math::Matrix3<T>& transformationMatrix, const Math::Vector2<T>& center, T radius) const {
+        const Math::Matrix3<T> clip = projectionMatrix*transformationMatrix;
+        return (Math::abs(clip.transformPoint(center)) - transformedSphereExtents(clip.rotationScaling(), radius) <= Math::Vector2<T>(T(1))).all();
+    }
+
+    bool box(const Math::Matrix3<T>& transformationMatrix, const Math::Vector2<T>& center, const Math::Vector2<T>& extents) const {
+        const Math::Matrix3<T> clip = projectionMatrix*transformationMatrix;
+        return (Math::abs(clip.transformPoint(center)) - transformedExtents(clip.rotationScaling(), extents) <= Math::Vector2<T>(T(1))).all();
+    }
+
+    Math::Matrix3<T> projectionMatrix;
+};
+
+/* The transformations are relative to the camera, so the frustum is
+   extracted from the projection matrix alone */
+template<class T> struct CameraCulling<3, T> {
+    explicit CameraCulling(const Math::Matrix4<T>& projectionMatrix): frustum{Math::Frustum<T>::fromMatrix(projectionMatrix)} {}
+
+    bool sphere(const Math::Matrix4<T>& transformationMatrix, const Math::Vector3<T>& center, T radius) const {
+        return Math::Intersection::sphereFrustum<T>(transformationMatrix.transformPoint(center), radius*maxScaling(transformationMatrix.rotationScaling()), frustum);
+    }
+
+    bool box(const Math::Matrix4<T>& transformationMatrix, const Math::Vector3<T>& center, const Math::Vector3<T>& extents) const {
+        return Math::Intersection::aabbFrustum<T>(transformationMatrix.transformPoint(center), transformedExtents(transformationMatrix.rotationScaling(), extents), frustum);
+    }
+
+    Math::Frustum<T> frustum;
+};
+
+}
+
+template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved), _cullingEnabled(false), _culledCount(0), _visibleCount(0) {
     AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::InvertedAbsolute);
 }
 
@@ -82,6 +161,44 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::setViewpor
     fixAspectRatio();
 }
 
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::calculateTransformations(const AbstractObject<dimensions, T>& scene, DrawableGroup<dimensions, T>& group) {
+    /* The object list and the output are kept between calls, together with
+       the scratch storage owned by the scene this means no allocations once
+       the group stops growing */
+    _objects.clear();
+    for(std::size_t i = 0; i != group.size(); ++i)
+        _objects.push_back(group[i].object());
+    _transformations.resize(group.size());
+    scene.transformationMatricesInto(_objects, {_transformations.data(), _transformations.size()}, _cameraMatrix);
+}
+
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::cull(DrawableGroup<dimensions, T>& group) {
+    /* All bounding volumes are tested in one pass over the already
+       calculated transformations, collecting indices of the visible
+       drawables. The index list is kept between calls as well. */
+    const Implementation::CameraCulling<dimensions, T> culling{_projectionMatrix};
+    _visible.clear();
+    for(std::size_t i = 0; i != group.size(); ++i) {
+        const Drawable<dimensions, T>& drawable = group[i];
+        bool visible = true;
+        switch(drawable._boundingVolume) {
+            case Implementation::DrawableBoundingVolume::None:
+                break;
+            case Implementation::DrawableBoundingVolume::Sphere:
+                visible = culling.sphere(_transformations[i], drawable._boundingCenter, drawable._boundingRadius);
+                break;
+            case Implementation::DrawableBoundingVolume::Box:
+                visible = culling.box(_transformations[i], drawable._boundingCenter, drawable._boundingExtents);
+                break;
+        }
+
+        if(visible) _visible.push_back(UnsignedInt(i));
+    }
+
+    _visibleCount = _visible.size();
+    _culledCount = group.size() - _visible.size();
+}
+
 template<UnsignedInt dimensions, class T> std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> Camera<dimensions, T>::drawableTransformations(DrawableGroup<dimensions, T>& group) {
     AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
     CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", {});
@@ -90,18 +207,23 @@ template<UnsignedInt dimensions, class T> std::vector<std::pair<std::reference_w
     AbstractFeature<dimensions, T>::object().setClean();
 
     /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
-    objects.reserve(group.size());
-    for(std::size_t i = 0; i != group.size(); ++i)
-        objects.push_back(group[i].object());
-    std::vector<MatrixTypeFor<dimensions, T>> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
+    calculateTransformations(*scene, group);
 
-    /* Combine drawable references and transformation matrices */
+    /* Combine drawable references and transformation matrices, skipping
+       the invisible ones if culling is enabled */
     std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> combined;
-    combined.reserve(group.size());
-    for(std::size_t i = 0; i != group.size(); ++i)
-        combined.emplace_back(group[i], transformations[i]);
+    if(_cullingEnabled) {
+        cull(group);
+        combined.reserve(_visible.size());
+        for(UnsignedInt i: _visible)
+            combined.emplace_back(group[i], _transformations[i]);
+    } else {
+        _culledCount = 0;
+        _visibleCount = group.size();
+        combined.reserve(group.size());
+        for(std::size_t i = 0; i != group.size(); ++i)
+            combined.emplace_back(group[i], _transformations[i]);
+    }
 
     return combined;
 }
@@ -114,16 +236,20 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(Drawa
     AbstractFeature<dimensions, T>::object().setClean();
 
     /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
-    objects.reserve(group.size());
-    for(std::size_t i = 0; i != group.size(); ++i)
-        objects.push_back(group[i].object());
-    std::vector<MatrixTypeFor<dimensions, T>> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
+    calculateTransformations(*scene, group);
 
-    /* Perform the drawing */
-    for(std::size_t i = 0; i != transformations.size(); ++i)
-        group[i].draw(transformations[i], *this);
+    /* Perform the drawing, skipping the invisible drawables if culling is
+       enabled */
+    if(_cullingEnabled) {
+        cull(group);
+        for(UnsignedInt i: _visible)
+            group[i].draw(_transformations[i], *this);
+    } else {
+        _culledCount = 0;
+        _visibleCount = group.size();
+        for(std::size_t i = 0; i != group.size(); ++i)
+            group[i].draw(_transformations[i], *this);
+    }
 }
 
 template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>& drawableTransformations) {
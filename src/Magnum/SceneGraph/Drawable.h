@@ -29,10 +29,18 @@
  * @brief Class @ref Magnum::SceneGraph::Drawable, @ref Magnum::SceneGraph::DrawableGroup, alias @ref Magnum::SceneGraph::BasicDrawable2D, @ref Magnum::SceneGraph::BasicDrawable3D, @ref Magnum::SceneGraph::BasicDrawableGroup2D, @ref Magnum::SceneGraph::BasicDrawableGroup3D, typedef @ref Magnum::SceneGraph::Drawable2D, @ref Magnum::SceneGraph::Drawable3D, @ref Magnum::SceneGraph::DrawableGroup2D, @ref Magnum::SceneGraph::DrawableGroup3D
  */
 
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/AbstractGroupedFeature.h"
 
 namespace Magnum { namespace SceneGraph {
 
+namespace Implementation {
+    enum class DrawableBoundingVolume: UnsignedByte {
+        None, Sphere, Box
+    };
+}
+
 /**
 @brief Drawable
 
@@ -122,6 +130,18 @@ predicate on the drawable transformation list:
 
 @snippet MagnumSceneGraph.cpp Drawable-draw-order
 
+@section SceneGraph-Drawable-culling Frustum culling
+
+Drawables can have a bounding sphere or a bounding box set using
+@ref setBoundingSphere() or @ref setBoundingBox(). If culling is enabled on
+the camera using @ref Camera::setCullingEnabled(), drawables whose bounding
+volume is completely outside of the camera view are skipped in
+@ref Camera::draw(DrawableGroup<dimensions, T>&) and
+@ref Camera::drawableTransformations(). Drawables without a bounding volume are
+always drawn.
+
+@snippet MagnumSceneGraph.cpp Drawable-culling
+
 @section SceneGraph-Drawable-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -167,6 +187,60 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
             return AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>::group();
         }
 
+        /**
+         * @brief Whether the drawable has a bounding volume
+         *
+         * @see @ref setBoundingSphere(), @ref setBoundingBox(),
+         *      @ref resetBoundingVolume()
+         */
+        bool hasBoundingVolume() const {
+            return _boundingVolume != Implementation::DrawableBoundingVolume::None;
+        }
+
+        /**
+         * @brief Set bounding sphere
+         * @param center    Sphere center relative to the object
+         * @param radius    Sphere radius
+         * @return Reference to self (for method chaining)
+         *
+         * Used by the camera for culling, see
+         * @ref SceneGraph-Drawable-culling for more information. Replaces
+         * the bounding box, if set.
+         */
+        Drawable<dimensions, T>& setBoundingSphere(const VectorTypeFor<dimensions, T>& center, T radius) {
+            _boundingVolume = Implementation::DrawableBoundingVolume::Sphere;
+            _boundingCenter = center;
+            _boundingRadius = radius;
+            return *this;
+        }
+
+        /**
+         * @brief Set bounding box
+         * @param box       Box relative to the object
+         * @return Reference to self (for method chaining)
+         *
+         * Used by the camera for culling, see
+         * @ref SceneGraph-Drawable-culling for more information. Replaces
+         * the bounding sphere, if set.
+         */
+        Drawable<dimensions, T>& setBoundingBox(const RangeTypeFor<dimensions, T>& box) {
+            _boundingVolume = Implementation::DrawableBoundingVolume::Box;
+            _boundingCenter = box.center();
+            _boundingExtents = box.size()/T(2);
+            return *this;
+        }
+
+        /**
+         * @brief Reset bounding volume
+         * @return Reference to self (for method chaining)
+         *
+         * The drawable is then never culled.
+         */
+        Drawable<dimensions, T>& resetBoundingVolume() {
+            _boundingVolume = Implementation::DrawableBoundingVolume::None;
+            return *this;
+        }
+
         /**
          * @brief Draw the object using given camera
          * @param transformationMatrix  Object transformation relative to camera
@@ -176,6 +250,15 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * @ref SceneGraph::Camera::projectionMatrix() "Camera::projectionMatrix()".
          */
         virtual void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) = 0;
+
+    private:
+        #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        friend Camera<dimensions, T>;
+        #endif
+
+        Implementation::DrawableBoundingVolume _boundingVolume;
+        T _boundingRadius;
+        VectorTypeFor<dimensions, T> _boundingCenter, _boundingExtents;
 };
 
 /**
@@ -0,0 +1,272 @@
+#ifndef Magnum_SceneGraph_FlatHierarchy_h
+#define Magnum_SceneGraph_FlatHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::FlatHierarchy
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Flat transformation hierarchy
+
+A data-oriented alternative to the pointer-linked @ref Object tree. The
+hierarchy is stored as a structure of arrays --- parent indices together with
+contiguous arrays of local and world transformations, ordered so each parent
+is stored before all its children. World transformations of all objects are
+then calculated with a single linear pass in @ref update(), without any
+recursion, pointer chasing or bookkeeping of visited objects as done in
+@ref Object::transformations().
+
+The hierarchy can be either built directly using @ref add() or mirrored from
+an existing @ref Scene using @ref mirror(), in which case the objects are
+stored in a breadth-first order and @ref objects() contains the mapping back
+to the original objects. Local transformations can be then modified directly
+through @ref localTransformations() or re-fetched from the mirrored scene
+using @ref pull():
+
+@snippet MagnumSceneGraph.cpp FlatHierarchy-usage
+
+The class is a header-only template and works with any transformation
+implementation, @p Transformation being the same type as used for the
+@ref Object and @ref Scene.
+@experimental
+*/
+template<class Transformation> class FlatHierarchy {
+    public:
+        /** @brief Underlying transformation type */
+        typedef typename Transformation::DataType DataType;
+
+        /** @brief Default constructor */
+        explicit FlatHierarchy() = default;
+
+        /**
+         * @brief Construct from a scene
+         *
+         * Equivalent to default-constructing the instance and calling
+         * @ref mirror().
+         */
+        explicit FlatHierarchy(Scene<Transformation>& scene) { mirror(scene); }
+
+        /** @brief Object count */
+        std::size_t size() const { return _parents.size(); }
+
+        /**
+         * @brief Parent indices
+         *
+         * Index of the parent object for each object, or @cpp -1 @ce for
+         * root objects. Each index is always less than the index of the
+         * object itself.
+         */
+        Containers::ArrayView<const Int> parents() const {
+            return {_parents.data(), _parents.size()};
+        }
+
+        /**
+         * @brief Local transformations
+         *
+         * Transformations relative to the parent object. Changes are
+         * propagated to @ref worldTransformations() on the next
+         * @ref update().
+         */
+        Containers::ArrayView<DataType> localTransformations() {
+            return {_localTransformations.data(), _localTransformations.size()};
+        }
+
+        /** @overload */
+        Containers::ArrayView<const DataType> localTransformations() const {
+            return {_localTransformations.data(), _localTransformations.size()};
+        }
+
+        /**
+         * @brief World transformations
+         *
+         * Absolute transformations calculated in the last call to
+         * @ref update(). Contents are unspecified for objects that were
+         * added after.
+         */
+        Containers::ArrayView<const DataType> worldTransformations() const {
+            return {_worldTransformations.data(), _worldTransformations.size()};
+        }
+
+        /**
+         * @brief Mirrored objects
+         *
+         * Object corresponding to each index, if the hierarchy was populated
+         * using @ref mirror(), @cpp nullptr @ce for objects added using
+         * @ref add().
+         */
+        Containers::ArrayView<Object<Transformation>* const> objects() const {
+            return {_objects.data(), _objects.size()};
+        }
+
+        /**
+         * @brief Reserve memory for given object count
+         * @return Reference to self (for method chaining)
+         */
+        FlatHierarchy<Transformation>& reserve(std::size_t size);
+
+        /**
+         * @brief Remove all objects
+         * @return Reference to self (for method chaining)
+         *
+         * The allocated memory is kept for reuse.
+         */
+        FlatHierarchy<Transformation>& clear();
+
+        /**
+         * @brief Add an object
+         * @param parent            Parent index or @cpp -1 @ce for a root
+         *      object
+         * @param transformation    Local transformation
+         * @return Index of the added object
+         *
+         * The @p parent is expected to be less than @ref size().
+         */
+        UnsignedInt add(Int parent, const DataType& transformation = DataType{});
+
+        /**
+         * @brief Mirror a scene
+         * @return Reference to self (for method chaining)
+         *
+         * Replaces the contents with all objects in @p scene in a
+         * breadth-first order, with children of the scene being the root
+         * objects. The scene itself is not included. The local transformations
+         * are initialized from @ref Object::transformation() "transformation()"
+         * of each object and @ref objects() contains the mapping back.
+         */
+        FlatHierarchy<Transformation>& mirror(Scene<Transformation>& scene);
+
+        /**
+         * @brief Update local transformations from mirrored objects
+         * @return Reference to self (for method chaining)
+         *
+         * Copies @ref Object::transformation() "transformation()" of every
+         * mirrored object to @ref localTransformations(). Objects added using
+         * @ref add() are left untouched. The hierarchy itself is not
+         * updated, call @ref mirror() if objects were added, removed or
+         * reparented in the scene.
+         */
+        FlatHierarchy<Transformation>& pull();
+
+        /**
+         * @brief Calculate world transformations
+         * @return Reference to self (for method chaining)
+         *
+         * Composes local transformation of each object with world
+         * transformation of its parent in a single linear pass. Root objects
+         * are composed with @p initialTransformation.
+         */
+        FlatHierarchy<Transformation>& update(const DataType& initialTransformation = DataType{});
+
+    private:
+        std::vector<Int> _parents;
+        std::vector<DataType> _localTransformations, _worldTransformations;
+        std::vector<Object<Transformation>*> _objects;
+};
+
+template<class Transformation> FlatHierarchy<Transformation>& FlatHierarchy<Transformation>::reserve(const std::size_t size) {
+    _parents.reserve(size);
+    _localTransformations.reserve(size);
+    _worldTransformations.reserve(size);
+    _objects.reserve(size);
+    return *this;
+}
+
+template<class Transformation> FlatHierarchy<Transformation>& FlatHierarchy<Transformation>::clear() {
+    _parents.clear();
+    _localTransformations.clear();
+    _worldTransformations.clear();
+    _objects.clear();
+    return *this;
+}
+
+template<class Transformation> UnsignedInt FlatHierarchy<Transformation>::add(const Int parent, const DataType& transformation) {
+    CORRADE_ASSERT(parent >= -1 && parent < Int(_parents.size()),
+        "SceneGraph::FlatHierarchy::add(): parent index" << parent << "out of range for" << _parents.size() << "objects", {});
+
+    _parents.push_back(parent);
+    _localTransformations.push_back(transformation);
+    _worldTransformations.emplace_back();
+    _objects.push_back(nullptr);
+    return UnsignedInt(_parents.size() - 1);
+}
+
+template<class Transformation> FlatHierarchy<Transformation>& FlatHierarchy<Transformation>::mirror(Scene<Transformation>& scene) {
+    clear();
+
+    /* Children of the scene are roots */
+    for(Object<Transformation>& child: scene.children()) {
+        _parents.push_back(-1);
+        _objects.push_back(&child);
+    }
+
+    /* The object array doubles as the queue for the breadth-first traversal,
+       which guarantees that parents are always before their children */
+    for(std::size_t i = 0; i != _objects.size(); ++i) {
+        for(Object<Transformation>& child: _objects[i]->children()) {
+            _parents.push_back(Int(i));
+            _objects.push_back(&child);
+        }
+    }
+
+    _localTransformations.reserve(_objects.size());
+    for(Object<Transformation>* object: _objects)
+        _localTransformations.push_back(object->transformation());
+    _worldTransformations.resize(_objects.size());
+
+    return *this;
+}
+
+template<class Transformation> FlatHierarchy<Transformation>& FlatHierarchy<Transformation>::pull() {
+    for(std::size_t i = 0; i != _objects.size(); ++i)
+        if(_objects[i]) _localTransformations[i] = _objects[i]->transformation();
+    return *this;
+}
+
+template<class Transformation> FlatHierarchy<Transformation>& FlatHierarchy<Transformation>::update(const DataType& initialTransformation) {
+    const Int* const parents = _parents.data();
+    const DataType* const local = _localTransformations.data();
+    DataType* const world = _worldTransformations.data();
+    for(std::size_t i = 0, size = _parents.size(); i != size; ++i) {
+        const Int parent = parents[i];
+        world[i] = Implementation::Transformation<Transformation>::compose(
+            parent == -1 ? initialTransformation : world[parent], local[i]);
+    }
+
+    return *this;
+}
+
+}}
+
+#endif
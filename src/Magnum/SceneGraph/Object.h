@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::SceneGraph::Object
  */
 
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/SceneGraph/AbstractFeature.h"
@@ -107,6 +108,8 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /** @brief Matrix type */
         typedef MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type> MatrixType;
 
+        class TransformationScratch;
+
         /**
          * @brief Constructor
          * @param parent    Parent object
@@ -261,9 +264,7 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          * if specified.
          * @see @ref transformationMatrices()
          */
-        /* `objects` passed by copy intentionally (to allow move from
-           transformationMatrices() and avoid copy in the function itself) */
-        std::vector<typename Transformation::DataType> transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation =
+        std::vector<typename Transformation::DataType> transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const typename Transformation::DataType& initialTransformation =
             #ifndef CORRADE_MSVC2015_COMPATIBILITY /* I hate this inconsistency */
             typename Transformation::DataType()
             #else
@@ -271,6 +272,35 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             #endif
             ) const;
 
+        /**
+         * @brief Calculate transformations of given group of objects into a pre-allocated view
+         *
+         * Like @ref transformations(), but the result is written into @p out,
+         * which is expected to have the same size as @p objects, and all
+         * temporary data are kept in @p scratch. When the same scratch
+         * instance is reused across calls (for example every frame), no heap
+         * allocations are done once its capacity is large enough for the
+         * object set. There's no limit on the object count.
+         * @see @ref transformationMatricesInto()
+         */
+        void transformationsInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, Containers::ArrayView<typename Transformation::DataType> out, TransformationScratch& scratch, const typename Transformation::DataType& initialTransformation =
+            #ifndef CORRADE_MSVC2015_COMPATIBILITY
+            typename Transformation::DataType()
+            #else
+            Transformation::DataType()
+            #endif
+            ) const;
+
+        /**
+         * @brief Calculate transformation matrices of given group of objects into a pre-allocated view
+         *
+         * Like @ref transformationMatrices(), but the result is written into
+         * @p out, which is expected to have the same size as @p objects, and
+         * all temporary data are kept in @p scratch. See
+         * @ref transformationsInto() for more information.
+         */
+        void transformationMatricesInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, Containers::ArrayView<MatrixType> out, TransformationScratch& scratch, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
         /*@}*/
 
         /**
@@ -291,7 +321,19 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /** @copydoc AbstractObject::isDirty() */
         bool isDirty() const { return !!(flags & Flag::Dirty); }
 
-        /** @copydoc AbstractObject::setDirty() */
+        /**
+         * @brief Set object absolute transformation as dirty
+         *
+         * Calls @ref AbstractFeature::markDirty() on all object features and
+         * recursively calls @ref setDirty() on every child object which is
+         * not already dirty. If the object is already marked as dirty, the
+         * function does nothing. If the object is part of a scene, it's
+         * additionally remembered as a root of a dirty subtree, so
+         * @ref Scene::cleanAll() doesn't need to search for it.
+         * @see @ref scenegraph-features-caching, @ref setClean(),
+         *      @ref isDirty()
+         */
+        /* note: doc partially copied from AbstractObject::setDirty() */
         void setDirty();
 
         /**
@@ -311,6 +353,36 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /* note: doc verbatim copied from AbstractObject::setClean() */
         void setClean();
 
+        /**
+         * @brief Clean absolute transformations of the whole subtree
+         * @param threadCount   Count of threads to use. If @cpp 0 @ce,
+         *      @ref std::thread::hardware_concurrency() is used.
+         *
+         * Calls @ref setClean() on this object and then cleans all dirty
+         * objects in its subtree. Because marking an object as dirty marks
+         * all its children as well, the dirty objects always form complete
+         * subtrees, which are independent of each other. With
+         * @p threadCount larger than @cpp 1 @ce these subtrees are split
+         * into tasks and distributed across the threads, with the calling
+         * thread participating as well. Each object is cleaned exactly once
+         * and all its features are cleaned on the same thread, but
+         * @ref AbstractFeature::clean() and
+         * @ref AbstractFeature::cleanInverted() of features on different
+         * objects can be called concurrently --- if the implementations
+         * access shared state, it's up to them to synchronize it.
+         *
+         * The threads are created for the duration of the call only, there
+         * is no persistent pool. Creating and joining a thread takes
+         * roughly 15 to 25 microseconds on a desktop Linux machine and this
+         * cost is paid on every call, so more than one thread pays off only
+         * if there are at least tens of thousands of dirty objects. For a
+         * few moved objects per frame it's better to stay with a single
+         * thread. On platforms without thread support the cleaning is
+         * always done on the calling thread.
+         * @see @ref setClean(std::vector<std::reference_wrapper<Object<Transformation>>>)
+         */
+        void setCleanSubtree(UnsignedInt threadCount = 1);
+
         /*@}*/
 
     #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -331,6 +403,7 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
         friend Containers::LinkedList<Object<Transformation>>;
         friend Containers::LinkedListItem<Object<Transformation>, Object<Transformation>>;
+        friend Scene<Transformation>;
         #endif
 
         Object<Transformation>* doScene() override final;
@@ -347,22 +420,86 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         }
 
         std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& initialTransformationMatrix) const override final;
+        void doTransformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix) const override final;
 
-        typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const;
+        template<class U> bool MAGNUM_SCENEGRAPH_LOCAL transformationsInternal(const std::vector<std::reference_wrapper<U>>& objects, TransformationScratch& scratch, const typename Transformation::DataType& initialTransformation) const;
+        template<class U> bool MAGNUM_SCENEGRAPH_LOCAL transformationMatricesInternal(const std::vector<std::reference_wrapper<U>>& objects, Containers::ArrayView<MatrixType> out, TransformationScratch& scratch, const MatrixType& initialTransformationMatrix) const;
 
         bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetClean() override final { setClean(); }
         void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) override final;
 
+        void MAGNUM_SCENEGRAPH_LOCAL setDirtyInternal();
+        void MAGNUM_SCENEGRAPH_LOCAL addDirtyRoot(Object<Transformation>& scene);
+        void MAGNUM_SCENEGRAPH_LOCAL removeDirtyRoot();
+        void MAGNUM_SCENEGRAPH_LOCAL removeDirtyRoots();
+        void setCleanDirtyRoots(UnsignedInt threadCount);
+
         void MAGNUM_SCENEGRAPH_LOCAL setCleanInternal(const typename Transformation::DataType& absoluteTransformation);
+        static void MAGNUM_SCENEGRAPH_LOCAL setCleanSubtreesInternal(std::vector<std::pair<Object<Transformation>*, typename Transformation::DataType>>& subtrees, UnsignedInt threadCount);
 
         typedef Implementation::ObjectFlag Flag;
         typedef Implementation::ObjectFlags Flags;
-        UnsignedShort counter;
+        /* Intrusive circular list of dirty subtree roots, with the scene
+           being its head. Both are nullptr if the object is not in the list,
+           the scene points to itself if the list is empty. */
+        Object<Transformation>* _dirtyPrevious;
+        Object<Transformation>* _dirtyNext;
+        UnsignedInt counter;
         Flags flags;
 };
 
+/**
+@brief Scratch storage for batch transformation calculation
+
+Temporary storage used by @ref Object::transformationsInto() and
+@ref Object::transformationMatricesInto(). The memory is kept between calls,
+so repeated calculation of the same or a smaller set of objects doesn't need
+to allocate:
+
+@snippet MagnumSceneGraph.cpp Object-transformationsInto
+
+The contents are an implementation detail. Instances are not meant to be
+shared between threads.
+*/
+template<class Transformation> class Object<Transformation>::TransformationScratch {
+    public:
+        /** @brief Constructor */
+        explicit TransformationScratch() = default;
+
+        /** @brief Copying is not allowed */
+        TransformationScratch(const TransformationScratch&) = delete;
+
+        /** @brief Move constructor */
+        TransformationScratch(TransformationScratch&&) = default;
+
+        /** @brief Copying is not allowed */
+        TransformationScratch& operator=(const TransformationScratch&) = delete;
+
+        /** @brief Move assignment */
+        TransformationScratch& operator=(TransformationScratch&&) = default;
+
+        /**
+         * @brief Reserve memory for given object count
+         *
+         * Optional, the storage grows as needed otherwise. The actual
+         * memory requirements depend also on shape of the hierarchy.
+         */
+        void reserve(std::size_t size) {
+            _joints.reserve(size);
+            _transformations.reserve(size);
+            _parentJoints.reserve(size);
+        }
+
+    private:
+        friend Object<Transformation>;
+
+        std::vector<Object<Transformation>*> _joints;
+        std::vector<typename Transformation::DataType> _transformations;
+        std::vector<UnsignedInt> _parentJoints, _stack;
+};
+
 }}
 
 #endif
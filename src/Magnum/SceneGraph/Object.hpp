@@ -30,7 +30,12 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <stack>
+#if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+#include <thread>
+#endif
 
 #include "Magnum/SceneGraph/AbstractTransformation.h"
 #include "Magnum/SceneGraph/Object.h"
@@ -43,11 +48,16 @@ template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::~Abstra
 
 template<UnsignedInt dimensions, class T> AbstractTransformation<dimensions, T>::AbstractTransformation() {}
 
-template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty) {
+template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): _dirtyPrevious{}, _dirtyNext{}, counter(~UnsignedInt{}), flags(Flag::Dirty) {
     setParent(parent);
 }
 
-template<class Transformation> Object<Transformation>::~Object() = default;
+template<class Transformation> Object<Transformation>::~Object() {
+    /* Remove itself from the dirty root list. If this is a scene, the
+       remaining objects in the list stay linked to each other and remove
+       themselves one by one when destroyed together with the children. */
+    removeDirtyRoot();
+}
 
 template<class Transformation> Scene<Transformation>* Object<Transformation>::scene() {
     Object<Transformation>* p(this);
@@ -91,12 +101,22 @@ template<class Transformation> Object<Transformation>& Object<Transformation>::s
     }
 
     /* Remove the object from old parent children list */
+    Scene<Transformation>* const oldScene = this->parent() ? this->parent()->scene() : nullptr;
     if(this->parent()) this->parent()->Containers::template LinkedList<Object<Transformation>>::cut(this);
 
     /* Add the object to list of new parent */
     if(parent) parent->Containers::LinkedList<Object<Transformation>>::insert(this);
+    Scene<Transformation>* const newScene = parent ? parent->scene() : nullptr;
+
+    /* Objects that are no longer in the original scene can't stay in its
+       dirty root list. Objects outside of any scene are never in any list. */
+    if(oldScene && oldScene != newScene) removeDirtyRoots();
+
+    /* If the new parent is clean, the object is now a root of a dirty
+       subtree. Not using setDirty(), as the object might be dirty already. */
+    setDirtyInternal();
+    if(newScene && !parent->isDirty()) addDirtyRoot(*newScene);
 
-    setDirty();
     return *this;
 }
 
@@ -121,18 +141,117 @@ template<class Transformation> void Object<Transformation>::setDirty() {
        nothing to do */
     if(flags & Flag::Dirty) return;
 
+    /* Otherwise the parent is clean as well, so this object becomes a root
+       of a dirty subtree */
+    Scene<Transformation>* const scene = this->scene();
+    if(scene && scene != this) addDirtyRoot(*scene);
+
+    setDirtyInternal();
+}
+
+template<class Transformation> void Object<Transformation>::setDirtyInternal() {
+    /* The transformation of this object (and all children) is already dirty,
+       nothing to do */
+    if(flags & Flag::Dirty) return;
+
     /* Make all features dirty */
     for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: this->features())
         feature.markDirty();
 
     /* Make all children dirty */
     for(Object<Transformation>& child: children())
-        child.setDirty();
+        child.setDirtyInternal();
 
     /* Mark object as dirty */
     flags |= Flag::Dirty;
 }
 
+template<class Transformation> void Object<Transformation>::addDirtyRoot(Object<Transformation>& scene) {
+    /* Already in the list */
+    if(_dirtyNext) return;
+
+    _dirtyPrevious = scene._dirtyPrevious;
+    _dirtyNext = &scene;
+    scene._dirtyPrevious->_dirtyNext = this;
+    scene._dirtyPrevious = this;
+}
+
+template<class Transformation> void Object<Transformation>::removeDirtyRoot() {
+    /* Not in the list */
+    if(!_dirtyNext) return;
+
+    _dirtyPrevious->_dirtyNext = _dirtyNext;
+    _dirtyNext->_dirtyPrevious = _dirtyPrevious;
+    _dirtyPrevious = _dirtyNext = nullptr;
+}
+
+template<class Transformation> void Object<Transformation>::removeDirtyRoots() {
+    removeDirtyRoot();
+    for(Object<Transformation>& child: children())
+        child.removeDirtyRoots();
+}
+
+template<class Transformation> void Object<Transformation>::setCleanDirtyRoots(const UnsignedInt threadCount) {
+    std::vector<std::pair<Object<Transformation>*, typename Transformation::DataType>> subtrees;
+
+    /* If the scene itself is dirty, everything is. The list contains nothing
+       useful in that case, just clean everything below the scene. */
+    if(flags & Flag::Dirty) {
+        const typename Transformation::DataType absoluteTransformation = Transformation::transformation();
+        setCleanInternal(absoluteTransformation);
+        for(Object<Transformation>& child: children())
+            subtrees.emplace_back(&child, absoluteTransformation);
+
+    } else {
+        /* Roots of dirty subtrees. Objects whose parent is dirty are part of
+           some other subtree, which is either in the list as well or gets
+           found below a clean object in the list. */
+        std::vector<Object<Transformation>*> roots;
+        std::vector<Object<Transformation>*> clean;
+        for(Object<Transformation>* o = _dirtyNext; o != this; o = o->_dirtyNext) {
+            if(o->isDirty()) {
+                if(!o->parent()->isDirty()) roots.push_back(o);
+                continue;
+            }
+
+            /* The object got cleaned using setClean() after being marked as
+               dirty, which could have left some objects below it dirty with
+               a clean parent. Search for them, skipping objects that are in
+               the list themselves -- the dirty ones are roots on their own
+               and the clean ones get searched when reached in the list, so
+               searching below them here would find the same roots twice. */
+            clean.push_back(o);
+            while(!clean.empty()) {
+                Object<Transformation>* c = clean.back();
+                clean.pop_back();
+                for(Object<Transformation>& child: c->children()) {
+                    if(child._dirtyNext) continue;
+                    if(!child.isDirty()) clean.push_back(&child);
+                    else roots.push_back(&child);
+                }
+            }
+        }
+
+        /* Group the roots by parent so absolute transformation of each
+           parent is calculated only once */
+        std::sort(roots.begin(), roots.end(), [](Object<Transformation>* a, Object<Transformation>* b) {
+            return std::less<Object<Transformation>*>{}(a->parent(), b->parent());
+        });
+        subtrees.reserve(roots.size());
+        for(std::size_t i = 0; i != roots.size(); ++i) {
+            if(i && roots[i]->parent() == roots[i - 1]->parent())
+                subtrees.emplace_back(roots[i], subtrees.back().second);
+            else
+                subtrees.emplace_back(roots[i], roots[i]->parent()->absoluteTransformation());
+        }
+    }
+
+    /* Empty the list */
+    while(_dirtyNext != this) _dirtyNext->removeDirtyRoot();
+
+    setCleanSubtreesInternal(subtrees, threadCount);
+}
+
 template<class Transformation> void Object<Transformation>::setClean() {
     /* The object (and all its parents) are already clean, nothing to do */
     if(!(flags & Flag::Dirty)) return;
@@ -170,22 +289,160 @@ template<class Transformation> void Object<Transformation>::setClean() {
     }
 }
 
+template<class Transformation> void Object<Transformation>::setCleanSubtree(const UnsignedInt threadCount) {
+    /* Clean the object itself together with all its dirty parents */
+    setClean();
+
+    /* Collect roots of dirty subtrees together with absolute transformations
+       of their parents. Dirty flag is always propagated to children, so it's
+       enough to descend through clean objects only. */
+    std::vector<std::pair<Object<Transformation>*, typename Transformation::DataType>> subtrees;
+    std::vector<Object<Transformation>*> clean{this};
+    while(!clean.empty()) {
+        Object<Transformation>* o = clean.back();
+        clean.pop_back();
+
+        /* Absolute transformation of the parent is calculated only if it has
+           any dirty children */
+        bool hasAbsoluteTransformation = false;
+        typename Transformation::DataType absoluteTransformation;
+        for(Object<Transformation>& child: o->children()) {
+            if(!child.isDirty()) {
+                clean.push_back(&child);
+                continue;
+            }
+
+            if(!hasAbsoluteTransformation) {
+                absoluteTransformation = o->absoluteTransformation();
+                hasAbsoluteTransformation = true;
+            }
+            subtrees.emplace_back(&child, absoluteTransformation);
+        }
+    }
+
+    setCleanSubtreesInternal(subtrees, threadCount);
+}
+
+template<class Transformation> void Object<Transformation>::setCleanSubtreesInternal(std::vector<std::pair<Object<Transformation>*, typename Transformation::DataType>>& subtrees, UnsignedInt threadCount) {
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    #else
+    threadCount = 1;
+    #endif
+
+    /* If there's not enough subtrees for all threads to balance the load
+       between each other, clean their roots here and replace them with their
+       children. This handles also the common case of a single dirty scene
+       with all objects directly below it. */
+    if(threadCount > 1) {
+        std::vector<std::pair<Object<Transformation>*, typename Transformation::DataType>> children;
+        while(!subtrees.empty() && subtrees.size() < 4*threadCount) {
+            children.clear();
+            for(const std::pair<Object<Transformation>*, typename Transformation::DataType>& subtree: subtrees) {
+                const typename Transformation::DataType absoluteTransformation = Implementation::Transformation<Transformation>::compose(subtree.second, subtree.first->transformation());
+                subtree.first->setCleanInternal(absoluteTransformation);
+                for(Object<Transformation>& child: subtree.first->children())
+                    children.emplace_back(&child, absoluteTransformation);
+            }
+            std::swap(subtrees, children);
+        }
+    }
+
+    /* Each thread takes the next unprocessed subtree until there's none left
+       and cleans all its objects going depth-first. The subtrees are
+       disjoint and everything above them is clean and thus not modified, so
+       the threads don't need to synchronize anything else. */
+    std::atomic<std::size_t> next{0};
+    auto worker = [&subtrees, &next]() {
+        std::vector<std::pair<Object<Transformation>*, typename Transformation::DataType>> stack;
+        for(std::size_t i; (i = next++) < subtrees.size(); ) {
+            stack.push_back(subtrees[i]);
+            while(!stack.empty()) {
+                const std::pair<Object<Transformation>*, typename Transformation::DataType> o = stack.back();
+                stack.pop_back();
+
+                CORRADE_INTERNAL_ASSERT(o.first->isDirty());
+                const typename Transformation::DataType absoluteTransformation = Implementation::Transformation<Transformation>::compose(o.second, o.first->transformation());
+                o.first->setCleanInternal(absoluteTransformation);
+                for(Object<Transformation>& child: o.first->children())
+                    stack.emplace_back(&child, absoluteTransformation);
+            }
+        }
+    };
+
+    /* The threads are spawned and joined on every call. That's tens of
+       microseconds per thread, which is negligible compared to cleaning a
+       large subtree, but dominates if only a few objects are dirty. */
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    std::vector<std::thread> threads;
+    for(std::size_t i = 1, end = std::min(std::size_t(threadCount), subtrees.size()); i < end; ++i)
+        threads.emplace_back(worker);
+    #endif
+    worker();
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    for(std::thread& thread: threads) thread.join();
+    #endif
+}
+
 template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
-    castObjects.reserve(objects.size());
+    /* Nearest common ancestor not yet implemented - assert this is done on
+       scene. Checked here already as the scratch storage is owned by it. */
+    CORRADE_ASSERT(isScene(), "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", {});
+
     /** @todo Ensure this doesn't crash, somehow */
-    for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
+    std::vector<MatrixType> transformationMatrices(objects.size());
+    if(!transformationMatricesInternal(objects, {transformationMatrices.data(), transformationMatrices.size()}, static_cast<const Scene<Transformation>*>(this)->_transformationScratch, initialTransformationMatrix)) return {};
+    return transformationMatrices;
+}
+
+template<class Transformation> void Object<Transformation>::doTransformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix) const {
+    /* Nearest common ancestor not yet implemented - assert this is done on
+       scene. Checked here already as the scratch storage is owned by it. */
+    CORRADE_ASSERT(isScene(), "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", );
 
-    return transformationMatrices(std::move(castObjects), initialTransformationMatrix);
+    /** @todo Ensure this doesn't crash, somehow */
+    transformationMatricesInternal(objects, out, static_cast<const Scene<Transformation>*>(this)->_transformationScratch, initialTransformationMatrix);
 }
 
 template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
-    std::vector<MatrixType> transformationMatrices(transformations.size());
+    TransformationScratch scratch;
+    std::vector<MatrixType> transformationMatrices(objects.size());
+    if(!transformationMatricesInternal(objects, {transformationMatrices.data(), transformationMatrices.size()}, scratch, initialTransformationMatrix)) return {};
+    return transformationMatrices;
+}
+
+template<class Transformation> void Object<Transformation>::transformationMatricesInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, Containers::ArrayView<MatrixType> out, TransformationScratch& scratch, const MatrixType& initialTransformationMatrix) const {
+    transformationMatricesInternal(objects, out, scratch, initialTransformationMatrix);
+}
+
+template<class Transformation> template<class U> bool Object<Transformation>::transformationMatricesInternal(const std::vector<std::reference_wrapper<U>>& objects, Containers::ArrayView<MatrixType> out, TransformationScratch& scratch, const MatrixType& initialTransformationMatrix) const {
+    CORRADE_ASSERT(out.size() == objects.size(),
+        "SceneGraph::Object::transformationMatrices(): expected" << objects.size() << "output items but got" << out.size(), false);
+
+    if(!transformationsInternal(objects, scratch, Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix))) return false;
+
     for(std::size_t i = 0; i != objects.size(); ++i)
-        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+        out[i] = Implementation::Transformation<Transformation>::toMatrix(scratch._transformations[i]);
+    return true;
+}
 
-    return transformationMatrices;
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const typename Transformation::DataType& initialTransformation) const {
+    TransformationScratch scratch;
+    if(!transformationsInternal(objects, scratch, initialTransformation)) return {};
+
+    /* Shrink the array to contain only transformations of requested objects
+       and return */
+    scratch._transformations.resize(objects.size());
+    return std::move(scratch._transformations);
+}
+
+template<class Transformation> void Object<Transformation>::transformationsInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, Containers::ArrayView<typename Transformation::DataType> out, TransformationScratch& scratch, const typename Transformation::DataType& initialTransformation) const {
+    CORRADE_ASSERT(out.size() == objects.size(),
+        "SceneGraph::Object::transformations(): expected" << objects.size() << "output items but got" << out.size(), );
+
+    if(!transformationsInternal(objects, scratch, initialTransformation)) return;
+
+    std::copy(scratch._transformations.begin(), scratch._transformations.begin() + objects.size(), out.begin());
 }
 
 /*
@@ -198,140 +455,169 @@ divided into two groups:
    child in the subtree
  - "non-joints", i.e. paths between joints
 
-Then for all joints their transformation (relative to parent joint) is
-computed and recursively concatenated together. Resulting transformations for
-joints which were originally in `object` list is then returned.
+Then for all joints their transformation relative to the parent joint is
+computed and the chains of joints are concatenated together, going from the
+root. The first `objects.size()` items of `scratch._transformations` then
+contain transformations of the originally requested objects.
+
+Each object in the subtree is visited a constant number of times, the whole
+calculation is done without recursion and all temporary data are stored in
+the scratch, so the memory can be reused across calls.
 */
-template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation) const {
-    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
+template<class Transformation> template<class U> bool Object<Transformation>::transformationsInternal(const std::vector<std::reference_wrapper<U>>& objects, TransformationScratch& scratch, const typename Transformation::DataType& initialTransformation) const {
+    /* Value of `counter` on objects that are not joints */
+    constexpr UnsignedInt NoCounter = ~UnsignedInt{};
+
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    /* Scene object */
+    const Scene<Transformation>* scene = this->scene();
+    #endif
+
+    /* Nearest common ancestor not yet implemented - assert this is done on scene */
+    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", false);
 
-    /* Remember object count for later */
-    std::size_t objectCount = objects.size();
+    std::vector<Object<Transformation>*>& joints = scratch._joints;
+    std::vector<typename Transformation::DataType>& transformations = scratch._transformations;
+    std::vector<UnsignedInt>& parentJoints = scratch._parentJoints;
+    std::vector<UnsignedInt>& stack = scratch._stack;
 
     /* Mark all original objects as joints and create initial list of joints
        from them */
-    for(std::size_t i = 0; i != objects.size(); ++i) {
+    const std::size_t objectCount = objects.size();
+    joints.clear();
+    for(std::size_t i = 0; i != objectCount; ++i) {
+        /** @todo Ensure this doesn't crash, somehow */
+        Object<Transformation>& o = static_cast<Object<Transformation>&>(objects[i].get());
+        joints.push_back(&o);
+
         /* Multiple occurences of one object in the array, don't overwrite it
            with different counter */
-        if(objects[i].get().counter != 0xFFFFu) continue;
+        if(o.counter != NoCounter) continue;
 
-        objects[i].get().counter = UnsignedShort(i);
-        objects[i].get().flags |= Flag::Joint;
+        o.counter = UnsignedInt(i);
+        o.flags |= Flag::Joint;
     }
-    std::vector<std::reference_wrapper<Object<Transformation>>> jointObjects(objects);
 
-    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
-    /* Scene object */
-    const Scene<Transformation>* scene = this->scene();
-    #endif
+    /* Mark all objects up the hierarchy as visited, going from each object
+       until an already visited object or a joint is found, which then
+       becomes a joint as well */
+    for(std::size_t i = 0; i != objectCount; ++i) {
+        Object<Transformation>* o = joints[i];
 
-    /* Nearest common ancestor not yet implemented - assert this is done on scene */
-    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", {});
+        /* Already visited (duplicate occurence), continue to next */
+        if(o->flags & Flag::Visited) continue;
 
-    /* Mark all objects up the hierarchy as visited */
-    auto it = objects.begin();
-    while(!objects.empty()) {
-        /* Already visited, remove and continue to next (duplicate occurence) */
-        if(it->get().flags & Flag::Visited) {
-            it = objects.erase(it);
-            continue;
-        }
+        for(;;) {
+            o->flags |= Flag::Visited;
 
-        /* Mark the object as visited */
-        it->get().flags |= Flag::Visited;
-
-        Object<Transformation>* parent = it->get().parent();
-
-        /* If this is root object, remove from list */
-        if(!parent) {
-            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
-            it = objects.erase(it);
-
-        /* Parent is an joint or already visited - remove current from list */
-        } else if(parent->flags & (Flag::Visited|Flag::Joint)) {
-            it = objects.erase(it);
-
-            /* If not already marked as joint, mark it as such and add it to
-               list of joint objects */
-            if(!(parent->flags & Flag::Joint)) {
-                CORRADE_ASSERT(jointObjects.size() < 0xFFFFu,
-                               "SceneGraph::Object::transformations(): too large scene", {});
-                CORRADE_INTERNAL_ASSERT(parent->counter == 0xFFFFu);
-                parent->counter = UnsignedShort(jointObjects.size());
-                parent->flags |= Flag::Joint;
-                jointObjects.push_back(*parent);
+            Object<Transformation>* parent = o->parent();
+
+            /* Root object, done */
+            if(!parent) {
+                CORRADE_ASSERT(o == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", false);
+                break;
             }
 
-        /* Else go up the hierarchy */
-        } else *it = *parent;
+            /* Parent is a joint or already visited, done. If not already
+               marked as joint, mark it as such and add it to list of joint
+               objects. */
+            if(parent->flags & (Flag::Visited|Flag::Joint)) {
+                if(!(parent->flags & Flag::Joint)) {
+                    CORRADE_INTERNAL_ASSERT(parent->counter == NoCounter);
+                    parent->counter = UnsignedInt(joints.size());
+                    parent->flags |= Flag::Joint;
+                    joints.push_back(parent);
+                }
+                break;
+            }
 
-        /* Cycle if reached end */
-        if(it == objects.end()) it = objects.begin();
+            /* Else go up the hierarchy */
+            o = parent;
+        }
     }
 
-    /* Array of absolute transformations in joints */
-    std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
+    /* Compute transformations of all joints relative to their parent joint
+       (or the root), remember index of the parent joint and clean visited
+       marks on the way */
+    transformations.resize(joints.size());
+    parentJoints.resize(joints.size());
+    for(std::size_t i = 0; i != joints.size(); ++i) {
+        /* Duplicate occurence, will be copied from the first one */
+        if(joints[i]->counter != i) continue;
+
+        Object<Transformation>* o = joints[i];
+        typename Transformation::DataType transformation = o->transformation();
+        CORRADE_INTERNAL_ASSERT(o->flags & Flag::Visited);
+        o->flags &= ~Flag::Visited;
+
+        for(;;) {
+            Object<Transformation>* parent = o->parent();
+
+            /* Root object, the transformation will be composed with the
+               initial one */
+            if(!parent) {
+                CORRADE_INTERNAL_ASSERT(o->isScene());
+                parentJoints[i] = NoCounter;
+                break;
+            }
 
-    /* Compute transformations for all joints */
-    for(std::size_t i = 0; i != jointTransformations.size(); ++i)
-        computeJointTransformation(jointObjects, jointTransformations, i, initialTransformation);
+            /* Joint object, the transformation will be composed with the
+               joint */
+            if(parent->flags & Flag::Joint) {
+                parentJoints[i] = parent->counter;
+                break;
+            }
 
-    /* Copy transformation for second or next occurences from first occurence
-       of duplicate object */
-    for(std::size_t i = 0; i != objectCount; ++i) {
-        if(jointObjects[i].get().counter != i)
-            jointTransformations[i] = jointTransformations[jointObjects[i].get().counter];
-    }
+            /* Else compose transformation with parent, go up the hierarchy */
+            CORRADE_INTERNAL_ASSERT(parent->flags & Flag::Visited);
+            parent->flags &= ~Flag::Visited;
+            transformation = Implementation::Transformation<Transformation>::compose(parent->transformation(), transformation);
+            o = parent;
+        }
 
-    /* All visited marks are now cleaned, clean joint marks and counters */
-    for(auto i: jointObjects) {
-        /* All not-already cleaned objects (...duplicate occurences) should
-           have joint mark */
-        CORRADE_INTERNAL_ASSERT(i.get().counter == 0xFFFFu || i.get().flags & Flag::Joint);
-        i.get().flags &= ~Flag::Joint;
-        i.get().counter = 0xFFFFu;
+        transformations[i] = transformation;
     }
 
-    /* Shrink the array to contain only transformations of requested objects and return */
-    jointTransformations.resize(objectCount);
-    return jointTransformations;
-}
-
-template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const {
-    std::reference_wrapper<Object<Transformation>> o = jointObjects[joint];
+    /* Concatenate the relative transformations to absolute ones. The visited
+       mark is now reused for joints that have the absolute transformation
+       already calculated. For each joint collect the chain of not yet
+       calculated parent joints and resolve it going down from the top. */
+    for(std::size_t i = 0; i != joints.size(); ++i) {
+        if(joints[i]->counter != i || joints[i]->flags & Flag::Visited)
+            continue;
 
-    /* Transformation already computed ("unvisited" by this function before
-       either due to recursion or duplicate object occurences), done */
-    if(!(o.get().flags & Flag::Visited)) return jointTransformations[joint];
+        stack.clear();
+        UnsignedInt joint = UnsignedInt(i);
+        while(joint != NoCounter && !(joints[joint]->flags & Flag::Visited)) {
+            stack.push_back(joint);
+            joint = parentJoints[joint];
+        }
 
-    /* Initialize transformation */
-    jointTransformations[joint] = o.get().transformation();
+        const typename Transformation::DataType* parentTransformation = joint == NoCounter ? &initialTransformation : &transformations[joint];
+        while(!stack.empty()) {
+            joint = stack[stack.size() - 1];
+            stack.pop_back();
 
-    /* Go up until next joint or root */
-    for(;;) {
-        /* Clean visited mark */
-        CORRADE_INTERNAL_ASSERT(o.get().flags & Flag::Visited);
-        o.get().flags &= ~Flag::Visited;
-
-        Object<Transformation>* parent = o.get().parent();
-
-        /* Root object, compose transformation with initial, done */
-        if(!parent) {
-            CORRADE_INTERNAL_ASSERT(o.get().isScene());
-            return (jointTransformations[joint] =
-                Implementation::Transformation<Transformation>::compose(initialTransformation, jointTransformations[joint]));
-
-        /* Joint object, compose transformation with the joint, done */
-        } else if(parent->flags & Flag::Joint) {
-            return (jointTransformations[joint] =
-                Implementation::Transformation<Transformation>::compose(computeJointTransformation(jointObjects, jointTransformations, parent->counter, initialTransformation), jointTransformations[joint]));
-
-        /* Else compose transformation with parent, go up the hierarchy */
-        } else {
-            jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(parent->transformation(), jointTransformations[joint]);
-            o = *parent;
+            transformations[joint] = Implementation::Transformation<Transformation>::compose(*parentTransformation, transformations[joint]);
+            joints[joint]->flags |= Flag::Visited;
+            parentTransformation = &transformations[joint];
         }
     }
+
+    /* Copy transformation for second or next occurences from first occurence
+       of duplicate object */
+    for(std::size_t i = 0; i != objectCount; ++i) {
+        if(joints[i]->counter != i)
+            transformations[i] = transformations[joints[i]->counter];
+    }
+
+    /* Clean visited and joint marks and counters */
+    for(Object<Transformation>* o: joints) {
+        o->flags &= ~(Flag::Visited|Flag::Joint);
+        o->counter = NoCounter;
+    }
+
+    return true;
 }
 
 template<class Transformation> void Object<Transformation>::doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) {
@@ -45,14 +45,58 @@ e.g.:
 
 @snippet MagnumSceneGraph.cpp Object-typedef
 
+@section SceneGraph-Scene-dirty Tracking dirty objects
+
+The scene keeps a list of roots of dirty subtrees --- every time a clean object
+is marked as dirty using @ref Object::setDirty(), either explicitly or by
+changing its transformation, or is added to a clean parent, it's remembered in
+the scene. The @ref cleanAll() function then cleans only these subtrees, in a
+single pass and without searching the hierarchy for dirty objects:
+
+@snippet MagnumSceneGraph.cpp Scene-cleanAll
+
 See @ref scenegraph for an introduction.
 */
 template<class Transformation> class Scene: public Object<Transformation> {
     public:
-        explicit Scene() = default;
+        explicit Scene() {
+            this->_dirtyPrevious = this->_dirtyNext = this;
+        }
+
+        /**
+         * @brief Clean all dirty objects in the scene
+         * @param threadCount   Count of threads to use. If @cpp 0 @ce,
+         *      @ref std::thread::hardware_concurrency() is used.
+         *
+         * Equivalent to @ref Object::setCleanSubtree() called on the scene,
+         * but instead of searching the whole hierarchy for dirty objects it
+         * processes only the dirty subtree roots remembered by
+         * @ref Object::setDirty(), so the cost is proportional to the
+         * number of changed objects and not to the size of the scene. Every
+         * dirty object is cleaned exactly once and the list is emptied
+         * afterwards. See @ref Object::setCleanSubtree() for details about
+         * the @p threadCount parameter.
+         *
+         * Objects that were cleaned individually using
+         * @ref Object::setClean() after being marked as dirty don't cause
+         * any problems, but their clean subtree has to be searched for
+         * dirty objects, which is slower.
+         */
+        void cleanAll(UnsignedInt threadCount = 1) {
+            this->setCleanDirtyRoots(threadCount);
+        }
 
     private:
+        #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        friend Object<Transformation>;
+        #endif
+
         bool isScene() const override final { return true; }
+
+        /* Used by AbstractObject::transformationMatricesInto(), which has no
+           way to pass caller-owned scratch storage through the type-erased
+           interface */
+        mutable typename Object<Transformation>::TransformationScratch _transformationScratch;
 };
 
 }}
@@ -117,6 +117,8 @@ template<class Feature, class T> using BasicFeatureGroup3D = FeatureGroup<3, Fea
 template<class Feature> using FeatureGroup2D = BasicFeatureGroup2D<Feature, Float>;
 template<class Feature> using FeatureGroup3D = BasicFeatureGroup3D<Feature, Float>;
 
+template<class Transformation> class FlatHierarchy;
+
 template<UnsignedInt dimensions, class T> using DrawableGroup = FeatureGroup<dimensions, Drawable<dimensions, T>, T>;
 template<class T> using BasicDrawableGroup2D = DrawableGroup<2, T>;
 template<class T> using BasicDrawableGroup3D = DrawableGroup<3, T>;
@@ -50,12 +50,30 @@ struct CameraTest: TestSuite::Tester {
 
     void draw();
     void drawOrdered();
+    void drawCulled2D();
+    void drawCulled3D();
+    void drawableTransformationsCulled();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 
+/* Records IDs of drawn drawables */
+template<UnsignedInt dimensions> class IdDrawable: public SceneGraph::Drawable<dimensions, Float> {
+    public:
+        explicit IdDrawable(AbstractObject<dimensions, Float>& object, DrawableGroup<dimensions, Float>& group, Int id, std::vector<Int>& drawn): SceneGraph::Drawable<dimensions, Float>{object, &group}, _id{id}, _drawn(drawn) {}
+
+    private:
+        void draw(const MatrixTypeFor<dimensions, Float>&, Camera<dimensions, Float>&) override {
+            _drawn.push_back(_id);
+        }
+
+        Int _id;
+        std::vector<Int>& _drawn;
+};
+
 CameraTest::CameraTest() {
     addTests({&CameraTest::fixAspectRatio,
               &CameraTest::defaultProjection2D,
@@ -67,7 +85,10 @@ CameraTest::CameraTest() {
               &CameraTest::projectionSizeViewport,
 
               &CameraTest::draw,
-              &CameraTest::drawOrdered});
+              &CameraTest::drawOrdered,
+              &CameraTest::drawCulled2D,
+              &CameraTest::drawCulled3D,
+              &CameraTest::drawableTransformationsCulled});
 }
 
 void CameraTest::fixAspectRatio() {
@@ -267,6 +288,217 @@ void CameraTest::drawOrdered() {
     }), TestSuite::Compare::Container);
 }
 
+void CameraTest::drawCulled2D() {
+    DrawableGroup2D group;
+    Scene2D scene;
+    std::vector<Int> drawn;
+
+    /* Inside */
+    Object2D a{&scene};
+    a.translate({1.0f, 1.0f});
+    (new IdDrawable<2>{a, group, 0, drawn})->setBoundingSphere({}, 0.5f);
+
+    /* Outside, but reaching into the view after scaling */
+    Object2D b{&scene};
+    b.scale(Vector2{2.0f})
+     .translate({3.0f, 0.0f});
+    (new IdDrawable<2>{b, group, 1, drawn})->setBoundingSphere({}, 0.6f);
+
+    /* Completely outside */
+    Object2D c{&scene};
+    c.translate({0.0f, -5.0f});
+    (new IdDrawable<2>{c, group, 2, drawn})->setBoundingBox({{-1.0f, -1.0f}, {1.0f, 1.0f}});
+
+    /* Outside, but rotated so the box corner reaches into the view */
+    Object2D d{&scene};
+    d.rotate(Deg(45.0f))
+     .translate({3.3f, 0.0f});
+    (new IdDrawable<2>{d, group, 3, drawn})->setBoundingBox({{-1.0f, -1.0f}, {1.0f, 1.0f}});
+
+    /* Outside, without a bounding volume */
+    Object2D e{&scene};
+    e.translate({10.0f, 0.0f});
+    new IdDrawable<2>{e, group, 4, drawn};
+
+    /* Rotated, above the view. With the non-square projection below, the
+       first reaches into it and the second doesn't. The sphere is stretched
+       more along Y than along any of the rotated axes there, so this
+       verifies the extents are calculated per clip-space axis. */
+    Object2D f{&scene};
+    f.rotate(Deg(45.0f))
+     .translate({0.0f, 5.4f});
+    (new IdDrawable<2>{f, group, 5, drawn})->setBoundingSphere({}, 1.0f);
+    Object2D g{&scene};
+    g.rotate(Deg(45.0f))
+     .translate({0.0f, 5.6f});
+    (new IdDrawable<2>{g, group, 6, drawn})->setBoundingSphere({}, 1.0f);
+
+    /* Visible area is [-2, 2] */
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix3::projection({4.0f, 4.0f}));
+    CORRADE_VERIFY(!camera.isCullingEnabled());
+
+    /* Everything drawn by default */
+    camera.draw(group);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 1, 2, 3, 4, 5, 6}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(camera.visibleCount(), 7);
+    CORRADE_COMPARE(camera.culledCount(), 0);
+
+    drawn.clear();
+    camera.setCullingEnabled(true);
+    CORRADE_VERIFY(camera.isCullingEnabled());
+    camera.draw(group);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 1, 3, 4}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(camera.visibleCount(), 4);
+    CORRADE_COMPARE(camera.culledCount(), 3);
+
+    /* Visible area is [-8, 8] x [-4.5, 4.5] */
+    drawn.clear();
+    camera.setProjectionMatrix(Matrix3::projection({16.0f, 9.0f}));
+    camera.draw(group);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 1, 2, 3, 4, 5}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(camera.visibleCount(), 6);
+    CORRADE_COMPARE(camera.culledCount(), 1);
+}
+
+void CameraTest::drawCulled3D() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Int> drawn;
+
+    /* In front of the camera */
+    Object3D a{&scene};
+    a.translate(Vector3::zAxis(-5.0f));
+    IdDrawable<3>* aDrawable = new IdDrawable<3>{a, group, 0, drawn};
+    aDrawable->setBoundingSphere({}, 1.0f);
+    CORRADE_VERIFY(aDrawable->hasBoundingVolume());
+
+    /* Behind the camera */
+    Object3D b{&scene};
+    b.translate(Vector3::zAxis(5.0f));
+    (new IdDrawable<3>{b, group, 1, drawn})->setBoundingSphere({}, 1.0f);
+
+    /* Behind the camera, but scaled so it reaches in front of the near
+       plane */
+    Object3D c{&scene};
+    c.scale(Vector3{4.0f})
+     .translate(Vector3::zAxis(2.0f));
+    (new IdDrawable<3>{c, group, 2, drawn})->setBoundingSphere({}, 1.0f);
+
+    /* Far to the left */
+    Object3D d{&scene};
+    d.translate({-20.0f, 0.0f, -5.0f});
+    (new IdDrawable<3>{d, group, 3, drawn})->setBoundingBox({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}});
+
+    /* Partially visible on the left, with the box offset from the object
+       origin */
+    Object3D e{&scene};
+    e.translate({-6.0f, 0.0f, -5.0f});
+    (new IdDrawable<3>{e, group, 4, drawn})->setBoundingBox({{0.0f, -1.0f, -1.0f}, {2.0f, 1.0f, 1.0f}});
+
+    /* Behind the camera, without a bounding volume */
+    Object3D f{&scene};
+    f.translate(Vector3::zAxis(10.0f));
+    new IdDrawable<3>{f, group, 5, drawn};
+
+    /* Beyond the far plane, bounding volume reset */
+    Object3D g{&scene};
+    g.translate(Vector3::zAxis(-200.0f));
+    IdDrawable<3>* gDrawable = new IdDrawable<3>{g, group, 6, drawn};
+    gDrawable->setBoundingSphere({}, 1.0f)
+        .resetBoundingVolume();
+    CORRADE_VERIFY(!gDrawable->hasBoundingVolume());
+
+    /* Beyond the far plane */
+    Object3D h{&scene};
+    h.translate(Vector3::zAxis(-200.0f));
+    (new IdDrawable<3>{h, group, 7, drawn})->setBoundingSphere({}, 1.0f);
+
+    /* Behind the camera, rotated and then scaled non-uniformly so it reaches
+       four units in front of its center, in front of the near plane. The
+       longest matrix column is only about 2.9 units. */
+    Object3D i{&scene};
+    i.rotateY(Deg(45.0f))
+     .scale({1.0f, 1.0f, 4.0f})
+     .translate(Vector3::zAxis(3.5f));
+    (new IdDrawable<3>{i, group, 8, drawn})->setBoundingSphere({}, 1.0f);
+
+    /* Behind the camera, scaled and then rotated so it reaches exactly four
+       units from its center, not to the near plane. The Frobenius norm of
+       the matrix would be about 4.24, reaching in front of it. */
+    Object3D j{&scene};
+    j.scale({4.0f, 1.0f, 1.0f})
+     .rotateY(Deg(90.0f))
+     .translate(Vector3::zAxis(4.0f));
+    (new IdDrawable<3>{j, group, 9, drawn})->setBoundingSphere({}, 1.0f);
+
+    /* At 5 units the view is roughly [-5, 5] wide */
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f))
+        .setCullingEnabled(true);
+
+    camera.draw(group);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 2, 4, 5, 6, 8}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(camera.visibleCount(), 6);
+    CORRADE_COMPARE(camera.culledCount(), 4);
+
+    /* Moving the camera changes what's visible */
+    drawn.clear();
+    cameraObject.translate(Vector3::xAxis(-20.0f));
+    camera.draw(group);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{3, 5, 6}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(camera.visibleCount(), 3);
+    CORRADE_COMPARE(camera.culledCount(), 7);
+
+    /* Disabling culling draws everything again */
+    drawn.clear();
+    camera.setCullingEnabled(false);
+    camera.draw(group);
+    CORRADE_COMPARE(drawn.size(), 10);
+    CORRADE_COMPARE(camera.visibleCount(), 10);
+    CORRADE_COMPARE(camera.culledCount(), 0);
+}
+
+void CameraTest::drawableTransformationsCulled() {
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Int> drawn;
+
+    Object3D a{&scene};
+    a.translate(Vector3::zAxis(5.0f));
+    (new IdDrawable<3>{a, group, 0, drawn})->setBoundingSphere({}, 1.0f);
+
+    Object3D b{&scene};
+    b.translate(Vector3::zAxis(-5.0f));
+    (new IdDrawable<3>{b, group, 1, drawn})->setBoundingSphere({}, 1.0f);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f))
+        .setCullingEnabled(true);
+
+    /* Only the visible drawables are returned, drawing them doesn't update
+       the counters */
+    std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>> drawableTransformations = camera.drawableTransformations(group);
+    CORRADE_COMPARE(drawableTransformations.size(), 1);
+    CORRADE_COMPARE(drawableTransformations[0].second, Matrix4::translation(Vector3::zAxis(-5.0f)));
+    CORRADE_COMPARE(camera.visibleCount(), 1);
+    CORRADE_COMPARE(camera.culledCount(), 1);
+
+    camera.draw(drawableTransformations);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(camera.visibleCount(), 1);
+    CORRADE_COMPARE(camera.culledCount(), 1);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::CameraTest)
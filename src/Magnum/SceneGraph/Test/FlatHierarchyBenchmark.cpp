@@ -0,0 +1,137 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/SceneGraph/FlatHierarchy.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct FlatHierarchyBenchmark: TestSuite::Tester {
+    explicit FlatHierarchyBenchmark();
+
+    void objectTransformations();
+    void objectTransformationsInto();
+    void flatHierarchyMirror();
+    void flatHierarchyUpdate();
+
+    void setupScene(std::size_t size);
+
+    typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+    typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+    Containers::Pointer<Scene3D> _scene;
+    std::vector<std::reference_wrapper<Object3D>> _objects;
+};
+
+constexpr std::size_t ObjectCount[]{10000, 100000, 1000000};
+
+FlatHierarchyBenchmark::FlatHierarchyBenchmark() {
+    addInstancedBenchmarks({&FlatHierarchyBenchmark::objectTransformations,
+                            &FlatHierarchyBenchmark::objectTransformationsInto,
+                            &FlatHierarchyBenchmark::flatHierarchyMirror,
+                            &FlatHierarchyBenchmark::flatHierarchyUpdate}, 5,
+        Containers::arraySize(ObjectCount));
+}
+
+void FlatHierarchyBenchmark::setupScene(const std::size_t size) {
+    setTestCaseDescription(Utility::formatString("{} objects", size));
+
+    /* Building a large scene takes a while, reuse it across repeats */
+    if(_objects.size() == size) return;
+
+    _objects.clear();
+    _scene.reset(new Scene3D);
+    _objects.reserve(size);
+
+    /* A random tree with a few roots, parent of each object picked from the
+       objects created before it. The depth grows roughly logarithmically. */
+    std::minstd_rand random{17};
+    for(std::size_t i = 0; i != size; ++i) {
+        Object3D* parent = i < 16 ? _scene.get() :
+            &_objects[std::uniform_int_distribution<std::size_t>{0, i - 1}(random)].get();
+        Object3D* object = new Object3D{parent};
+        object->translate({0.1f, 0.2f, 0.3f})
+            .rotateY(Deg(Float(i % 360)));
+        _objects.push_back(*object);
+    }
+}
+
+void FlatHierarchyBenchmark::objectTransformations() {
+    setupScene(ObjectCount[testCaseInstanceId()]);
+
+    std::vector<Matrix4> transformations;
+    CORRADE_BENCHMARK(1)
+        transformations = _scene->transformations(_objects);
+
+    CORRADE_COMPARE(transformations.size(), _objects.size());
+}
+
+void FlatHierarchyBenchmark::objectTransformationsInto() {
+    setupScene(ObjectCount[testCaseInstanceId()]);
+
+    /* Populate the scratch storage outside of the benchmark */
+    Object3D::TransformationScratch scratch;
+    std::vector<Matrix4> transformations(_objects.size());
+    _scene->transformationsInto(_objects, {transformations.data(), transformations.size()}, scratch);
+
+    CORRADE_BENCHMARK(1)
+        _scene->transformationsInto(_objects, {transformations.data(), transformations.size()}, scratch);
+
+    const std::size_t last = _objects.size() - 1;
+    CORRADE_COMPARE(transformations[last], _objects[last].get().absoluteTransformation());
+}
+
+void FlatHierarchyBenchmark::flatHierarchyMirror() {
+    setupScene(ObjectCount[testCaseInstanceId()]);
+
+    FlatHierarchy<SceneGraph::MatrixTransformation3D> hierarchy;
+    CORRADE_BENCHMARK(1)
+        hierarchy.mirror(*_scene);
+
+    CORRADE_COMPARE(hierarchy.size(), _objects.size());
+}
+
+void FlatHierarchyBenchmark::flatHierarchyUpdate() {
+    setupScene(ObjectCount[testCaseInstanceId()]);
+
+    FlatHierarchy<SceneGraph::MatrixTransformation3D> hierarchy{*_scene};
+    CORRADE_BENCHMARK(1)
+        hierarchy.update();
+
+    CORRADE_COMPARE(hierarchy.size(), _objects.size());
+    const std::size_t last = hierarchy.size() - 1;
+    CORRADE_COMPARE(hierarchy.worldTransformations()[last],
+        hierarchy.objects()[last]->absoluteTransformation());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatHierarchyBenchmark)
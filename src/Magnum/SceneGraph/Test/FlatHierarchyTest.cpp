@@ -0,0 +1,259 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/FlatHierarchy.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct FlatHierarchyTest: TestSuite::Tester {
+    explicit FlatHierarchyTest();
+
+    void construct();
+    void add();
+    void addInvalidParent();
+    void update();
+    void updateInitialTransformation();
+    void mirror();
+    void mirrorEmpty();
+    void mirrorAgain();
+    void pull();
+    void clear();
+};
+
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::FlatHierarchy<SceneGraph::MatrixTransformation3D> FlatHierarchy3D;
+
+FlatHierarchyTest::FlatHierarchyTest() {
+    addTests({&FlatHierarchyTest::construct,
+              &FlatHierarchyTest::add,
+              &FlatHierarchyTest::addInvalidParent,
+              &FlatHierarchyTest::update,
+              &FlatHierarchyTest::updateInitialTransformation,
+              &FlatHierarchyTest::mirror,
+              &FlatHierarchyTest::mirrorEmpty,
+              &FlatHierarchyTest::mirrorAgain,
+              &FlatHierarchyTest::pull,
+              &FlatHierarchyTest::clear});
+}
+
+void FlatHierarchyTest::construct() {
+    FlatHierarchy3D hierarchy;
+    CORRADE_COMPARE(hierarchy.size(), 0);
+    CORRADE_VERIFY(hierarchy.parents().empty());
+    CORRADE_VERIFY(hierarchy.localTransformations().empty());
+    CORRADE_VERIFY(hierarchy.worldTransformations().empty());
+    CORRADE_VERIFY(hierarchy.objects().empty());
+}
+
+void FlatHierarchyTest::add() {
+    FlatHierarchy3D hierarchy;
+    CORRADE_COMPARE(hierarchy.add(-1, Matrix4::translation(Vector3::xAxis())), 0);
+    CORRADE_COMPARE(hierarchy.add(0), 1);
+    CORRADE_COMPARE(hierarchy.add(0, Matrix4::scaling(Vector3{2.0f})), 2);
+    CORRADE_COMPARE(hierarchy.add(-1), 3);
+
+    CORRADE_COMPARE(hierarchy.size(), 4);
+    CORRADE_COMPARE(hierarchy.parents()[0], -1);
+    CORRADE_COMPARE(hierarchy.parents()[1], 0);
+    CORRADE_COMPARE(hierarchy.parents()[2], 0);
+    CORRADE_COMPARE(hierarchy.parents()[3], -1);
+    CORRADE_COMPARE(hierarchy.localTransformations()[0], Matrix4::translation(Vector3::xAxis()));
+    CORRADE_COMPARE(hierarchy.localTransformations()[1], Matrix4{});
+    CORRADE_COMPARE(hierarchy.localTransformations()[2], Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(hierarchy.worldTransformations().size(), 4);
+    CORRADE_COMPARE(hierarchy.objects().size(), 4);
+    CORRADE_VERIFY(!hierarchy.objects()[0]);
+}
+
+void FlatHierarchyTest::addInvalidParent() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FlatHierarchy3D hierarchy;
+    hierarchy.add(-1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    hierarchy.add(1);
+    hierarchy.add(-2);
+    CORRADE_COMPARE(hierarchy.size(), 1);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatHierarchy::add(): parent index 1 out of range for 1 objects\n"
+        "SceneGraph::FlatHierarchy::add(): parent index -2 out of range for 1 objects\n");
+}
+
+void FlatHierarchyTest::update() {
+    FlatHierarchy3D hierarchy;
+    hierarchy.add(-1, Matrix4::translation(Vector3::xAxis()));
+    hierarchy.add(0, Matrix4::scaling(Vector3{2.0f}));
+    hierarchy.add(1, Matrix4::translation(Vector3::yAxis()));
+    hierarchy.add(-1, Matrix4::rotationZ(Deg(90.0f)));
+
+    hierarchy.update();
+    CORRADE_COMPARE(hierarchy.worldTransformations()[0],
+        Matrix4::translation(Vector3::xAxis()));
+    CORRADE_COMPARE(hierarchy.worldTransformations()[1],
+        Matrix4::translation(Vector3::xAxis())*Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(hierarchy.worldTransformations()[2],
+        Matrix4::translation(Vector3::xAxis())*Matrix4::scaling(Vector3{2.0f})*Matrix4::translation(Vector3::yAxis()));
+    CORRADE_COMPARE(hierarchy.worldTransformations()[3],
+        Matrix4::rotationZ(Deg(90.0f)));
+
+    /* Changes in local transformations are propagated */
+    hierarchy.localTransformations()[1] = Matrix4{};
+    hierarchy.update();
+    CORRADE_COMPARE(hierarchy.worldTransformations()[2],
+        Matrix4::translation(Vector3::xAxis() + Vector3::yAxis()));
+}
+
+void FlatHierarchyTest::updateInitialTransformation() {
+    FlatHierarchy3D hierarchy;
+    hierarchy.add(-1, Matrix4::translation(Vector3::xAxis()));
+    hierarchy.add(0, Matrix4::translation(Vector3::yAxis()));
+
+    hierarchy.update(Matrix4::scaling(Vector3{3.0f}));
+    CORRADE_COMPARE(hierarchy.worldTransformations()[0],
+        Matrix4::scaling(Vector3{3.0f})*Matrix4::translation(Vector3::xAxis()));
+    CORRADE_COMPARE(hierarchy.worldTransformations()[1],
+        Matrix4::scaling(Vector3{3.0f})*Matrix4::translation(Vector3::xAxis() + Vector3::yAxis()));
+}
+
+void FlatHierarchyTest::mirror() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D aa{&a};
+    Object3D aaa{&aa};
+    Object3D ab{&a};
+    Object3D b{&scene};
+    Object3D ba{&b};
+    a.translate(Vector3::xAxis());
+    aa.rotateY(Deg(45.0f));
+    aaa.scale(Vector3{0.5f});
+    ab.translate(Vector3::zAxis());
+    b.rotateX(Deg(30.0f));
+    ba.translate(Vector3::yAxis());
+
+    FlatHierarchy3D hierarchy{scene};
+    CORRADE_COMPARE(hierarchy.size(), 6);
+
+    /* Breadth-first order, scene not included */
+    CORRADE_VERIFY(hierarchy.objects()[0] == &a);
+    CORRADE_VERIFY(hierarchy.objects()[1] == &b);
+    CORRADE_VERIFY(hierarchy.objects()[2] == &aa);
+    CORRADE_VERIFY(hierarchy.objects()[3] == &ab);
+    CORRADE_VERIFY(hierarchy.objects()[4] == &ba);
+    CORRADE_VERIFY(hierarchy.objects()[5] == &aaa);
+    CORRADE_COMPARE(hierarchy.parents()[0], -1);
+    CORRADE_COMPARE(hierarchy.parents()[1], -1);
+    CORRADE_COMPARE(hierarchy.parents()[2], 0);
+    CORRADE_COMPARE(hierarchy.parents()[3], 0);
+    CORRADE_COMPARE(hierarchy.parents()[4], 1);
+    CORRADE_COMPARE(hierarchy.parents()[5], 2);
+
+    hierarchy.update();
+    for(std::size_t i = 0; i != hierarchy.size(); ++i) {
+        CORRADE_COMPARE(hierarchy.localTransformations()[i], hierarchy.objects()[i]->transformation());
+        CORRADE_COMPARE(hierarchy.worldTransformations()[i], hierarchy.objects()[i]->absoluteTransformation());
+    }
+}
+
+void FlatHierarchyTest::mirrorEmpty() {
+    Scene3D scene;
+    FlatHierarchy3D hierarchy{scene};
+    CORRADE_COMPARE(hierarchy.size(), 0);
+
+    /* Shouldn't crash */
+    hierarchy.update();
+}
+
+void FlatHierarchyTest::mirrorAgain() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&a};
+
+    FlatHierarchy3D hierarchy;
+    hierarchy.add(-1);
+    hierarchy.add(0);
+    hierarchy.add(1);
+
+    /* Previous contents are replaced */
+    hierarchy.mirror(scene);
+    CORRADE_COMPARE(hierarchy.size(), 2);
+    CORRADE_VERIFY(hierarchy.objects()[0] == &a);
+    CORRADE_VERIFY(hierarchy.objects()[1] == &b);
+
+    /* Reparenting gets reflected after mirroring again */
+    b.setParent(&scene);
+    hierarchy.mirror(scene);
+    CORRADE_COMPARE(hierarchy.size(), 2);
+    CORRADE_COMPARE(hierarchy.parents()[0], -1);
+    CORRADE_COMPARE(hierarchy.parents()[1], -1);
+}
+
+void FlatHierarchyTest::pull() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&a};
+
+    FlatHierarchy3D hierarchy{scene};
+    const UnsignedInt c = hierarchy.add(1, Matrix4::translation(Vector3::zAxis()));
+
+    a.translate(Vector3::xAxis());
+    b.translate(Vector3::yAxis());
+    CORRADE_COMPARE(hierarchy.localTransformations()[0], Matrix4{});
+
+    hierarchy.pull().update();
+    CORRADE_COMPARE(hierarchy.localTransformations()[0], Matrix4::translation(Vector3::xAxis()));
+    CORRADE_COMPARE(hierarchy.localTransformations()[1], Matrix4::translation(Vector3::yAxis()));
+    /* Not mirrored, left untouched */
+    CORRADE_COMPARE(hierarchy.localTransformations()[c], Matrix4::translation(Vector3::zAxis()));
+    CORRADE_COMPARE(hierarchy.worldTransformations()[c], Matrix4::translation({1.0f, 1.0f, 1.0f}));
+}
+
+void FlatHierarchyTest::clear() {
+    Scene3D scene;
+    Object3D a{&scene};
+
+    FlatHierarchy3D hierarchy{scene};
+    hierarchy.reserve(10);
+    CORRADE_COMPARE(hierarchy.size(), 1);
+
+    hierarchy.clear();
+    CORRADE_COMPARE(hierarchy.size(), 0);
+    CORRADE_VERIFY(hierarchy.localTransformations().empty());
+    CORRADE_VERIFY(hierarchy.worldTransformations().empty());
+    CORRADE_VERIFY(hierarchy.objects().empty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatHierarchyTest)
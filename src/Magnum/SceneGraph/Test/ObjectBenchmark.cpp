@@ -0,0 +1,175 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct ObjectBenchmark: TestSuite::Tester {
+    explicit ObjectBenchmark();
+
+    void setCleanList();
+    void setCleanSubtree();
+    void setCleanSubtreeSparse();
+    void cleanAllSparse();
+
+    void setupScene();
+    void moveObjects();
+
+    typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+    typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+    Containers::Pointer<Scene3D> _scene;
+    std::vector<std::reference_wrapper<Object3D>> _objects;
+};
+
+class CachingFeature: public AbstractFeature3D {
+    public:
+        explicit CachingFeature(AbstractObject3D& object): AbstractFeature3D{object} {
+            setCachedTransformations(CachedTransformation::Absolute|CachedTransformation::InvertedAbsolute);
+        }
+
+        Matrix4 absoluteTransformation, invertedAbsoluteTransformation;
+
+    private:
+        void clean(const Matrix4& absoluteTransformation) override {
+            this->absoluteTransformation = absoluteTransformation;
+        }
+
+        void cleanInverted(const Matrix4& invertedAbsoluteTransformation) override {
+            this->invertedAbsoluteTransformation = invertedAbsoluteTransformation;
+        }
+};
+
+constexpr UnsignedInt ThreadCount[]{1, 2, 4, 8};
+
+/* A wide scene, like a city with many independent blocks */
+constexpr std::size_t SubtreeCount = 64;
+constexpr std::size_t SubtreeSize = 2048;
+
+/* Objects moved each frame in the sparse case, about 1% of the scene */
+constexpr std::size_t MovedCount = 1024;
+
+ObjectBenchmark::ObjectBenchmark() {
+    addBenchmarks({&ObjectBenchmark::setCleanList}, 5);
+
+    addInstancedBenchmarks({&ObjectBenchmark::setCleanSubtree}, 5,
+        Containers::arraySize(ThreadCount));
+
+    addBenchmarks({&ObjectBenchmark::setCleanSubtreeSparse}, 5);
+
+    /* With only a few dirty objects the cost of spawning the threads on
+       every call becomes visible */
+    addInstancedBenchmarks({&ObjectBenchmark::cleanAllSparse}, 5,
+        Containers::arraySize(ThreadCount));
+}
+
+void ObjectBenchmark::setupScene() {
+    /* Building a large scene takes a while, reuse it across repeats */
+    if(!_scene) {
+        _scene.reset(new Scene3D);
+        _objects.reserve(SubtreeCount*SubtreeSize);
+
+        /* Each subtree is a balanced quaternary tree */
+        for(std::size_t i = 0; i != SubtreeCount; ++i) {
+            const std::size_t root = _objects.size();
+            for(std::size_t j = 0; j != SubtreeSize; ++j) {
+                Object3D* object = new Object3D{j ? &_objects[root + (j - 1)/4].get() : _scene.get()};
+                object->translate({0.1f, 0.2f, 0.3f})
+                    .rotateY(Deg(Float(j % 360)));
+                object->addFeature<CachingFeature>();
+                _objects.push_back(*object);
+            }
+        }
+    }
+
+    _scene->setDirty();
+}
+
+void ObjectBenchmark::moveObjects() {
+    /* Clean everything, then move a few random objects, like in an animated
+       scene where most of the objects are static */
+    _scene->cleanAll();
+    std::minstd_rand random{17};
+    for(std::size_t i = 0; i != MovedCount; ++i)
+        _objects[std::uniform_int_distribution<std::size_t>{0, _objects.size() - 1}(random)].get()
+            .translate({0.0f, 0.1f, 0.0f});
+}
+
+void ObjectBenchmark::setCleanList() {
+    setupScene();
+
+    CORRADE_BENCHMARK(1)
+        Object3D::setClean(_objects);
+
+    CORRADE_VERIFY(!_objects[_objects.size() - 1].get().isDirty());
+}
+
+void ObjectBenchmark::setCleanSubtree() {
+    const UnsignedInt threadCount = ThreadCount[testCaseInstanceId()];
+    setTestCaseDescription(Utility::formatString("{} threads", threadCount));
+
+    setupScene();
+
+    CORRADE_BENCHMARK(1)
+        _scene->setCleanSubtree(threadCount);
+
+    CORRADE_VERIFY(!_objects[_objects.size() - 1].get().isDirty());
+}
+
+void ObjectBenchmark::setCleanSubtreeSparse() {
+    setupScene();
+    moveObjects();
+
+    CORRADE_BENCHMARK(1)
+        _scene->setCleanSubtree();
+
+    CORRADE_VERIFY(!_objects[_objects.size() - 1].get().isDirty());
+}
+
+void ObjectBenchmark::cleanAllSparse() {
+    const UnsignedInt threadCount = ThreadCount[testCaseInstanceId()];
+    setTestCaseDescription(Utility::formatString("{} threads", threadCount));
+
+    setupScene();
+    moveObjects();
+
+    CORRADE_BENCHMARK(1)
+        _scene->cleanAll(threadCount);
+
+    CORRADE_VERIFY(!_objects[_objects.size() - 1].get().isDirty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ObjectBenchmark)
@@ -23,6 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
 #include <sstream>
 #include <Corrade/Containers/Pointer.h>
 #include <Corrade/TestSuite/Tester.h>
@@ -30,6 +33,23 @@
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Scene.h"
 
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+    /* Counts all heap allocations in the executable, used to verify that
+       the batch transformation APIs don't allocate in a steady state. Atomic
+       because setCleanSubtree() allocates from multiple threads. */
+    std::atomic<std::size_t> allocationCount{0};
+}}}}
+
+void* operator new(std::size_t size) {
+    ++Magnum::SceneGraph::Test::allocationCount;
+    if(void* data = std::malloc(size ? size : 1)) return data;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* data) noexcept {
+    std::free(data);
+}
+
 namespace Magnum { namespace SceneGraph { namespace Test { namespace {
 
 struct ObjectTest: TestSuite::Tester {
@@ -46,9 +66,18 @@ struct ObjectTest: TestSuite::Tester {
     void transformationsRelative();
     void transformationsOrphan();
     void transformationsDuplicate();
+    void transformationsLarge();
+    void transformationsInto();
+    void transformationsIntoWrongSize();
+    void transformationsIntoNoAllocations();
     void setClean();
     void setCleanListHierarchy();
     void setCleanListBulk();
+    void setCleanSubtree();
+    void cleanAll();
+    void cleanAllPartiallyCleaned();
+    void cleanAllPartiallyCleanedNested();
+    void cleanAllRemoved();
 
     void rangeBasedForChildren();
     void rangeBasedForFeatures();
@@ -64,13 +93,25 @@ class CachingObject: public Object3D, AbstractFeature3D {
         }
 
         Matrix4 cleanedAbsoluteTransformation;
+        Int cleanCount = 0;
 
     protected:
         void clean(const Matrix4& absoluteTransformation) override {
             cleanedAbsoluteTransformation = absoluteTransformation;
+            ++cleanCount;
         }
 };
 
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} SetCleanSubtreeData[]{
+    {"single thread", 1},
+    {"two threads", 2},
+    {"four threads", 4},
+    {"hardware concurrency", 0}
+};
+
 ObjectTest::ObjectTest() {
     addTests({&ObjectTest::addFeature,
 
@@ -83,9 +124,21 @@ ObjectTest::ObjectTest() {
               &ObjectTest::transformationsRelative,
               &ObjectTest::transformationsOrphan,
               &ObjectTest::transformationsDuplicate,
+              &ObjectTest::transformationsLarge,
+              &ObjectTest::transformationsInto,
+              &ObjectTest::transformationsIntoWrongSize,
+              &ObjectTest::transformationsIntoNoAllocations,
               &ObjectTest::setClean,
               &ObjectTest::setCleanListHierarchy,
-              &ObjectTest::setCleanListBulk,
+              &ObjectTest::setCleanListBulk});
+
+    addInstancedTests({&ObjectTest::setCleanSubtree,
+                       &ObjectTest::cleanAll},
+        Containers::arraySize(SetCleanSubtreeData));
+
+    addTests({&ObjectTest::cleanAllPartiallyCleaned,
+              &ObjectTest::cleanAllPartiallyCleanedNested,
+              &ObjectTest::cleanAllRemoved,
 
               &ObjectTest::rangeBasedForChildren,
               &ObjectTest::rangeBasedForFeatures});
@@ -309,6 +362,130 @@ void ObjectTest::transformationsDuplicate() {
     }));
 }
 
+void ObjectTest::transformationsLarge() {
+    /* More than 65535 objects, which was the limit of the original
+       implementation. Each object is a child of object at half its index,
+       making a balanced binary tree that isn't too deep. */
+    Scene3D s;
+    std::vector<Object3D*> objects;
+    std::vector<std::reference_wrapper<Object3D>> list;
+    objects.reserve(70000);
+    list.reserve(70000);
+    for(std::size_t i = 0; i != 70000; ++i) {
+        Object3D* o = new Object3D{i ? objects[i/2] : &s};
+        o->translate(Vector3::xAxis(1.0f));
+        objects.push_back(o);
+        list.push_back(*o);
+    }
+
+    std::vector<Matrix4> transformations = s.transformations(list);
+    CORRADE_COMPARE(transformations.size(), 70000);
+    CORRADE_COMPARE(transformations[0], Matrix4::translation(Vector3::xAxis(1.0f)));
+    CORRADE_COMPARE(transformations[1], Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_COMPARE(transformations[65536], Matrix4::translation(Vector3::xAxis(18.0f)));
+    CORRADE_COMPARE(transformations[69999], objects[69999]->absoluteTransformation());
+}
+
+void ObjectTest::transformationsInto() {
+    Scene3D s;
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+    Object3D third(&first);
+    third.translate(Vector3::xAxis(5.0f));
+
+    Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+    Matrix4 firstExpected = initial*Matrix4::rotationZ(Deg(30.0f));
+    Matrix4 secondExpected = initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f));
+    Matrix4 thirdExpected = initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f));
+
+    /* Duplicates and the scene itself */
+    Object3D::TransformationScratch scratch;
+    Matrix4 out[6];
+    s.transformationsInto({second, third, second, s, first, third}, out, scratch, initial);
+    CORRADE_COMPARE(out[0], secondExpected);
+    CORRADE_COMPARE(out[1], thirdExpected);
+    CORRADE_COMPARE(out[2], secondExpected);
+    CORRADE_COMPARE(out[3], initial);
+    CORRADE_COMPARE(out[4], firstExpected);
+    CORRADE_COMPARE(out[5], thirdExpected);
+
+    /* Reusing the scratch for a different set, all marks should be cleaned
+       from the previous run */
+    Matrix4 outMatrices[2];
+    s.transformationMatricesInto({third, first}, outMatrices, scratch, initial);
+    CORRADE_COMPARE(outMatrices[0], thirdExpected);
+    CORRADE_COMPARE(outMatrices[1], firstExpected);
+
+    /* Type-erased variant with scratch storage owned by the scene */
+    const AbstractObject3D& abstractScene = s;
+    Matrix4 outAbstract[2];
+    abstractScene.transformationMatricesInto({second, first}, outAbstract, initial);
+    CORRADE_COMPARE(outAbstract[0], secondExpected);
+    CORRADE_COMPARE(outAbstract[1], firstExpected);
+}
+
+void ObjectTest::transformationsIntoWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Scene3D s;
+    Object3D first(&s);
+
+    Object3D::TransformationScratch scratch;
+    Matrix4 out[2];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    s.transformationsInto({first}, out, scratch);
+    s.transformationMatricesInto({first}, out, scratch);
+    CORRADE_COMPARE(o.str(),
+        "SceneGraph::Object::transformations(): expected 1 output items but got 2\n"
+        "SceneGraph::Object::transformationMatrices(): expected 1 output items but got 2\n");
+}
+
+void ObjectTest::transformationsIntoNoAllocations() {
+    #if defined(CORRADE_TARGET_WINDOWS) && !defined(MAGNUM_BUILD_STATIC)
+    CORRADE_SKIP("Replaced operator new isn't used by allocations inside DLLs.");
+    #endif
+
+    Scene3D s;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::vector<std::reference_wrapper<AbstractObject3D>> abstractObjects;
+    for(std::size_t i = 0; i != 100; ++i) {
+        Object3D* o = new Object3D{i ? &objects[i/3].get() : &s};
+        o->rotateY(Deg(1.0f*i));
+        objects.push_back(*o);
+        abstractObjects.push_back(*o);
+    }
+
+    Object3D::TransformationScratch scratch;
+    std::vector<Matrix4> out(objects.size());
+    std::vector<Matrix4> outMatrices(objects.size());
+    std::vector<Matrix4> outAbstract(objects.size());
+    const AbstractObject3D& abstractScene = s;
+
+    /* The first calculation populates the scratch storage */
+    s.transformationsInto(objects, {out.data(), out.size()}, scratch);
+    abstractScene.transformationMatricesInto(abstractObjects, {outAbstract.data(), outAbstract.size()});
+
+    /* The subsequent ones, even with modified transformations, don't
+       allocate anything */
+    objects[50].get().translate(Vector3::zAxis(3.0f));
+    const std::size_t count = allocationCount;
+    s.transformationsInto(objects, {out.data(), out.size()}, scratch);
+    s.transformationMatricesInto(objects, {outMatrices.data(), outMatrices.size()}, scratch);
+    abstractScene.transformationMatricesInto(abstractObjects, {outAbstract.data(), outAbstract.size()});
+    CORRADE_COMPARE(allocationCount - count, 0);
+
+    /* Verify the output is still correct */
+    CORRADE_COMPARE(out[50], objects[50].get().absoluteTransformation());
+    CORRADE_COMPARE(outMatrices[99], objects[99].get().absoluteTransformation());
+    CORRADE_COMPARE(outAbstract[50], objects[50].get().absoluteTransformation());
+}
+
 void ObjectTest::setClean() {
     Scene3D scene;
 
@@ -489,6 +666,213 @@ void ObjectTest::setCleanListBulk() {
     CORRADE_COMPARE(d.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(-2.0f)));
 }
 
+void ObjectTest::setCleanSubtree() {
+    auto&& data = SetCleanSubtreeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Eight independent subtrees, each a ternary tree with three levels */
+    Scene3D scene;
+    std::vector<CachingObject*> objects;
+    for(std::size_t i = 0; i != 8; ++i) {
+        const std::size_t root = objects.size();
+        for(std::size_t j = 0; j != 13; ++j) {
+            CachingObject* o = new CachingObject{j ? static_cast<Object3D*>(objects[root + (j - 1)/3]) : &scene};
+            o->translate(Vector3::xAxis(Float(i)))
+                .rotateZ(Deg(10.0f*j));
+            objects.push_back(o);
+        }
+    }
+
+    /* Clean one root beforehand, it shouldn't get cleaned again */
+    objects[0]->setClean();
+    CORRADE_VERIFY(!objects[0]->isDirty());
+    CORRADE_VERIFY(objects[1]->isDirty());
+
+    /* Every object should be cleaned exactly once with correct
+       transformation */
+    scene.setCleanSubtree(data.threadCount);
+    for(CachingObject* o: objects) {
+        CORRADE_VERIFY(!o->isDirty());
+        CORRADE_COMPARE(o->cleanCount, 1);
+        CORRADE_COMPARE(o->cleanedAbsoluteTransformation, o->absoluteTransformationMatrix());
+    }
+
+    /* Modifying one subtree cleans only that subtree again */
+    objects[13]->translate(Vector3::yAxis(2.0f));
+    CORRADE_VERIFY(objects[25]->isDirty());
+    scene.setCleanSubtree(data.threadCount);
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        CORRADE_VERIFY(!objects[i]->isDirty());
+        CORRADE_COMPARE(objects[i]->cleanCount, i >= 13 && i < 26 ? 2 : 1);
+        CORRADE_COMPARE(objects[i]->cleanedAbsoluteTransformation, objects[i]->absoluteTransformationMatrix());
+    }
+
+    /* Cleaning a subtree of a non-scene object cleans the dirty parents as
+       well */
+    objects[26]->setDirty();
+    objects[27]->setCleanSubtree(data.threadCount);
+    CORRADE_VERIFY(!objects[26]->isDirty());
+    CORRADE_VERIFY(!objects[27]->isDirty());
+    CORRADE_VERIFY(!objects[30]->isDirty());
+    CORRADE_VERIFY(objects[28]->isDirty());
+    CORRADE_COMPARE(objects[30]->cleanedAbsoluteTransformation, objects[30]->absoluteTransformationMatrix());
+}
+
+void ObjectTest::cleanAll() {
+    auto&& data = SetCleanSubtreeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Eight independent subtrees, each a ternary tree with three levels */
+    Scene3D scene;
+    std::vector<CachingObject*> objects;
+    for(std::size_t i = 0; i != 8; ++i) {
+        const std::size_t root = objects.size();
+        for(std::size_t j = 0; j != 13; ++j) {
+            CachingObject* o = new CachingObject{j ? static_cast<Object3D*>(objects[root + (j - 1)/3]) : &scene};
+            o->translate(Vector3::xAxis(Float(i)))
+                .rotateZ(Deg(10.0f*j));
+            objects.push_back(o);
+        }
+    }
+
+    /* The scene is dirty initially, so everything gets cleaned */
+    CORRADE_VERIFY(scene.isDirty());
+    scene.cleanAll(data.threadCount);
+    CORRADE_VERIFY(!scene.isDirty());
+    for(CachingObject* o: objects) {
+        CORRADE_VERIFY(!o->isDirty());
+        CORRADE_COMPARE(o->cleanCount, 1);
+        CORRADE_COMPARE(o->cleanedAbsoluteTransformation, o->absoluteTransformationMatrix());
+    }
+
+    /* An inner object of the second subtree (with three children), root of
+       the third subtree together with its child and root of the fourth
+       subtree after its child */
+    objects[14]->translate(Vector3::yAxis(2.0f));
+    objects[26]->rotateZ(Deg(5.0f));
+    objects[27]->translate(Vector3::zAxis(1.0f));
+    objects[40]->translate(Vector3::zAxis(1.0f));
+    objects[39]->rotateY(Deg(15.0f));
+
+    /* Only the modified subtrees are cleaned, each object exactly once */
+    scene.cleanAll(data.threadCount);
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        const bool modified = i == 14 || (i >= 17 && i < 20) || (i >= 26 && i < 52);
+        CORRADE_VERIFY(!objects[i]->isDirty());
+        CORRADE_COMPARE(objects[i]->cleanCount, modified ? 2 : 1);
+        CORRADE_COMPARE(objects[i]->cleanedAbsoluteTransformation, objects[i]->absoluteTransformationMatrix());
+    }
+
+    /* Nothing to clean the second time */
+    scene.cleanAll(data.threadCount);
+    CORRADE_COMPARE(objects[14]->cleanCount, 2);
+    CORRADE_COMPARE(objects[0]->cleanCount, 1);
+}
+
+void ObjectTest::cleanAllPartiallyCleaned() {
+    Scene3D scene;
+    CachingObject a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+    CachingObject b{&a};
+    CachingObject c{&a};
+    c.scale(Vector3(2.0f));
+    CachingObject d{&c};
+    d.translate(Vector3::yAxis(3.0f));
+    scene.cleanAll();
+
+    /* Cleaning one child cleans the parent in the list as well, the other
+       child stays dirty with a clean parent */
+    a.translate(Vector3::zAxis(-1.0f));
+    b.setClean();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+    CORRADE_VERIFY(d.isDirty());
+
+    /* The dirty subtree is still found */
+    scene.cleanAll();
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_VERIFY(!d.isDirty());
+    CORRADE_COMPARE(a.cleanCount, 2);
+    CORRADE_COMPARE(b.cleanCount, 2);
+    CORRADE_COMPARE(c.cleanCount, 2);
+    CORRADE_COMPARE(d.cleanCount, 2);
+    CORRADE_COMPARE(d.cleanedAbsoluteTransformation,
+        Matrix4::translation({1.0f, 0.0f, -1.0f})*
+        Matrix4::scaling(Vector3(2.0f))*
+        Matrix4::translation(Vector3::yAxis(3.0f)));
+}
+
+void ObjectTest::cleanAllPartiallyCleanedNested() {
+    Scene3D scene;
+    CachingObject a{&scene};
+    CachingObject c{&a};
+    CachingObject d{&c};
+    d.translate(Vector3::yAxis(3.0f));
+    scene.cleanAll();
+
+    /* Both a and c end up clean in the list, with d dirty below both of
+       them. It should be found only once. */
+    a.translate(Vector3::xAxis(1.0f));
+    c.setClean();
+    c.translate(Vector3::zAxis(-1.0f));
+    c.setClean();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_VERIFY(d.isDirty());
+
+    scene.cleanAll();
+    CORRADE_VERIFY(!d.isDirty());
+    CORRADE_COMPARE(a.cleanCount, 2);
+    CORRADE_COMPARE(c.cleanCount, 3);
+    CORRADE_COMPARE(d.cleanCount, 2);
+    CORRADE_COMPARE(d.cleanedAbsoluteTransformation,
+        Matrix4::translation({1.0f, 3.0f, -1.0f}));
+}
+
+void ObjectTest::cleanAllRemoved() {
+    Scene3D scene;
+    Scene3D another;
+    CachingObject a{&scene};
+    CachingObject* b = new CachingObject{&scene};
+    CachingObject c{&scene};
+    scene.cleanAll();
+    another.cleanAll();
+
+    a.translate(Vector3::xAxis(1.0f));
+    b->translate(Vector3::xAxis(2.0f));
+    c.translate(Vector3::xAxis(3.0f));
+
+    /* Deleted objects and objects moved to another scene are removed from
+       the list */
+    delete b;
+    c.setParent(&another);
+    scene.cleanAll();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_COMPARE(a.cleanCount, 2);
+    CORRADE_VERIFY(c.isDirty());
+    CORRADE_COMPARE(c.cleanCount, 1);
+
+    /* The moved object is in the list of the other scene */
+    another.cleanAll();
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(c.cleanCount, 2);
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(3.0f)));
+
+    /* Objects removed from the scene are removed from the list as well */
+    a.translate(Vector3::xAxis(1.0f));
+    a.setParent(nullptr);
+    scene.cleanAll();
+    CORRADE_VERIFY(a.isDirty());
+    CORRADE_COMPARE(a.cleanCount, 2);
+
+    /* Destroying a scene with a non-empty list shouldn't crash */
+    Scene3D* temporary = new Scene3D;
+    CachingObject* d = new CachingObject{temporary};
+    temporary->cleanAll();
+    d->translate(Vector3::xAxis(1.0f));
+    delete temporary;
+}
+
 void ObjectTest::rangeBasedForChildren() {
     Scene3D scene;
     Object3D a(&scene);
@@ -0,0 +1,403 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <type_traits>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/AbstractAsyncResourceLoader.h"
+#include "Magnum/ResourceManager.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct AbstractAsyncResourceLoaderTest: TestSuite::Tester {
+    explicit AbstractAsyncResourceLoaderTest();
+
+    void synchronous();
+    void threaded();
+    void notFound();
+    void priority();
+    void priorityChange();
+    void updateLimit();
+    void cancelQueued();
+    void cancelLoading();
+    void cancelNotPending();
+    void differentType();
+    void differentTypeFinishRequired();
+    void stop();
+};
+
+typedef Magnum::ResourceManager<Int> ResourceManager;
+
+/* Values are looked up by the key in a map that's populated before any
+   request is made and only read afterwards, so that's thread-safe */
+class IntLoader: public AbstractAsyncResourceLoader<Int> {
+    public:
+        explicit IntLoader(UnsignedInt workerCount): AbstractAsyncResourceLoader<Int>{workerCount} {}
+
+        ~IntLoader() { stop(); }
+
+        void add(const std::string& name, Int value) {
+            values.emplace(name, value);
+        }
+
+        std::unordered_map<ResourceKey, Int> values;
+        std::vector<ResourceKey> order;
+
+    private:
+        Containers::Optional<Int> doLoadAsync(ResourceKey key, UnsignedInt) override {
+            /* Accessed only with zero workers, where it's called from
+               update() */
+            if(!workerCount()) order.push_back(key);
+
+            auto found = values.find(key);
+            if(found == values.end()) return Containers::NullOpt;
+            return found->second;
+        }
+};
+
+AbstractAsyncResourceLoaderTest::AbstractAsyncResourceLoaderTest() {
+    addTests({&AbstractAsyncResourceLoaderTest::synchronous,
+              &AbstractAsyncResourceLoaderTest::threaded,
+              &AbstractAsyncResourceLoaderTest::notFound,
+              &AbstractAsyncResourceLoaderTest::priority,
+              &AbstractAsyncResourceLoaderTest::priorityChange,
+              &AbstractAsyncResourceLoaderTest::updateLimit,
+              &AbstractAsyncResourceLoaderTest::cancelQueued,
+              &AbstractAsyncResourceLoaderTest::cancelLoading,
+              &AbstractAsyncResourceLoaderTest::cancelNotPending,
+              &AbstractAsyncResourceLoaderTest::differentType,
+              &AbstractAsyncResourceLoaderTest::differentTypeFinishRequired,
+              &AbstractAsyncResourceLoaderTest::stop});
+}
+
+void AbstractAsyncResourceLoaderTest::synchronous() {
+    ResourceManager rm;
+    Containers::Pointer<IntLoader> loaderPtr{Containers::InPlaceInit, 0u};
+    IntLoader& loader = *loaderPtr;
+    loader.add("hello", 773);
+    rm.setLoader<Int>(std::move(loaderPtr));
+    CORRADE_COMPARE(loader.workerCount(), 0);
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    CORRADE_COMPARE(hello.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader.requestedCount(), 1);
+    CORRADE_COMPARE(loader.pendingCount(), 1);
+    CORRADE_VERIFY(loader.order.empty());
+
+    CORRADE_COMPARE(loader.update(), 1);
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_COMPARE(*hello, 773);
+    CORRADE_COMPARE(loader.loadedCount(), 1);
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+
+    /* Nothing more to do */
+    CORRADE_COMPARE(loader.update(), 0);
+}
+
+void AbstractAsyncResourceLoaderTest::threaded() {
+    ResourceManager rm;
+    Containers::Pointer<IntLoader> loaderPtr{Containers::InPlaceInit, 3u};
+    IntLoader& loader = *loaderPtr;
+    for(Int i = 0; i != 100; ++i) loader.add(std::to_string(i), i*10);
+    rm.setLoader<Int>(std::move(loaderPtr));
+    CORRADE_COMPARE(loader.workerCount(), 3);
+
+    std::vector<Resource<Int>> resources;
+    for(Int i = 0; i != 100; ++i)
+        resources.push_back(rm.get<Int>(std::to_string(i)));
+    CORRADE_COMPARE(loader.requestedCount(), 100);
+
+    /* The manager isn't touched by the workers, so nothing can be loaded
+       before the synchronization point */
+    for(Resource<Int>& resource: resources)
+        CORRADE_COMPARE(resource.state(), ResourceState::Loading);
+
+    loader.wait();
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(loader.loadedCount(), 100);
+    for(Int i = 0; i != 100; ++i) {
+        CORRADE_COMPARE(resources[i].state(), ResourceState::Final);
+        CORRADE_COMPARE(*resources[i], i*10);
+    }
+}
+
+void AbstractAsyncResourceLoaderTest::notFound() {
+    ResourceManager rm;
+    Containers::Pointer<IntLoader> loaderPtr{Containers::InPlaceInit, 1u};
+    IntLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> world = rm.get<Int>("world");
+    CORRADE_COMPARE(world.state(), ResourceState::Loading);
+
+    loader.wait();
+    CORRADE_COMPARE(world.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader.loadedCount(), 0);
+    CORRADE_COMPARE(loader.notFoundCount(), 1);
+}
+
+void AbstractAsyncResourceLoaderTest::priority() {
+    ResourceManager rm;
+    Containers::Pointer<IntLoader> loaderPtr{Containers::InPlaceInit, 0u};
+    IntLoader& loader = *loaderPtr;
+    loader.add("a", 1);
+    loader.add("b", 2);
+    loader.add("c", 3);
+    loader.add("d", 4);
+    loader.setPriority("c", 5)
+          .setPriority("b", -1);
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    rm.get<Int>("a");
+    rm.get<Int>("b");
+    rm.get<Int>("c");
+    rm.get<Int>("d");
+    CORRADE_COMPARE(loader.update(), 4);
+
+    /* Highest priority first, same priority in order of request */
+    CORRADE_COMPARE(loader.order.size(), 4);
+    CORRADE_VERIFY(loader.order[0] == ResourceKey{"c"});
+    CORRADE_VERIFY(loader.order[1] == ResourceKey{"a"});
+    CORRADE_VERIFY(loader.order[2] == ResourceKey{"d"});
+    CORRADE_VERIFY(loader.order[3] == ResourceKey{"b"});
+}
+
+void AbstractAsyncResourceLoaderTest::priorityChange() {
+    ResourceManager rm;
+    Containers::Pointer<IntLoader> loaderPtr{Containers::InPlaceInit, 0u};
+    IntLoader& loader = *loaderPtr;
+    loader.add("a", 1);
+    loader.add("b", 2);
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    rm.get<Int>("a");
+    rm.get<Int>("b");
+
+    /* Reprioritizing an already queued request */
+    loader.setPriority("b", 1);
+    CORRADE_COMPARE(loader.update(), 2);
+
+    CORRADE_COMPARE(loader.order.size(), 2);
+    CORRADE_VERIFY(loader.order[0] == ResourceKey{"b"});
+    CORRADE_VERIFY(loader.order[1] == ResourceKey{"a"});
+}
+
+void AbstractAsyncResourceLoaderTest::updateLimit() {
+    ResourceManager rm;
+    Containers::Pointer<IntLoader> loaderPtr{Containers::InPlaceInit, 0u};
+    IntLoader& loader = *loaderPtr;
+    loader.add("a", 1);
+    loader.add("b", 2);
+    loader.add("c", 3);
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> a = rm.get<Int>("a");
+    Resource<Int> b = rm.get<Int>("b");
+    Resource<Int> c = rm.get<Int>("c");
+
+    CORRADE_COMPARE(loader.update(2), 2);
+    CORRADE_COMPARE(loader.pendingCount(), 1);
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    CORRADE_COMPARE(b.state(), ResourceState::Final);
+    CORRADE_COMPARE(c.state(), ResourceState::Loading);
+
+    CORRADE_COMPARE(loader.update(2), 1);
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(*a, 1);
+    CORRADE_COMPARE(*b, 2);
+    CORRADE_COMPARE(*c, 3);
+}
+
+void AbstractAsyncResourceLoaderTest::cancelQueued() {
+    ResourceManager rm;
+    Containers::Pointer<IntLoader> loaderPtr{Containers::InPlaceInit, 0u};
+    IntLoader& loader = *loaderPtr;
+    loader.add("a", 1);
+    loader.add("b", 2);
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> a = rm.get<Int>("a");
+    Resource<Int> b = rm.get<Int>("b");
+    CORRADE_COMPARE(loader.pendingCount(), 2);
+
+    CORRADE_VERIFY(loader.cancel("a"));
+    CORRADE_COMPARE(a.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader.pendingCount(), 1);
+    CORRADE_COMPARE(loader.notFoundCount(), 1);
+
+    CORRADE_COMPARE(loader.update(), 1);
+    CORRADE_COMPARE(loader.order.size(), 1);
+    CORRADE_COMPARE(a.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(b.state(), ResourceState::Final);
+
+    /* It's possible to request it again */
+    loader.load("a");
+    CORRADE_COMPARE(a.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader.update(), 1);
+    CORRADE_COMPARE(*a, 1);
+}
+
+void AbstractAsyncResourceLoaderTest::cancelLoading() {
+    /* Blocks the worker until the test lets it go */
+    class BlockingLoader: public AbstractAsyncResourceLoader<Int> {
+        public:
+            explicit BlockingLoader(): AbstractAsyncResourceLoader<Int>{1} {}
+
+            ~BlockingLoader() { stop(); }
+
+            void waitForLoading() {
+                std::unique_lock<std::mutex> lock{mutex};
+                condition.wait(lock, [this]() { return loading; });
+            }
+
+            void release() {
+                {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    released = true;
+                }
+                condition.notify_all();
+            }
+
+        private:
+            Containers::Optional<Int> doLoadAsync(ResourceKey, UnsignedInt) override {
+                std::unique_lock<std::mutex> lock{mutex};
+                loading = true;
+                condition.notify_all();
+                condition.wait(lock, [this]() { return released; });
+                return 42;
+            }
+
+            std::mutex mutex;
+            std::condition_variable condition;
+            bool loading{}, released{};
+    };
+
+    ResourceManager rm;
+    Containers::Pointer<BlockingLoader> loaderPtr{Containers::InPlaceInit};
+    BlockingLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> a = rm.get<Int>("a");
+    loader.waitForLoading();
+
+    CORRADE_VERIFY(loader.cancel("a"));
+    CORRADE_COMPARE(a.state(), ResourceState::NotFound);
+
+    /* The result is discarded */
+    loader.release();
+    loader.wait();
+    CORRADE_COMPARE(a.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader.loadedCount(), 0);
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+}
+
+void AbstractAsyncResourceLoaderTest::cancelNotPending() {
+    ResourceManager rm;
+    Containers::Pointer<IntLoader> loaderPtr{Containers::InPlaceInit, 0u};
+    IntLoader& loader = *loaderPtr;
+    loader.add("a", 1);
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    CORRADE_VERIFY(!loader.cancel("a"));
+
+    Resource<Int> a = rm.get<Int>("a");
+    loader.update();
+    CORRADE_VERIFY(!loader.cancel("a"));
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    CORRADE_COMPARE(loader.notFoundCount(), 0);
+}
+
+void AbstractAsyncResourceLoaderTest::differentType() {
+    /* The string is produced on the worker, converted on the main thread */
+    class StringLoader: public AbstractAsyncResourceLoader<Int, std::string> {
+        public:
+            explicit StringLoader(): AbstractAsyncResourceLoader<Int, std::string>{1} {}
+
+            ~StringLoader() { stop(); }
+
+        private:
+            Containers::Optional<std::string> doLoadAsync(ResourceKey key, UnsignedInt) override {
+                if(key == ResourceKey{"answer"}) return std::string{"42"};
+                return Containers::NullOpt;
+            }
+
+            void doFinish(ResourceKey key, std::string&& data) override {
+                set(key, std::stoi(data));
+            }
+    };
+
+    ResourceManager rm;
+    Containers::Pointer<StringLoader> loaderPtr{Containers::InPlaceInit};
+    StringLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> answer = rm.get<Int>("answer");
+    Resource<Int> question = rm.get<Int>("question");
+    loader.wait();
+    CORRADE_COMPARE(answer.state(), ResourceState::Final);
+    CORRADE_COMPARE(*answer, 42);
+    CORRADE_COMPARE(question.state(), ResourceState::NotFound);
+}
+
+void AbstractAsyncResourceLoaderTest::differentTypeFinishRequired() {
+    /* Without doFinish() the loader can't be instantiated */
+    class StringLoader: public AbstractAsyncResourceLoader<Int, std::string> {
+        public:
+            explicit StringLoader(): AbstractAsyncResourceLoader<Int, std::string>{0} {}
+
+            ~StringLoader() { stop(); }
+
+        private:
+            Containers::Optional<std::string> doLoadAsync(ResourceKey, UnsignedInt) override {
+                return std::string{"42"};
+            }
+    };
+
+    CORRADE_VERIFY(std::is_abstract<StringLoader>::value);
+    CORRADE_VERIFY(!std::is_abstract<IntLoader>::value);
+}
+
+void AbstractAsyncResourceLoaderTest::stop() {
+    ResourceManager rm;
+    Containers::Pointer<IntLoader> loaderPtr{Containers::InPlaceInit, 2u};
+    IntLoader& loader = *loaderPtr;
+    loader.add("a", 1);
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    rm.get<Int>("a");
+    loader.stop();
+    CORRADE_COMPARE(loader.workerCount(), 0);
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+
+    /* Subsequent requests are loaded synchronously */
+    Resource<Int> b = rm.get<Int>("b");
+    loader.add("b", 2);
+    CORRADE_COMPARE(loader.update(), 1);
+    CORRADE_COMPARE(*b, 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::AbstractAsyncResourceLoaderTest)
@@ -0,0 +1,263 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshBlob.h"
+
+#include <cstdint>
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+constexpr char Magic[8]{'M', 'G', 'N', 'M', 'E', 'S', 'H', 'B'};
+constexpr UnsignedShort ByteOrderMark = 0xfeff;
+
+/* All arrays are aligned to this value relative to the blob start */
+constexpr std::size_t Alignment = 16;
+
+/* Counts and sizes are stored as 32-bit values */
+constexpr std::size_t MaxCount = 0xffffffffu;
+
+struct Header {
+    char magic[8];
+    UnsignedShort version;
+    UnsignedShort byteOrderMark;
+    UnsignedInt meshCount;
+};
+
+static_assert(sizeof(Header) == 16, "improper size of the blob header");
+
+/* Offsets are from the blob start, zero offset means the array is not
+   present */
+struct MeshHeader {
+    UnsignedInt primitive;
+    UnsignedInt nameSize;
+    UnsignedInt indexCount;
+    UnsignedInt vertexCount;
+    UnsignedLong nameOffset;
+    UnsignedLong indexOffset;
+    UnsignedLong positionOffset;
+    UnsignedLong normalOffset;
+    UnsignedLong textureCoordinateOffset;
+    UnsignedLong colorOffset;
+};
+
+static_assert(sizeof(MeshHeader) == 64, "improper size of the blob mesh header");
+
+inline std::size_t aligned(const std::size_t offset) {
+    return (offset + Alignment - 1) & ~(Alignment - 1);
+}
+
+/* Reserves space for an array at the end of the blob, returns zero offset
+   for empty arrays */
+inline UnsignedLong reserve(std::size_t& size, const std::size_t bytes) {
+    if(!bytes) return 0;
+    const std::size_t offset = size;
+    size = aligned(size + bytes);
+    return offset;
+}
+
+inline void copy(const Containers::ArrayView<char> out, const UnsignedLong offset, const void* const data, const std::size_t bytes) {
+    if(bytes) std::memcpy(out.data() + offset, data, bytes);
+}
+
+template<class T> bool view(const Containers::ArrayView<const char> data, const UnsignedInt mesh, const char* const what, const UnsignedLong offset, const UnsignedLong count, Containers::ArrayView<const T>& out) {
+    if(!offset) return true;
+
+    if(offset % alignof(T) || offset > data.size() || count*sizeof(T) > data.size() - offset) {
+        Error() << "Trade::parseMeshBlob():" << what << "of mesh" << mesh << "out of bounds";
+        return false;
+    }
+
+    out = {reinterpret_cast<const T*>(data.data() + offset), std::size_t(count)};
+    return true;
+}
+
+}
+
+MeshData3D MeshBlobView::toMeshData3D(const void* const importerState) const {
+    std::vector<std::vector<Vector3>> positionArrays;
+    positionArrays.emplace_back(positions.begin(), positions.end());
+
+    std::vector<std::vector<Vector3>> normalArrays;
+    if(!normals.empty())
+        normalArrays.emplace_back(normals.begin(), normals.end());
+
+    std::vector<std::vector<Vector2>> textureCoordinateArrays;
+    if(!textureCoords2D.empty())
+        textureCoordinateArrays.emplace_back(textureCoords2D.begin(), textureCoords2D.end());
+
+    std::vector<std::vector<Color4>> colorArrays;
+    if(!colors.empty())
+        colorArrays.emplace_back(colors.begin(), colors.end());
+
+    return MeshData3D{primitive,
+        std::vector<UnsignedInt>(indices.begin(), indices.end()),
+        std::move(positionArrays), std::move(normalArrays),
+        std::move(textureCoordinateArrays), std::move(colorArrays), importerState};
+}
+
+Containers::Array<char> serializeMeshBlob(const std::vector<MeshData3D>& meshes, const std::vector<std::string>& names) {
+    CORRADE_ASSERT(names.empty() || names.size() == meshes.size(),
+        "Trade::serializeMeshBlob(): expected" << meshes.size() << "names but got" << names.size(), {});
+    CORRADE_ASSERT(meshes.size() <= MaxCount,
+        "Trade::serializeMeshBlob(): expected at most" << MaxCount << "meshes but got" << meshes.size(), {});
+
+    /* Calculate the layout first so the blob is allocated just once */
+    std::size_t size = aligned(sizeof(Header) + meshes.size()*sizeof(MeshHeader));
+    std::vector<MeshHeader> headers(meshes.size());
+    for(std::size_t i = 0; i != meshes.size(); ++i) {
+        const MeshData3D& mesh = meshes[i];
+        MeshHeader& header = headers[i];
+
+        const std::size_t nameSize = names.empty() ? 0 : names[i].size();
+        const std::size_t indexCount = mesh.isIndexed() ? mesh.indices().size() : 0;
+        const std::size_t vertexCount = mesh.positions(0).size();
+        CORRADE_ASSERT(nameSize <= MaxCount,
+            "Trade::serializeMeshBlob(): expected name of mesh" << i << "to have at most" << MaxCount << "bytes but got" << nameSize, {});
+        CORRADE_ASSERT(indexCount <= MaxCount,
+            "Trade::serializeMeshBlob(): expected at most" << MaxCount << "indices in mesh" << i << "but got" << indexCount, {});
+        CORRADE_ASSERT(vertexCount <= MaxCount,
+            "Trade::serializeMeshBlob(): expected at most" << MaxCount << "vertices in mesh" << i << "but got" << vertexCount, {});
+
+        header.primitive = UnsignedInt(mesh.primitive());
+        header.nameSize = UnsignedInt(nameSize);
+        header.indexCount = UnsignedInt(indexCount);
+        header.vertexCount = UnsignedInt(vertexCount);
+
+        CORRADE_ASSERT(!mesh.hasNormals() || mesh.normals(0).size() == header.vertexCount,
+            "Trade::serializeMeshBlob(): expected" << header.vertexCount << "normals in mesh" << i << "but got" << mesh.normals(0).size(), {});
+        CORRADE_ASSERT(!mesh.hasTextureCoords2D() || mesh.textureCoords2D(0).size() == header.vertexCount,
+            "Trade::serializeMeshBlob(): expected" << header.vertexCount << "texture coordinates in mesh" << i << "but got" << mesh.textureCoords2D(0).size(), {});
+        CORRADE_ASSERT(!mesh.hasColors() || mesh.colors(0).size() == header.vertexCount,
+            "Trade::serializeMeshBlob(): expected" << header.vertexCount << "colors in mesh" << i << "but got" << mesh.colors(0).size(), {});
+
+        header.nameOffset = reserve(size, header.nameSize);
+        header.indexOffset = reserve(size, header.indexCount*sizeof(UnsignedInt));
+        header.positionOffset = reserve(size, header.vertexCount*sizeof(Vector3));
+        header.normalOffset = mesh.hasNormals() ? reserve(size, header.vertexCount*sizeof(Vector3)) : 0;
+        header.textureCoordinateOffset = mesh.hasTextureCoords2D() ? reserve(size, header.vertexCount*sizeof(Vector2)) : 0;
+        header.colorOffset = mesh.hasColors() ? reserve(size, header.vertexCount*sizeof(Color4)) : 0;
+    }
+
+    /* Value-initialized so the padding is deterministic */
+    Containers::Array<char> out{Containers::ValueInit, size};
+
+    Header header;
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = MeshBlobVersion;
+    header.byteOrderMark = ByteOrderMark;
+    header.meshCount = UnsignedInt(meshes.size());
+    copy(out, 0, &header, sizeof(Header));
+    copy(out, sizeof(Header), headers.data(), headers.size()*sizeof(MeshHeader));
+
+    for(std::size_t i = 0; i != meshes.size(); ++i) {
+        const MeshData3D& mesh = meshes[i];
+        const MeshHeader& meshHeader = headers[i];
+
+        if(meshHeader.nameSize)
+            copy(out, meshHeader.nameOffset, names[i].data(), meshHeader.nameSize);
+        if(meshHeader.indexCount)
+            copy(out, meshHeader.indexOffset, mesh.indices().data(), meshHeader.indexCount*sizeof(UnsignedInt));
+        copy(out, meshHeader.positionOffset, mesh.positions(0).data(), meshHeader.vertexCount*sizeof(Vector3));
+        if(mesh.hasNormals())
+            copy(out, meshHeader.normalOffset, mesh.normals(0).data(), meshHeader.vertexCount*sizeof(Vector3));
+        if(mesh.hasTextureCoords2D())
+            copy(out, meshHeader.textureCoordinateOffset, mesh.textureCoords2D(0).data(), meshHeader.vertexCount*sizeof(Vector2));
+        if(mesh.hasColors())
+            copy(out, meshHeader.colorOffset, mesh.colors(0).data(), meshHeader.vertexCount*sizeof(Color4));
+    }
+
+    return out;
+}
+
+Containers::Optional<std::vector<MeshBlobView>> parseMeshBlob(const Containers::ArrayView<const char> data) {
+    if(reinterpret_cast<std::uintptr_t>(data.data()) % 4) {
+        Error() << "Trade::parseMeshBlob(): data not aligned to four bytes";
+        return Containers::NullOpt;
+    }
+
+    if(data.size() < sizeof(Header)) {
+        Error() << "Trade::parseMeshBlob(): expected at least" << sizeof(Header) << "bytes for a header but got" << data.size();
+        return Containers::NullOpt;
+    }
+
+    Header header;
+    std::memcpy(&header, data.data(), sizeof(Header));
+    if(std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        Error() << "Trade::parseMeshBlob(): invalid file signature";
+        return Containers::NullOpt;
+    }
+    if(header.byteOrderMark != ByteOrderMark) {
+        Error() << "Trade::parseMeshBlob(): unsupported byte order";
+        return Containers::NullOpt;
+    }
+    if(header.version != MeshBlobVersion) {
+        Error() << "Trade::parseMeshBlob(): unsupported version" << header.version << Debug::nospace << ", expected" << MeshBlobVersion;
+        return Containers::NullOpt;
+    }
+
+    const UnsignedLong headersSize = sizeof(Header) + UnsignedLong(header.meshCount)*sizeof(MeshHeader);
+    if(data.size() < headersSize) {
+        Error() << "Trade::parseMeshBlob(): expected at least" << headersSize << "bytes for" << header.meshCount << "meshes but got" << data.size();
+        return Containers::NullOpt;
+    }
+
+    std::vector<MeshBlobView> out(header.meshCount);
+    for(UnsignedInt i = 0; i != header.meshCount; ++i) {
+        MeshHeader meshHeader;
+        std::memcpy(&meshHeader, data.data() + sizeof(Header) + i*sizeof(MeshHeader), sizeof(MeshHeader));
+
+        if(meshHeader.primitive > UnsignedInt(MeshPrimitive::TriangleFan)) {
+            Error() << "Trade::parseMeshBlob(): invalid primitive" << meshHeader.primitive << "in mesh" << i;
+            return Containers::NullOpt;
+        }
+        if(!meshHeader.positionOffset && meshHeader.vertexCount) {
+            Error() << "Trade::parseMeshBlob(): mesh" << i << "has no positions";
+            return Containers::NullOpt;
+        }
+
+        MeshBlobView& mesh = out[i];
+        mesh.primitive = MeshPrimitive(meshHeader.primitive);
+        if(!view(data, i, "name", meshHeader.nameOffset, meshHeader.nameSize, mesh.name) ||
+           !view(data, i, "indices", meshHeader.indexOffset, meshHeader.indexCount, mesh.indices) ||
+           !view(data, i, "positions", meshHeader.positionOffset, meshHeader.vertexCount, mesh.positions) ||
+           !view(data, i, "normals", meshHeader.normalOffset, meshHeader.vertexCount, mesh.normals) ||
+           !view(data, i, "texture coordinates", meshHeader.textureCoordinateOffset, meshHeader.vertexCount, mesh.textureCoords2D) ||
+           !view(data, i, "colors", meshHeader.colorOffset, meshHeader.vertexCount, mesh.colors))
+            return Containers::NullOpt;
+    }
+
+    return out;
+}
+
+}}
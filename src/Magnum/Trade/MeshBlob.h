@@ -0,0 +1,123 @@
+#ifndef Magnum_Trade_MeshBlob_h
+#define Magnum_Trade_MeshBlob_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Struct @ref Magnum::Trade::MeshBlobView, function @ref Magnum::Trade::serializeMeshBlob(), @ref Magnum::Trade::parseMeshBlob()
+ */
+
+#include <string>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Mesh blob format version
+
+Version of the format written by @ref serializeMeshBlob(). Blobs with a
+different version are rejected by @ref parseMeshBlob().
+*/
+constexpr UnsignedShort MeshBlobVersion = 1;
+
+/**
+@brief View on a mesh stored in a mesh blob
+
+Returned by @ref parseMeshBlob(), the views point directly into the blob data
+so nothing is copied. Attributes that are not present are empty views, an
+empty @ref indices view means the mesh is not indexed, the same as with
+@ref MeshData3D.
+*/
+struct MeshBlobView {
+    /** @brief Mesh name */
+    Containers::ArrayView<const char> name;
+
+    /** @brief Primitive */
+    MeshPrimitive primitive;
+
+    /** @brief Indices */
+    Containers::ArrayView<const UnsignedInt> indices;
+
+    /** @brief Positions */
+    Containers::ArrayView<const Vector3> positions;
+
+    /** @brief Normals */
+    Containers::ArrayView<const Vector3> normals;
+
+    /** @brief 2D texture coordinates */
+    Containers::ArrayView<const Vector2> textureCoords2D;
+
+    /** @brief Vertex colors */
+    Containers::ArrayView<const Color4> colors;
+
+    /**
+     * @brief Copy the data to a @ref MeshData3D
+     * @param importerState     Importer-specific state
+     *
+     * The returned instance has at most one array of each attribute.
+     */
+    MAGNUM_TRADE_EXPORT MeshData3D toMeshData3D(const void* importerState = nullptr) const;
+};
+
+/**
+@brief Serialize meshes to a mesh blob
+@param meshes   Meshes to serialize
+@param names    Mesh names. Expected to be either empty or have the same size
+    as @p meshes.
+
+Only the first array of each attribute is stored. The blob consists of a
+16-byte header with a magic, @ref MeshBlobVersion and a byte order mark,
+followed by a table of 64-byte mesh headers with offsets and counts. Names,
+indices and attribute arrays follow, each of them aligned to 16 bytes, so the
+blob can be memory-mapped and the data used directly. The byte order is the
+one of the machine the blob was created on. Counts and name sizes are stored
+as 32-bit values, so the mesh count, name sizes, index and vertex counts are
+expected to fit into 32 bits.
+@see @ref parseMeshBlob(), @ref MeshBlobImporter
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<char> serializeMeshBlob(const std::vector<MeshData3D>& meshes, const std::vector<std::string>& names = {});
+
+/**
+@brief Parse a mesh blob
+@param data     Blob data. Expected to be aligned to at least four bytes.
+
+Checks the header and that all arrays are in bounds of @p data and returns a
+view on each mesh, pointing into @p data. On failure prints a message to
+@ref Error and returns @ref Corrade::Containers::NullOpt.
+@see @ref serializeMeshBlob()
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<std::vector<MeshBlobView>> parseMeshBlob(Containers::ArrayView<const char> data);
+
+}}
+
+#endif
@@ -0,0 +1,261 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/MeshBlob.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MeshBlobTest: TestSuite::Tester {
+    explicit MeshBlobTest();
+
+    void serializeParse();
+    void serializeEmpty();
+    void serializeWrongNameCount();
+    void serializeWrongAttributeCount();
+    void alignment();
+    void toMeshData3D();
+
+    void parseTooShort();
+    void parseInvalidSignature();
+    void parseInvalidVersion();
+    void parseInvalidByteOrder();
+    void parseInvalidPrimitive();
+    void parseOutOfBounds();
+};
+
+MeshBlobTest::MeshBlobTest() {
+    addTests({&MeshBlobTest::serializeParse,
+              &MeshBlobTest::serializeEmpty,
+              &MeshBlobTest::serializeWrongNameCount,
+              &MeshBlobTest::serializeWrongAttributeCount,
+              &MeshBlobTest::alignment,
+              &MeshBlobTest::toMeshData3D,
+
+              &MeshBlobTest::parseTooShort,
+              &MeshBlobTest::parseInvalidSignature,
+              &MeshBlobTest::parseInvalidVersion,
+              &MeshBlobTest::parseInvalidByteOrder,
+              &MeshBlobTest::parseInvalidPrimitive,
+              &MeshBlobTest::parseOutOfBounds});
+}
+
+std::vector<MeshData3D> meshes() {
+    std::vector<MeshData3D> out;
+    out.emplace_back(MeshPrimitive::Triangles, std::vector<UnsignedInt>{0, 1, 2, 2, 1, 0},
+        std::vector<std::vector<Vector3>>{{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {7.0f, 8.0f, 9.0f}}},
+        std::vector<std::vector<Vector3>>{{Vector3::zAxis(), Vector3::yAxis(), Vector3::xAxis()}},
+        std::vector<std::vector<Vector2>>{{{0.5f, 1.0f}, {1.0f, 0.0f}, {0.0f, 0.0f}}},
+        std::vector<std::vector<Color4>>{});
+    out.emplace_back(MeshPrimitive::Points, std::vector<UnsignedInt>{},
+        std::vector<std::vector<Vector3>>{{{1.0f, 1.0f, 1.0f}}},
+        std::vector<std::vector<Vector3>>{}, std::vector<std::vector<Vector2>>{},
+        std::vector<std::vector<Color4>>{{{1.0f, 0.0f, 0.0f, 1.0f}}});
+    out.emplace_back(MeshPrimitive::Lines, std::vector<UnsignedInt>{},
+        std::vector<std::vector<Vector3>>{{}},
+        std::vector<std::vector<Vector3>>{}, std::vector<std::vector<Vector2>>{},
+        std::vector<std::vector<Color4>>{});
+    return out;
+}
+
+void MeshBlobTest::serializeParse() {
+    const Containers::Array<char> blob = serializeMeshBlob(meshes(), {"first", "", "third one"});
+
+    const Containers::Optional<std::vector<MeshBlobView>> parsed = parseMeshBlob(blob);
+    CORRADE_VERIFY(parsed);
+    CORRADE_COMPARE(parsed->size(), 3);
+
+    const MeshBlobView& first = (*parsed)[0];
+    CORRADE_COMPARE((std::string{first.name.data(), first.name.size()}), "first");
+    CORRADE_COMPARE(first.primitive, MeshPrimitive::Triangles);
+    CORRADE_COMPARE(first.indices.size(), 6);
+    CORRADE_COMPARE(first.indices[3], 2);
+    CORRADE_COMPARE(first.positions.size(), 3);
+    CORRADE_COMPARE(first.positions[2], (Vector3{7.0f, 8.0f, 9.0f}));
+    CORRADE_COMPARE(first.normals.size(), 3);
+    CORRADE_COMPARE(first.normals[1], Vector3::yAxis());
+    CORRADE_COMPARE(first.textureCoords2D.size(), 3);
+    CORRADE_COMPARE(first.textureCoords2D[0], (Vector2{0.5f, 1.0f}));
+    CORRADE_VERIFY(first.colors.empty());
+
+    const MeshBlobView& second = (*parsed)[1];
+    CORRADE_VERIFY(second.name.empty());
+    CORRADE_COMPARE(second.primitive, MeshPrimitive::Points);
+    CORRADE_VERIFY(second.indices.empty());
+    CORRADE_COMPARE(second.positions.size(), 1);
+    CORRADE_VERIFY(second.normals.empty());
+    CORRADE_VERIFY(second.textureCoords2D.empty());
+    CORRADE_COMPARE(second.colors.size(), 1);
+    CORRADE_COMPARE(second.colors[0], (Color4{1.0f, 0.0f, 0.0f, 1.0f}));
+
+    const MeshBlobView& third = (*parsed)[2];
+    CORRADE_COMPARE((std::string{third.name.data(), third.name.size()}), "third one");
+    CORRADE_COMPARE(third.primitive, MeshPrimitive::Lines);
+    CORRADE_VERIFY(third.positions.empty());
+}
+
+void MeshBlobTest::serializeEmpty() {
+    const Containers::Array<char> blob = serializeMeshBlob({});
+    CORRADE_COMPARE(blob.size(), 16);
+
+    const Containers::Optional<std::vector<MeshBlobView>> parsed = parseMeshBlob(blob);
+    CORRADE_VERIFY(parsed);
+    CORRADE_VERIFY(parsed->empty());
+}
+
+void MeshBlobTest::serializeWrongNameCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    serializeMeshBlob(meshes(), {"a", "b"});
+    CORRADE_COMPARE(out.str(), "Trade::serializeMeshBlob(): expected 3 names but got 2\n");
+}
+
+void MeshBlobTest::serializeWrongAttributeCount() {
+    std::vector<MeshData3D> data;
+    data.emplace_back(MeshPrimitive::Points, std::vector<UnsignedInt>{},
+        std::vector<std::vector<Vector3>>{{{}, {}}},
+        std::vector<std::vector<Vector3>>{{{}}}, std::vector<std::vector<Vector2>>{},
+        std::vector<std::vector<Color4>>{});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    serializeMeshBlob(data);
+    CORRADE_COMPARE(out.str(), "Trade::serializeMeshBlob(): expected 2 normals in mesh 0 but got 1\n");
+}
+
+void MeshBlobTest::alignment() {
+    const Containers::Array<char> blob = serializeMeshBlob(meshes(), {"a", "bc", "def"});
+    const Containers::Optional<std::vector<MeshBlobView>> parsed = parseMeshBlob(blob);
+    CORRADE_VERIFY(parsed);
+
+    /* All arrays are aligned to 16 bytes relative to the blob start */
+    for(const MeshBlobView& mesh: *parsed) {
+        for(const void* data: {
+            static_cast<const void*>(mesh.name.data()),
+            static_cast<const void*>(mesh.indices.data()),
+            static_cast<const void*>(mesh.positions.data()),
+            static_cast<const void*>(mesh.normals.data()),
+            static_cast<const void*>(mesh.textureCoords2D.data()),
+            static_cast<const void*>(mesh.colors.data())}) {
+            if(!data) continue;
+            CORRADE_COMPARE((static_cast<const char*>(data) - blob.data()) % 16, 0);
+        }
+    }
+}
+
+void MeshBlobTest::toMeshData3D() {
+    const std::vector<MeshData3D> original = meshes();
+    const Containers::Array<char> blob = serializeMeshBlob(original);
+    const Containers::Optional<std::vector<MeshBlobView>> parsed = parseMeshBlob(blob);
+    CORRADE_VERIFY(parsed);
+
+    const int state{};
+    const MeshData3D first = (*parsed)[0].toMeshData3D(&state);
+    CORRADE_COMPARE(first.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(first.indices(), original[0].indices());
+    CORRADE_COMPARE(first.positionArrayCount(), 1);
+    CORRADE_COMPARE(first.positions(0), original[0].positions(0));
+    CORRADE_COMPARE(first.normalArrayCount(), 1);
+    CORRADE_COMPARE(first.normals(0), original[0].normals(0));
+    CORRADE_COMPARE(first.textureCoords2DArrayCount(), 1);
+    CORRADE_COMPARE(first.textureCoords2D(0), original[0].textureCoords2D(0));
+    CORRADE_COMPARE(first.colorArrayCount(), 0);
+    CORRADE_VERIFY(first.importerState() == &state);
+
+    const MeshData3D second = (*parsed)[1].toMeshData3D();
+    CORRADE_VERIFY(!second.isIndexed());
+    CORRADE_COMPARE(second.normalArrayCount(), 0);
+    CORRADE_COMPARE(second.colors(0), original[1].colors(0));
+}
+
+void MeshBlobTest::parseTooShort() {
+    const Containers::Array<char> blob = serializeMeshBlob(meshes());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!parseMeshBlob(blob.prefix(15)));
+    CORRADE_VERIFY(!parseMeshBlob(blob.prefix(100)));
+    CORRADE_COMPARE(out.str(),
+        "Trade::parseMeshBlob(): expected at least 16 bytes for a header but got 15\n"
+        "Trade::parseMeshBlob(): expected at least 208 bytes for 3 meshes but got 100\n");
+}
+
+void MeshBlobTest::parseInvalidSignature() {
+    Containers::Array<char> blob = serializeMeshBlob(meshes());
+    blob[0] = 'X';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!parseMeshBlob(blob));
+    CORRADE_COMPARE(out.str(), "Trade::parseMeshBlob(): invalid file signature\n");
+}
+
+void MeshBlobTest::parseInvalidVersion() {
+    Containers::Array<char> blob = serializeMeshBlob(meshes());
+    blob[8] = 2;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!parseMeshBlob(blob));
+    CORRADE_COMPARE(out.str(), "Trade::parseMeshBlob(): unsupported version 2, expected 1\n");
+}
+
+void MeshBlobTest::parseInvalidByteOrder() {
+    Containers::Array<char> blob = serializeMeshBlob(meshes());
+    std::swap(blob[10], blob[11]);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!parseMeshBlob(blob));
+    CORRADE_COMPARE(out.str(), "Trade::parseMeshBlob(): unsupported byte order\n");
+}
+
+void MeshBlobTest::parseInvalidPrimitive() {
+    Containers::Array<char> blob = serializeMeshBlob(meshes());
+    /* Primitive of the second mesh */
+    blob[16 + 64] = 100;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!parseMeshBlob(blob));
+    CORRADE_COMPARE(out.str(), "Trade::parseMeshBlob(): invalid primitive 100 in mesh 1\n");
+}
+
+void MeshBlobTest::parseOutOfBounds() {
+    const Containers::Array<char> blob = serializeMeshBlob(meshes());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!parseMeshBlob(blob.prefix(blob.size() - 1)));
+    CORRADE_COMPARE(out.str(), "Trade::parseMeshBlob(): colors of mesh 1 out of bounds\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshBlobTest)
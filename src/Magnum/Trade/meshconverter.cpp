@@ -0,0 +1,139 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshBlob.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum {
+
+/** @page magnum-meshconverter Mesh conversion utility
+@brief Converts meshes from any importer to a mesh blob
+
+@m_footernavigation
+@m_keywords{magnum-meshconverter meshconverter}
+
+This utility is built if both `WITH_TRADE` and `WITH_MESHCONVERTER` is enabled
+when building Magnum. To use this utility with CMake, you need to request the
+`meshconverter` component of the `Magnum` package and use the
+`Magnum::meshconverter` target for example in a custom command:
+
+@code{.cmake}
+find_package(Magnum REQUIRED meshconverter)
+
+add_custom_command(OUTPUT ... COMMAND Magnum::meshconverter ...)
+@endcode
+
+See @ref building, @ref cmake and the @ref Trade namespace for more
+information.
+
+@section magnum-meshconverter-usage Usage
+
+@code{.sh}
+magnum-meshconverter [-h|--help] [--importer IMPORTER] [--plugin-dir DIR]
+    [--] input output
+@endcode
+
+Arguments:
+
+-   `input` --- input file
+-   `output` --- output mesh blob
+-   `-h`, `--help` --- display this help message and exit
+-   `--importer IMPORTER` --- scene importer plugin (default:
+    @ref Trade::AnySceneImporter "AnySceneImporter")
+-   `--plugin-dir DIR` --- override base plugin dir
+
+All 3D meshes in the input file are imported and saved together with their
+names using @ref Trade::serializeMeshBlob(). The output can be then opened
+with the @ref Trade::MeshBlobImporter "MeshBlobImporter" plugin, which uses
+the memory-mapped data directly without any parsing.
+
+@section magnum-meshconverter-example Example usage
+
+Converting an OBJ file to a mesh blob:
+
+@code{.sh}
+magnum-meshconverter scene.obj scene.meshblob
+@endcode
+
+*/
+
+}
+
+using namespace Magnum;
+
+int main(int argc, char** argv) {
+    Utility::Arguments args;
+    args.addArgument("input").setHelp("input", "input file")
+        .addArgument("output").setHelp("output", "output mesh blob")
+        .addOption("importer", "AnySceneImporter").setHelp("importer", "scene importer plugin")
+        .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
+        .setGlobalHelp("Converts meshes from any importer to a mesh blob.")
+        .parse(argc, argv);
+
+    /* Load importer plugin */
+    PluginManager::Manager<Trade::AbstractImporter> importerManager{
+        args.value("plugin-dir").empty() ? std::string{} :
+        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths()[0])};
+    Containers::Pointer<Trade::AbstractImporter> importer = importerManager.loadAndInstantiate(args.value("importer"));
+    if(!importer) return 1;
+
+    /* Open input file */
+    if(!importer->openFile(args.value("input"))) {
+        Error() << "Cannot open file" << args.value("input");
+        return 2;
+    }
+
+    /* Import all meshes */
+    std::vector<Trade::MeshData3D> meshes;
+    std::vector<std::string> names;
+    meshes.reserve(importer->mesh3DCount());
+    names.reserve(importer->mesh3DCount());
+    for(UnsignedInt i = 0; i != importer->mesh3DCount(); ++i) {
+        Containers::Optional<Trade::MeshData3D> mesh = importer->mesh3D(i);
+        if(!mesh) {
+            Error() << "Cannot import mesh" << i << "from" << args.value("input");
+            return 3;
+        }
+
+        meshes.push_back(std::move(*mesh));
+        names.push_back(importer->mesh3DName(i));
+    }
+
+    Debug() << "Converting" << meshes.size() << "meshes to" << args.value("output");
+
+    /* Save output file */
+    const Containers::Array<char> blob = Trade::serializeMeshBlob(meshes, names);
+    if(!Utility::Directory::write(args.value("output"), blob)) {
+        Error() << "Cannot save file" << args.value("output");
+        return 4;
+    }
+}
@@ -101,6 +101,8 @@ void AnySceneImporter::doOpenFile(const std::string& filename) {
         plugin = "ModoImporter";
     else if(Utility::String::endsWith(normalized, ".ms3d"))
         plugin = "MilkshapeImporter";
+    else if(Utility::String::endsWith(normalized, ".meshblob"))
+        plugin = "MeshBlobImporter";
     else if(Utility::String::endsWith(normalized, ".obj"))
         plugin = "ObjImporter";
     else if(Utility::String::endsWith(normalized, ".xml"))
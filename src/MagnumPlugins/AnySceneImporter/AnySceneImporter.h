@@ -89,6 +89,8 @@ Supported formats:
 -   Modo (`*.lxo`), loaded with any plugin that provides `ModoImporter`
 -   Milkshape 3D (`*.ms3d`), loaded with any plugin that provides
     `MilkshapeImporter`
+-   Magnum mesh blob (`*.meshblob`), loaded with @ref MeshBlobImporter or any
+    other plugin that provides it
 -   Wavefront OBJ (`*.obj`), loaded with @ref ObjImporter or any other plugin
     that provides it
 -   Ogre XML (`*.xml`), loaded with any plugin that provides `OgreImporter`
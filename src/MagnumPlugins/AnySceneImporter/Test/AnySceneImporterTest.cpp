@@ -52,8 +52,11 @@ struct AnySceneImporterTest: TestSuite::Tester {
 constexpr struct {
     const char* name;
     const char* filename;
+    const char* plugin;
+    std::size_t positionCount;
 } LoadData[]{
-    {"OBJ", OBJ_FILE},
+    {"OBJ", OBJ_FILE, "ObjImporter", 3},
+    {"Magnum mesh blob", MESHBLOB_FILE, "MeshBlobImporter", 4}
 };
 
 constexpr struct {
@@ -88,6 +91,9 @@ AnySceneImporterTest::AnySceneImporterTest() {
     CORRADE_INTERNAL_ASSERT(_manager.load(ANYSCENEIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
     #endif
     /* Optional plugins that don't have to be here */
+    #ifdef MESHBLOBIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_manager.load(MESHBLOBIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
     #ifdef OBJIMPORTER_PLUGIN_FILENAME
     CORRADE_INTERNAL_ASSERT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
     #endif
@@ -97,8 +103,8 @@ void AnySceneImporterTest::load() {
     auto&& data = LoadData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
 
-    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
-        CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
+    if(!(_manager.loadState(data.plugin) & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP(Utility::formatString("{} plugin not enabled, cannot test", data.plugin));
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
     CORRADE_VERIFY(importer->openFile(data.filename));
@@ -106,7 +112,7 @@ void AnySceneImporterTest::load() {
     /* Check only size, as it is good enough proof that it is working */
     Containers::Optional<MeshData3D> mesh = importer->mesh3D(0);
     CORRADE_VERIFY(mesh);
-    CORRADE_COMPARE(mesh->positions(0).size(), 3);
+    CORRADE_COMPARE(mesh->positions(0).size(), data.positionCount);
 
     importer->close();
     CORRADE_VERIFY(!importer->isOpened());
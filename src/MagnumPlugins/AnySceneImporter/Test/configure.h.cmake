@@ -24,5 +24,7 @@
 */
 
 #cmakedefine ANYSCENEIMPORTER_PLUGIN_FILENAME "${ANYSCENEIMPORTER_PLUGIN_FILENAME}"
+#cmakedefine MESHBLOBIMPORTER_PLUGIN_FILENAME "${MESHBLOBIMPORTER_PLUGIN_FILENAME}"
 #cmakedefine OBJIMPORTER_PLUGIN_FILENAME "${OBJIMPORTER_PLUGIN_FILENAME}"
+#define MESHBLOB_FILE "${MESHBLOB_FILE}"
 #define OBJ_FILE "${OBJ_FILE}"
@@ -0,0 +1,143 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshBlobImporter.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace Trade {
+
+struct MeshBlobImporter::File {
+    /* Memory-mapped file or a copy of the data passed to openData(), `data`
+       points to whichever is used */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Utility::Directory::MapDeleter> mapped;
+    #endif
+    Containers::Array<char> copy;
+    Containers::ArrayView<const char> data;
+
+    std::vector<MeshBlobView> meshes;
+    std::unordered_map<std::string, UnsignedInt> meshesForName;
+};
+
+MeshBlobImporter::MeshBlobImporter() = default;
+
+MeshBlobImporter::MeshBlobImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+MeshBlobImporter::~MeshBlobImporter() = default;
+
+auto MeshBlobImporter::doFeatures() const -> Features { return Feature::OpenData; }
+
+void MeshBlobImporter::doClose() { _file.reset(); }
+
+bool MeshBlobImporter::doIsOpened() const { return !!_file; }
+
+void MeshBlobImporter::doOpenFile(const std::string& filename) {
+    if(!Utility::Directory::exists(filename)) {
+        Error() << "Trade::MeshBlobImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    Containers::Pointer<File> file{new File};
+
+    /* Memory-map the file so the data can be used directly without reading
+       them upfront. Mapping fails for empty files, in which case we fall back
+       to reading it so the error is reported by the parser. */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    {
+        Error silenceError{nullptr};
+        file->mapped = Utility::Directory::mapRead(filename);
+    }
+    if(file->mapped) file->data = file->mapped;
+    else
+    #endif
+    {
+        file->copy = Utility::Directory::read(filename);
+        file->data = file->copy;
+    }
+
+    openInternal(std::move(file));
+}
+
+void MeshBlobImporter::doOpenData(Containers::ArrayView<const char> data) {
+    Containers::Pointer<File> file{new File};
+
+    /* The data are not guaranteed to stay in scope after this function
+       returns, so we need to make a copy. That also makes them properly
+       aligned. */
+    file->copy = Containers::Array<char>{Containers::NoInit, data.size()};
+    if(data.size()) std::memcpy(file->copy.data(), data.data(), data.size());
+    file->data = file->copy;
+
+    openInternal(std::move(file));
+}
+
+void MeshBlobImporter::openInternal(Containers::Pointer<File> file) {
+    /* Error message printed by the parser already */
+    Containers::Optional<std::vector<MeshBlobView>> meshes = parseMeshBlob(file->data);
+    if(!meshes) return;
+
+    file->meshes = std::move(*meshes);
+    for(std::size_t i = 0; i != file->meshes.size(); ++i) {
+        const Containers::ArrayView<const char> name = file->meshes[i].name;
+        if(!name.empty()) file->meshesForName.emplace(std::string{name.data(), name.size()}, i);
+    }
+
+    _file = std::move(file);
+}
+
+Containers::ArrayView<const MeshBlobView> MeshBlobImporter::meshViews() const {
+    CORRADE_ASSERT(_file, "Trade::MeshBlobImporter::meshViews(): no file opened", {});
+    return {_file->meshes.data(), _file->meshes.size()};
+}
+
+UnsignedInt MeshBlobImporter::doMesh3DCount() const { return _file->meshes.size(); }
+
+Int MeshBlobImporter::doMesh3DForName(const std::string& name) {
+    const auto it = _file->meshesForName.find(name);
+    return it == _file->meshesForName.end() ? -1 : it->second;
+}
+
+std::string MeshBlobImporter::doMesh3DName(const UnsignedInt id) {
+    const Containers::ArrayView<const char> name = _file->meshes[id].name;
+    return name.empty() ? std::string{} : std::string{name.data(), name.size()};
+}
+
+Containers::Optional<MeshData3D> MeshBlobImporter::doMesh3D(const UnsignedInt id) {
+    return _file->meshes[id].toMeshData3D(&_file->meshes[id]);
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MeshBlobImporter, Magnum::Trade::MeshBlobImporter,
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3")
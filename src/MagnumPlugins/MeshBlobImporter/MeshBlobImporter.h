@@ -0,0 +1,132 @@
+#ifndef Magnum_Trade_MeshBlobImporter_h
+#define Magnum_Trade_MeshBlobImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MeshBlobImporter
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshBlob.h"
+
+#include "MagnumPlugins/MeshBlobImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MESHBLOBIMPORTER_BUILD_STATIC
+    #ifdef MeshBlobImporter_EXPORTS
+        #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MESHBLOBIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MESHBLOBIMPORTER_EXPORT
+#define MAGNUM_MESHBLOBIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Mesh blob importer plugin
+
+Loads Magnum mesh blobs (`*.meshblob`) produced by @ref serializeMeshBlob()
+or the @ref magnum-meshconverter "magnum-meshconverter" utility, with the
+following supported features:
+
+-   multiple named meshes
+-   indices, vertex positions, normals, 2D texture coordinates and colors
+-   all primitive types
+
+This plugin depends on the @ref Trade library and is built if
+`WITH_MESHBLOBIMPORTER` is enabled when building Magnum. To use as a dynamic
+plugin, you need to load the @cpp "MeshBlobImporter" @ce plugin from
+`MAGNUM_PLUGINS_IMPORTER_DIR`. To use as a static plugin or as a dependency of
+another plugin with CMake, you need to request the `MeshBlobImporter`
+component of the `Magnum` package and link to the `Magnum::MeshBlobImporter`
+target. See @ref building, @ref cmake and @ref plugins for more information.
+
+@section Trade-MeshBlobImporter-behavior Behavior and limitations
+
+Files opened with @ref openFile() are memory-mapped on platforms that support
+it, data passed to @ref openData() are copied as the importer can't rely on
+them staying in scope. Opening a file only validates the header, no data are
+read until accessed. @ref mesh3D() copies the data into a @ref MeshData3D for
+compatibility with other importers, use @ref meshViews() to access the data
+directly without any copies. The @ref MeshData3D::importerState() of imported
+meshes points to the corresponding @ref MeshBlobView, which makes the views
+accessible also when the plugin is loaded dynamically.
+
+The blob is stored in the byte order of the machine that created it, blobs
+created on a machine with different endianness are rejected.
+*/
+class MAGNUM_MESHBLOBIMPORTER_EXPORT MeshBlobImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit MeshBlobImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit MeshBlobImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MeshBlobImporter();
+
+        /**
+         * @brief Views on all meshes in the file
+         *
+         * Expects that a file is opened. The views point directly to the
+         * memory-mapped file and are valid until the file is closed or
+         * another file is opened.
+         */
+        Containers::ArrayView<const MeshBlobView> meshViews() const;
+
+    private:
+        struct File;
+
+        MAGNUM_MESHBLOBIMPORTER_LOCAL Features doFeatures() const override;
+
+        MAGNUM_MESHBLOBIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_MESHBLOBIMPORTER_LOCAL UnsignedInt doMesh3DCount() const override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL Int doMesh3DForName(const std::string& name) override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL std::string doMesh3DName(UnsignedInt id) override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL Containers::Optional<MeshData3D> doMesh3D(UnsignedInt id) override;
+
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void openInternal(Containers::Pointer<File> file);
+
+        Containers::Pointer<File> _file;
+};
+
+}}
+
+#endif
@@ -0,0 +1,212 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshBlob.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+#ifndef MESHBLOBIMPORTER_PLUGIN_FILENAME
+#include "MagnumPlugins/MeshBlobImporter/MeshBlobImporter.h"
+#endif
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MeshBlobImporterTest: TestSuite::Tester {
+    explicit MeshBlobImporterTest();
+
+    void openFile();
+    void openData();
+    void openFileNonexistent();
+    void openDataInvalid();
+
+    void names();
+    void views();
+    void importerState();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+MeshBlobImporterTest::MeshBlobImporterTest() {
+    addTests({&MeshBlobImporterTest::openFile,
+              &MeshBlobImporterTest::openData,
+              &MeshBlobImporterTest::openFileNonexistent,
+              &MeshBlobImporterTest::openDataInvalid,
+
+              &MeshBlobImporterTest::names,
+              &MeshBlobImporterTest::views,
+              &MeshBlobImporterTest::importerState});
+
+    #ifdef MESHBLOBIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_manager.load(MESHBLOBIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MeshBlobImporterTest::openFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.meshblob")));
+    CORRADE_COMPARE(importer->mesh3DCount(), 2);
+
+    const Containers::Optional<MeshData3D> quad = importer->mesh3D(0);
+    CORRADE_VERIFY(quad);
+    CORRADE_COMPARE(quad->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(quad->indices(), (std::vector<UnsignedInt>{
+        0, 1, 2, 0, 2, 3
+    }));
+    CORRADE_COMPARE(quad->positionArrayCount(), 1);
+    CORRADE_COMPARE(quad->positions(0), (std::vector<Vector3>{
+        {-1.0f, -1.0f, 0.0f},
+        { 1.0f, -1.0f, 0.0f},
+        { 1.0f,  1.0f, 0.0f},
+        {-1.0f,  1.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(quad->normalArrayCount(), 1);
+    CORRADE_COMPARE(quad->normals(0), std::vector<Vector3>(4, Vector3::zAxis()));
+    CORRADE_COMPARE(quad->textureCoords2DArrayCount(), 1);
+    CORRADE_COMPARE(quad->textureCoords2D(0), (std::vector<Vector2>{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 1.0f}
+    }));
+    CORRADE_VERIFY(!quad->hasColors());
+
+    const Containers::Optional<MeshData3D> points = importer->mesh3D(1);
+    CORRADE_VERIFY(points);
+    CORRADE_COMPARE(points->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!points->isIndexed());
+    CORRADE_COMPARE(points->positions(0), (std::vector<Vector3>{
+        {0.5f, 2.0f, 3.0f},
+        {0.0f, 1.5f, 1.0f}
+    }));
+    CORRADE_VERIFY(!points->hasNormals());
+    CORRADE_VERIFY(!points->hasTextureCoords2D());
+    CORRADE_COMPARE(points->colorArrayCount(), 1);
+    CORRADE_COMPARE(points->colors(0), (std::vector<Color4>{
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {0.0f, 0.5f, 1.0f, 0.25f}
+    }));
+}
+
+void MeshBlobImporterTest::openData() {
+    std::vector<MeshData3D> meshes;
+    meshes.emplace_back(MeshPrimitive::LineStrip, std::vector<UnsignedInt>{},
+        std::vector<std::vector<Vector3>>{{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}}},
+        std::vector<std::vector<Vector3>>{}, std::vector<std::vector<Vector2>>{},
+        std::vector<std::vector<Color4>>{});
+    const Containers::Array<char> blob = serializeMeshBlob(meshes);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+    CORRADE_VERIFY(importer->openData(blob));
+    CORRADE_COMPARE(importer->mesh3DCount(), 1);
+    CORRADE_COMPARE(importer->mesh3DName(0), "");
+
+    const Containers::Optional<MeshData3D> mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::LineStrip);
+    CORRADE_COMPARE(mesh->positions(0), meshes[0].positions(0));
+}
+
+void MeshBlobImporterTest::openFileNonexistent() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openFile("nonexistent.meshblob"));
+    CORRADE_COMPARE(out.str(), "Trade::MeshBlobImporter::openFile(): cannot open file nonexistent.meshblob\n");
+}
+
+void MeshBlobImporterTest::openDataInvalid() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData({"MGNMESHA\x01\x00\xff\xfe\x00\x00\x00\x00", 16}));
+    CORRADE_VERIFY(!importer->openData({"MGNMESHB", 8}));
+    CORRADE_VERIFY(!importer->isOpened());
+    CORRADE_COMPARE(out.str(),
+        "Trade::parseMeshBlob(): invalid file signature\n"
+        "Trade::parseMeshBlob(): expected at least 16 bytes for a header but got 8\n");
+}
+
+void MeshBlobImporterTest::names() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.meshblob")));
+    CORRADE_COMPARE(importer->mesh3DName(0), "Quad");
+    CORRADE_COMPARE(importer->mesh3DName(1), "Points");
+    CORRADE_COMPARE(importer->mesh3DForName("Points"), 1);
+    CORRADE_COMPARE(importer->mesh3DForName("Nonexistent"), -1);
+}
+
+void MeshBlobImporterTest::views() {
+    #ifdef MESHBLOBIMPORTER_PLUGIN_FILENAME
+    CORRADE_SKIP("MeshBlobImporter::meshViews() can be called only if the plugin is linked statically.");
+    #else
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.meshblob")));
+
+    const Containers::ArrayView<const MeshBlobView> views = static_cast<MeshBlobImporter&>(*importer).meshViews();
+    CORRADE_COMPARE(views.size(), 2);
+    CORRADE_COMPARE(views[0].primitive, MeshPrimitive::Triangles);
+    CORRADE_COMPARE(std::vector<UnsignedInt>(views[0].indices.begin(), views[0].indices.end()), (std::vector<UnsignedInt>{
+        0, 1, 2, 0, 2, 3
+    }));
+    CORRADE_COMPARE(views[0].positions.size(), 4);
+    CORRADE_COMPARE(views[0].positions[2], (Vector3{1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(views[1].colors.size(), 2);
+    CORRADE_COMPARE(views[1].colors[1], (Color4{0.0f, 0.5f, 1.0f, 0.25f}));
+    CORRADE_VERIFY(views[1].normals.empty());
+    #endif
+}
+
+void MeshBlobImporterTest::importerState() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshBlobImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "mesh.meshblob")));
+
+    const Containers::Optional<MeshData3D> mesh = importer->mesh3D(1);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(mesh->importerState());
+
+    /* The view points to the same data as were copied to the mesh */
+    const MeshBlobView& view = *static_cast<const MeshBlobView*>(mesh->importerState());
+    CORRADE_COMPARE(view.primitive, MeshPrimitive::Points);
+    CORRADE_COMPARE(view.positions.size(), 2);
+    CORRADE_COMPARE(view.positions[0], mesh->positions(0)[0]);
+    CORRADE_VERIFY(view.positions.data() != mesh->positions(0).data());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshBlobImporterTest)
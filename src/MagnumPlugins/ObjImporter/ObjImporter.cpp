@@ -25,13 +25,16 @@
 
 #include "ObjImporter.h"
 
-#include <fstream>
-#include <limits>
-#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
 #include <unordered_map>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
-#include <Corrade/Utility/String.h>
+#include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshTools/CombineIndexedArrays.h"
@@ -41,196 +44,211 @@
 
 namespace Magnum { namespace Trade {
 
+namespace {
+
+/* Byte range of one mesh in the file together with index offsets and element
+   counts gathered during the indexing pass in parseMeshNames() */
+struct MeshRange {
+    std::size_t begin, end;
+    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
+    UnsignedInt positionCount, textureCoordinateCount, normalCount, primitiveCount;
+};
+
+}
+
 struct ObjImporter::File {
     std::unordered_map<std::string, UnsignedInt> meshesForName;
     std::vector<std::string> meshNames;
-    std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    Containers::Pointer<std::istream> in;
+    std::vector<MeshRange> meshes;
+
+    /* Memory-mapped file or a copy of the data passed to openData(), `data`
+       points to whichever is used */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Utility::Directory::MapDeleter> mapped;
+    #endif
+    Containers::Array<char> copy;
+    Containers::ArrayView<const char> data;
 };
 
 namespace {
 
-void ignoreLine(std::istream& in) {
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
 }
 
-template<std::size_t size> Math::Vector<size, Float> extractFloatData(const std::string& str, Float* extra = nullptr) {
-    std::vector<std::string> data = Utility::String::splitWithoutEmptyParts(str, ' ');
-    if(data.size() < size || data.size() > size + (extra ? 1 : 0)) {
-        Error() << "Trade::ObjImporter::mesh3D(): invalid float array size";
-        throw 0;
-    }
-
-    Math::Vector<size, Float> output;
-
-    for(std::size_t i = 0; i != size; ++i)
-        output[i] = std::stof(data[i]);
-
-    if(data.size() == size+1) {
-        /* This should be obvious from the first if, but add this just to make
-           Clang Analyzer happy */
-        CORRADE_INTERNAL_ASSERT(extra);
-
-        *extra = std::stof(data.back());
-    }
-
-    return output;
+inline bool isDigit(const char c) {
+    return UnsignedInt(c - '0') < 10;
 }
 
-template<class T> void reindex(const std::vector<UnsignedInt>& indices, std::vector<T>& data) {
-    /* Check that indices are in range */
-    for(UnsignedInt i: indices) if(i >= data.size()) {
-        Error() << "Trade::ObjImporter::mesh3D(): index out of range";
-        throw 0;
-    }
-
-    data = MeshTools::duplicate(indices, data);
+inline const char* findLineEnd(const char* const it, const char* const end) {
+    const void* found = std::memchr(it, '\n', end - it);
+    return found ? static_cast<const char*>(found) : end;
 }
 
+inline const char* skipWhitespace(const char* it, const char* const end) {
+    while(it != end && isWhitespace(*it)) ++it;
+    return it;
 }
 
-ObjImporter::ObjImporter() = default;
-
-ObjImporter::ObjImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
-
-ObjImporter::~ObjImporter() = default;
-
-auto ObjImporter::doFeatures() const -> Features { return Feature::OpenData; }
+inline const char* findWhitespace(const char* it, const char* const end) {
+    while(it != end && !isWhitespace(*it)) ++it;
+    return it;
+}
 
-void ObjImporter::doClose() { _file.reset(); }
+inline const char* trimmedEnd(const char* const begin, const char* end) {
+    while(end != begin && isWhitespace(*(end - 1))) --end;
+    return end;
+}
 
-bool ObjImporter::doIsOpened() const { return !!_file; }
+template<std::size_t size> inline bool equals(const char* const begin, const char* const end, const char(&string)[size]) {
+    return std::size_t(end - begin) == size - 1 && std::memcmp(begin, string, size - 1) == 0;
+}
 
-void ObjImporter::doOpenFile(const std::string& filename) {
-    Containers::Pointer<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
-        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
-        return;
+std::size_t countTokens(const char* it, const char* const end) {
+    std::size_t count = 0;
+    while((it = skipWhitespace(it, end)) != end) {
+        it = findWhitespace(it, end);
+        ++count;
     }
-
-    _file.reset(new File);
-    _file->in = std::move(in);
-    parseMeshNames();
+    return count;
 }
 
-void ObjImporter::doOpenData(Containers::ArrayView<const char> data) {
-    _file.reset(new File);
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+/* Parses an unsigned integer spanning the whole [begin, end) range, without
+   any allocations. Returns false if the range is empty, contains anything
+   else than digits or the value doesn't fit into 32 bits. */
+bool parseUnsignedInt(const char* it, const char* const end, UnsignedInt& out) {
+    if(it == end) return false;
+
+    UnsignedLong value = 0;
+    for(; it != end; ++it) {
+        if(!isDigit(*it)) return false;
+        value = value*10 + (*it - '0');
+        if(value > 0xffffffffull) return false;
+    }
 
-    parseMeshNames();
+    out = UnsignedInt(value);
+    return true;
 }
 
-void ObjImporter::parseMeshNames() {
-    /* First mesh starts at the beginning, its indices start from 1. The end
-       offset will be updated to proper value later. */
-    UnsignedInt positionIndexOffset = 1;
-    UnsignedInt normalIndexOffset = 1;
-    UnsignedInt textureCoordinateIndexOffset = 1;
-    _file->meshes.emplace_back(0, 0, positionIndexOffset, normalIndexOffset, textureCoordinateIndexOffset);
-
-    /* The first mesh doesn't have name by default but we might find it later,
-       so we need to track whether there are any data before first name */
-    bool thisIsFirstMeshAndItHasNoData = true;
-    _file->meshNames.emplace_back();
+/* Powers of ten that are exactly representable in a double */
+constexpr Double PowersOfTen[]{
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+    1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18,
+    1.0e19, 1.0e20, 1.0e21, 1.0e22};
+
+/* Parses a decimal floating-point number spanning the whole [begin, end)
+   range, without any allocations. Up to 19 significant digits are kept in an
+   integer mantissa, which is then scaled by an exact power of ten, giving a
+   correctly rounded result for all practical inputs. */
+bool parseFloat(const char* it, const char* const end, Float& out) {
+    bool negative = false;
+    if(it != end && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
 
-    while(_file->in->good()) {
-        /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
+    UnsignedLong mantissa = 0;
+    Int exponent = 0;
+    Int significantDigits = 0;
+    bool hasDigits = false;
+
+    /* Integral part, digits that don't fit into the mantissa only scale it */
+    for(; it != end && isDigit(*it); ++it) {
+        hasDigits = true;
+        if(significantDigits < 19) {
+            mantissa = mantissa*10 + (*it - '0');
+            if(mantissa) ++significantDigits;
+        } else ++exponent;
+    }
 
-        /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
+    /* Fractional part, digits that don't fit into the mantissa are dropped */
+    if(it != end && *it == '.') for(++it; it != end && isDigit(*it); ++it) {
+        hasDigits = true;
+        if(significantDigits < 19) {
+            mantissa = mantissa*10 + (*it - '0');
+            if(mantissa) ++significantDigits;
+            --exponent;
         }
+    }
 
-        /* Parse the keyword */
-        std::string keyword;
-        *_file->in >> keyword;
-
-        /* Mesh name */
-        if(keyword == "o") {
-            std::string name;
-            std::getline(*_file->in, name);
-            name = Utility::String::trim(name);
-
-            /* This is the name of first mesh */
-            if(thisIsFirstMeshAndItHasNoData) {
-                thisIsFirstMeshAndItHasNoData = false;
+    if(!hasDigits) return false;
 
-                /* Update its name and add it to name map */
-                if(!name.empty())
-                    _file->meshesForName.emplace(name, _file->meshes.size() - 1);
-                _file->meshNames.back() = std::move(name);
+    /* Exponent */
+    if(it != end && (*it == 'e' || *it == 'E')) {
+        ++it;
+        bool negativeExponent = false;
+        if(it != end && (*it == '-' || *it == '+')) {
+            negativeExponent = *it == '-';
+            ++it;
+        }
 
-                /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+        if(it == end) return false;
 
-            /* Otherwise this is a name of new mesh */
-            } else {
-                /* Set end of the previous one */
-                std::get<1>(_file->meshes.back()) = end;
+        Int value = 0;
+        for(; it != end && isDigit(*it); ++it)
+            if(value < 100000) value = value*10 + (*it - '0');
+        exponent += negativeExponent ? -value : value;
+    }
 
-                /* Save name and offset of the new one. The end offset will be
-                   updated later. */
-                if(!name.empty())
-                    _file->meshesForName.emplace(name, _file->meshes.size());
-                _file->meshNames.emplace_back(std::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
-            }
+    /* Trailing garbage */
+    if(it != end) return false;
 
-            continue;
+    Double value = Double(mantissa);
+    if(exponent < 0)
+        value /= exponent >= -22 ? PowersOfTen[-exponent] : std::pow(10.0, -exponent);
+    else if(exponent > 0)
+        value *= exponent <= 22 ? PowersOfTen[exponent] : std::pow(10.0, exponent);
 
-        /* If there are any data/indices before the first name, it means that
-           the first object is unnamed. We need to check for them. */
+    out = Float(negative ? -value : value);
+    return true;
+}
 
-        /* Vertex data, update index offset for the following meshes */
-        } else if(keyword == "v") {
-            ++positionIndexOffset;
-            thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vt") {
-            ++textureCoordinateIndexOffset;
-            thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vn") {
-            ++normalIndexOffset;
-            thisIsFirstMeshAndItHasNoData = false;
+/* Extracts `size` whitespace-separated floats from the line, plus one
+   optional extra value if `extra` is non-null. Prints a message and returns
+   false on error. */
+template<std::size_t size> bool extractFloatData(const char* it, const char* const end, Math::Vector<size, Float>& output, Float* extra = nullptr) {
+    std::size_t count = 0;
+    bool valid = true;
+    while((it = skipWhitespace(it, end)) != end) {
+        const char* const tokenEnd = findWhitespace(it, end);
+
+        /* Convert only as long as there's space for the value, the count
+           error takes precedence over a conversion error */
+        if(count < size)
+            valid = valid && parseFloat(it, tokenEnd, output[count]);
+        else if(count == size && extra)
+            valid = valid && parseFloat(it, tokenEnd, *extra);
+
+        ++count;
+        it = tokenEnd;
+    }
 
-        /* Index data, just mark that we found something for first unnamed
-           object */
-        } else if(thisIsFirstMeshAndItHasNoData) for(const std::string& data: {"p", "l", "f"}) {
-            if(keyword == data) {
-                thisIsFirstMeshAndItHasNoData = false;
-                break;
-            }
-        }
+    if(count < size || count > size + (extra ? 1 : 0)) {
+        Error() << "Trade::ObjImporter::mesh3D(): invalid float array size";
+        return false;
+    }
 
-        /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
+    if(!valid) {
+        Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+        return false;
     }
 
-    /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    return true;
 }
 
-UnsignedInt ObjImporter::doMesh3DCount() const { return _file->meshes.size(); }
-
-Int ObjImporter::doMesh3DForName(const std::string& name) {
-    const auto it = _file->meshesForName.find(name);
-    return it == _file->meshesForName.end() ? -1 : it->second;
-}
+template<class T> void reindex(const std::vector<UnsignedInt>& indices, std::vector<T>& data) {
+    /* Check that indices are in range */
+    for(UnsignedInt i: indices) if(i >= data.size()) {
+        Error() << "Trade::ObjImporter::mesh3D(): index out of range";
+        throw 0;
+    }
 
-std::string ObjImporter::doMesh3DName(UnsignedInt id) {
-    return _file->meshNames[id];
+    data = MeshTools::duplicate(indices, data);
 }
 
-Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
-    /* Seek the file, set mesh parsing parameters */
-    std::streampos begin, end;
-    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
-    std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
-
+/* Parses a single mesh out of given file data. Doesn't touch any importer
+   state, so it's safe to call it from multiple threads at once. */
+Containers::Optional<MeshData3D> parseMesh(const Containers::ArrayView<const char> data, const MeshRange& range) {
     Containers::Optional<MeshPrimitive> primitive;
     std::vector<Vector3> positions;
     std::vector<std::vector<Vector2>> textureCoordinates;
@@ -239,61 +257,75 @@ Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
     std::vector<UnsignedInt> textureCoordinateIndices;
     std::vector<UnsignedInt> normalIndices;
 
-    try { while(_file->in->good() && _file->in->tellg() < end) {
-        /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
-
-        /* Get the line */
-        std::string line;
-        std::getline(*_file->in, line);
-        line = Utility::String::trim(line);
+    /* Reserve memory based on counts gathered during the indexing pass. The
+       primitive count is an upper bound for index count of triangles, lines
+       and points alike. */
+    positions.reserve(range.positionCount);
+    if(range.textureCoordinateCount) {
+        textureCoordinates.emplace_back();
+        textureCoordinates.front().reserve(range.textureCoordinateCount);
+    }
+    if(range.normalCount) {
+        normals.emplace_back();
+        normals.front().reserve(range.normalCount);
+    }
+    positionIndices.reserve(range.primitiveCount*3);
 
-        /* Ignore empty lines */
-        if(line.empty()) continue;
+    const char* const end = data.begin() + range.end;
+    for(const char* it = data.begin() + range.begin; it < end; ) {
+        const char* const lineEnd = findLineEnd(it, end);
+        const char* const keywordBegin = skipWhitespace(it, lineEnd);
+        const char* const keywordEnd = findWhitespace(keywordBegin, lineEnd);
+        const char* const contents = keywordEnd;
+        it = lineEnd == end ? end : lineEnd + 1;
 
-        /* Split the line into keyword and contents */
-        const std::size_t keywordEnd = line.find(' ');
-        const std::string keyword = line.substr(0, keywordEnd);
-        const std::string contents = keywordEnd != std::string::npos ?
-            Utility::String::ltrim(line.substr(keywordEnd+1)) : "";
+        /* Ignore empty lines and comments */
+        if(keywordBegin == keywordEnd || *keywordBegin == '#') continue;
 
         /* Vertex position */
-        if(keyword == "v") {
+        if(equals(keywordBegin, keywordEnd, "v")) {
             Float extra{1.0f};
-            const Vector3 data = extractFloatData<3>(contents, &extra);
+            Vector3 position{Math::NoInit};
+            if(!extractFloatData<3>(contents, lineEnd, position, &extra))
+                return Containers::NullOpt;
             if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
                 Error() << "Trade::ObjImporter::mesh3D(): homogeneous coordinates are not supported";
                 return Containers::NullOpt;
             }
 
-            positions.push_back(data);
+            positions.push_back(position);
 
         /* Texture coordinate */
-        } else if(keyword == "vt") {
+        } else if(equals(keywordBegin, keywordEnd, "vt")) {
             Float extra{0.0f};
-            const auto data = extractFloatData<2>(contents, &extra);
+            Vector2 textureCoordinate{Math::NoInit};
+            if(!extractFloatData<2>(contents, lineEnd, textureCoordinate, &extra))
+                return Containers::NullOpt;
             if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
                 Error() << "Trade::ObjImporter::mesh3D(): 3D texture coordinates are not supported";
                 return Containers::NullOpt;
             }
 
             if(textureCoordinates.empty()) textureCoordinates.emplace_back();
-            textureCoordinates.front().emplace_back(data);
+            textureCoordinates.front().emplace_back(textureCoordinate);
 
         /* Normal */
-        } else if(keyword == "vn") {
+        } else if(equals(keywordBegin, keywordEnd, "vn")) {
+            Vector3 normal{Math::NoInit};
+            if(!extractFloatData<3>(contents, lineEnd, normal))
+                return Containers::NullOpt;
+
             if(normals.empty()) normals.emplace_back();
-            normals.front().emplace_back(extractFloatData<3>(contents));
+            normals.front().emplace_back(normal);
 
         /* Indices */
-        } else if(keyword == "p" || keyword == "l" || keyword == "f") {
-            const std::vector<std::string> indexTuples = Utility::String::splitWithoutEmptyParts(contents, ' ');
+        } else if(equals(keywordBegin, keywordEnd, "p") ||
+                  equals(keywordBegin, keywordEnd, "l") ||
+                  equals(keywordBegin, keywordEnd, "f")) {
+            const std::size_t indexTupleCount = countTokens(contents, lineEnd);
 
             /* Points */
-            if(keyword == "p") {
+            if(*keywordBegin == 'p') {
                 /* Check that we don't mix the primitives in one mesh */
                 if(primitive && primitive != MeshPrimitive::Points) {
                     Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
@@ -301,7 +333,7 @@ Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() != 1) {
+                if(indexTupleCount != 1) {
                     Error() << "Trade::ObjImporter::mesh3D(): wrong index count for point";
                     return Containers::NullOpt;
                 }
@@ -309,7 +341,7 @@ Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
                 primitive = MeshPrimitive::Points;
 
             /* Lines */
-            } else if(keyword == "l") {
+            } else if(*keywordBegin == 'l') {
                 /* Check that we don't mix the primitives in one mesh */
                 if(primitive && primitive != MeshPrimitive::Lines) {
                     Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
@@ -317,7 +349,7 @@ Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() != 2) {
+                if(indexTupleCount != 2) {
                     Error() << "Trade::ObjImporter::mesh3D(): wrong index count for line";
                     return Containers::NullOpt;
                 }
@@ -325,7 +357,7 @@ Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
                 primitive = MeshPrimitive::Lines;
 
             /* Faces */
-            } else if(keyword == "f") {
+            } else if(*keywordBegin == 'f') {
                 /* Check that we don't mix the primitives in one mesh */
                 if(primitive && primitive != MeshPrimitive::Triangles) {
                     Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
@@ -333,10 +365,10 @@ Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() < 3) {
+                if(indexTupleCount < 3) {
                     Error() << "Trade::ObjImporter::mesh3D(): wrong index count for triangle";
                     return Containers::NullOpt;
-                } else if(indexTuples.size() != 3) {
+                } else if(indexTupleCount != 3) {
                     Error() << "Trade::ObjImporter::mesh3D(): polygons are not supported";
                     return Containers::NullOpt;
                 }
@@ -345,42 +377,59 @@ Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
 
             } else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 
-            for(const std::string& indexTuple: indexTuples) {
-                std::vector<std::string> indices = Utility::String::split(indexTuple, '/');
-                if(indices.size() > 3) {
-                    Error() << "Trade::ObjImporter::mesh3D(): invalid index data";
-                    return Containers::NullOpt;
+            for(const char* tuple = contents; (tuple = skipWhitespace(tuple, lineEnd)) != lineEnd; ) {
+                const char* const tupleEnd = findWhitespace(tuple, lineEnd);
+
+                /* Split the tuple on slashes, without allocating */
+                const char* parts[4];
+                std::size_t partCount = 1;
+                parts[0] = tuple;
+                for(const char* i = tuple; i != tupleEnd; ++i) if(*i == '/') {
+                    if(partCount == 3) {
+                        Error() << "Trade::ObjImporter::mesh3D(): invalid index data";
+                        return Containers::NullOpt;
+                    }
+                    parts[partCount++] = i + 1;
                 }
+                parts[partCount] = tupleEnd + 1;
 
                 /* Position indices */
-                positionIndices.push_back(std::stoul(indices[0]) - positionIndexOffset);
+                UnsignedInt index;
+                if(!parseUnsignedInt(parts[0], parts[1] - 1, index)) {
+                    Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+                    return Containers::NullOpt;
+                }
+                positionIndices.push_back(index - range.positionIndexOffset);
 
                 /* Texture coordinates */
-                if(indices.size() == 2 || (indices.size() == 3 && !indices[1].empty()))
-                    textureCoordinateIndices.push_back(std::stoul(indices[1]) - textureCoordinateIndexOffset);
+                if(partCount == 2 || (partCount == 3 && parts[2] - 1 != parts[1])) {
+                    if(!parseUnsignedInt(parts[1], parts[2] - 1, index)) {
+                        Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+                        return Containers::NullOpt;
+                    }
+                    textureCoordinateIndices.push_back(index - range.textureCoordinateIndexOffset);
+                }
 
                 /* Normal indices */
-                if(indices.size() == 3)
-                    normalIndices.push_back(std::stoul(indices[2]) - normalIndexOffset);
+                if(partCount == 3) {
+                    if(!parseUnsignedInt(parts[2], parts[3] - 1, index)) {
+                        Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+                        return Containers::NullOpt;
+                    }
+                    normalIndices.push_back(index - range.normalIndexOffset);
+                }
+
+                tuple = tupleEnd;
             }
 
         /* Ignore unsupported keywords, error out on unknown keywords */
-        } else if(![&keyword](){
-            /* Using lambda to emulate for-else construct like in Python */
-            for(const std::string expected: {"mtllib", "usemtl", "g", "s"})
-                if(keyword == expected) return true;
-            return false;
-        }()) {
-            Error() << "Trade::ObjImporter::mesh3D(): unknown keyword" << keyword;
+        } else if(!equals(keywordBegin, keywordEnd, "mtllib") &&
+                  !equals(keywordBegin, keywordEnd, "usemtl") &&
+                  !equals(keywordBegin, keywordEnd, "g") &&
+                  !equals(keywordBegin, keywordEnd, "s")) {
+            Error() << "Trade::ObjImporter::mesh3D(): unknown keyword" << std::string{keywordBegin, keywordEnd};
             return Containers::NullOpt;
         }
-
-    }} catch(const std::exception&) {
-        Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
-        return Containers::NullOpt;
-    } catch(...) {
-        /* Error message already printed */
-        return Containers::NullOpt;
     }
 
     /* There should be at least indexed position data */
@@ -444,6 +493,202 @@ Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
     return MeshData3D{*primitive, std::move(indices), {std::move(positions)}, std::move(normals), std::move(textureCoordinates), {}, nullptr};
 }
 
+}
+
+ObjImporter::ObjImporter() = default;
+
+ObjImporter::ObjImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+ObjImporter::~ObjImporter() = default;
+
+auto ObjImporter::doFeatures() const -> Features { return Feature::OpenData; }
+
+void ObjImporter::doClose() { _file.reset(); }
+
+bool ObjImporter::doIsOpened() const { return !!_file; }
+
+void ObjImporter::doOpenFile(const std::string& filename) {
+    if(!Utility::Directory::exists(filename)) {
+        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    Containers::Pointer<File> file{new File};
+
+    /* Memory-map the file so it's neither copied nor read upfront. Mapping
+       fails for empty files, in which case we fall back to reading it. */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    {
+        Error silenceError{nullptr};
+        file->mapped = Utility::Directory::mapRead(filename);
+    }
+    if(file->mapped) file->data = file->mapped;
+    else
+    #endif
+    {
+        file->copy = Utility::Directory::read(filename);
+        file->data = file->copy;
+    }
+
+    _file = std::move(file);
+    parseMeshNames();
+}
+
+void ObjImporter::doOpenData(Containers::ArrayView<const char> data) {
+    _file.reset(new File);
+
+    /* The data are not guaranteed to stay in scope after this function
+       returns, so we need to make a copy */
+    _file->copy = Containers::Array<char>{Containers::NoInit, data.size()};
+    if(data.size()) std::memcpy(_file->copy.data(), data.data(), data.size());
+    _file->data = _file->copy;
+
+    parseMeshNames();
+}
+
+void ObjImporter::parseMeshNames() {
+    /* First mesh starts at the beginning, its indices start from 1. The end
+       offset will be updated to proper value later. */
+    UnsignedInt positionIndexOffset = 1;
+    UnsignedInt normalIndexOffset = 1;
+    UnsignedInt textureCoordinateIndexOffset = 1;
+    _file->meshes.push_back({0, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, 0, 0, 0, 0});
+
+    /* The first mesh doesn't have name by default but we might find it later,
+       so we need to track whether there are any data before first name */
+    bool thisIsFirstMeshAndItHasNoData = true;
+    _file->meshNames.emplace_back();
+
+    /* Single pass through the whole file, looking only at the keyword at the
+       beginning of each line */
+    const char* const begin = _file->data.begin();
+    const char* const end = _file->data.end();
+    for(const char* it = begin; it != end; ) {
+        /* The previous object might end at the beginning of this line */
+        const std::size_t lineBegin = it - begin;
+        const char* const lineEnd = findLineEnd(it, end);
+        const char* const keywordBegin = skipWhitespace(it, lineEnd);
+        const char* const keywordEnd = findWhitespace(keywordBegin, lineEnd);
+        it = lineEnd == end ? end : lineEnd + 1;
+
+        MeshRange& mesh = _file->meshes.back();
+
+        /* Mesh name */
+        if(equals(keywordBegin, keywordEnd, "o")) {
+            const char* const nameBegin = skipWhitespace(keywordEnd, lineEnd);
+            std::string name{nameBegin, trimmedEnd(nameBegin, lineEnd)};
+
+            /* This is the name of first mesh */
+            if(thisIsFirstMeshAndItHasNoData) {
+                thisIsFirstMeshAndItHasNoData = false;
+
+                /* Update its name and add it to name map */
+                if(!name.empty())
+                    _file->meshesForName.emplace(name, _file->meshes.size() - 1);
+                _file->meshNames.back() = std::move(name);
+
+                /* Update its begin offset to be more precise */
+                mesh.begin = it - begin;
+
+            /* Otherwise this is a name of new mesh */
+            } else {
+                /* Set end of the previous one */
+                mesh.end = lineBegin;
+
+                /* Save name and offset of the new one. The end offset will be
+                   updated later. */
+                if(!name.empty())
+                    _file->meshesForName.emplace(name, _file->meshes.size());
+                _file->meshNames.emplace_back(std::move(name));
+                _file->meshes.push_back({std::size_t(it - begin), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, 0, 0, 0, 0});
+            }
+
+        /* If there are any data/indices before the first name, it means that
+           the first object is unnamed. We need to check for them. */
+
+        /* Vertex data, update index offset for the following meshes and
+           element counts for this one */
+        } else if(equals(keywordBegin, keywordEnd, "v")) {
+            ++positionIndexOffset;
+            ++mesh.positionCount;
+            thisIsFirstMeshAndItHasNoData = false;
+        } else if(equals(keywordBegin, keywordEnd, "vt")) {
+            ++textureCoordinateIndexOffset;
+            ++mesh.textureCoordinateCount;
+            thisIsFirstMeshAndItHasNoData = false;
+        } else if(equals(keywordBegin, keywordEnd, "vn")) {
+            ++normalIndexOffset;
+            ++mesh.normalCount;
+            thisIsFirstMeshAndItHasNoData = false;
+
+        /* Index data, count the primitives and mark that we found something
+           for first unnamed object */
+        } else if(equals(keywordBegin, keywordEnd, "p") ||
+                  equals(keywordBegin, keywordEnd, "l") ||
+                  equals(keywordBegin, keywordEnd, "f")) {
+            ++mesh.primitiveCount;
+            thisIsFirstMeshAndItHasNoData = false;
+        }
+
+        /* Everything else (including comments) is ignored here */
+    }
+
+    /* Set end of the last object */
+    _file->meshes.back().end = _file->data.size();
+}
+
+UnsignedInt ObjImporter::doMesh3DCount() const { return _file->meshes.size(); }
+
+Int ObjImporter::doMesh3DForName(const std::string& name) {
+    const auto it = _file->meshesForName.find(name);
+    return it == _file->meshesForName.end() ? -1 : it->second;
+}
+
+std::string ObjImporter::doMesh3DName(UnsignedInt id) {
+    return _file->meshNames[id];
+}
+
+Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
+    return parseMesh(_file->data, _file->meshes[id]);
+}
+
+std::vector<Containers::Optional<MeshData3D>> ObjImporter::meshes3D(const Containers::ArrayView<const UnsignedInt> ids, UnsignedInt threadCount) {
+    CORRADE_ASSERT(_file, "Trade::ObjImporter::meshes3D(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt id: ids)
+        CORRADE_ASSERT(id < _file->meshes.size(), "Trade::ObjImporter::meshes3D(): index" << id << "out of range for" << _file->meshes.size() << "meshes", {});
+    #endif
+
+    std::vector<Containers::Optional<MeshData3D>> out(ids.size());
+
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    #else
+    threadCount = 1;
+    #endif
+    threadCount = std::min(threadCount, UnsignedInt(ids.size()));
+
+    /* Each worker picks the next unprocessed ID, so a few large meshes don't
+       leave the other threads idle. Parsing only reads the file data and the
+       output slots are disjoint, so there's no need for any locking. */
+    std::atomic<std::size_t> next{0};
+    const Containers::ArrayView<const char> data = _file->data;
+    const std::vector<MeshRange>& meshes = _file->meshes;
+    auto worker = [&]() {
+        for(std::size_t i; (i = next++) < ids.size(); )
+            out[i] = parseMesh(data, meshes[ids[i]]);
+    };
+
+    std::vector<std::thread> threads;
+    if(threadCount > 1) threads.reserve(threadCount - 1);
+    for(UnsignedInt i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for(std::thread& thread: threads) thread.join();
+
+    return out;
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(ObjImporter, Magnum::Trade::ObjImporter,
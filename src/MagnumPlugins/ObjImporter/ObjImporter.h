@@ -29,7 +29,11 @@
  * @brief Class @ref Magnum::Trade::ObjImporter
  */
 
+#include <vector>
+#include <Corrade/Containers/Optional.h>
+
 #include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData3D.h"
 
 #include "MagnumPlugins/ObjImporter/configure.h"
 
@@ -70,8 +74,23 @@ for more information.
 
 @section Trade-ObjImporter-limitations Behavior and limitations
 
+Files opened with @ref openFile() are memory-mapped on platforms that support
+it, data passed to @ref openData() are copied as the importer can't rely on
+them staying in scope. All mesh ranges are found in a single indexing pass when
+the file is opened, @ref mesh3D() then parses just the corresponding range
+directly from memory, without any intermediate string allocations.
+
 Polygons (quads etc.), automatic normal generation and material properties are
 currently not supported.
+
+@section Trade-ObjImporter-parallel Parallel import
+
+Meshes are parsed from independent ranges of the file data and @ref mesh3D()
+doesn't modify any importer state, so it's safe to call it for different (or
+the same) meshes from multiple threads at once, as long as the file isn't
+closed or reopened in the meantime. For convenience, @ref meshes3D() decodes a
+set of meshes on a pool of threads and returns them in the same order as the
+IDs were passed.
 */
 class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
     public:
@@ -83,6 +102,25 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
 
         ~ObjImporter();
 
+        /**
+         * @brief Import multiple meshes in parallel
+         * @param ids           Mesh IDs, expected to be all less than
+         *      @ref mesh3DCount()
+         * @param threadCount   Count of threads to use, including the calling
+         *      one. If @cpp 0 @ce, @ref std::thread::hardware_concurrency()
+         *      is used.
+         *
+         * Expects that a file is opened. Equivalent to calling @ref mesh3D()
+         * for each of @p ids, but the meshes are distributed across a pool
+         * of @p threadCount threads, each picking up the next unprocessed ID
+         * once it's done with the previous one. Meshes that fail to import
+         * are @ref Corrade::Containers::NullOpt in the returned array. Note
+         * that error messages from worker threads are printed to the default
+         * output and not to one redirected in the calling thread. See
+         * @ref Trade-ObjImporter-parallel for more information.
+         */
+        std::vector<Containers::Optional<MeshData3D>> meshes3D(Containers::ArrayView<const UnsignedInt> ids, UnsignedInt threadCount = 0);
+
     private:
         struct File;
 
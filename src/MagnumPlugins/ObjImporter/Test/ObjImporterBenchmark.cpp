@@ -0,0 +1,192 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/String.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/CombineIndexedArrays.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+/* Stream-based parser equivalent to the original ObjImporter implementation,
+   for comparison. Handles just the subset of the format that's generated by
+   the benchmark. */
+std::size_t parseNaive(const std::string& data) {
+    std::istringstream in{data};
+    std::vector<Vector3> positions;
+    std::vector<Vector2> textureCoordinates;
+    std::vector<Vector3> normals;
+    std::vector<UnsignedInt> positionIndices;
+    std::vector<UnsignedInt> textureCoordinateIndices;
+    std::vector<UnsignedInt> normalIndices;
+
+    while(in.good()) {
+        std::string line;
+        std::getline(in, line);
+        line = Utility::String::trim(line);
+        if(line.empty() || line[0] == '#') continue;
+
+        const std::size_t keywordEnd = line.find(' ');
+        const std::string keyword = line.substr(0, keywordEnd);
+        const std::vector<std::string> contents = Utility::String::splitWithoutEmptyParts(line.substr(keywordEnd + 1), ' ');
+
+        if(keyword == "v")
+            positions.emplace_back(std::stof(contents[0]), std::stof(contents[1]), std::stof(contents[2]));
+        else if(keyword == "vt")
+            textureCoordinates.emplace_back(std::stof(contents[0]), std::stof(contents[1]));
+        else if(keyword == "vn")
+            normals.emplace_back(std::stof(contents[0]), std::stof(contents[1]), std::stof(contents[2]));
+        else if(keyword == "f") for(const std::string& indexTuple: contents) {
+            const std::vector<std::string> indices = Utility::String::split(indexTuple, '/');
+            positionIndices.push_back(std::stoul(indices[0]) - 1);
+            if(indices.size() == 3) {
+                textureCoordinateIndices.push_back(std::stoul(indices[1]) - 1);
+                normalIndices.push_back(std::stoul(indices[2]) - 1);
+            }
+        }
+    }
+
+    if(normalIndices.empty()) return positionIndices.size();
+
+    std::vector<std::reference_wrapper<std::vector<UnsignedInt>>> arrays{positionIndices, normalIndices, textureCoordinateIndices};
+    const std::vector<UnsignedInt> indices = MeshTools::combineIndexArrays(arrays);
+    positions = MeshTools::duplicate(positionIndices, positions);
+    normals = MeshTools::duplicate(normalIndices, normals);
+    textureCoordinates = MeshTools::duplicate(textureCoordinateIndices, textureCoordinates);
+    return indices.size();
+}
+
+/* Generates a size x size grid with triangle faces */
+std::string generateGrid(const UnsignedInt size, const bool textureCoordinatesNormals) {
+    std::string out;
+    out.reserve(size*size*(textureCoordinatesNormals ? 160 : 80));
+    out += "o Grid\n";
+    for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+        out += Utility::formatString("v {} {} {}\n", x*0.0125f, y*0.0125f, (x ^ y)*0.000732f);
+        if(!textureCoordinatesNormals) continue;
+        out += Utility::formatString("vt {} {}\n", Float(x)/size, Float(y)/size);
+        out += Utility::formatString("vn 0 {} 0.8660254\n", (x & 1) ? 0.5f : -0.5f);
+    }
+
+    for(UnsignedInt y = 0; y + 1 < size; ++y) for(UnsignedInt x = 0; x + 1 < size; ++x) {
+        const UnsignedInt a = y*size + x + 1, b = a + 1, c = a + size, d = c + 1;
+        if(textureCoordinatesNormals) {
+            out += Utility::formatString("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\n", a, b, d);
+            out += Utility::formatString("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\n", a, d, c);
+        } else {
+            out += Utility::formatString("f {} {} {}\n", a, b, d);
+            out += Utility::formatString("f {} {} {}\n", a, d, c);
+        }
+    }
+
+    return out;
+}
+
+struct ObjImporterBenchmark: TestSuite::Tester {
+    explicit ObjImporterBenchmark();
+
+    void positionsNaive();
+    void positions();
+    void textureCoordinatesNormalsNaive();
+    void textureCoordinatesNormals();
+
+    std::string _positions, _textureCoordinatesNormals;
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+ObjImporterBenchmark::ObjImporterBenchmark() {
+    addBenchmarks({&ObjImporterBenchmark::positionsNaive,
+                   &ObjImporterBenchmark::positions,
+                   &ObjImporterBenchmark::textureCoordinatesNormalsNaive,
+                   &ObjImporterBenchmark::textureCoordinatesNormals}, 5);
+
+    _positions = generateGrid(256, false);
+    _textureCoordinatesNormals = generateGrid(256, true);
+
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void ObjImporterBenchmark::positionsNaive() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1)
+        count += parseNaive(_positions);
+
+    CORRADE_COMPARE(count, 255*255*6);
+}
+
+void ObjImporterBenchmark::positions() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData({_positions.data(), _positions.size()}));
+        Containers::Optional<MeshData3D> mesh = importer->mesh3D(0);
+        CORRADE_VERIFY(mesh);
+        count += mesh->indices().size();
+    }
+
+    CORRADE_COMPARE(count, 255*255*6);
+}
+
+void ObjImporterBenchmark::textureCoordinatesNormalsNaive() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1)
+        count += parseNaive(_textureCoordinatesNormals);
+
+    CORRADE_COMPARE(count, 255*255*6);
+}
+
+void ObjImporterBenchmark::textureCoordinatesNormals() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData({_textureCoordinatesNormals.data(), _textureCoordinatesNormals.size()}));
+        Containers::Optional<MeshData3D> mesh = importer->mesh3D(0);
+        CORRADE_VERIFY(mesh);
+        count += mesh->indices().size();
+    }
+
+    CORRADE_COMPARE(count, 255*255*6);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterBenchmark)
@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <thread>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
@@ -33,6 +34,10 @@
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/MeshData3D.h"
 
+#ifndef OBJIMPORTER_PLUGIN_FILENAME
+#include "MagnumPlugins/ObjImporter/ObjImporter.h"
+#endif
+
 #include "configure.h"
 
 namespace Magnum { namespace Trade { namespace Test { namespace {
@@ -56,6 +61,11 @@ struct ObjImporterTest: TestSuite::Tester {
     void moreMeshes();
     void unnamedFirstMesh();
 
+    void openData();
+    void numberFormats();
+    void concurrentMesh3D();
+    void meshes3D();
+
     void wrongFloat();
     void wrongInteger();
     void unmergedIndexOutOfRange();
@@ -111,6 +121,11 @@ ObjImporterTest::ObjImporterTest() {
               &ObjImporterTest::moreMeshes,
               &ObjImporterTest::unnamedFirstMesh,
 
+              &ObjImporterTest::openData,
+              &ObjImporterTest::numberFormats,
+              &ObjImporterTest::concurrentMesh3D,
+              &ObjImporterTest::meshes3D,
+
               &ObjImporterTest::wrongFloat,
               &ObjImporterTest::wrongInteger,
               &ObjImporterTest::unmergedIndexOutOfRange,
@@ -407,6 +422,119 @@ void ObjImporterTest::unnamedFirstMesh() {
     CORRADE_COMPARE(importer->mesh3DForName("SecondMesh"), 1);
 }
 
+void ObjImporterTest::openData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    /* Tabs, CRLF line endings and no newline at the end */
+    const char data[] =
+        "# comment\r\n"
+        "o\tFirst \r\n"
+        "v 1 2 3\r\n"
+        "\tv\t4 5 6\r\n"
+        "  # indented comment\r\n"
+        "l 1 2\r\n"
+        "o Second\n"
+        "v 7 8 9\n"
+        "p 3";
+    CORRADE_VERIFY(importer->openData({data, sizeof(data) - 1}));
+    CORRADE_COMPARE(importer->mesh3DCount(), 2);
+    CORRADE_COMPARE(importer->mesh3DName(0), "First");
+    CORRADE_COMPARE(importer->mesh3DName(1), "Second");
+
+    const Containers::Optional<MeshData3D> data0 = importer->mesh3D(0);
+    CORRADE_VERIFY(data0);
+    CORRADE_COMPARE(data0->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(data0->positions(0), (std::vector<Vector3>{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f}
+    }));
+    CORRADE_COMPARE(data0->indices(), (std::vector<UnsignedInt>{0, 1}));
+
+    const Containers::Optional<MeshData3D> data1 = importer->mesh3D(1);
+    CORRADE_VERIFY(data1);
+    CORRADE_COMPARE(data1->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(data1->positions(0), (std::vector<Vector3>{
+        {7.0f, 8.0f, 9.0f}
+    }));
+    CORRADE_COMPARE(data1->indices(), std::vector<UnsignedInt>{0});
+}
+
+void ObjImporterTest::numberFormats() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    const char data[] =
+        "v -1.5 +.25 3.\n"
+        "v 1e2 -2.5E-1 7.125e+1\n"
+        "v 0.000000000000000000000000000000000000012345678 123456789012345678901234567890 -0\n"
+        "p 1\n"
+        "p 2\n"
+        "p 3\n";
+    CORRADE_VERIFY(importer->openData({data, sizeof(data) - 1}));
+
+    const Containers::Optional<MeshData3D> mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{
+        {-1.5f, 0.25f, 3.0f},
+        {100.0f, -0.25f, 71.25f},
+        {1.2345678e-38f, 1.2345679e+29f, 0.0f}
+    }));
+}
+
+void ObjImporterTest::concurrentMesh3D() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "moreMeshes.obj")));
+    CORRADE_COMPARE(importer->mesh3DCount(), 3);
+
+    /* Each thread imports all meshes, in a different order */
+    Containers::Optional<MeshData3D> meshes[3][3];
+    std::thread threads[3];
+    for(UnsignedInt i = 0; i != 3; ++i) threads[i] = std::thread{[&importer, &meshes, i]() {
+        for(UnsignedInt j = 0; j != 3; ++j)
+            meshes[i][(i + j) % 3] = importer->mesh3D((i + j) % 3);
+    }};
+    for(std::thread& thread: threads) thread.join();
+
+    for(UnsignedInt i = 0; i != 3; ++i) {
+        CORRADE_VERIFY(meshes[i][0]);
+        CORRADE_VERIFY(meshes[i][1]);
+        CORRADE_VERIFY(meshes[i][2]);
+        CORRADE_COMPARE(meshes[i][0]->primitive(), MeshPrimitive::Points);
+        CORRADE_COMPARE(meshes[i][1]->primitive(), MeshPrimitive::Lines);
+        CORRADE_COMPARE(meshes[i][2]->primitive(), MeshPrimitive::Triangles);
+        CORRADE_COMPARE(meshes[i][2]->positions(0), (std::vector<Vector3>{
+            {0.5f, 2.0f, 3.0f},
+            {0.0f, 1.5f, 1.0f},
+            {2.0f, 3.0f, 5.5f}
+        }));
+        CORRADE_COMPARE(meshes[i][2]->indices(), (std::vector<UnsignedInt>{
+            0, 1, 2, 2, 1, 0
+        }));
+    }
+}
+
+void ObjImporterTest::meshes3D() {
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    CORRADE_SKIP("ObjImporter::meshes3D() can be called only if the plugin is linked statically.");
+    #else
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "moreMeshes.obj")));
+
+    /* Duplicate IDs are allowed, order should be preserved */
+    const UnsignedInt ids[]{2, 0, 1, 2, 0};
+    std::vector<Containers::Optional<MeshData3D>> meshes = static_cast<ObjImporter&>(*importer).meshes3D(ids, 4);
+    CORRADE_COMPARE(meshes.size(), 5);
+    for(std::size_t i = 0; i != meshes.size(); ++i) {
+        CORRADE_VERIFY(meshes[i]);
+        CORRADE_COMPARE(meshes[i]->primitive(), ids[i] == 0 ? MeshPrimitive::Points :
+            ids[i] == 1 ? MeshPrimitive::Lines : MeshPrimitive::Triangles);
+    }
+
+    /* Single-threaded and empty variants */
+    CORRADE_COMPARE(static_cast<ObjImporter&>(*importer).meshes3D(ids, 1).size(), 5);
+    CORRADE_VERIFY(static_cast<ObjImporter&>(*importer).meshes3D(nullptr).empty());
+    #endif
+}
+
 void ObjImporterTest::wrongFloat() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
     CORRADE_VERIFY(importer->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "wrongNumbers.obj")));